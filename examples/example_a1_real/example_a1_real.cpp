@@ -24,6 +24,7 @@
 
 #include "quadruped/exec/qr_robot_runner.h"
 #include "quadruped/ros/qr_control2gazebo_msg.h"
+#include "quadruped/ros/qr_cmd_vel_receiver.h"
 
 #include <ros/package.h>
 
@@ -36,6 +37,11 @@ int main(int argc, char **argv)
     std::string robotName = "a1";
     YAML::Node mainConfig = YAML::LoadFile(homeDir + "config/a1/main.yaml");
     int twistMode = mainConfig["speed_update_mode"].as<int>();
+
+    // keep ros and sdk threads off the control core, they inherit the cpu mask of this thread.
+    qrUserParameters userParameters(homeDir + "config/user_parameters.yaml");
+    qrRealtimeSetup realtimeSetup(userParameters);
+    realtimeSetup.IsolateHelperThreads();
     
     ros::init(argc, argv, "ascend_quadruped_robot");
     ros::NodeHandle nh;
@@ -123,6 +129,10 @@ int main(int argc, char **argv)
         if ((count+1) % 1000==0) {
             printf("avg time cost = %f [ms]\n", avgCost);
             avgCost = 0.;
+            if (qrAllocTracker::Enabled()) {
+                printf("heap allocations in last tick = %zu (%zu bytes)\n",
+                       robotRunner.GetAllocStats().allocations, robotRunner.GetAllocStats().bytes);
+            }
         }
         
         if (quadruped->stateDataFlow.heightInControlFrame < 0.05
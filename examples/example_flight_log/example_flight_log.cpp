@@ -0,0 +1,122 @@
+// The MIT License
+
+// Copyright (c) 2022
+// Robot Motion and Vision Laboratory at East China Normal University
+// Contact: tophill.robotics@gmail.com
+
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+
+#include <ros/package.h>
+
+#include "quadruped/exec/qr_log_replay.h"
+#include "quadruped/utils/qr_flight_recorder.h"
+#include "matplotlibcpp.h"
+
+using namespace Quadruped;
+namespace plt = matplotlibcpp;
+
+
+/**
+ * @brief Find a column given as field or field_index, e.g. motorAngles_2.
+ * @return whether the column exists.
+ */
+bool FindColumn(const qrFlightLog &log, const std::string &column, const qrFlightField *&field, unsigned int &index)
+{
+    field = log.FindField(column);
+    index = 0;
+    size_t separator = column.rfind('_');
+    if (!field && separator != std::string::npos) {
+        field = log.FindField(column.substr(0, separator));
+        index = std::atoi(column.c_str() + separator + 1);
+    }
+    return field && index < field->count;
+}
+
+
+int main(int argc, char **argv)
+{
+    if (argc < 2) {
+        std::cout << "usage: example_flight_log <log>                    print the fields and the tick range\n"
+                     "       example_flight_log <log> csv <file>         export all records as CSV\n"
+                     "       example_flight_log <log> plot <column> ...  plot columns against time, e.g. motorAngles_2\n"
+                     "       example_flight_log <log> replay <robot> [dir]  re-run the controllers on the log, e.g. a1_sim,\n"
+                     "                                                  with the config of dir, the quadruped package by default"
+                  << std::endl;
+        return 1;
+    }
+
+    const std::string command = argc > 2 ? argv[2] : "";
+    if (command == "replay" && argc > 3) {
+        std::string homeDir = argc > 4 ? argv[4] : ros::package::getPath("quadruped") + "/";
+        qrLogReplay replay(homeDir, argv[3]);
+        qrReplayReport report = replay.Run(argv[1]);
+        report.Print();
+        return report.error.empty() && report.divergentTicks == 0 ? 0 : 1;
+    }
+
+    qrFlightLog log(argv[1]);
+
+    if (command == "csv" && argc > 3) {
+        std::ofstream out(argv[3]);
+        log.ExportCsv(out);
+        std::cout << "exported " << log.Size() << " records to " << argv[3] << std::endl;
+        return 0;
+    }
+
+    if (command == "plot" && argc > 3) {
+        const qrFlightField *time = log.FindField("time");
+        std::vector<double> x(log.Size());
+        for (size_t r = 0; r < log.Size(); ++r) {
+            x[r] = time ? log.Value(r, *time) : r;
+        }
+        plt::figure();
+        for (int i = 3; i < argc; ++i) {
+            const qrFlightField *field;
+            unsigned int index;
+            if (!FindColumn(log, argv[i], field, index)) {
+                std::cerr << "no column " << argv[i] << std::endl;
+                continue;
+            }
+            std::vector<double> y(log.Size());
+            for (size_t r = 0; r < log.Size(); ++r) {
+                y[r] = log.Value(r, *field, index);
+            }
+            plt::plot(x, y, {{"label", argv[i]}});
+        }
+        plt::grid(true);
+        plt::legend();
+        plt::show();
+        return 0;
+    }
+
+    std::cout << log.Size() << " records";
+    const qrFlightField *tick = log.FindField("tick");
+    if (tick && log.Size() > 0) {
+        std::cout << ", ticks " << log.Value(0, *tick) << " to " << log.Value(log.Size() - 1, *tick);
+    }
+    std::cout << "\nfields:" << std::endl;
+    for (const auto &field : log.GetFields()) {
+        std::cout << "  " << field.name << " [" << field.count << "]" << std::endl;
+    }
+    return 0;
+}
@@ -0,0 +1,98 @@
+// The MIT License
+
+// Copyright (c) 2022
+// Robot Motion and Vision Laboratory at East China Normal University
+// Contact: tophill.robotics@gmail.com
+
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include <chrono>
+#include <cstdio>
+#include <map>
+#include <string>
+
+#include <lcm/lcm-cpp.hpp>
+
+#include "quadruped/lcm_types/qr_telemetry_lcmt.hpp"
+
+
+/**
+ * @brief Counts the telemetry messages of each channel and keeps the last one.
+ */
+class TelemetryMonitor {
+
+public:
+
+    void Handle(const lcm::ReceiveBuffer *, const std::string &channel, const qr_telemetry_lcmt *message) {
+        ++counts[channel];
+        last = *message;
+    }
+
+    /**
+     * @brief Print the rate of each channel over the last period and the last message, then reset the counts.
+     * @param period: time since the last print (unit: s).
+     */
+    void Print(double period) {
+        for (const auto &count : counts) {
+            printf("%s %.1f Hz  ", count.first.c_str(), count.second / period);
+        }
+        printf("| tick %d, mode %d, latency %.1f us, v [%.2f %.2f %.2f] m/s, command [%.2f %.2f] m/s %.2f rad/s\n",
+               last.tick, last.fsm_mode, last.latency * 1e6, last.velocity[0], last.velocity[1], last.velocity[2],
+               last.velocity_command[0], last.velocity_command[1], last.omega_command[2]);
+        counts.clear();
+    }
+
+private:
+
+    std::map<std::string, unsigned long> counts;
+
+    qr_telemetry_lcmt last = {};
+};
+
+
+int main(int argc, char **argv)
+{
+    if (argc > 1 && std::string(argv[1]) == "-h") {
+        printf("usage: example_telemetry [url] [channels]  print the telemetry of a running controller,\n"
+               "                                           e.g. udpm://239.255.76.67:7667?ttl=0 \"QR_TELEMETRY.*\"\n");
+        return 1;
+    }
+    const std::string url = argc > 1 ? argv[1] : "";
+    const std::string channels = argc > 2 ? argv[2] : "QR_TELEMETRY.*";
+
+    lcm::LCM lcm(url);
+    if (!lcm.good()) {
+        fprintf(stderr, "cannot connect to LCM at %s\n", url.c_str());
+        return 1;
+    }
+    TelemetryMonitor monitor;
+    lcm.subscribe(channels, &TelemetryMonitor::Handle, &monitor);
+
+    auto lastPrint = std::chrono::steady_clock::now();
+    while (true) {
+        lcm.handleTimeout(100);
+        auto now = std::chrono::steady_clock::now();
+        double period = std::chrono::duration<double>(now - lastPrint).count();
+        if (period >= 1.) {
+            monitor.Print(period);
+            lastPrint = now;
+        }
+    }
+    return 0;
+}
@@ -0,0 +1,181 @@
+// The MIT License
+
+// Copyright (c) 2022
+// Robot Motion and Vision Laboratory at East China Normal University
+// Contact: tophill.robotics@gmail.com
+
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+#include "qr_bench.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <iomanip>
+
+#include "utils/qr_running_stats.h"
+
+
+namespace Quadruped {
+
+namespace {
+
+/**
+ * @brief Shortest sample that the batch is calibrated to, in nanoseconds.
+ */
+constexpr double MIN_SAMPLE_TIME = 1000.;
+
+constexpr unsigned int MAX_BATCH = 1u << 16;
+
+constexpr unsigned long MIN_SAMPLES = 10;
+
+constexpr unsigned long MAX_SAMPLES = 1000000;
+
+using Clock = std::chrono::steady_clock;
+
+double ElapsedNs(Clock::time_point start, Clock::time_point end)
+{
+    return std::chrono::duration<double, std::nano>(end - start).count();
+}
+
+} // Anonymous namespace
+
+
+qrBenchSuite::qrBenchSuite(size_t numInputs, double minTime):
+    numInputs(std::max<size_t>(numInputs, 1)), minTime(minTime)
+{
+}
+
+
+void qrBenchSuite::Add(const std::string &name, std::function<void(size_t)> prepare, std::function<void()> run,
+                       bool repeatable)
+{
+    cases.push_back({name, prepare, run, repeatable});
+}
+
+
+std::vector<qrBenchResult> qrBenchSuite::Run(const std::string &filter)
+{
+    std::vector<qrBenchResult> results;
+    for (const qrBenchCase &benchCase : cases) {
+        if (benchCase.name.find(filter) == std::string::npos) {
+            continue;
+        }
+        results.push_back(RunCase(benchCase));
+        const qrBenchResult &result = results.back();
+        printf("%-36s %10.0f ns\n", result.name.c_str(), result.mean);
+    }
+    return results;
+}
+
+
+qrBenchResult qrBenchSuite::RunCase(const qrBenchCase &benchCase)
+{
+    /* Warm up the caches and the lazily allocated workspaces. */
+    for (size_t i = 0; i < std::min<size_t>(numInputs, MIN_SAMPLES); ++i) {
+        benchCase.prepare(i);
+        benchCase.run();
+    }
+
+    unsigned int batch = 1;
+    if (benchCase.repeatable) {
+        while (batch < MAX_BATCH) {
+            benchCase.prepare(0);
+            Clock::time_point start = Clock::now();
+            for (unsigned int i = 0; i < batch; ++i) {
+                benchCase.run();
+            }
+            if (ElapsedNs(start, Clock::now()) >= MIN_SAMPLE_TIME) {
+                break;
+            }
+            batch *= 2;
+        }
+    }
+
+    qrRunningStats stats;
+    qrQuantileSketch quantiles;
+    Clock::time_point caseStart = Clock::now();
+    unsigned long samples = 0;
+    while (samples < MAX_SAMPLES
+           && (samples < MIN_SAMPLES || ElapsedNs(caseStart, Clock::now()) < minTime * 1e9)) {
+        benchCase.prepare(samples % numInputs);
+        Clock::time_point start = Clock::now();
+        for (unsigned int i = 0; i < batch; ++i) {
+            benchCase.run();
+        }
+        double ns = ElapsedNs(start, Clock::now()) / batch;
+        stats.Update(ns);
+        quantiles.Update(ns);
+        ++samples;
+    }
+
+    qrBenchResult result;
+    result.name = benchCase.name;
+    result.samples = stats.GetCount();
+    result.batch = batch;
+    result.mean = stats.GetMean();
+    result.stdDev = stats.GetStandardDeviation();
+    result.p50 = quantiles.GetQuantile(0.5);
+    result.p99 = quantiles.GetQuantile(0.99);
+    result.min = stats.GetMin();
+    result.max = stats.GetMax();
+    return result;
+}
+
+
+void qrBenchSuite::PrintTable(std::ostream &os, const std::vector<qrBenchResult> &results)
+{
+    os << std::left << std::setw(36) << "case" << std::right
+       << std::setw(10) << "samples" << std::setw(8) << "batch"
+       << std::setw(12) << "mean ns" << std::setw(12) << "sigma ns"
+       << std::setw(12) << "p50 ns" << std::setw(12) << "p99 ns"
+       << std::setw(12) << "min ns" << std::setw(12) << "max ns" << "\n";
+    os << std::fixed << std::setprecision(0);
+    for (const qrBenchResult &result : results) {
+        os << std::left << std::setw(36) << result.name << std::right
+           << std::setw(10) << result.samples << std::setw(8) << result.batch
+           << std::setw(12) << result.mean << std::setw(12) << result.stdDev
+           << std::setw(12) << result.p50 << std::setw(12) << result.p99
+           << std::setw(12) << result.min << std::setw(12) << result.max << "\n";
+    }
+    os << std::defaultfloat;
+}
+
+
+void qrBenchSuite::WriteJson(std::ostream &os, const std::vector<qrBenchResult> &results,
+                             const std::vector<std::pair<std::string, std::string>> &context)
+{
+    os << "{\n  \"context\": {";
+    for (size_t i = 0; i < context.size(); ++i) {
+        os << (i ? ", " : "") << "\"" << context[i].first << "\": \"" << context[i].second << "\"";
+    }
+    os << "},\n  \"unit\": \"ns\",\n  \"results\": [";
+    os << std::fixed << std::setprecision(1);
+    for (size_t i = 0; i < results.size(); ++i) {
+        const qrBenchResult &result = results[i];
+        os << (i ? "," : "") << "\n    {\"name\": \"" << result.name << "\""
+           << ", \"samples\": " << result.samples << ", \"batch\": " << result.batch
+           << ", \"mean\": " << result.mean << ", \"stddev\": " << result.stdDev
+           << ", \"p50\": " << result.p50 << ", \"p99\": " << result.p99
+           << ", \"min\": " << result.min << ", \"max\": " << result.max << "}";
+    }
+    os << "\n  ]\n}\n";
+    os << std::defaultfloat;
+}
+
+} // namespace Quadruped
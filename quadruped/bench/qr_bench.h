@@ -0,0 +1,160 @@
+// The MIT License
+
+// Copyright (c) 2022
+// Robot Motion and Vision Laboratory at East China Normal University
+// Contact: tophill.robotics@gmail.com
+
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+#ifndef QR_BENCH_H
+#define QR_BENCH_H
+
+#include <functional>
+#include <ostream>
+#include <string>
+#include <vector>
+
+
+namespace Quadruped {
+
+/**
+ * @brief Keep the compiler from optimizing away the computation of a value that is never read.
+ */
+template<typename T>
+inline void qrBenchKeep(const T &value)
+{
+    asm volatile("" : : "g"(&value) : "memory");
+}
+
+/**
+ * @brief A kernel to time.
+ */
+struct qrBenchCase {
+
+    /**
+     * @brief Name of the case, as "group/kernel".
+     */
+    std::string name;
+
+    /**
+     * @brief Load input i, e.g. set the robot to the i-th recorded state. Not timed.
+     */
+    std::function<void(size_t)> prepare;
+
+    /**
+     * @brief The timed kernel.
+     */
+    std::function<void()> run;
+
+    /**
+     * @brief Whether the kernel may run several times on one input. Kernels that advance
+     * a state, like the estimators, run once per prepared input.
+     */
+    bool repeatable;
+};
+
+/**
+ * @brief Timing of one case, per call of the kernel, in nanoseconds.
+ */
+struct qrBenchResult {
+
+    std::string name;
+
+    /**
+     * @brief Number of timed samples.
+     */
+    unsigned long samples;
+
+    /**
+     * @brief Number of calls of the kernel in one sample.
+     */
+    unsigned int batch;
+
+    double mean;
+
+    double stdDev;
+
+    double p50;
+
+    double p99;
+
+    double min;
+
+    double max;
+};
+
+/**
+ * @brief Runs the cases over a set of inputs and collects their timing.
+ * Each sample prepares the next input, then times a batch of calls. The batch is calibrated so that
+ * a sample lasts about a microsecond, above the resolution of the clock.
+ */
+class qrBenchSuite {
+
+public:
+
+    /**
+     * @brief Constructor of class qrBenchSuite.
+     * @param numInputs: number of inputs, prepare() is called with 0 ... numInputs - 1.
+     * @param minTime: time spent in each case, in seconds.
+     */
+    qrBenchSuite(size_t numInputs, double minTime);
+
+    /**
+     * @brief Add a case.
+     */
+    void Add(const std::string &name, std::function<void(size_t)> prepare, std::function<void()> run,
+             bool repeatable = true);
+
+    /**
+     * @brief Run the cases whose name contains filter, in the order of adding.
+     * @param filter: substring of the names of the cases to run, empty to run all of them.
+     * @return the timing of each case that has run.
+     */
+    std::vector<qrBenchResult> Run(const std::string &filter = "");
+
+    /**
+     * @brief Print the results as a table.
+     */
+    static void PrintTable(std::ostream &os, const std::vector<qrBenchResult> &results);
+
+    /**
+     * @brief Write the results as JSON, for tracking the regressions.
+     * @param os: the stream to write.
+     * @param results: the results of Run().
+     * @param context: (key, value) pairs describing the run, e.g. robot and input log.
+     */
+    static void WriteJson(std::ostream &os, const std::vector<qrBenchResult> &results,
+                          const std::vector<std::pair<std::string, std::string>> &context);
+
+private:
+
+    /**
+     * @brief Time one case.
+     */
+    qrBenchResult RunCase(const qrBenchCase &benchCase);
+
+    std::vector<qrBenchCase> cases;
+
+    size_t numInputs;
+
+    double minTime;
+};
+
+} // namespace Quadruped
+
+#endif // QR_BENCH_H
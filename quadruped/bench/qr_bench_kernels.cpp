@@ -0,0 +1,491 @@
+// The MIT License
+
+// Copyright (c) 2022
+// Robot Motion and Vision Laboratory at East China Normal University
+// Contact: tophill.robotics@gmail.com
+
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+#include "qr_bench_kernels.h"
+
+#include <cstring>
+#include <iostream>
+
+
+namespace Quadruped {
+
+namespace {
+
+/**
+ * @brief Time of one MPC step of the stance leg controller.
+ */
+constexpr float DT_MPC = 0.06f;
+
+/**
+ * @brief Inputs of SolveMPCKernel().
+ */
+struct qrMPCInput {
+
+    EIGEN_MAKE_ALIGNED_OPERATOR_NEW
+
+    Vec3<float> p;
+
+    Vec3<float> v;
+
+    Quat<float> q;
+
+    Vec3<float> w;
+
+    Eigen::Matrix<float, 3, 4> r;
+
+    Vec3<float> rpy;
+
+    std::vector<float> trajectory;
+
+    Eigen::Matrix<float, Eigen::Dynamic, 4, Eigen::RowMajor> gait;
+};
+
+} // Anonymous namespace
+
+
+qrBenchKernels::qrBenchKernels(const std::string &homeDirIn, const std::string &robotNameIn,
+                               std::vector<qrFlightRecord> recordsIn):
+    homeDir(homeDirIn),
+    robotName(robotNameIn),
+    records(std::move(recordsIn)),
+    userParameters(homeDirIn + "config/user_parameters.yaml")
+{
+    robot = new qrRobotReplay(homeDir + "config/" + robotName + "/" + robotName + ".yaml");
+    robot->BuildDynamicModel();
+    model = robot->model;
+    if (records.empty()) {
+        std::cout << "[Bench] no log given, the only input is the robot standing still." << std::endl;
+        records.push_back(StandingRecord());
+    }
+    LoadState(0);
+
+    gaitGenerator = new qrOpenLoopGaitGenerator(robot, homeDir + "config/" + robotName + "/openloop_gait_generator.yaml");
+    stateEstimators = new qrStateEstimatorContainer(robot, gaitGenerator, &userParameters,
+                                                    "config/" + robotName + "/terrain.yaml", homeDir);
+    stateEstimators->Reset();
+    stateEstimators->GetRobotEstimator()->CMUInitState();
+    invariantEKF = new qrInvariantEKF(robot);
+    invariantEKF->Reset(robot->GetTimeSinceReset());
+
+    YAML::Node stanceParams = YAML::LoadFile(homeDir + "config/" + robotName + "/stance_leg_controller.yaml")
+                                  ["stance_leg_params"]["advanced_trot"];
+    std::vector<float> v = stanceParams["Q"].as<std::vector<float>>();
+    std::copy(v.begin(), v.begin() + 12, mpcWeights);
+    v = stanceParams["acc_weight"].as<std::vector<float>>();
+    accWeight = Eigen::Map<Vec6<float>>(&v[0]);
+    v = stanceParams["KD"].as<std::vector<float>>();
+    KD = Eigen::Map<Vec6<float>>(&v[0]);
+
+    /* The whole body impulse control as set up by the WBC locomotion controller. */
+    const size_t dimConfig = NumMotor + 6;
+    multitask = new qrMultitaskProjection<float>(dimConfig);
+    wbic = new qrWholeBodyImpulseCtrl<float>(dimConfig, &contactList, &taskList);
+    wbicExtraData.weightFb = DVec<float>::Constant(6, 0.1);
+    wbicExtraData.weightFr = DVec<float>::Constant(12, 1);
+    taskBodyOri = new qrTaskBodyOrientation<float>(&robot->model);
+    taskBodyPos = new qrTaskBodyPosition<float>(&robot->model);
+    const int footLinks[4] = {linkID::FR, linkID::FL, linkID::HR, linkID::HL};
+    for (int leg = 0; leg < NumLeg; ++leg) {
+        footContact[leg] = new qrSingleContact<float>(&robot->model, footLinks[leg]);
+        taskFootPos[leg] = new qrTaskLinkPosition<float>(&robot->model, footLinks[leg]);
+    }
+    for (int i = 0; i < 3; ++i) {
+        taskBodyPos->Kp[i] = 100.;
+        taskBodyPos->Kd[i] = 10.;
+        taskBodyOri->Kp[i] = 100.;
+        taskBodyOri->Kd[i] = 10.;
+        for (int leg = 0; leg < NumLeg; ++leg) {
+            taskFootPos[leg]->Kp[i] = 500.;
+            taskFootPos[leg]->Kd[i] = 10.;
+        }
+    }
+
+    windowFilter = qrMovingWindowFilter<float, 12>(userParameters.movingWindowFilterSize);
+    kalmanFilter = qrKalmanFilter<float, 3, 3>(userParameters.initialVariance,
+                                               userParameters.accelerometerVariance,
+                                               userParameters.sensorVariance);
+}
+
+
+qrBenchKernels::~qrBenchKernels()
+{
+    delete taskBodyOri;
+    delete taskBodyPos;
+    for (int leg = 0; leg < NumLeg; ++leg) {
+        delete footContact[leg];
+        delete taskFootPos[leg];
+    }
+    delete wbic;
+    delete multitask;
+    delete invariantEKF;
+    delete stateEstimators;
+    delete gaitGenerator;
+    delete robot;
+}
+
+
+void qrBenchKernels::AddCases(qrBenchSuite &suite)
+{
+    AddRobotCases(suite);
+    AddDynamicsCases(suite);
+    AddMPCCases(suite);
+    AddContactForceCases(suite);
+    AddWBICCases(suite);
+    AddEstimatorCases(suite);
+    AddFilterCases(suite);
+}
+
+
+void qrBenchKernels::LoadState(size_t i)
+{
+    const qrFlightRecord &record = records[i];
+    robot->LoadRecord(record);
+
+    /* The estimated state, as the estimators have left it in flight. */
+    auto &dataFlow = robot->stateDataFlow;
+    robot->basePosition = Eigen::Map<const Vec3<float>>(record.basePosition);
+    dataFlow.baseVInWorldFrame = Eigen::Map<const Vec3<float>>(record.baseVInWorldFrame);
+    dataFlow.baseWInWorldFrame = Eigen::Map<const Vec3<float>>(record.baseWInWorldFrame);
+    robot->baseVelocityInBaseFrame = dataFlow.baseRMat.transpose() * dataFlow.baseVInWorldFrame;
+}
+
+
+qrFlightRecord qrBenchKernels::StandingRecord() const
+{
+    qrFlightRecord record;
+    memset(&record, 0, sizeof(record));
+    Eigen::Map<Vec12<float>>(record.motorAngles) = robot->standUpMotorAngles;
+    Eigen::Map<Vec3<float>>(record.accelerometer) << 0.f, 0.f, 9.81f;
+    Eigen::Map<Vec3<float>>(record.basePosition) << 0.f, 0.f, robot->bodyHeight;
+    Eigen::Map<Mat34<float>>(record.footPositionsInBaseFrame) = robot->FootPositionsInBaseFrame(robot->standUpMotorAngles);
+    for (int leg = 0; leg < NumLeg; ++leg) {
+        record.footContacts[leg] = 1.f;
+        record.footForces[leg] = robot->totalMass * 9.81f / NumLeg;
+        record.mpcForces[3 * leg + 2] = robot->totalMass * 9.81f / NumLeg;
+    }
+    return record;
+}
+
+
+void qrBenchKernels::AddRobotCases(qrBenchSuite &suite)
+{
+    auto load = [this](size_t i) { LoadState(i); };
+
+    suite.Add("robot/foot_positions", load, [this]() {
+        qrBenchKeep(robot->FootPositionsInBaseFrame(robot->motorAngles));
+    });
+
+    suite.Add("robot/jacobian", load, [this]() {
+        for (int leg = 0; leg < NumLeg; ++leg) {
+            qrBenchKeep(robot->ComputeJacobian(leg));
+        }
+    });
+
+    auto footPositions = std::make_shared<Mat34<float>>();
+    suite.Add("robot/inverse_kinematics", [this, footPositions](size_t i) {
+        LoadState(i);
+        *footPositions = robot->GetFootPositionsInBaseFrame();
+    }, [this, footPositions]() {
+        Vec3<int> jointIdx;
+        Vec3<float> jointAngles;
+        for (int leg = 0; leg < NumLeg; ++leg) {
+            robot->ComputeMotorAnglesFromFootLocalPosition(leg, footPositions->col(leg), jointIdx, jointAngles);
+            qrBenchKeep(jointAngles);
+        }
+    });
+}
+
+
+void qrBenchKernels::AddDynamicsCases(qrBenchSuite &suite)
+{
+    /* The model is evaluated from scratch at each call, as setState() resets the cached terms. */
+    auto load = [this](size_t i) {
+        LoadState(i);
+        modelState.bodyOrientation = robot->GetBaseOrientation();
+        modelState.bodyPosition = robot->GetBasePosition();
+        modelState.bodyVelocity << robot->GetBaseRollPitchYawRate(), robot->GetBaseVelocityInBaseFrame();
+        modelState.q = robot->GetMotorAngles();
+        modelState.qd = robot->GetMotorVelocities();
+    };
+
+    suite.Add("dynamics/forward_kinematics", load, [this]() {
+        model.setState(modelState);
+        model.forwardKinematics();
+    });
+
+    suite.Add("dynamics/contact_jacobians", load, [this]() {
+        model.setState(modelState);
+        model.contactJacobians();
+        qrBenchKeep(model._Jc[0]);
+    });
+
+    suite.Add("dynamics/mass_matrix", load, [this]() {
+        model.setState(modelState);
+        qrBenchKeep(model.massMatrix());
+    });
+
+    suite.Add("dynamics/coriolis", load, [this]() {
+        model.setState(modelState);
+        qrBenchKeep(model.generalizedCoriolisForce());
+    });
+}
+
+
+void qrBenchKernels::AddMPCCases(qrBenchSuite &suite)
+{
+    const int ticksPerStep = std::max(1, int(std::round(DT_MPC / robot->timeStep)));
+    Vec3<float> inertia(robot->totalInertia(0, 0), robot->totalInertia(1, 1), robot->totalInertia(2, 2));
+
+    for (int horizon : {5, 10, 15}) {
+        mpcProblems.emplace_back(new qrMPCProblem());
+        qrMPCProblem *problem = mpcProblems.back().get();
+        problem->SetupProblem(DT_MPC, horizon, 0.45, robot->totalMass * 9.81, robot->totalMass,
+                              inertia.data(), mpcWeights, 4e-6);
+
+        std::shared_ptr<qrMPCInput> input = std::allocate_shared<qrMPCInput>(Eigen::aligned_allocator<qrMPCInput>());
+        input->trajectory.resize(12 * horizon);
+        input->gait.resize(horizon, 4);
+
+        auto load = [this, input, horizon, ticksPerStep](size_t i) {
+            LoadState(i);
+            const qrFlightRecord &record = records[i];
+            auto &dataFlow = robot->stateDataFlow;
+            input->p = robot->GetBasePosition();
+            input->v = dataFlow.baseVInWorldFrame;
+            input->q = robot->GetBaseOrientation();
+            input->w = dataFlow.baseWInWorldFrame;
+            input->rpy = robot->GetBaseRollPitchYaw();
+            input->r = dataFlow.baseRMat * (robot->GetFootPositionsInBaseFrame().colwise() - robot->comOffset);
+
+            /* The desired trajectory of the commanded twist from the current pose, as in the stance leg controller. */
+            float yaw = input->rpy[2];
+            float yawRate = record.wDesInBodyFrame[2];
+            Vec3<float> vDesWorld = robotics::math::coordinateRotation(robotics::math::CoordinateAxis::Z, -yaw)
+                                    * Eigen::Map<const Vec3<float>>(record.vDesInBodyFrame);
+            float *trajectory = input->trajectory.data();
+            float trajInitial[12] = {0.f, 0.f, yaw,
+                                     input->p[0], input->p[1], robot->bodyHeight,
+                                     0.f, 0.f, yawRate,
+                                     vDesWorld[0], vDesWorld[1], 0.f};
+            for (int k = 0; k < horizon; ++k) {
+                for (int j = 0; j < 12; ++j) {
+                    trajectory[12 * k + j] = trajInitial[j];
+                }
+                if (k > 0) {
+                    trajectory[12 * k + 2] = trajectory[12 * (k - 1) + 2] + DT_MPC * yawRate;
+                    trajectory[12 * k + 3] = trajectory[12 * (k - 1) + 3] + DT_MPC * vDesWorld[0];
+                    trajectory[12 * k + 4] = trajectory[12 * (k - 1) + 4] + DT_MPC * vDesWorld[1];
+                }
+            }
+
+            /* The contacts that the robot has actually made over the horizon. */
+            for (int k = 0; k < horizon; ++k) {
+                const qrFlightRecord &future = records[std::min(i + size_t(k * ticksPerStep), records.size() - 1)];
+                for (int leg = 0; leg < NumLeg; ++leg) {
+                    input->gait(k, leg) = future.footContacts[leg] > 0.5f ? 1.f : 0.f;
+                }
+            }
+        };
+
+        suite.Add("mpc/horizon_" + std::to_string(horizon), load, [problem, input]() {
+            problem->SolveMPCKernel(input->p, input->v, input->q, input->w, input->r, input->rpy,
+                                    input->trajectory.data(), input->gait.data());
+            qrBenchKeep(problem->GetMPCSolution(0));
+        });
+    }
+}
+
+
+void qrBenchKernels::AddContactForceCases(qrBenchSuite &suite)
+{
+    struct Input {
+        Vec6<float> desiredAcc;
+        Eigen::Matrix<bool, 4, 1> contacts;
+    };
+    auto input = std::make_shared<Input>();
+
+    auto load = [this, input](size_t i) {
+        LoadState(i);
+        const qrFlightRecord &record = records[i];
+        auto &dataFlow = robot->stateDataFlow;
+
+        /* The damping term of the torque stance leg controller, which tracks the commanded twist. */
+        Vec3<float> vDesWorld = dataFlow.baseRMat * Eigen::Map<const Vec3<float>>(record.vDesInBodyFrame);
+        Vec3<float> wDesWorld = dataFlow.baseRMat * Eigen::Map<const Vec3<float>>(record.wDesInBodyFrame);
+        input->desiredAcc << vDesWorld - dataFlow.baseVInWorldFrame, wDesWorld - dataFlow.baseWInWorldFrame;
+        input->desiredAcc = KD.cwiseProduct(input->desiredAcc);
+        for (int leg = 0; leg < NumLeg; ++leg) {
+            input->contacts[leg] = record.footContacts[leg] > 0.5f;
+        }
+    };
+
+    suite.Add("contact_force/qp", load, [this, input]() {
+        qrBenchKeep(ComputeContactForce(robot, input->desiredAcc, input->contacts, accWeight,
+                                        {0.f, 0.f, 1.f}, {1.f, 0.f, 0.f}, {0.f, 1.f, 0.f}));
+    });
+}
+
+
+void qrBenchKernels::AddWBICCases(qrBenchSuite &suite)
+{
+    /* The tasks and the contacts of the WBC locomotion controller, tracking the recorded state and forces. */
+    struct Input {
+        Quat<float> quatDes;
+        Vec3<float> pBodyDes;
+        DVec<float> fullConfig = DVec<float>::Zero(NumMotor + 7);
+        DVec<float> desiredJPos = DVec<float>::Zero(NumMotor);
+        DVec<float> desiredJVel = DVec<float>::Zero(NumMotor);
+        DVec<float> jointTorqueCmd = DVec<float>::Zero(NumMotor);
+    };
+    auto input = std::make_shared<Input>();
+
+    auto updateTasks = [this, input](size_t i) {
+        LoadState(i);
+        const qrFlightRecord &record = records[i];
+        robot->UpdateDynamicsModel();
+        wbic->GetModelRes(robot->model);
+        input->fullConfig.segment(6, NumMotor) = robot->modelState.q;
+
+        Vec3<float> zero = Vec3<float>::Zero();
+        Vec3<float> rpyDes(0.f, 0.f, robot->GetBaseRollPitchYaw()[2]);
+        input->quatDes = robotics::math::rpyToQuat(rpyDes);
+        input->pBodyDes = robot->GetBasePosition();
+        Vec3<float> vBodyDes = robot->stateDataFlow.baseVInWorldFrame;
+        taskBodyOri->UpdateTask(&input->quatDes, zero, zero);
+        taskBodyPos->UpdateTask(&input->pBodyDes, vBodyDes, zero);
+
+        taskList.clear();
+        contactList.clear();
+        taskList.push_back(taskBodyOri);
+        taskList.push_back(taskBodyPos);
+        Mat34<float> footPositions = robot->GetFootPositionsInWorldFrame();
+        for (int leg = 0; leg < NumLeg; ++leg) {
+            if (record.footContacts[leg] > 0.5f) {
+                DVec<float> force = Eigen::Map<const Vec3<float>>(record.mpcForces + 3 * leg);
+                footContact[leg]->SetDesiredFr(force);
+                footContact[leg]->UpdateContactSpec();
+                contactList.push_back(footContact[leg]);
+            } else {
+                Vec3<float> footPosition = footPositions.col(leg);
+                taskFootPos[leg]->UpdateTask(&footPosition, zero, zero);
+                taskList.push_back(taskFootPos[leg]);
+            }
+        }
+    };
+
+    suite.Add("wbic/multitask_projection", updateTasks, [this, input]() {
+        multitask->FindConfiguration(input->fullConfig, taskList, contactList, input->desiredJPos, input->desiredJVel);
+        qrBenchKeep(input->desiredJPos);
+    });
+
+    suite.Add("wbic/make_torque", [this, input, updateTasks](size_t i) {
+        updateTasks(i);
+        multitask->FindConfiguration(input->fullConfig, taskList, contactList, input->desiredJPos, input->desiredJVel);
+    }, [this, input]() {
+        wbic->MakeTorque(input->jointTorqueCmd, &wbicExtraData);
+        qrBenchKeep(input->jointTorqueCmd);
+    });
+}
+
+
+void qrBenchKernels::AddEstimatorCases(qrBenchSuite &suite)
+{
+    /* The estimators integrate over time, so each input is a new tick and runs once. */
+    auto load = [this](size_t i) {
+        LoadState(i);
+        robot->AdvanceTime(robot->timeStep);
+        gaitGenerator->Update(robot->GetTimeSinceReset());
+    };
+
+    suite.Add("estimators/container", load, [this]() {
+        stateEstimators->Update();
+    }, false);
+
+    suite.Add("estimators/ground_surface", load, [this]() {
+        stateEstimators->GetGroundEstimator()->Update(robot->GetTimeSinceReset());
+    }, false);
+
+    suite.Add("estimators/contact_detection", load, [this]() {
+        stateEstimators->GetContactDetection()->Update(robot->GetTimeSinceReset());
+    }, false);
+
+    suite.Add("estimators/robot", load, [this]() {
+        stateEstimators->GetRobotEstimator()->Update(robot->GetTimeSinceReset());
+    }, false);
+
+    suite.Add("estimators/momentum_observer", load, [this]() {
+        stateEstimators->GetMomentumObserver()->Update(robot->GetTimeSinceReset());
+    }, false);
+
+    suite.Add("estimators/invariant_ekf", load, [this]() {
+        invariantEKF->Update(robot->GetTimeSinceReset());
+    }, false);
+
+    /* The linear Kalman filter of CMU, which the robot estimator only runs if useCMUFilter is set. */
+    suite.Add("estimators/robot_cmu", load, [this]() {
+        stateEstimators->GetRobotEstimator()->CMUUpdate(robot->timeStep);
+    }, false);
+}
+
+
+void qrBenchKernels::AddFilterCases(qrBenchSuite &suite)
+{
+    struct Input {
+        Vec12<float> motorVelocities;
+        Vec3<float> u;
+        Vec3<float> z;
+    };
+    auto input = std::make_shared<Input>();
+
+    auto load = [this, input](size_t i) {
+        const qrFlightRecord &record = records[i];
+        input->motorVelocities = Eigen::Map<const Vec12<float>>(record.motorVelocities);
+        input->u = robot->timeStep * Eigen::Map<const Vec3<float>>(record.baseLinearAcceleration);
+        input->z = Eigen::Map<const Vec3<float>>(record.baseVInWorldFrame);
+    };
+
+    suite.Add("filters/moving_window", load, [this, input]() {
+        qrBenchKeep(windowFilter.CalculateAverage(input->motorVelocities));
+    });
+
+    suite.Add("filters/kalman", load, [this, input]() {
+        kalmanFilter.Predict(input->u);
+        kalmanFilter.Update(input->z);
+        qrBenchKeep(kalmanFilter);
+    });
+
+    /* As in the velocity estimator, the velocity of each of the four legs is gated before the update. */
+    suite.Add("filters/kalman_gated", load, [this, input]() {
+        kalmanFilter.Predict(input->u);
+        int num = 0;
+        for (int leg = 0; leg < NumLeg; ++leg) {
+            num += kalmanFilter.IsInlier(input->z, userParameters.velocityGateThreshold);
+        }
+        if (num > 0) {
+            kalmanFilter.Update(input->z);
+        }
+        qrBenchKeep(kalmanFilter);
+    });
+}
+
+} // namespace Quadruped
@@ -0,0 +1,170 @@
+// The MIT License
+
+// Copyright (c) 2022
+// Robot Motion and Vision Laboratory at East China Normal University
+// Contact: tophill.robotics@gmail.com
+
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+#ifndef QR_BENCH_KERNELS_H
+#define QR_BENCH_KERNELS_H
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "qr_bench.h"
+#include "robots/qr_robot_replay.h"
+#include "gait/qr_openloop_gait_generator.h"
+#include "estimators/qr_state_estimator_container.h"
+#include "estimators/qr_invariant_ekf.h"
+#include "controllers/mpc/qr_mpc_interface.h"
+#include "controllers/balance_controller/qr_qp_torque_optimizer.h"
+#include "controllers/wbc/qr_wholebody_impulse_ctrl.hpp"
+#include "controllers/wbc/qr_multitask_projection.hpp"
+#include "controllers/wbc/task_set/qr_task_body_orientation.hpp"
+#include "controllers/wbc/task_set/qr_task_body_position.hpp"
+#include "controllers/wbc/task_set/qr_task_link_position.hpp"
+#include "estimators/qr_kalman_filter.hpp"
+#include "estimators/qr_moving_window_filter.hpp"
+#include "utils/qr_flight_recorder.h"
+
+
+namespace Quadruped {
+
+/**
+ * @brief The core kernels of the control stack, run on recorded states of a robot.
+ * Each input is one record of a flight log, loaded into a replay robot as the replay does,
+ * with the estimated state of the record, so that every kernel sees the state it saw in flight.
+ */
+class qrBenchKernels {
+
+public:
+
+    /**
+     * @brief Constructor of class qrBenchKernels.
+     * @param homeDir: directory of the configuration files.
+     * @param robotName: robot of the configuration, e.g. a1_sim.
+     * @param records: the inputs. If empty, the robot standing still is the only input.
+     */
+    qrBenchKernels(const std::string &homeDir, const std::string &robotName, std::vector<qrFlightRecord> records);
+
+    ~qrBenchKernels();
+
+    /**
+     * @brief Number of inputs of the cases.
+     */
+    size_t NumInputs() const {
+        return records.size();
+    };
+
+    /**
+     * @brief Add the cases of all the kernels to a suite.
+     */
+    void AddCases(qrBenchSuite &suite);
+
+private:
+
+    /**
+     * @brief Load the i-th record into the robot.
+     */
+    void LoadState(size_t i);
+
+    /**
+     * @brief The record of the robot standing still, for lack of a log.
+     */
+    qrFlightRecord StandingRecord() const;
+
+    void AddRobotCases(qrBenchSuite &suite);
+
+    void AddDynamicsCases(qrBenchSuite &suite);
+
+    void AddMPCCases(qrBenchSuite &suite);
+
+    void AddContactForceCases(qrBenchSuite &suite);
+
+    void AddWBICCases(qrBenchSuite &suite);
+
+    void AddEstimatorCases(qrBenchSuite &suite);
+
+    void AddFilterCases(qrBenchSuite &suite);
+
+    std::string homeDir;
+
+    std::string robotName;
+
+    std::vector<qrFlightRecord> records;
+
+    qrRobotReplay *robot;
+
+    /**
+     * @brief Copy of the dynamic model of the robot, so that the dynamics cases
+     * do not invalidate the evaluation cached by the robot.
+     */
+    FloatingBaseModel<float> model;
+
+    FBModelState<float> modelState;
+
+    qrUserParameters userParameters;
+
+    qrOpenLoopGaitGenerator *gaitGenerator;
+
+    qrStateEstimatorContainer *stateEstimators;
+
+    /**
+     * @brief Invariant EKF, timed next to the estimators of the container, which only run it if useInEKF is set.
+     */
+    qrInvariantEKF *invariantEKF;
+
+    /**
+     * @brief Weights of the stance leg controllers in stance_leg_controller.yaml.
+     */
+    float mpcWeights[12];
+
+    Vec6<float> accWeight;
+
+    Vec6<float> KD;
+
+    std::vector<std::unique_ptr<qrMPCProblem>> mpcProblems;
+
+    qrWholeBodyImpulseCtrl<float> *wbic;
+
+    qrMultitaskProjection<float> *multitask;
+
+    qrWBICExtraData<float> wbicExtraData;
+
+    qrTaskBodyOrientation<float> *taskBodyOri;
+
+    qrTaskBodyPosition<float> *taskBodyPos;
+
+    qrTaskLinkPosition<float> *taskFootPos[4];
+
+    qrSingleContact<float> *footContact[4];
+
+    std::vector<qrTask<float> *> taskList;
+
+    std::vector<qrSingleContact<float> *> contactList;
+
+    qrMovingWindowFilter<float, 12> windowFilter;
+
+    qrKalmanFilter<float, 3, 3> kalmanFilter;
+};
+
+} // namespace Quadruped
+
+#endif // QR_BENCH_KERNELS_H
@@ -0,0 +1,118 @@
+// The MIT License
+
+// Copyright (c) 2022
+// Robot Motion and Vision Laboratory at East China Normal University
+// Contact: tophill.robotics@gmail.com
+
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+
+#include "qr_bench.h"
+#include "qr_bench_kernels.h"
+#include "fsm/qr_fsm_state.hpp"
+
+using namespace Quadruped;
+
+
+/**
+ * @brief Read the records of a log in which the robot walks, all of them if it never does.
+ */
+std::vector<qrFlightRecord> ReadLog(const std::string &path)
+{
+    qrFlightLog log(path);
+    std::vector<qrFlightRecord> all(log.Size());
+    std::vector<qrFlightRecord> locomotion;
+    for (size_t i = 0; i < log.Size(); ++i) {
+        log.Read(i, all[i]);
+        if (int(all[i].fsmMode[0]) == K_LOCOMOTION) {
+            locomotion.push_back(all[i]);
+        }
+    }
+    return locomotion.empty() ? all : locomotion;
+}
+
+
+int main(int argc, char **argv)
+{
+    std::string homeDir = QR_BENCH_HOME;
+    std::string robotName = "a1_sim";
+    std::string logPath;
+    std::string jsonPath;
+    std::string filter;
+    double minTime = 0.5;
+
+    for (int i = 1; i < argc; ++i) {
+        const bool hasValue = i + 1 < argc;
+        if (!strcmp(argv[i], "--home") && hasValue) {
+            homeDir = argv[++i];
+            if (homeDir.back() != '/') {
+                homeDir += "/";
+            }
+        } else if (!strcmp(argv[i], "--robot") && hasValue) {
+            robotName = argv[++i];
+        } else if (!strcmp(argv[i], "--log") && hasValue) {
+            logPath = argv[++i];
+        } else if (!strcmp(argv[i], "--json") && hasValue) {
+            jsonPath = argv[++i];
+        } else if (!strcmp(argv[i], "--filter") && hasValue) {
+            filter = argv[++i];
+        } else if (!strcmp(argv[i], "--time") && hasValue) {
+            minTime = std::atof(argv[++i]);
+        } else {
+            std::cout << "usage: quadruped_bench [--log <flight log>] [--json <file>] [--filter <substring>]\n"
+                         "                       [--time <seconds per case>] [--robot <name>] [--home <dir>]\n"
+                         "  --log    recorded states to run the kernels on, the robot standing still by default\n"
+                         "  --json   write the results for tracking, in nanoseconds per call\n"
+                         "  --filter run the cases whose name contains the substring, e.g. mpc/\n"
+                         "  --robot  configuration of the robot, a1_sim by default\n"
+                         "  --home   directory of the config directory, the quadruped package by default"
+                      << std::endl;
+            return 1;
+        }
+    }
+
+    std::vector<qrFlightRecord> records;
+    if (!logPath.empty()) {
+        records = ReadLog(logPath);
+        std::cout << "[Bench] " << records.size() << " records from " << logPath << std::endl;
+    }
+
+    qrBenchKernels kernels(homeDir, robotName, records);
+    qrBenchSuite suite(kernels.NumInputs(), minTime);
+    kernels.AddCases(suite);
+    std::vector<qrBenchResult> results = suite.Run(filter);
+
+    std::cout << std::endl;
+    qrBenchSuite::PrintTable(std::cout, results);
+
+    if (!jsonPath.empty()) {
+        std::ofstream os(jsonPath);
+        qrBenchSuite::WriteJson(os, results, {{"robot", robotName},
+                                              {"log", logPath.empty() ? "standing" : logPath},
+                                              {"inputs", std::to_string(kernels.NumInputs())}});
+        if (!os) {
+            std::cerr << "[Bench] cannot write " << jsonPath << std::endl;
+            return 1;
+        }
+    }
+    return 0;
+}
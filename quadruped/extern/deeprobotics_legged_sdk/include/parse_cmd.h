@@ -23,6 +23,8 @@
 #include <chrono>
 #include <sys/timerfd.h>
 #include <sys/epoll.h>
+#include <string.h>
+#include <atomic>
 
 #include "robot_types.h"
 #include "udpserver.hpp"
@@ -33,13 +35,65 @@
 #define JOINT_VEL_CMD 0x0903
 #define JOINT_TOR_CMD 0x0904
 
+/**
+ * @brief Lock-free triple buffer of RobotState.
+ * The udp thread is the only writer and the control thread the only reader.
+ * Neither side ever waits, and the reader always sees a whole packet.
+ */
+class StateTripleBuffer{
+  private:
+    static const uint8_t kIndexMask = 0x3;
+    static const uint8_t kFresh = 0x4;  ///< set in middle_ when it holds an unread packet
+
+    struct Slot{
+      RobotState state;
+      uint64_t seq;
+    };
+    Slot slots_[3];
+    uint8_t back_;                 ///< owned by the writer
+    std::atomic<uint8_t> middle_;  ///< exchanged between writer and reader
+    uint8_t front_;                ///< owned by the reader
+    uint64_t seq_;                 ///< packets published so far, writer only
+  public:
+    StateTripleBuffer(): back_(0), middle_(1), front_(2), seq_(0){
+      memset(slots_, 0, sizeof(slots_));
+    }
+    /// buffer for the writer to fill the next packet into
+    RobotState& back(){
+      return slots_[back_].state;
+    }
+    /// make the filled back buffer visible to the reader
+    void publish(){
+      slots_[back_].seq = ++seq_;
+      back_ = middle_.exchange(back_ | kFresh, std::memory_order_acq_rel) & kIndexMask;
+    }
+    /// switch to the latest packet if there is one, and return the reader buffer
+    const RobotState& front(uint64_t& seq){
+      if (middle_.load(std::memory_order_relaxed) & kFresh) {
+        front_ = middle_.exchange(front_, std::memory_order_acq_rel) & kIndexMask;
+      }
+      seq = slots_[front_].seq;
+      return slots_[front_].state;
+    }
+};
+
 class ParseCMD{
   private:
-    RobotState state_rec;
+    StateTripleBuffer state_buffer;
   public:
     void startWork();
     void work();
+    /**
+     * @brief Latest received state. The reference stays valid and unchanged
+     * until the next get_recv call, which must come from the same thread.
+     */
     RobotState& get_recv();
+    /**
+     * @brief Copy the latest received state.
+     * @return sequence number of the packet, 0 if nothing received yet.
+     * The same number on consecutive calls means no new packet has arrived.
+     */
+    uint64_t get_recv(RobotState& state);
 };
 
 
@@ -91,7 +91,8 @@ void ParseCMD::work()
           break;
         case 0x0906:
           clock_gettime(1,&test_time);
-          memcpy(&state_rec, cm.data_buffer, sizeof(state_rec));
+          memcpy(&state_buffer.back(), cm.data_buffer, sizeof(RobotState));
+          state_buffer.publish();
           break;
           case 600:
             memcpy((void*) &(user_command_set_.data_send_pose) , nc.get_command_parameters(),sizeof(user_command_set_.data_send_pose)); 
@@ -167,5 +168,11 @@ void ParseCMD::startWork()
 	work_thread.detach();
 }
 RobotState& ParseCMD::get_recv(){
-  return state_rec;
+  uint64_t seq;
+  return const_cast<RobotState&>(state_buffer.front(seq));
+}
+uint64_t ParseCMD::get_recv(RobotState& state){
+  uint64_t seq;
+  state = state_buffer.front(seq);
+  return seq;
 }
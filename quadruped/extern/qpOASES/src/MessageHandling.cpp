@@ -616,7 +616,9 @@ MessageHandling* getGlobalMessageHandler( )
 {
 	#ifndef __DSPACE__
     #ifndef __XPCTARGET__
-	static MessageHandling globalMessageHandler( stdFile,VS_VISIBLE,VS_VISIBLE,VS_VISIBLE );
+	/* One handler per thread: every QProblem resets it and sets its visibility from its options,
+	 * which would race between the controllers that qrBatchRollout runs on parallel threads. */
+	static thread_local MessageHandling globalMessageHandler( stdFile,VS_VISIBLE,VS_VISIBLE,VS_VISIBLE );
 	#endif /* __DSPACE__ */
     #endif /* __XPCTARGET__ */
 
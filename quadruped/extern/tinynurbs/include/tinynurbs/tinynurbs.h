@@ -1,14 +0,0 @@
-/**
- * Import the entire library into the tinynurbs namespace.
- * 
- * Use of this source code is governed by a BSD-style license that can be found in
- * the LICENSE file.
- */
-
-#include "core/basis.h"
-#include "core/check.h"
-#include "core/curve.h"
-#include "core/evaluate.h"
-#include "core/modify.h"
-#include "core/surface.h"
-#include "io/obj.h"
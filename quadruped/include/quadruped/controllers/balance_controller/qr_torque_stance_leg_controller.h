@@ -103,13 +103,14 @@ public:
      * @brief Update the stance leg controller with current time every control loop.
      * @param currentTime: current time to update.
      */
-    void Update(float currentTime);
+    virtual void Update(float currentTime);
 
     /**
      * @brief Get the motor commands of the stance leg controller
-     * @return commands and forces calculated by force balance.
+     * @return commands of all the motors and forces calculated by force balance.
+     * The commands are a member, which is overwritten in the next call.
      */
-    virtual std::tuple<std::map<int, qrMotorCommand>, Eigen::Matrix<float, 3, 4>> GetAction();
+    virtual std::tuple<const std::vector<qrMotorCommand>&, Eigen::Matrix<float, 3, 4>> GetAction();
 
     /**
      * @brief Desired linear speed of quadruped. commanded by user.
@@ -247,6 +248,11 @@ public:
      */
     long long count = 0;
 
+    /**
+     * @brief Motor commands returned by GetAction(), sized once so that a tick does not allocate them.
+     */
+    std::vector<qrMotorCommand> action;
+
 };
 
 } // namespace Quadruped
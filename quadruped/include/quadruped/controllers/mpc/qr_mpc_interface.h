@@ -143,35 +143,6 @@ struct ProblemConfig {
     float alpha;
 };
 
-/**
- * @brief Setup the MPC parameters. This function will fill the static variable %problemConfig in cpp.
- * @param dt: time sonsidered by one MPC step.
- * @param horizon: future steps considered by MPC.
- * @param frictionCoeff: defines the interaction force effect between foot and env.
- * @param fMax: the max force acting on one leg.
- * @param totalMass: the total mass of the quadruped.
- * @param inertia: the inertia matrix of the quadruped in base frame.
- * @param weight: a 12-element weight vector for pose and twist.
- * @param alpha: a weight for forces in QP formulation.
- */
-void SetupProblem(double dt, int horizon, double frictionCoeff, double fMax,
-                  double totalMass, float *inertia, float *weight, float alpha);
-
-/**
- * @brief Resize the static matrices before constructing MPC problem.
- * @param horizon: steps considered by MPC.
- */
-void ResizeQPMats(s16 horizon);
-
-/**
- * @brief Convert the problem to discrete time dynamics.
- * @param Ac: state matrix in continuous time.
- * @param Bc: transition matrix in continuous time.
- * @param dt: time for one MPC step.
- * @param horizon: steps considered by MPC.
- */
-void ConvertToDiscreteQP(Eigen::Matrix<float, 13, 13> Ac, Eigen::Matrix<float, 13, 12> Bc, float dt, s16 horizon);
-
 /**
  * @brief [in] Continuous time state space matrices, including A and B.
  * @param [in] I_world: inertia matrix in world frame.
@@ -186,33 +157,208 @@ void ComputeContinuousTimeStateSpaceMatrices(
     Eigen::Matrix<float, 13, 13> &A, Eigen::Matrix<float, 13, 12> &B);
 
 /**
- * @brief Solve the MPC problem.
- * This function actually construct the QP formulation and use qpOASES to solve it.
- * @param p: position of the quadruped in world frame.
- * @param v: velocity of the quadruped in world frame.
- * @param q: rotation expressed in quaternion in world frame.
- * @param w: angular velocity of the quadruped in world frame.
- * @param r: 4 vectors of footholds to CoM.
- * @param rpy: roll pitch and yaw of the quadruped.
- * @param state_trajectory: future state trajectory generated before.
- * @param gait: gait state in %horizon steps. Usually STANCE or SWING.
+ * @brief The condensed MPC problem and its qpOASES workspace.
+ * Each stance controller owns one, so several control stacks can solve in the same process.
  */
-void SolveMPCKernel(Vec3<float>& p, Vec3<float>& v, Quat<float>& q, Vec3<float>& w,
-                            Eigen::Matrix<float,3,4> &r, Vec3<float>& rpy,
-                            float *state_trajectory, float *gait);
+class qrMPCProblem {
 
-/**
- * @brief Solve the MPC problem. Prepare essential data for MPC and call %SolveMPCKernel to solve it.
- * @param setup: some parameters for the MPC problem.
- */
-void SolveMPC(ProblemConfig *setup);
+public:
 
-/**
- * @brief Get value in MPC solution which is in form of qpOASES float vector.
- * @param index: the index of the result.
- * @return the result in MPC solution.
- */
-double GetMPCSolution(int index);
+    EIGEN_MAKE_ALIGNED_OPERATOR_NEW
+
+    qrMPCProblem() = default;
+
+    qrMPCProblem(const qrMPCProblem &) = delete;
+
+    qrMPCProblem &operator=(const qrMPCProblem &) = delete;
+
+    ~qrMPCProblem();
+
+    /**
+     * @brief Setup the MPC parameters. This function will fill %problemConfig.
+     * @param dt: time sonsidered by one MPC step.
+     * @param horizon: future steps considered by MPC.
+     * @param frictionCoeff: defines the interaction force effect between foot and env.
+     * @param fMax: the max force acting on one leg.
+     * @param totalMass: the total mass of the quadruped.
+     * @param inertia: the inertia matrix of the quadruped in base frame.
+     * @param weight: a 12-element weight vector for pose and twist.
+     * @param alpha: a weight for forces in QP formulation.
+     */
+    void SetupProblem(double dt, int horizon, double frictionCoeff, double fMax,
+                      double totalMass, float *inertia, float *weight, float alpha);
+
+    /**
+     * @brief Resize the QP matrices before constructing MPC problem.
+     * @param horizon: steps considered by MPC.
+     */
+    void ResizeQPMats(s16 horizon);
+
+    /**
+     * @brief Convert the problem to discrete time dynamics.
+     * @param Ac: state matrix in continuous time.
+     * @param Bc: transition matrix in continuous time.
+     * @param dt: time for one MPC step.
+     * @param horizon: steps considered by MPC.
+     */
+    void ConvertToDiscreteQP(Eigen::Matrix<float, 13, 13> Ac, Eigen::Matrix<float, 13, 12> Bc, float dt, s16 horizon);
+
+    /**
+     * @brief Solve the MPC problem.
+     * This function actually construct the QP formulation and use qpOASES to solve it.
+     * @param p: position of the quadruped in world frame.
+     * @param v: velocity of the quadruped in world frame.
+     * @param q: rotation expressed in quaternion in world frame.
+     * @param w: angular velocity of the quadruped in world frame.
+     * @param r: 4 vectors of footholds to CoM.
+     * @param rpy: roll pitch and yaw of the quadruped.
+     * @param state_trajectory: future state trajectory generated before.
+     * @param gait: gait state in %horizon steps. Usually STANCE or SWING.
+     */
+    void SolveMPCKernel(Vec3<float>& p, Vec3<float>& v, Quat<float>& q, Vec3<float>& w,
+                        Eigen::Matrix<float,3,4> &r, Vec3<float>& rpy,
+                        float *state_trajectory, float *gait);
+
+    /**
+     * @brief Solve the MPC problem. Prepare essential data for MPC and call %SolveMPCKernel to solve it.
+     * @param setup: some parameters for the MPC problem.
+     */
+    void SolveMPC(ProblemConfig *setup);
+
+    /**
+     * @brief Get value in MPC solution which is in form of qpOASES float vector.
+     * @param index: the index of the result.
+     * @return the result in MPC solution.
+     */
+    double GetMPCSolution(int index);
+
+private:
+
+    /**
+     * @brief The problem configuration, for example, horizon length, weight and other robot infomation.
+     */
+    ProblemConfig problemConfig;
+
+    /**
+     * @brief Basic robot states, for example, pose, twist, rotation matrix and so on.
+     */
+    MPCRobotState robotState;
+
+    /**
+     * @brief Whether the MPC problem has been solved by qpOASES.
+     */
+    int has_solved = 0;
+
+    /**
+     * @brief State matrix consists of %horizon states.
+     */
+    Eigen::Matrix<float, Eigen::Dynamic, 13> Aqp;
+
+    /**
+     * @brief Transform matrix consists of 4 * %horizon forces.
+     */
+    Eigen::Matrix<float, Eigen::Dynamic, Eigen::Dynamic> Bqp;
+
+    /**
+     * @brief Transform matrix in discrete form.
+     */
+    Eigen::Matrix<float, 13, 12> Bdt;
+
+    /**
+     * @brief State matrix in discrete form.
+     */
+    Eigen::Matrix<float, 13, 13> Adt;
+
+    /**
+     * @brief Auxilliary matrix while calculating discrete dynamics.
+     */
+    Eigen::Matrix<float, 25, 25> ABc, expmm;
+
+    /**
+     * @brief The predictive state trajectory.
+     */
+    Eigen::Matrix<float, Eigen::Dynamic, 1> X_d;
+
+    /**
+     * @brief Upper bound for the constraint of forces.
+     */
+    Eigen::Matrix<float, Eigen::Dynamic, 1> U_b;
+
+    /**
+     * @brief Friction cone and force limit matrix for constraint of forces.
+     */
+    Eigen::Matrix<float, Eigen::Dynamic, Eigen::Dynamic> fmat;
+
+    /**
+     * @brief Hessian matrix used in QP form of MPC problem.
+     */
+    Eigen::Matrix<float, Eigen::Dynamic, Eigen::Dynamic> qH;
+
+    /**
+     * @brief Linear term used in QP form of MPC problem.
+     */
+    Eigen::Matrix<float, Eigen::Dynamic, 1> qg;
+
+    /**
+     * @brief A matrix with small value for constructing Hessian matrix.
+     */
+    Eigen::Matrix<float, Eigen::Dynamic, Eigen::Dynamic> Idendity12Horizon;
+
+    /**
+     * @brief Hessian matrix in qpOASES form.
+     */
+    qpOASES::real_t *H_qpoases = nullptr;
+
+    /**
+     * @brief g vector in qpOASES form.
+     */
+    qpOASES::real_t *g_qpoases = nullptr;
+
+    /**
+     * @brief Constraint matrix in qpOASES form.
+     */
+    qpOASES::real_t *A_qpoases = nullptr;
+
+    /**
+     * @brief Lower bound vector in qpOASES form.
+     */
+    qpOASES::real_t *lb_qpoases = nullptr;
+
+    /**
+     * @brief Upper bound vector in qpOASES form.
+     */
+    qpOASES::real_t *ub_qpoases = nullptr;
+
+    /**
+     * @brief Solution of MPC in qpOASES form.
+     */
+    qpOASES::real_t *q_soln = nullptr;
+
+    /**
+     * @brief Current robot state, including pose and twist, along with a gravity component.
+     */
+    Eigen::Matrix<float, 13, 1> x0;
+
+    /**
+     * @brief State Matrix of simplified dynamics in continuous time.
+     */
+    Eigen::Matrix<float, 13, 13> A_ct;
+
+    /**
+     * @brief Transform Matrix of simplified dynamics in continuous time.
+     */
+    Eigen::Matrix<float, 13, 12> B_ct_r;
+
+    /**
+     * @brief Temporary matrix to construct the Hessian matrix.
+     */
+    Eigen::MatrixXf temp;
+
+    /**
+     * @brief Error of the free response to the predictive trajectory, Aqp * x0 - X_d, to construct the linear term.
+     */
+    Eigen::Matrix<float, Eigen::Dynamic, 1> trajError;
+};
 
 } // Namespace Quadruped
 
@@ -64,14 +64,33 @@ public:
      */
     virtual void Reset(float t);
 
+    /**
+     * @brief Update the stance leg controller and plan the reference of the MPC problem.
+     * @param currentTime: current time to update.
+     */
+    virtual void Update(float currentTime);
+
+    /**
+     * @brief Solve the MPC problem on the reference of the last Update().
+     * Scheduled by the "mpc" task of the runner, twice per MPC step by default.
+     */
+    void SolveMPC();
+
+    /**
+     * @brief The default rate of SolveMPC() in control ticks.
+     */
+    qrTaskRate DefaultMPCRate() const {
+        return {static_cast<unsigned int>(iterationsInaMPC / 2), 0};
+    }
+
     /**
      * @brief Get the motor commands of the stance leg controller
-     * @return commands and forces calculated by MPC.
+     * @return commands of all the motors mapped from the forces of the last MPC solve, and the forces.
      */
-    virtual std::tuple<std::map<int, qrMotorCommand>, Eigen::Matrix<float, 3, 4>> GetAction();
+    virtual std::tuple<const std::vector<qrMotorCommand>&, Eigen::Matrix<float, 3, 4>> GetAction();
 
     /**
-     * @brief Setup MPC problem and solve the MPC problem.
+     * @brief Setup the reference of the MPC problem, which is solved by SolveMPC().
      * @param legCommand: output of the MPC problem.
      * This may be removed in the future.
      * @param gaitType: the gait type of current state.
@@ -79,7 +98,7 @@ public:
      * @param robotMode: current robot mode.
      * This may be removed in the future.
      */
-    void Run(std::map<int, qrMotorCommand> &legCommand, int gaitType, int robotMode = 0);
+    void Run(std::vector<qrMotorCommand> &legCommand, int gaitType, int robotMode = 0);
 
 private:
 
@@ -88,12 +107,6 @@ private:
      */
     void SetupCommand();
 
-    /**
-     * @brief Update MPC state of this iteration.
-     * @param robot: pointer to robot.
-     */
-    void UpdateMPC(qrRobot *robot);
-
     /**
      * @brief Solve the MPC problem
      * @param robot: pointer to robot.
@@ -170,11 +183,6 @@ private:
      */
     float dtMPC;
 
-    /**
-     * @brief An iteration count for controlling the frequency of MPC updating.
-     */
-    unsigned long long iterationCounter = 0;
-
     /**
      * @brief MPC table storing the contact state with %horizonLength.
      */
@@ -216,9 +224,9 @@ private:
     float Q[12];
 
     /**
-     * @brief A bool variable indicating whether MPC has been updated.
+     * @brief The QP workspace of this controller's MPC problem.
      */
-    bool mpcUpdated = false;
+    qrMPCProblem mpcProblem;
 
     /**
      * @brief A bool variable indicating whether Whole Body Control will be used.
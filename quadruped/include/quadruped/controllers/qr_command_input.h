@@ -0,0 +1,54 @@
+// The MIT License
+
+// Copyright (c) 2022
+// Robot Motion and Vision Laboratory at East China Normal University
+// Contact: tophill.robotics@gmail.com
+
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#ifndef QR_COMMAND_INPUT_H
+#define QR_COMMAND_INPUT_H
+
+
+namespace Quadruped {
+
+class qrDesiredStateCommand;
+
+/**
+ * @brief Source of the operator commands, e.g. a gamepad read over ROS or by a driver.
+ * Once connected, it hands what it receives to the desired state command, e.g. with
+ * qrDesiredStateCommand::ReceiveGamepad, in the thread of the control loop.
+ */
+class qrCommandInput {
+
+public:
+
+    virtual ~qrCommandInput() = default;
+
+    /**
+     * @brief Deliver the commands to the desired state command from now on.
+     * @param command: the desired state command, which outlives the input.
+     */
+    virtual void Connect(qrDesiredStateCommand *command) = 0;
+
+};
+
+} // namespace Quadruped
+
+#endif // QR_COMMAND_INPUT_H
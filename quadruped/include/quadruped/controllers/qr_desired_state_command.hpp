@@ -26,9 +26,7 @@
 #define QR_DESIRED_STATE_COMMAND_H
 
 #include <iostream>
-
-#include <ros/ros.h>
-#include <sensor_msgs/Joy.h>
+#include <vector>
 
 #include "config/qr_enum_types.h"
 #include "config/qr_config.h"
@@ -46,10 +44,11 @@ public:
 
     /**
      * @brief Contructor of class qrDesiredStateCommand.
-     * @param nhIn: ROS node handle. This is used to subscribe the joy node.
+     * The remote controller is connected by a qrCommandInput, e.g. qrJoyReceiver of the ROS adapter.
+     * Without it, the command is given by vDesInBodyFrame and wDesInBodyFrame, e.g. in HARD_CODE mode.
      * @param robotIn: robot pointer. This is mainly used to get the robot height and then set the desired height.
      */
-    qrDesiredStateCommand(ros::NodeHandle &nhIn, qrRobot* robotIn);
+    explicit qrDesiredStateCommand(qrRobot* robotIn);
 
     ~qrDesiredStateCommand() = default;
 
@@ -69,10 +68,11 @@ public:
     void PrintStateCommandInfo();
 
     /**
-     * @brief the callback function called when the joy command received
-     * @param joy_msg: joy command message from ROS joy_node
+     * @brief Update the joy commands with the state of the gamepad, called by the command input.
+     * @param axes: the axes of the gamepad, laid out as sensor_msgs::Joy of the ROS joy_node.
+     * @param buttons: the buttons of the gamepad, 1 if pressed.
      */
-    void JoyCallback(const sensor_msgs::Joy::ConstPtr &joy_msg);
+    void ReceiveGamepad(const std::vector<float> &axes, const std::vector<int> &buttons);
 
     /**
      * @brief Getter method of member joyCtrlState.
@@ -96,6 +96,28 @@ public:
       joyCtrlStateChangeRequest = request;
     }
 
+    /**
+     * @brief Setter method of member joyCtrlState, used when no remote controller drives the robot.
+     * @param state: new value for joyCtrlState.
+     */
+    inline void setJoyCtrlState(RC_MODE state) {
+      joyCtrlState = state;
+    }
+
+    /**
+     * @brief Getter method of member filteredVel.
+     */
+    inline const Vec3<float>& getFilteredVel() const {
+      return filteredVel;
+    }
+
+    /**
+     * @brief Getter method of member filteredOmega.
+     */
+    inline const Vec3<float>& getFilteredOmega() const {
+      return filteredOmega;
+    }
+
     /**
      * @brief Desired linear velocity expressed in body frame.
      */
@@ -154,22 +176,6 @@ private:
      */
     float dt = 0.002f;
 
-    /**
-     * @brief ROS nodehandle to subscribe "/joy".
-     * @todo will use driver to get the state of the joy instead of ROS topic
-     */
-    ros::NodeHandle &nh;
-
-    /**
-     * @brief ROS subscriber for the ROS joy_node.
-     */
-    ros::Subscriber gamepadCommandSub;
-
-    /**
-     * @brief Topic name of the ROS joy_node.
-     */
-    std::string topicName = "/joy";
-
     /**
      * @brief Current joy state.
      */
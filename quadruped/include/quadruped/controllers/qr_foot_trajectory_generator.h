@@ -25,8 +25,6 @@
 #ifndef QR_FOOT_TRAJECTORY_GENERATOR_H
 #define QR_FOOT_TRAJECTORY_GENERATOR_H
 
-#include <glm/glm.hpp>
-#include <tinynurbs/tinynurbs.h>
 #include <Eigen/Dense>
 
 #include "utils/qr_geometry.h"
@@ -71,19 +69,6 @@ struct qrStepParameters {
 
 struct qrSplineInfo {
 
-    qrSplineInfo () = default;
-
-    /**
-     * @brief Constructor of class qrSplineInfo.
-     * @param control_points: control points of the splines.
-     * @param knots: knots of the splines.
-     */
-    qrSplineInfo (std::vector<glm::vec3> &control_points, std::vector<float> &knots) {
-        this->splineType = SplineType::BSpline;
-        this->controlPoints = control_points;
-        this->knots = knots;
-    }
-
     /**
      * @brief The degree of spline, such as 2, 3, 5.
      */
@@ -94,10 +79,6 @@ struct qrSplineInfo {
      */
     SplineType splineType = SplineType::CubicPolygon;
 
-    std::vector<glm::vec3> controlPoints;
-
-    std::vector<float> knots;
-
 };
 
 class qrFootSplinePatternGenerator {
@@ -281,6 +262,18 @@ class qrFootBSplinePatternGenerator : public qrFootSplinePatternGenerator {
 
 public:
 
+    EIGEN_MAKE_ALIGNED_OPERATOR_NEW
+
+    /**
+     * @brief Number of control points of the swing BSpline.
+     */
+    static constexpr int NumControlPoints = 9;
+
+    /**
+     * @brief Constructor method of class qrFootBSplinePatternGenerator.
+     */
+    qrFootBSplinePatternGenerator();
+
     /**
      * @brief Constructor method of class qrFootBSplinePatternGenerator.
      * @param splinInfo: BSpline information.
@@ -316,9 +309,20 @@ public:
 
 private:
 
-    tinynurbs::Curve3f crv;
+    /**
+     * @brief Cubic BSpline of the swing in canonical frame, in centimeter.
+     */
+    robotics::math::qrBSpline<float, 3, NumControlPoints> crv;
 
-    std::vector<glm::vec3> controlPointsTemplate;
+    /**
+     * @brief Control points of the spline, scaled from the template by UpdateSpline().
+     */
+    Eigen::Matrix<float, 3, NumControlPoints> controlPoints;
+
+    /**
+     * @brief Control points of a normalized swing.
+     */
+    Eigen::Matrix<float, 3, NumControlPoints> controlPointsTemplate;
 
 };
 
@@ -327,6 +331,8 @@ class SwingFootTrajectory {
 
 public:
 
+    EIGEN_MAKE_ALIGNED_OPERATOR_NEW
+
     SwingFootTrajectory() = default;
 
     /**
@@ -345,8 +351,20 @@ public:
 
     SwingFootTrajectory(const SwingFootTrajectory &item);
 
+    SwingFootTrajectory &operator=(const SwingFootTrajectory &item);
+
     virtual ~SwingFootTrajectory() = default;
 
+    /**
+     * @brief Start a new trajectory in place, without allocating a new spline generator.
+     * @see SwingFootTrajectory::SwingFootTrajectory for the parameters.
+     */
+    void Reset(const qrSplineInfo &splineInfoIn,
+               const Vec3<float> &startPosIn,
+               const Vec3<float> &endPosIn,
+               float duration = 1.f,
+               float maxClearance = 0.1f);
+
     /**
      * @brief Call it every time you need a tarjectory point to control.
      * @param Vec3<float>& foot position;
@@ -387,10 +405,26 @@ public:
 
     qrStepParameters stepParams;
 
-    qrFootSplinePatternGenerator *footTarjGen;
+    /**
+     * @brief Points to the generator of splineInfo.splineType below.
+     */
+    qrFootSplinePatternGenerator *footTarjGen = &parabolaGenerator;
 
     qrSplineInfo splineInfo;
 
+private:
+
+    /**
+     * @brief Get the generator of the spline type.
+     */
+    qrFootSplinePatternGenerator *GetGenerator(SplineType splineType);
+
+    qrFootParabolaPatternGenerator parabolaGenerator;
+
+    qrFootCubicPatternGenerator cubicGenerator;
+
+    qrFootBSplinePatternGenerator bSplineGenerator;
+
 };
 
 } // Quadruped
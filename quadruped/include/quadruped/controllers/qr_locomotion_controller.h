@@ -86,19 +86,41 @@ public:
 
     /**
      * @brief Update components in the locomotion controller every control loop.
+     * Runs all the stages below in one call, solving the MPC every time.
+     * qrRobotRunner schedules them as separate tasks instead.
      */
     void Update();
 
-    /** @brief Compute all motors' commands via subcontrollers.
-     *  @return control ouputs (e.g. positions/torques) for all (12) motors.
+    /**
+     * @brief Update the gait schedule and the pose planners.
+     */
+    void UpdateGait();
+
+    /**
+     * @brief Update the swing leg controller and compute the commands of the swing legs.
+     */
+    void UpdateSwing();
+
+    /**
+     * @brief Update the stance leg controller, which plans the reference of the MPC.
+     */
+    void UpdateStance();
+
+    /**
+     * @brief Solve the MPC problem of the stance legs, if the MPC controller is in use.
+     */
+    void SolveMPC();
+
+    /** @brief Compute all motors' commands from the outputs of the stages.
+     *  @return control ouputs (e.g. positions/torques) for all (12) motors, i.e. member action.
      */
-    std::tuple<std::vector<qrMotorCommand>, Eigen::Matrix<float, 3, 4>> GetAction();
+    std::tuple<const std::vector<qrMotorCommand>&, Eigen::Matrix<float, 3, 4>> GetAction();
 
     /**
      * @brief A function as GetAction(). Only for Debug.
      * @return control ouputs (e.g. positions/torques) for all (12) motors.
      */
-    std::tuple<std::vector<qrMotorCommand>, Eigen::Matrix<float, 3, 4>> GetFakeAction();
+    std::tuple<const std::vector<qrMotorCommand>&, Eigen::Matrix<float, 3, 4>> GetFakeAction();
 
     /**
      * @brief Getter method of member gaitGenerator.
@@ -189,9 +211,20 @@ private:
 
     /**
      * @brief A list of commands that will send to gazebo/real quadrupeds every control loop.
+     * It is sized once, and overwritten by GetAction().
      */
     std::vector<qrMotorCommand> action;
 
+    /**
+     * @brief Commands of the swing leg motors computed by UpdateSwing(), a column per motor.
+     */
+    Eigen::Matrix<float, 5, NumMotor> swingAction;
+
+    /**
+     * @brief Whether each motor is commanded by the swing leg controller, computed by UpdateSwing().
+     */
+    Eigen::Matrix<bool, NumMotor, 1> isSwingMotor;
+
     /**
      * @brief Records the time quadruped resets.
      */
@@ -86,11 +86,23 @@ public:
      */
     void Update(float currentTime);
 
+    /**
+     * @brief Solve the MPC problem if the MPC controller is in use.
+     */
+    void SolveMPC();
+
+    /**
+     * @brief The default rate of SolveMPC(), see MPCStanceLegController::DefaultMPCRate.
+     */
+    qrTaskRate DefaultMPCRate() const {
+        return static_cast<MPCStanceLegController*>(c2)->DefaultMPCRate();
+    }
+
     /**
      * @brief get the motor commands of the stance leg controller
-     * @return commands and forces calculated by MPC or force balance.
+     * @return commands of all the motors and forces calculated by MPC or force balance.
      */
-    std::tuple<std::map<int, qrMotorCommand>, Eigen::Matrix<float, 3, 4>> GetAction();
+    std::tuple<const std::vector<qrMotorCommand>&, Eigen::Matrix<float, 3, 4>> GetAction();
 
     /**
      * @brief The pointer to specific stance leg controller.
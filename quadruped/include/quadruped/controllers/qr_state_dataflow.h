@@ -33,6 +33,25 @@
 #include "utils/qr_visualization.h"
 
 
+/**
+ * @brief Rate of a periodic task of the control tick, see qrTaskScheduler.
+ * The task runs at the ticks where tick % period == offset, and never if period is 0.
+ */
+struct qrTaskRate {
+
+    unsigned int period = 1;
+
+    unsigned int offset = 0;
+
+    /**
+     * @brief Whether the task runs at the given tick.
+     */
+    bool IsDue(unsigned long tick) const {
+        return period > 0 && tick % period == offset % period;
+    };
+
+};
+
 struct qrUserParameters {
 
     /**
@@ -83,6 +102,18 @@ struct qrUserParameters {
      */
     int movingWindowFilterSize = 50;
 
+    /**
+     * @brief Chi-square gate on the velocity observed by each contact leg in velocity estimator.
+     * The default is the 99% quantile for 3 degrees of freedom: it rejects the slipping feet, but no leg
+     * of a trotting robot in simulation. A non-positive value disables the gate.
+     */
+    float velocityGateThreshold = 11.34f;
+
+    /**
+     * @brief Gain of the generalized momentum observer, the bandwidth of its estimate (unit: 1/s).
+     */
+    float momentumObserverGain = 50.f;
+
     /**
      * @brief Desired body height used for swing leg controller.
      */
@@ -124,6 +155,117 @@ struct qrUserParameters {
      */
     bool useWBC = true;
 
+    /**
+     * @brief Whether to set up the process for real-time operation.
+     * @see qrRealtimeSetup
+     */
+    bool useRealtime = false;
+
+    /**
+     * @brief SCHED_FIFO priority of the control thread, in [1, 99].
+     */
+    int realtimePriority = 80;
+
+    /**
+     * @brief CPU core that the control thread is pinned to. -1 means no pinning.
+     */
+    int controlCpu = -1;
+
+    /**
+     * @brief CPU cores for helper threads, e.g. ROS spinner, SDK I/O threads.
+     * Empty means no isolation.
+     */
+    std::vector<int> helperCpus;
+
+    /**
+     * @brief Whether to lock all current and future pages of the process in RAM.
+     */
+    bool lockMemory = true;
+
+    /**
+     * @brief Size of stack to prefault for the control thread (unit: byte).
+     */
+    unsigned int prefaultStackSize = 512 * 1024;
+
+    /**
+     * @brief Size of heap to prefault and keep reserved (unit: byte).
+     */
+    unsigned int prefaultHeapSize = 64 * 1024 * 1024;
+
+    /**
+     * @brief Action on the first heap allocation in a control tick, 0: count, 1: backtrace, 2: abort.
+     * Only takes effect when built with TRACK_ALLOCATION.
+     */
+    int allocPolicy = 0;
+
+    /**
+     * @brief Whether to estimate the base state by the invariant EKF instead of the velocity and pose estimators.
+     */
+    bool useInEKF = false;
+
+    /**
+     * @brief Whether to estimate the base state by the linear Kalman filter of CMU over the base and foot positions,
+     * instead of the velocity and pose estimators. Ignored if useInEKF is set.
+     */
+    bool useCMUFilter = false;
+
+    /**
+     * @brief Whether the runner overlaps the estimation of the next tick with the control of the current tick.
+     */
+    bool usePipeline = false;
+
+    /**
+     * @brief Cpu core of the estimation thread of the pipelined runner, -1 for no pinning.
+     */
+    int estimationCpu = -1;
+
+    /**
+     * @brief Print the tick timing every this number of ticks, 0 for never.
+     */
+    unsigned int tickStatsInterval = 0;
+
+    /**
+     * @brief Number of extra threads of the task scheduler, 0 runs every task on the control thread.
+     */
+    unsigned int schedulerThreads = 0;
+
+    /**
+     * @brief File the flight recorder writes every tick to, empty to disable it.
+     */
+    std::string flightRecorderPath;
+
+    /**
+     * @brief Number of ticks the flight recorder can buffer before its thread flushes them.
+     */
+    unsigned int flightRecorderCapacity = 4096;
+
+    /**
+     * @brief LCM provider the telemetry is published to, e.g. udpm://239.255.76.67:7667?ttl=0, empty to disable it.
+     */
+    std::string telemetryUrl;
+
+    /**
+     * @brief Number of samples the telemetry can buffer before its thread publishes them.
+     */
+    unsigned int telemetryCapacity = 256;
+
+    /**
+     * @brief Rate (unit: Hz) of each telemetry channel, by channel name.
+     */
+    std::map<std::string, float> telemetryChannels;
+
+    /**
+     * @brief Period and offset (unit: tick) of the tasks of the control tick, by task name.
+     */
+    std::map<std::string, qrTaskRate> taskRates;
+
+    /**
+     * @brief Get the configured rate of a task.
+     * @param name: name of the task.
+     * @param defaultRate: rate used if the task is not configured.
+     */
+    qrTaskRate GetTaskRate(const std::string &name, qrTaskRate defaultRate = qrTaskRate()) const;
+
 };
 
 /**
@@ -184,6 +326,11 @@ public:
      */
     Vec4<bool> contact_state;
 
+    /**
+     * @brief Joint torques of the last WBC solve, applied to the stance legs.
+     */
+    Eigen::Matrix<float, 12, 1> jointTorqueCmd = Eigen::Matrix<float, 12, 1>::Zero();
+
     /**
      * @brief Whether to conduct WBC.
      * If MPC and WBC are conducted in one iteration, this iteration will consume so much time,
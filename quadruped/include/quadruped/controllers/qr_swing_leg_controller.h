@@ -99,8 +99,11 @@ public:
 
     /**
      * @brief Get position-mode commands for swing leg motors.
+     * @return commands of the motors, each column is (p, Kp, d, Kd, tau) of one motor,
+     * and whether each motor is commanded by the swing leg controller in this control loop.
+     * Both are members, which are overwritten in the next call.
      */
-    std::map<int, Eigen::Matrix<float, 5, 1>> GetAction();
+    std::tuple<const Eigen::Matrix<float, 5, NumMotor>&, const Eigen::Matrix<bool, NumMotor, 1>&> GetAction();
 
     /**
      * @brief pointer to DesiredStateCommand.
@@ -177,6 +180,16 @@ public:
      */
     std::map<int, std::tuple<float, float, int>> swingJointAnglesVelocities;
 
+    /**
+     * @brief Motor commands of the last GetAction(), a column per motor.
+     */
+    Eigen::Matrix<float, 5, NumMotor> swingActions;
+
+    /**
+     * @brief Whether the column of a motor in swingActions is a swing command.
+     */
+    Eigen::Matrix<bool, NumMotor, 1> isSwingMotor;
+
     /**
      * @brief Foot positions in base frame when switch leg state.
      */
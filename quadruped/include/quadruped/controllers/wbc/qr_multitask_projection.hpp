@@ -66,14 +66,14 @@ private:
      * @param [in] J: input matrix.
      * @param [out] Jinv: inverse matrix of J.
      */
-    void PseudoInverse(const DMat<T> &J, DMat<T> &Jinv);
+    void PseudoInverse(const WbcMat<T> &J, WbcMat<T> &Jinv);
 
     /**
      * @brief Compute the null-space projection matrix of J.
      * @param [in] J: previous jacobian matrix.
      * @param [out] N: null-space projection matrix.
      */
-    void BuildProjectionMatrix(const DMat<T> &J, DMat<T> &N);
+    void BuildProjectionMatrix(const WbcMat<T> &J, WbcMat<T> &N);
 
     /**
      * @brief Threshold for singular values being zero.
@@ -94,12 +94,12 @@ private:
     /**
      * @brief Identity matrix used in computing null-space projection.
      */
-    DMat<T> identityMat;
+    WbcMat<T> identityMat;
 
     /**
      * @brief Null-space projection matrix of contact jacobian matrix.
      */
-    DMat<T> Nc;
+    WbcMat<T> Nc;
 
 };
 
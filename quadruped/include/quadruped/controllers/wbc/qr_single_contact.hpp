@@ -65,42 +65,42 @@ public:
     /**
      * @brief Getter method of member Jc.
      */
-    void GetJc(DMat<T>& Jc) const {
+    void GetJc(WbcMat<T>& Jc) const {
         Jc = this->Jc;
     }
 
     /**
      * @brief Getter method of member JcDotQDot.
      */
-    void GetJcDotQdot(DVec<T>& JcDotQdot) const {
+    void GetJcDotQdot(WbcVec<T>& JcDotQdot) const {
         JcDotQdot = this->JcDotQdot;
     }
 
     /**
      * @brief Getter method of member Uf.
      */
-    void GetUf(DMat<T>& Uf) const {
+    void GetUf(WbcMat<T>& Uf) const {
         Uf = this->Uf;
     }
 
     /**
      * @brief Getter method of member ineqVec.
      */
-    void GetIneqVec(DVec<T>& ineqVec) const {
+    void GetIneqVec(WbcVec<T>& ineqVec) const {
         ineqVec = this->ineqVec;
     }
 
     /**
      * @brief Getter method of member desiredFr
      */
-    const DVec<T>& GetDesiredFr() const {
+    const WbcVec<T>& GetDesiredFr() const {
         return desiredFr;
     }
 
     /**
      * @brief Setter method of member desiredFr.
      */
-    void SetDesiredFr(const DVec<T>& desiredFr) {
+    void SetDesiredFr(const WbcVec<T>& desiredFr) {
         this->desiredFr = desiredFr;
     }
 
@@ -173,31 +173,31 @@ protected:
      * @brief 6x3 inequivalent constraint martix, including conic and boundary constraints.
      *
      */
-    DMat<T> Uf;
+    WbcMat<T> Uf;
 
 
     /**
      * @brief Desired reaction force.
      * This is set to the result force from MPC solver.
      */
-    DVec<T> desiredFr;
+    WbcVec<T> desiredFr;
 
     /**
      * @brief 6x1 inequivalent vector.
      * The sixth entry is set to -maxFz to satisfy fz < maxFz.
      */
-    DVec<T> ineqVec;
+    WbcVec<T> ineqVec;
 
     /**
      * @brief Single contact jacobian of corresponding contact point.
      */
-    DMat<T> Jc;
+    WbcMat<T> Jc;
 
     /**
      * @brief Derivative of Jc dot derivative of q.
      * Used in null-space projection.
      */
-    DVec<T> JcDotQdot;
+    WbcVec<T> JcDotQdot;
 
     /**
      * @brief Dimension of contact point.
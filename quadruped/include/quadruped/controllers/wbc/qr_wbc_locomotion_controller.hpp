@@ -53,11 +53,17 @@ public:
 
     /**
      * @brief Compute desired joint position and velocity using null-space projection,
-     * then caculate the desired torque by QP formulation and make it into torque conmmands.
+     * then caculate the desired torque by QP formulation. Scheduled by the "wbc" task of the runner.
      * @param precomputeData: pointer to qrWbcCtrlData @see qrWbcLocomotionCtrl::wbcCtrlData
      */
     void Run(void *precomputeData);
 
+    /**
+     * @brief Write the torques of the last Run() into the commands of the stance legs.
+     * @param control_fsm_data: stores desired command of robot
+     */
+    void UpdateLegCMD(qrControlFSMData<T> *control_fsm_data);
+
 protected:
 
     /**
@@ -75,12 +81,6 @@ protected:
      */
     void ContactTaskUpdate(qrWbcCtrlData *ctrl_data, qrControlFSMData<T> *control_fsm_data);
 
-    /**
-     * @brief Write the torque into member jointTorqueCmd.
-     * @param control_fsm_data: stores desired command of robot
-     */
-    void UpdateLegCMD(qrControlFSMData<T> *control_fsm_data);
-
     /**
      * @brief Task that set the body position. Used in multi-task.
      * @see qrTaskBodyOrientation
@@ -152,11 +152,6 @@ protected:
      */
     FloatingBaseModel<T> &fbModel;
 
-    /**
-     * @brief The state of a floating base model, mainly kinematic information.
-     */
-    FBModelState<T> modelState;
-
     /**
      * @brief Currunt joint states with floating base.
      */
@@ -178,7 +173,7 @@ protected:
     DVec<T> desiredJVel;
     
     /**
-     * @brief Counter for locomotion loop. Also used to adjust the frequency of WBC calculate.
+     * @brief Number of WBC solves.
      */
     unsigned long long iteration;
 
@@ -45,23 +45,23 @@ public:
     /**
      * @brief The result of the QP problem.
      */
-    DVec<T> optimizedResult;
+    WbcVec<T> optimizedResult;
 
     /**
      * @brief The optimized reaction force.
      * Force from MPC plus force from QP problem.
      */
-    DVec<T> optimalFr;
+    WbcVec<T> optimalFr;
 
     /**
      * @brief Weight of the floating base part in the QP problem.
      */
-    DVec<T> weightFb;
+    WbcVec<T> weightFb;
 
     /**
      * @brief Weight of the reaction force part in the QP problem.
      */
-    DVec<T> weightFr;
+    WbcVec<T> weightFr;
 
 
 };
@@ -107,13 +107,13 @@ private:
      * @param [out] Jinv: the pseudo inverse matrix of J.
      * @param threshold: threshold for singular values being zero.
      */
-    void WeightedInverse(const DMat<T> &J, const DMat<T> &Winv, DMat<T> &Jinv, double threshold = 0.0001);
+    void WeightedInverse(const WbcMat<T> &J, const WbcMat<T> &Winv, WbcMat<T> &Jinv, double threshold = 0.0001);
 
     /**
      * @brief Setup the dynamic equality constraint.
      * @param qddot: derivative of qdot.
      */
-    void SetEqualityConstraint(const DVec<T> &qddot);
+    void SetEqualityConstraint(const WbcVec<T> &qddot);
 
     /**
      * @brief Setup inequality constraint, including conic and boundary constraints.
@@ -129,7 +129,7 @@ private:
      * @brief Given the acceleration command of generalized coordinate,
      * compute the total torque command of stance leg by dynamic formulation.
      */
-    void GetSolution(const DVec<T> &qddot, DVec<T> &cmd);
+    void GetSolution(const WbcVec<T> &qddot, DVec<T> &cmd);
 
     /**
      * @brief Set the weight of target used in QP problem.
@@ -159,27 +159,27 @@ private:
     /**
      * @brief Selection matrix of floating base in dynamics equation.
      */
-    DMat<T> Sf;
+    WbcMat<T> Sf;
 
     /**
      * @brief Generalized mass inertia matrix of floating base model.
      */
-    DMat<T> A;
+    WbcMat<T> A;
 
     /**
      * @brief Inverse of generalized mass inertia matrix.
      */
-    DMat<T> Ainv;
+    WbcMat<T> Ainv;
 
     /**
      * @brief Coriolis and centrifugal matrix of floating base model.
      */
-    DVec<T> Coriolis;
+    WbcVec<T> Coriolis;
 
     /**
      * @brief Generalized gravitational matrix of floating base model .
      */
-    DVec<T> Gravity;
+    WbcVec<T> Gravity;
 
     /**
      * @brief Set to true if WBIC has get the results of MIT floating base model.
@@ -228,91 +228,118 @@ private:
     /**
      * @brief Equality constraint matrix of the QP problem in Eigen form.
      */
-    DMat<T> CE;
+    WbcMat<T> CE;
 
     /**
      * @brief Linear vector of the equality constraint of the QP problem in Eigen form.
      */
-    DVec<T> ce0;
+    WbcVec<T> ce0;
 
     /**
      * @brief Inequality constraint matrix of the QP problem in Eigen form.
      */
-    DMat<T> CI;
+    WbcMat<T> CI;
 
     /**
      * @brief Linear vector of the inequality constraint of the QP problem in Eigen form.
      */
-    DVec<T> ci0;
+    WbcVec<T> ci0;
 
     /**
      * @brief Identity matrix used for initial calculation of acceleration command.
      */
-    DMat<T> identityMat;
+    WbcMat<T> identityMat;
 
     /**
      * @brief Force constraint segment of inequality constraint matrix.
      * @see qrSingleContact::Uf
      */
-    DMat<T> UF;
+    WbcMat<T> UF;
 
     /**
      * @brief Linear vector of inequality constraint matrix
      * @see qrSingleContact::ineqVec
      */
-    DVec<T> ineqVec;
+    WbcVec<T> ineqVec;
 
     /**
      * @brief Stacked contact jacobian including all single contact jacobians.
      * @see qrSingleContact::Jc
      */
-    DMat<T> JC;
+    WbcMat<T> JC;
 
     /**
      * @brief Stacked JcDotQdot including all single JcDotQdot.
      * @see qrSingleContact::JcDotQdot
      */
-    DVec<T> JCDotQdot;
+    WbcVec<T> JCDotQdot;
 
     /**
      * @brief Desired reaction force computed from MPC solver.
      */
-    DVec<T> desiredFr;
+    WbcVec<T> desiredFr;
 
     /**
-     * @brief Result vector of the QP problem in quadprogpp form.
+     * @brief The QP problem in quadprogpp form for one number of contacts.
+     * Resizing a quadprogpp matrix reallocates it, so every number of contacts keeps its own problem.
      */
-    quadprogpp::Vector<double> qpz;
+    struct QuadProgProblem {
 
-    /**
-     * @brief Hessian matrix of the QP problem in quadprogpp form.
-     */
-    quadprogpp::Matrix<double> qpG;
+        /**
+         * @brief Result vector of the QP problem.
+         */
+        quadprogpp::Vector<double> z;
 
-    /**
-     * @brief Gradient vector of the QP problem in quadprogpp form.
-     */
-    quadprogpp::Vector<double> qpg0;
+        /**
+         * @brief Hessian matrix of the QP problem.
+         */
+        quadprogpp::Matrix<double> G;
 
-    /**
-     * @brief Equality constraint matrix of the QP problem in quadprogpp form.
-     */
-    quadprogpp::Matrix<double> qpCE;
+        /**
+         * @brief Gradient vector of the QP problem.
+         */
+        quadprogpp::Vector<double> g0;
+
+        /**
+         * @brief Equality constraint matrix of the QP problem.
+         */
+        quadprogpp::Matrix<double> CE;
+
+        /**
+         * @brief Linear vector of the equality constraint of the QP problem.
+         */
+        quadprogpp::Vector<double> ce0;
+
+        /**
+         * @brief Inequality constraint matrix of the QP problem.
+         */
+        quadprogpp::Matrix<double> CI;
+
+        /**
+         * @brief Linear vector of the inequality constraint of the QP problem.
+         */
+        quadprogpp::Vector<double> ci0;
+
+    };
 
     /**
-     * @brief Linear vector of the equality constraint of the QP problem in quadprogpp form.
+     * @brief Resize and clear a QP problem. Only allocates if the dimensions change.
+     * @param problem: the QP problem.
+     * @param dimOpt: dimension of the optimal variable.
+     * @param dimEq: dimension of the equality constraints.
+     * @param dimIneq: dimension of the inequality constraints.
      */
-    quadprogpp::Vector<double> qpce0;
+    static void ResizeProblem(QuadProgProblem &problem, size_t dimOpt, size_t dimEq, size_t dimIneq);
 
     /**
-     * @brief Inequality constraint matrix of the QP problem in quadprogpp form.
+     * @brief QP problems indexed by the number of contacts, allocated in the constructor.
      */
-    quadprogpp::Matrix<double> qpCI;
+    QuadProgProblem qpProblems[NumLeg + 1];
 
     /**
-     * @brief Linear vector of the inequality constraint of the QP problem in quadprogpp form.
+     * @brief QP problem of the current number of contacts.
      */
-    quadprogpp::Vector<double> qpci0;
+    QuadProgProblem *qp;
 
 };
 
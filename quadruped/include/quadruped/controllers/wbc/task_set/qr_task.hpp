@@ -39,13 +39,14 @@ public:
     /**
      * @brief Constructor of class task.
      * @param dim: the dimension of the task.
+     * The commands start at zero, as UpdateCommand() of a task may read them before it writes them.
      */
     qrTask(size_t dim):
         dimTask(dim),
-        xddotCmd(dim),
-        posErr(dim),
-        desiredVel(dim),
-        desiredAcc(dim) {
+        xddotCmd(WbcVec<T>::Zero(dim)),
+        posErr(WbcVec<T>::Zero(dim)),
+        desiredVel(WbcVec<T>::Zero(dim)),
+        desiredAcc(WbcVec<T>::Zero(dim)) {
     }
 
     virtual ~qrTask() = default;
@@ -57,7 +58,7 @@ public:
      * @param des_acc: desired acceleration of the task.
      * @return true if update has finished
      */
-    bool UpdateTask(const void *des_pos, const DVec<T> &des_vel, const DVec<T> &des_acc)
+    bool UpdateTask(const void *des_pos, const WbcVec<T> &des_vel, const WbcVec<T> &des_acc)
     {
         UpdateTaskJacobian();
         UpdateTaskJDotQdot();
@@ -69,42 +70,42 @@ public:
     /**
      * @brief Getter method of member xddotCmd.
      */
-    void GetXddotCmd(DVec<T> &xddot_cmd) const {
+    void GetXddotCmd(WbcVec<T> &xddot_cmd) const {
         xddot_cmd = this->xddotCmd;
     }
 
     /**
      * @brief Getter method of member Jt.
      */
-    void GetJt(DMat<T> &Jt) const {
+    void GetJt(WbcMat<T> &Jt) const {
         Jt = this->Jt;
     }
 
     /**
      * @brief Getter method of member JtDotQdot.
      */
-    void GetJtDotQdot(DVec<T> &JtDot_Qdot) const {
+    void GetJtDotQdot(WbcVec<T> &JtDot_Qdot) const {
         JtDot_Qdot = this->JtDotQdot;
     }
 
     /**
      * @brief Getter method of member posErr.
      */
-    const DVec<T> &GetPosErr() const {
+    const WbcVec<T> &GetPosErr() const {
         return posErr;
     }
 
     /**
      * @brief Getter method of member desiredVel.
      */
-    const DVec<T> &GetDesiredVel() const {
+    const WbcVec<T> &GetDesiredVel() const {
         return desiredVel;
     }
 
     /**
      * @brief Getter method of member desiredAcc.
      */
-    const DVec<T> &GetDesiredAcc() const {
+    const WbcVec<T> &GetDesiredAcc() const {
         return desiredAcc;
     }
 
@@ -114,7 +115,7 @@ protected:
      * @brief Update the desired acceleration command or position error if needed.
      * @return true if update has finished.
      */
-    virtual bool UpdateCommand(const void *pos_des, const DVec<T> &vel_des, const DVec<T> &acc_des) = 0;
+    virtual bool UpdateCommand(const void *pos_des, const WbcVec<T> &vel_des, const WbcVec<T> &acc_des) = 0;
 
     /**
      * @brief Update task jacobian.
@@ -138,36 +139,36 @@ protected:
      * @brief The optimized acceleration command.
      * The acceleration command is computed from PD control of desired position and desired velocity.
      */
-    DVec<T> xddotCmd;
+    WbcVec<T> xddotCmd;
 
     /**
      * @brief Derivative of Jt dot Derivative of q.
      * Used in null-space projection.
      */
-    DVec<T> JtDotQdot;
+    WbcVec<T> JtDotQdot;
 
     /**
      * @brief Task jacobian.
      */
-    DMat<T> Jt;
+    WbcMat<T> Jt;
 
     /**
      * @brief Position error of the task. Will be used in null-space projection.
      * Computed from (desired position/orientation - current  position/orientation.)
      */
-    DVec<T> posErr;
+    WbcVec<T> posErr;
 
     /**
      * @brief Desired velocity of the task.
      * Used in PD control to compute the acceleration command.
      */
-    DVec<T> desiredVel;
+    WbcVec<T> desiredVel;
 
     /**
      * @brief Desired acceleration of the task.
      * Used in PD control to compute the acceleration command.
      */
-    DVec<T> desiredAcc;
+    WbcVec<T> desiredAcc;
 
     /**
      * @brief The dimension of the configuration space.
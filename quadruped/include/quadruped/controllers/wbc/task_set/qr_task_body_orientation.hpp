@@ -63,7 +63,7 @@ protected:
     /**
      * @see qrTask::UpdateCommand
      */
-    virtual bool UpdateCommand(const void *des_pos, const DVec<T> &des_vel, const DVec<T> &des_acc);
+    virtual bool UpdateCommand(const void *des_pos, const WbcVec<T> &des_vel, const WbcVec<T> &des_acc);
 
     /**
      * @see qrTask::UpdateTaskJacobian
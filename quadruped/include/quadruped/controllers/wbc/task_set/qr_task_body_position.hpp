@@ -63,7 +63,7 @@ protected:
     /**
      * @see qrTask::UpdateCommand
      */
-    virtual bool UpdateCommand(const void *pos_des, const DVec<T> &vel_des, const DVec<T> &acc_des);
+    virtual bool UpdateCommand(const void *pos_des, const WbcVec<T> &vel_des, const WbcVec<T> &acc_des);
 
     /**
      * @see qrTask::UpdateTaskJacobian
@@ -193,9 +193,9 @@ class FloatingBaseModel {
   void forwardAccelerationKinematics();
   void contactJacobians();
 
-  DVec<T> generalizedGravityForce();
-  DVec<T> generalizedCoriolisForce();
-  DMat<T> massMatrix();
+  const DVec<T>& generalizedGravityForce();
+  const DVec<T>& generalizedCoriolisForce();
+  const DMat<T>& massMatrix();
   DVec<T> inverseDynamics(const FBModelStateDerivative<T>& dState);
   void runABA(const DVec<T>& tau, FBModelStateDerivative<T>& dstate);
 
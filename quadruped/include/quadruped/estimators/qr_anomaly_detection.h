@@ -25,14 +25,17 @@
 #ifndef QR_CONTACT_DETECTION_H
 #define QR_CONTACT_DETECTION_H
 
+#include <deque>
 
 #include "robots/qr_robot.h"
+#include "estimators/qr_base_state_estimator.h"
 #include "estimators/qr_moving_window_filter.hpp"
 
 /* this is a external lib, but using some variables defined in qr_filter.hpp*/
 #include "TinyEKF.h"
 
 #include "estimators/qr_ground_surface_estimator.h"
+#include "estimators/qr_momentum_observer.h"
 #include "gait/qr_gait.h"
 #include "gait/qr_walk_gait_generator.h"
 #include "utils/physics_transform.h"
@@ -40,7 +43,7 @@
 
 namespace Quadruped {
 
-class qrContactDetection {
+class qrContactDetection : public qrBaseStateEstimator {
 
 public:
 
@@ -74,10 +77,12 @@ public:
     void UpdateSlip(float currentTime);
 
     /**
-     * @brief Warning: do nothing.
+     * @brief Get the external torques on the knees from the whole-body generalized momentum observer.
+     * Since the observer runs after this estimator, it gives the torques of the last tick.
      * @param currentTime: currunt time since the timer started.
+     * @return exteral torques on the knees.
      */
-    void GMObserver(float currentTime);
+    Vec4<float> GMObserver(float currentTime);
 
     /**
      * @brief Caculate the external torques on the legs.
@@ -93,6 +98,14 @@ public:
         return isContact;
     };
 
+    /**
+     * @brief Use the external torques of a momentum observer instead of JointObserver() when it is running.
+     * @param observer: the whole-body generalized momentum observer.
+     */
+    void SetMomentumObserver(qrMomentumObserver *observer) {
+        momentumObserver = observer;
+    };
+
 private:
 
     /**
@@ -110,6 +123,11 @@ private:
      */
     qrGroundSurfaceEstimator* groundEstimator;
 
+    /**
+     * @brief whole-body observer of the external torques, nullptr if not used.
+     */
+    qrMomentumObserver* momentumObserver = nullptr;
+
     /**
      * @brief kalman fitler for the contact state detection.
      */
@@ -0,0 +1,198 @@
+// The MIT License
+
+// Copyright (c) 2022
+// Robot Motion and Vision Laboratory at East China Normal University
+// Contact: tophill.robotics@gmail.com
+
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#ifndef QR_ELEVATION_MAP_H
+#define QR_ELEVATION_MAP_H
+
+#include <cmath>
+#include <vector>
+
+#include "utils/qr_cpptypes.h"
+#include "config/qr_config.h"
+
+
+namespace Quadruped {
+
+/**
+ * @brief Robot-centric rolling 2.5D elevation map fused from the footholds.
+ * The map is a square grid of SIZE x SIZE cells aligned with the world frame. A cell stores
+ * a height and its variance. Cells are addressed by their world cell indices modulo SIZE,
+ * so moving the map only clears the rows and columns that scroll in, and a query is O(1).
+ * The cells are stored in TILE x TILE tiles, so that a local neighbourhood is close in memory.
+ */
+class qrElevationMap {
+
+public:
+
+    /**
+     * @brief Number of cells along a side of the map, a power of two.
+     */
+    static constexpr int SIZE = 64;
+
+    /**
+     * @brief Number of cells along a side of a tile, a power of two.
+     */
+    static constexpr int TILE = 8;
+
+    /**
+     * @brief Constructor of class qrElevationMap.
+     * @param resolutionIn: side length of a cell (unit: m).
+     * @param measurementVarianceIn: variance of a foothold height.
+     * @param processVarianceIn: variance added to a cell before fusing a new foothold,
+     * so that the map follows a changing terrain.
+     */
+    qrElevationMap(float resolutionIn = 0.04f, float measurementVarianceIn = 1e-4f, float processVarianceIn = 1e-4f);
+
+    /**
+     * @brief Clear all cells and center the map at the origin.
+     */
+    void Reset();
+
+    /**
+     * @brief Move the map so that it is centered at the given position, clearing the cells that scroll in.
+     * @param x: x in world frame.
+     * @param y: y in world frame.
+     */
+    void Recenter(float x, float y);
+
+    /**
+     * @brief Fuse a measured height into the cell containing the point, by a scalar Kalman update.
+     * Points outside the map are ignored.
+     * @param point: the point in world frame.
+     */
+    void Fuse(const Vec3<float> &point);
+
+    /**
+     * @brief Get the height at a point.
+     * @param x: x in world frame.
+     * @param y: y in world frame.
+     * @param z: the height if the cell is known.
+     * @return whether the cell is known.
+     */
+    bool GetHeight(float x, float y, float &z) const;
+
+    /**
+     * @brief Get the variance of the height at a point, infinity if unknown.
+     */
+    float GetVariance(float x, float y) const;
+
+    /**
+     * @brief Fit a plane z = a0 + a1 * (x - cx) + a2 * (y - cy) to the known cells around a center,
+     * weighted by the inverse variance of each cell.
+     * @param center: (cx, cy) in world frame.
+     * @param radius: half side of the square window (unit: m).
+     * @param a: the coefficients of the plane.
+     * @return number of known cells used, 0 if the fit is degenerate.
+     */
+    int FitPlane(const Vec2<float> &center, float radius, Vec3<float> &a) const;
+
+    /**
+     * @brief Copy the cells and the center of another map.
+     * The copy is skipped if neither map has changed since the last copy from the same map.
+     */
+    void CopyFrom(const qrElevationMap &other);
+
+    /**
+     * @brief Incremented whenever the cells change.
+     */
+    inline unsigned long GetRevision() const {
+        return revision;
+    };
+
+    /**
+     * @brief Getter method of member resolution.
+     */
+    inline float GetResolution() const {
+        return resolution;
+    };
+
+private:
+
+    /**
+     * @brief World cell index of a coordinate.
+     */
+    inline int CellIndex(float coordinate) const {
+        return static_cast<int>(std::floor(coordinate / resolution));
+    };
+
+    /**
+     * @brief Whether a world cell is inside the map.
+     */
+    inline bool Contains(int ix, int iy) const {
+        return ix >= centerX - SIZE / 2 && ix < centerX + SIZE / 2 && iy >= centerY - SIZE / 2 && iy < centerY + SIZE / 2;
+    };
+
+    /**
+     * @brief Storage offset of a world cell, by wraparound and tiling.
+     */
+    inline int Offset(int ix, int iy) const {
+        const int wx = ix & (SIZE - 1);
+        const int wy = iy & (SIZE - 1);
+        return ((wy / TILE) * (SIZE / TILE) + wx / TILE) * TILE * TILE + (wy % TILE) * TILE + wx % TILE;
+    };
+
+    /**
+     * @brief Clear a column (ix) or a row (iy) of world cells.
+     */
+    void ClearColumn(int ix);
+
+    void ClearRow(int iy);
+
+    float resolution;
+
+    float measurementVariance;
+
+    float processVariance;
+
+    /**
+     * @brief World cell index of the center of the map.
+     */
+    int centerX;
+
+    int centerY;
+
+    /**
+     * @brief Heights of the cells.
+     */
+    std::vector<float> height;
+
+    /**
+     * @brief Variances of the cells, infinity for an unknown cell.
+     */
+    std::vector<float> variance;
+
+    unsigned long revision;
+
+    /**
+     * @brief The map of the last CopyFrom(), and the revision of both maps after it.
+     */
+    const qrElevationMap *copySource;
+
+    unsigned long copyRevision;
+
+};
+
+} // Namespace Quadruped
+
+#endif // QR_ELEVATION_MAP_H
@@ -28,6 +28,7 @@
 #include "utils/qr_se3.h"
 #include "robots/qr_robot.h"
 #include "estimators/qr_base_state_estimator.h"
+#include "estimators/qr_elevation_map.h"
 
 
 namespace Quadruped {
@@ -169,11 +170,25 @@ public:
     virtual void Reset(float currentTime);
 
     /**
-     * @brief Compute the plane equation when four feet are all in contact with ground.
+     * @brief Fuse the footholds of the legs touching down into the elevation map,
+     * and update the plane equation from the map around the robot.
+     * Falls back to the plane of the four feet when the map has too few cells.
      * @param currentTime: time since the timer started.
      */
     virtual void Update(float currentTime);
 
+    /**
+     * @brief Update the plane equation in base frame from a local plane fit of the elevation map.
+     * @return whether the fit is valid.
+     */
+    bool UpdatePlaneFromMap();
+
+    /**
+     * @brief Copy the estimated plane and control frame of another estimator, used by the pipelined runner.
+     * @param other: the estimator updated by the estimation stage.
+     */
+    void CopyEstimates(const qrGroundSurfaceEstimator &other);
+
     /**
      * @brief Compute or return the normal of ground surface represent in (initial) base frame.
      * @param update: if normalize the normal vector or not.
@@ -283,6 +298,21 @@ public:
      * @brief Contact state of for legs at last control loop.
     */
     Eigen::Matrix<bool, 4, 1> lastContactState;
+
+    /**
+     * @brief Rolling elevation map around the robot, fused from every touchdown.
+    */
+    qrElevationMap elevationMap;
+
+    /**
+     * @brief Half side of the window of the local plane fit around the robot (unit: m).
+    */
+    float mapFitRadius;
+
+    /**
+     * @brief Minimum number of known cells for a local plane fit to replace the plane of the four feet.
+    */
+    int mapFitMinCells;
     
     /**
      * @brief Yaml node of the foothold planner config file.
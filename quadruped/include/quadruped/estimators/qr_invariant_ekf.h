@@ -0,0 +1,245 @@
+// The MIT License
+
+// Copyright (c) 2022
+// Robot Motion and Vision Laboratory at East China Normal University
+// Contact: tophill.robotics@gmail.com
+
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#ifndef QR_INVARIANT_EKF_H
+#define QR_INVARIANT_EKF_H
+
+#include "utils/qr_se3.h"
+#include "robots/qr_robot.h"
+#include "estimators/qr_base_state_estimator.h"
+
+
+namespace Quadruped {
+
+/**
+ * @brief Contact-aided right-invariant EKF of the base state, re-expressed from extern/invariant-ekf
+ * over fixed-size matrices for the four feet, so that neither propagation nor correction allocates.
+ * The state X in SE_6(3) holds the rotation, velocity, position of the base and the positions of the four feet
+ * in world frame, and Theta holds the gyroscope and accelerometer biases.
+ * Instead of removing a foot from the state when it lifts and augmenting it again at touch down,
+ * a swinging foot is kept but not observed, and is re-initialized with the augmentation Jacobian
+ * when it touches down. Since an unobserved foot does not enter the gain of the other states,
+ * this gives the same estimate as the variable-size filter.
+ */
+class qrInvariantEKF : public qrBaseStateEstimator {
+
+public:
+
+    EIGEN_MAKE_ALIGNED_OPERATOR_NEW
+
+    /**
+     * @brief Dimension of X, 3 for rotation, 1 for velocity, 1 for position and 1 for each foot.
+     */
+    static constexpr int DIM_X = 5 + NumLeg;
+
+    /**
+     * @brief Dimension of Theta.
+     */
+    static constexpr int DIM_THETA = 6;
+
+    /**
+     * @brief Dimension of the error state of X.
+     */
+    static constexpr int DIM_XI = 3 * (DIM_X - 2);
+
+    /**
+     * @brief Dimension of P.
+     */
+    static constexpr int DIM_P = DIM_XI + DIM_THETA;
+
+    /**
+     * @brief Maximum dimension of the stacked kinematic measurement.
+     */
+    static constexpr int MAX_MEAS = 3 * NumLeg;
+
+    /**
+     * @brief Constructor of class qrInvariantEKF.
+     * @param robotIn: the robot class for the estimation.
+     */
+    qrInvariantEKF(qrRobot *robotIn);
+
+    /**
+     * @brief Initialize the state from the current orientation and kinematics of the robot.
+     * @param currentTime: current time since the timer started.
+     */
+    void Reset(float currentTime);
+
+    /**
+     * @brief Propagate with the IMU and correct with the kinematics of the feet in contact.
+     * @param currentTime: current time since the timer started.
+     */
+    void Update(float currentTime);
+
+    /**
+     * @brief Propagate the state with IMU data.
+     * @param w: angular velocity in base frame.
+     * @param a: linear acceleration in base frame, including gravity.
+     * @param dt: time step.
+     */
+    void Propagate(const Vec3<double> &w, const Vec3<double> &a, double dt);
+
+    /**
+     * @brief Correct the state with the foot positions in base frame.
+     * @param footPositions: foot positions in base frame.
+     * @param contacts: contact state of each foot.
+     */
+    void CorrectKinematics(const Eigen::Matrix<double, 3, NumLeg> &footPositions, const Vec4<bool> &contacts);
+
+    /**
+     * @brief Getter method of the base rotation matrix, from base frame to world frame.
+     */
+    inline Mat3<double> GetRotation() const {
+        return X.block<3, 3>(0, 0);
+    };
+
+    /**
+     * @brief Getter method of the base velocity in world frame.
+     */
+    inline Vec3<double> GetVelocity() const {
+        return X.block<3, 1>(0, 3);
+    };
+
+    /**
+     * @brief Getter method of the base position in world frame.
+     */
+    inline Vec3<double> GetPosition() const {
+        return X.block<3, 1>(0, 4);
+    };
+
+    /**
+     * @brief Getter method of the gyroscope bias.
+     */
+    inline Vec3<double> GetGyroscopeBias() const {
+        return theta.head(3);
+    };
+
+    /**
+     * @brief Getter method of member P.
+     */
+    inline const Eigen::Matrix<double, DIM_P, DIM_P> &GetCovariance() const {
+        return P;
+    };
+
+    /**
+     * @brief Covariance of gyroscope noise.
+     */
+    Mat3<double> gyroscopeCov;
+
+    /**
+     * @brief Covariance of accelerometer noise.
+     */
+    Mat3<double> accelerometerCov;
+
+    /**
+     * @brief Covariance of gyroscope bias random walk.
+     */
+    Mat3<double> gyroscopeBiasCov;
+
+    /**
+     * @brief Covariance of accelerometer bias random walk.
+     */
+    Mat3<double> accelerometerBiasCov;
+
+    /**
+     * @brief Covariance of the slip of a foot in contact.
+     */
+    Mat3<double> contactCov;
+
+    /**
+     * @brief Covariance of the foot position from forward kinematics.
+     */
+    Mat3<double> kinematicsCov;
+
+private:
+
+    /**
+     * @brief Reset the position and covariance of a foot that touches down.
+     * @param legId: which leg.
+     * @param footPosition: foot position in base frame.
+     */
+    void InitializeFoot(int legId, const Vec3<double> &footPosition);
+
+    /**
+     * @brief Compute the time interval from the tick of the robot.
+     */
+    double ComputeDeltaTime(uint32_t tick);
+
+    /**
+     * @brief The robot class for the estimation.
+     */
+    qrRobot *robot;
+
+    /**
+     * @brief Gravity in world frame.
+     */
+    Vec3<double> gravity;
+
+    /**
+     * @brief Base rotation, velocity, position and foot positions.
+     */
+    Eigen::Matrix<double, DIM_X, DIM_X> X;
+
+    /**
+     * @brief Gyroscope and accelerometer biases.
+     */
+    Eigen::Matrix<double, DIM_THETA, 1> theta;
+
+    /**
+     * @brief Covariance of the right-invariant error.
+     */
+    Eigen::Matrix<double, DIM_P, DIM_P> P;
+
+    /**
+     * @brief Whether each foot is in the state, i.e. has been in contact since its last touch down.
+     */
+    Vec4<bool> footInState;
+
+    /**
+     * @brief Linearized error dynamics, its discretization and the adjoint of X.
+     */
+    Eigen::Matrix<double, DIM_P, DIM_P> A, Phi, Adj, PhiAdj, Qk;
+
+    /**
+     * @brief Stacked kinematic measurement. The row count is the number of feet in contact times 3.
+     */
+    Eigen::Matrix<double, Eigen::Dynamic, 1, 0, MAX_MEAS, 1> Z;
+
+    Eigen::Matrix<double, Eigen::Dynamic, DIM_P, Eigen::RowMajor, MAX_MEAS, DIM_P> H;
+
+    Eigen::Matrix<double, Eigen::Dynamic, Eigen::Dynamic, 0, MAX_MEAS, MAX_MEAS> N, S;
+
+    Eigen::Matrix<double, DIM_P, Eigen::Dynamic, 0, DIM_P, MAX_MEAS> PHT, K;
+
+    Eigen::Matrix<double, DIM_P, DIM_P> IKH, PTemp;
+
+    /**
+     * @brief Last tick of the robot used for computing the time interval.
+     */
+    uint32_t lastTimestamp;
+
+};
+
+} // Namespace Quadruped
+
+#endif // QR_INVARIANT_EKF_H
@@ -0,0 +1,235 @@
+// The MIT License
+
+// Copyright (c) 2022
+// Robot Motion and Vision Laboratory at East China Normal University
+// Contact: tophill.robotics@gmail.com
+
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+#ifndef QR_KALMAN_FILTER_H
+#define QR_KALMAN_FILTER_H
+
+#include "Eigen/Dense"
+
+
+namespace Quadruped {
+
+/**
+ * @brief Linear Kalman filter over fixed-size Eigen matrices, so that neither Predict() nor Update() allocates.
+ * The process model is x' = F x + u, where u is the control input already mapped into the state space,
+ * and the measurement model is z = H x. F and H default to identity.
+ * @tparam T: scalar type.
+ * @tparam NX: dimension of the state.
+ * @tparam NZ: dimension of the measurement.
+ */
+template<typename T, int NX, int NZ>
+class qrKalmanFilter {
+
+public:
+
+    EIGEN_MAKE_ALIGNED_OPERATOR_NEW
+
+    using StateVec = Eigen::Matrix<T, NX, 1>;
+
+    using StateMat = Eigen::Matrix<T, NX, NX>;
+
+    using MeasVec = Eigen::Matrix<T, NZ, 1>;
+
+    using MeasMat = Eigen::Matrix<T, NZ, NZ>;
+
+    /**
+     * @brief Constructor of class qrKalmanFilter with a zero state and zero noise.
+     */
+    qrKalmanFilter()
+    {
+        Reset(StateVec::Zero(), StateMat::Zero());
+        F.setIdentity();
+        H.setIdentity();
+        Q.setZero();
+        R.setZero();
+    }
+
+    /**
+     * @brief Constructor of class qrKalmanFilter with isotropic noise.
+     * @param initialVariance: variance of the initial state.
+     * @param processVariance: variance of the process noise.
+     * @param measurementVariance: variance of the measurement noise.
+     */
+    qrKalmanFilter(T initialVariance, T processVariance, T measurementVariance): qrKalmanFilter()
+    {
+        P = StateMat::Identity() * initialVariance;
+        Q = StateMat::Identity() * processVariance;
+        R = MeasMat::Identity() * measurementVariance;
+    }
+
+    /**
+     * @brief Reset the state and its covariance.
+     * @param x0: initial state.
+     * @param P0: initial covariance.
+     */
+    void Reset(const StateVec &x0, const StateMat &P0)
+    {
+        x = x0;
+        P = P0;
+        gateFactorValid = false;
+    }
+
+    /**
+     * @brief Propagate the state and its covariance.
+     * @param u: control input in the state space.
+     */
+    void Predict(const StateVec &u)
+    {
+        x = F * x + u;
+        P = F * P * F.transpose() + Q;
+        gateFactorValid = false;
+    }
+
+    /**
+     * @brief Squared Mahalanobis distance of a measurement to the current prediction.
+     * @param z: the measurement.
+     * @param RIn: covariance of this measurement.
+     * @return (z - Hx)^T (H P H^T + R)^-1 (z - Hx).
+     */
+    T MahalanobisDistance(const MeasVec &z, const MeasMat &RIn) const
+    {
+        const MeasVec innovation = z - H * x;
+        const MeasMat S = H * P * H.transpose() + RIn;
+        return innovation.dot(S.llt().solve(innovation));
+    }
+
+    /**
+     * @brief Whether a measurement with covariance R passes the chi-square gate.
+     * The innovation covariance is factorized once after each Predict() or Update(),
+     * so that gating several measurements against the same prediction costs one factorization.
+     * @param z: the measurement.
+     * @param threshold: gate on the squared Mahalanobis distance, a non-positive value disables the gate.
+     */
+    bool IsInlier(const MeasVec &z, T threshold)
+    {
+        if (threshold <= T(0)) {
+            return true;
+        }
+        if (!gateFactorValid) {
+            gateFactor.compute(H * P * H.transpose() + R);
+            gateFactorValid = true;
+        }
+        const MeasVec innovation = z - H * x;
+        return innovation.dot(gateFactor.solve(innovation)) <= threshold;
+    }
+
+    /**
+     * @brief Correct the state with a measurement.
+     * The innovation covariance S = H P H^T + R is factorized once by Cholesky, and P H^T is shared
+     * by S, the gain and the covariance update P - P H^T S^-1 H P, which is kept symmetric.
+     * @param z: the measurement.
+     * @param RIn: covariance of this measurement.
+     * @return false if the innovation covariance is not positive definite, in which case the state is kept.
+     */
+    bool Update(const MeasVec &z, const MeasMat &RIn)
+    {
+        PHt.noalias() = P * H.transpose();
+        S = RIn;
+        S.noalias() += H * PHt;
+        SFactor.compute(S);
+        if (SFactor.info() != Eigen::Success) {
+            return false;
+        }
+        K.transpose() = SFactor.solve(PHt.transpose());
+        x += K * (z - H * x);
+        P.noalias() -= K * PHt.transpose();
+        P = (T(0.5) * (P + P.transpose())).eval();
+        gateFactorValid = false;
+        return true;
+    }
+
+    /**
+     * @brief Correct the state with a measurement whose covariance is R.
+     */
+    bool Update(const MeasVec &z)
+    {
+        return Update(z, R);
+    }
+
+    /**
+     * @brief The state.
+     */
+    StateVec x;
+
+    /**
+     * @brief Covariance of the state.
+     */
+    StateMat P;
+
+    /**
+     * @brief State transition matrix.
+     */
+    StateMat F;
+
+    /**
+     * @brief Measurement matrix.
+     */
+    Eigen::Matrix<T, NZ, NX> H;
+
+    /**
+     * @brief Process noise covariance.
+     */
+    StateMat Q;
+
+    /**
+     * @brief Measurement noise covariance.
+     */
+    MeasMat R;
+
+private:
+
+    /**
+     * @brief P * H^T, kept between calls of Update().
+     */
+    Eigen::Matrix<T, NX, NZ> PHt;
+
+    /**
+     * @brief Kalman gain.
+     */
+    Eigen::Matrix<T, NX, NZ> K;
+
+    /**
+     * @brief Innovation covariance.
+     */
+    MeasMat S;
+
+    /**
+     * @brief Cholesky factorization of the innovation covariance.
+     */
+    Eigen::LLT<MeasMat> SFactor;
+
+    /**
+     * @brief Cholesky factorization of H P H^T + R used by IsInlier().
+     */
+    Eigen::LLT<MeasMat> gateFactor;
+
+    /**
+     * @brief Whether gateFactor belongs to the current covariance.
+     */
+    bool gateFactorValid = false;
+
+};
+
+} // Namespace Quadruped
+
+#endif // QR_KALMAN_FILTER_H
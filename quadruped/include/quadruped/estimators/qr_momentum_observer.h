@@ -0,0 +1,157 @@
+// The MIT License
+
+// Copyright (c) 2022
+// Robot Motion and Vision Laboratory at East China Normal University
+// Contact: tophill.robotics@gmail.com
+
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+#ifndef QR_MOMENTUM_OBSERVER_H
+#define QR_MOMENTUM_OBSERVER_H
+
+#include "robots/qr_robot.h"
+#include "estimators/qr_base_state_estimator.h"
+
+
+namespace Quadruped {
+
+/**
+ * @brief Whole-body generalized momentum observer of the external forces on the robot.
+ * With the generalized momentum p = H(q) qd and the equation of motion H qdd + C qd + G = tau + tau_ext,
+ * the residual r = K (p(t) - p(0) - integral(tau - C qd - G + dH/dt qd + r)) is a first order filter of tau_ext
+ * with bandwidth K, which needs neither the joint accelerations nor the inverse of H.
+ * The terms of the dynamic model are evaluated by qrRobot::UpdateDynamicsModel(),
+ * once per tick for the observer and the whole body controller.
+ */
+class qrMomentumObserver : public qrBaseStateEstimator {
+
+public:
+
+    EIGEN_MAKE_ALIGNED_OPERATOR_NEW
+
+    /**
+     * @brief Number of generalized velocities, 6 for the floating base and 1 for each joint.
+     */
+    static constexpr int DIM = BaseFreedomDim + NumMotor;
+
+    /**
+     * @brief Constructor of class qrMomentumObserver.
+     * @param robotIn: the robot whose dynamic model is used.
+     * @param userParametersIn: parameters of the observer gain.
+     */
+    qrMomentumObserver(qrRobot *robotIn, qrUserParameters *userParametersIn);
+
+    /**
+     * @brief Restart the observer from the momentum of the next update.
+     * @param currentTime: time since the timer started.
+     */
+    void Reset(float currentTime);
+
+    /**
+     * @brief Update the residual and the contact forces.
+     * @param currentTime: time since the timer started.
+     */
+    void Update(float currentTime);
+
+    /**
+     * @brief Copy the estimates of the observer updated by the estimation stage of the pipelined runner.
+     */
+    void CopyEstimates(const qrMomentumObserver &other);
+
+    /**
+     * @brief Whether the observer has run since the last reset.
+     */
+    bool IsReady() const {
+        return initialized;
+    };
+
+    /**
+     * @brief Getter method of the external generalized forces, the wrench on the base in base frame
+     * followed by the joint torques.
+     */
+    const Eigen::Matrix<float, DIM, 1> &GetExternalForces() const {
+        return residual;
+    };
+
+    /**
+     * @brief Getter method of the external joint torques.
+     */
+    Eigen::Matrix<float, NumMotor, 1> GetExternalJointTorques() const {
+        return residual.tail<NumMotor>();
+    };
+
+    /**
+     * @brief Getter method of the contact forces on the feet in world frame,
+     * explaining the external joint torques of each leg by a force at its foot.
+     */
+    const Mat34<float> &GetContactForces() const {
+        return contactForces;
+    };
+
+private:
+
+    /**
+     * @brief The robot whose dynamic model is used.
+     */
+    qrRobot *robot;
+
+    /**
+     * @brief Gain K of the observer (unit: 1/s).
+     */
+    float gain;
+
+    /**
+     * @brief Whether the observer has run since the last reset.
+     */
+    bool initialized = false;
+
+    /**
+     * @brief Time of the last update.
+     */
+    float lastTime = 0.f;
+
+    /**
+     * @brief Mass matrix of the last update.
+     */
+    Eigen::Matrix<float, DIM, DIM> lastH;
+
+    /**
+     * @brief Generalized momentum at the first update since reset.
+     */
+    Eigen::Matrix<float, DIM, 1> initialMomentum;
+
+    /**
+     * @brief Integral of the modelled rate of change of the momentum and of the residual.
+     */
+    Eigen::Matrix<float, DIM, 1> integral;
+
+    /**
+     * @brief Residual of the observer, the estimate of the external generalized forces.
+     */
+    Eigen::Matrix<float, DIM, 1> residual;
+
+    /**
+     * @brief Contact forces on the feet in world frame.
+     */
+    Mat34<float> contactForces;
+
+};
+
+} // Namespace Quadruped
+
+#endif // QR_MOMENTUM_OBSERVER_H
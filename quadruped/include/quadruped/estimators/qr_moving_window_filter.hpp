@@ -25,8 +25,9 @@
 #ifndef QR_MOVING_WINDOW_FILTER_H
 #define QR_MOVING_WINDOW_FILTER_H
 
-#include <deque>
+#include <algorithm>
 #include <cmath>
+#include <vector>
 
 #include "Eigen/Dense"
 
@@ -41,6 +42,8 @@ namespace Quadruped {
 
 /**
  * @brief filtering a sequence of noisy measurment data.
+ * The window is a circular buffer allocated once by the constructor,
+ * so that CalculateAverage() does not allocate.
 */
 template<class T=double, int N=1>
 class qrMovingWindowFilter {
@@ -59,7 +62,7 @@ public:
     qrMovingWindowFilter(unsigned int windowSize);
 
     /**
-     * @brief Reset some intermediate variable of the method, include sum, correction, deque.
+     * @brief Reset some intermediate variable of the method, include sum, correction, window.
      */
     void Reset();
 
@@ -79,6 +82,12 @@ public:
      */
     Eigen::Matrix<T, N, 1> CalculateAverage(const Eigen::Matrix<T, N, 1> &newValue);
 
+    /**
+     * @brief Compute the variance of each component of the values in the window, about their average.
+     * It walks the window, so it costs O(window size), but it does not allocate.
+     * @return zero if the window is empty.
+     */
+    Eigen::Matrix<T, N, 1> GetVariance() const;
 
     /**
      * @brief Getter method of member sum.
@@ -106,44 +115,47 @@ private:
     Eigen::Matrix<T, N, 1> correction;
 
     /**
-     * @brief Stores the moving window values.
+     * @brief Stores the moving window values, a circular buffer of moveWindowSize.
      */
-    std::deque<Eigen::Matrix<T, N, 1>> valueDeque;
+    std::vector<Eigen::Matrix<T, N, 1>, Eigen::aligned_allocator<Eigen::Matrix<T, N, 1>>> valueBuffer;
+
+    /**
+     * @brief Index of the oldest value in valueBuffer.
+     */
+    unsigned int front;
+
+    /**
+     * @brief Number of values in the window.
+     */
+    unsigned int count;
 
 
 };
 
 
 template<class T, int N>
-qrMovingWindowFilter<T, N>::qrMovingWindowFilter()
+qrMovingWindowFilter<T, N>::qrMovingWindowFilter():
+    qrMovingWindowFilter(DEFAULT_WINDOW_SIZE)
 {
-    moveWindowSize = DEFAULT_WINDOW_SIZE;
-    for (int i = 0; i < N; ++i) {
-        sum[i] = 0.;
-        correction[i] = 0.;
-    }
 }
 
 
 template<class T, int N>
 qrMovingWindowFilter<T, N>::qrMovingWindowFilter(unsigned int windowSizeIn)
 {
-    moveWindowSize = windowSizeIn;
-    for (int i = 0; i < N; ++i) {
-        sum[i] = 0.;
-        correction[i] = 0.;
-    }
+    moveWindowSize = std::max(windowSizeIn, 1u);
+    valueBuffer.resize(moveWindowSize);
+    Reset();
 }
 
 
 template<class T, int N>
 void qrMovingWindowFilter<T, N>::Reset()
 {
-    for (int i = 0; i < N; ++i) {
-        sum[i] = 0.;
-        correction[i] = 0.;
-    }
-    valueDeque.clear();
+    sum.setZero();
+    correction.setZero();
+    front = 0;
+    count = 0;
 }
 
 
@@ -151,16 +163,10 @@ template<class T, int N>
 void qrMovingWindowFilter<T, N>::NeumaierSum(const Eigen::Matrix<T, N, 1> &value)
 {
     Eigen::Matrix<T, N, 1> newSum = sum + value;
-    for (int i = 0; i < N; ++i) {
-        if (std::abs(sum[i]) >= std::abs(value[i])) {
-        // If self._sum is bigger, low-order digits of value are lost.
-        correction[i] += (sum[i] - newSum[i]) + value[i];
-        } else {
-            // low-order digits of sum are lost
-            correction[i] += (value[i] - newSum[i]) + sum[i];
-        }
-    }
-
+    /* If sum is bigger, low-order digits of value are lost, otherwise low-order digits of sum are lost. */
+    correction.array() += (sum.array().abs() >= value.array().abs()).select(
+        (sum - newSum).array() + value.array(),
+        (value - newSum).array() + sum.array());
     sum = newSum;
 }
 
@@ -175,17 +181,33 @@ void qrMovingWindowFilter<T, N>::NeumaierSum(const Eigen::Matrix<T, N, 1> &value
 template<class T, int N>
 Eigen::Matrix<T, N, 1> qrMovingWindowFilter<T, N>::CalculateAverage(const Eigen::Matrix<T, N, 1> &newValue)
 {
-    int dequeLen = valueDeque.size();
-    if (dequeLen >= moveWindowSize) {
+    if (count >= moveWindowSize) {
         // The left most value to be subtracted from the moving sum.
-        NeumaierSum(-valueDeque[0]);
-        valueDeque.pop_front();
-        dequeLen--;
+        NeumaierSum(-valueBuffer[front]);
+        valueBuffer[front] = newValue;
+        front = (front + 1) % moveWindowSize;
+    } else {
+        valueBuffer[(front + count) % moveWindowSize] = newValue;
+        ++count;
     }
 
     NeumaierSum(newValue);
-    valueDeque.push_back(newValue);
-    return (sum + correction) / (dequeLen + 1);
+    return (sum + correction) / count;
+}
+
+
+template<class T, int N>
+Eigen::Matrix<T, N, 1> qrMovingWindowFilter<T, N>::GetVariance() const
+{
+    Eigen::Matrix<T, N, 1> variance = Eigen::Matrix<T, N, 1>::Zero();
+    if (count == 0) {
+        return variance;
+    }
+    const Eigen::Matrix<T, N, 1> average = (sum + correction) / count;
+    for (unsigned int i = 0; i < count; ++i) {
+        variance += (valueBuffer[(front + i) % moveWindowSize] - average).array().square().matrix();
+    }
+    return variance / count;
 }
 
 } // Namespace Quadruped
@@ -199,30 +221,27 @@ public:
     /**
      * @brief Constructor of the class MovingWindowFilter.
      */
-    qrMovingWindowFilter() {
-        moveWindowSize = DEFAULT_WINDOW_SIZE;
-        sum = 0.;
-        correction = 0.;
-    };
+    qrMovingWindowFilter(): qrMovingWindowFilter(DEFAULT_WINDOW_SIZE) {};
 
     /**
      * @brief Constructor of the class MovingWindowFilter.
      * @windowSizeIn: window size for the moving window algorithm.
      */
     qrMovingWindowFilter(unsigned int windowSizeIn) {
-        moveWindowSize = windowSizeIn;
-        sum = 0.;
-        correction = 0.;
+        moveWindowSize = std::max(windowSizeIn, 1u);
+        valueBuffer.resize(moveWindowSize);
+        Reset();
     };
 
     /**
      * @brief Reset some intermediate variable of the method,
-     * include sum, correction, deque.
+     * include sum, correction, window.
      */
     void Reset() {
         sum = 0.;
         correction = 0.;
-        valueDeque.clear();
+        front = 0;
+        count = 0;
     };
 
     /**
@@ -249,17 +268,35 @@ public:
      * @param newValue: push a new value into the window queue.
      */
     double CalculateAverage(const double &newValue) {
-        int dequeLen = valueDeque.size();
-        if (dequeLen >= moveWindowSize) {
+        if (count >= moveWindowSize) {
             // The left most value to be subtracted from the moving sum.
-            NeumaierSum(-valueDeque[0]);
-            valueDeque.pop_front();
-            dequeLen--;
+            NeumaierSum(-valueBuffer[front]);
+            valueBuffer[front] = newValue;
+            front = (front + 1) % moveWindowSize;
+        } else {
+            valueBuffer[(front + count) % moveWindowSize] = newValue;
+            ++count;
         }
 
         NeumaierSum(newValue);
-        valueDeque.push_back(newValue);
-        return (sum + correction) / (dequeLen+1);
+        return (sum + correction) / count;
+    };
+
+    /**
+     * @brief Compute the variance of the values in the window about their average, in O(window size).
+     * @return zero if the window is empty.
+     */
+    double GetVariance() const {
+        if (count == 0) {
+            return 0.;
+        }
+        const double average = (sum + correction) / count;
+        double variance = 0.;
+        for (unsigned int i = 0; i < count; ++i) {
+            const double deviation = valueBuffer[(front + i) % moveWindowSize] - average;
+            variance += deviation * deviation;
+        }
+        return variance / count;
     };
 
     /**
@@ -288,9 +325,19 @@ private:
     double correction;
 
     /**
-     * @brief Stores the moving window values.
+     * @brief Stores the moving window values, a circular buffer of moveWindowSize.
+     */
+    std::vector<double> valueBuffer;
+
+    /**
+     * @brief Index of the oldest value in valueBuffer.
+     */
+    unsigned int front;
+
+    /**
+     * @brief Number of values in the window.
      */
-    std::deque<double> valueDeque;
+    unsigned int count;
 
 };
 
@@ -29,6 +29,8 @@
 #include "robots/qr_robot.h"
 #include "estimators/qr_robot_pose_estimator.h"
 #include "estimators/qr_robot_velocity_estimator.h"
+#include "estimators/qr_invariant_ekf.h"
+#include "estimators/qr_kalman_filter.hpp"
 #include "estimators/qr_ground_surface_estimator.h"
 
 
@@ -87,6 +89,18 @@ public:
      */
     void Update(float currentTime);
 
+    /**
+     * @brief Update the robot state by the invariant EKF.
+     * @param currentTime: time since the timer started.
+     */
+    void UpdateByInEKF(float currentTime);
+
+    /**
+     * @brief Update the robot state by the linear Kalman filter of CMU.
+     * @param currentTime: time since the timer started.
+     */
+    void UpdateByCMUFilter(float currentTime);
+
     /**
      * @brief Initialize the state of Filter.
      */
@@ -98,6 +112,12 @@ public:
      */
     void CMUUpdate(double currentTime);
 
+    /**
+     * @brief Copy the estimation results of another estimator, used by the pipelined runner.
+     * @param other: the estimator updated by the estimation stage.
+     */
+    void CopyEstimates(const qrRobotEstimator &other);
+
     /**
      * @brief Getter mthod of member estimatedVelocity.
      */
@@ -143,6 +163,21 @@ private:
      */
     qrRobotPoseEstimator poseEstimator;
 
+    /**
+     * @brief Invariant EKF, used instead of velocityEstimator and poseEstimator if useInEKF.
+     */
+    qrInvariantEKF invariantEKF;
+
+    /**
+     * @brief Whether to estimate the base state by the invariant EKF.
+     */
+    bool useInEKF;
+
+    /**
+     * @brief Whether to estimate the base state by CMUUpdate.
+     */
+    bool useCMUFilter;
+
     /**
      * @brief Time since reset the timer.
      */
@@ -179,41 +214,16 @@ private:
     uint32_t lastTimestamp;
 
     /**
-     * @brief Estimation state.
+     * @brief Kalman filter of the estimation state, whose F is the state transition and H the observation.
      * 0 1 2 pos 3 4 5 vel 6 7 8 foot pos FL 9 10 11 foot pos FR 12 13 14 foot pos RL 15 16 17 foot pos RR
      */
-    Eigen::Matrix<double, STATE_SIZE, 1> x; // estimation state
-
-    /**
-     * @brief Estimation state after process update.
-     */
-    Eigen::Matrix<double, STATE_SIZE, 1> xbar; // estimation state after process update
-
-    /**
-     * @brief Estimation state covariance.
-     */
-    Eigen::Matrix<double, STATE_SIZE, STATE_SIZE> P; // estimation state covariance
-
-    /**
-     * @brief Estimation state covariance after process update.
-     */
-    Eigen::Matrix<double, STATE_SIZE, STATE_SIZE> Pbar; // estimation state covariance after process update
-
-    /**
-     * @brief Estimation state transition.
-     */
-    Eigen::Matrix<double, STATE_SIZE, STATE_SIZE> A; // estimation state transition
+    qrKalmanFilter<double, STATE_SIZE, MEAS_SIZE> cmuFilter;
 
     /**
      * @brief Estimation state transition.
      */
     Eigen::Matrix<double, STATE_SIZE, 3> B; // estimation state transition
 
-    /**
-     * @brief Estimation state transition noise.
-     */
-    Eigen::Matrix<double, STATE_SIZE, STATE_SIZE> Q; // estimation state transition noise
-
     /**
      * @brief Observation.
      * observation
@@ -229,51 +239,11 @@ private:
      */
     Eigen::Matrix<double, MEAS_SIZE, 1> y;
 
-    /**
-     * @brief Estimated observation.
-     */
-    Eigen::Matrix<double, MEAS_SIZE, 1> yhat;
-
-    /**
-     * @brief Estimated observation.
-     */
-    Eigen::Matrix<double, MEAS_SIZE, 1> error_y;
-
-    /**
-     * @brief S^-1*error_y.
-     */
-    Eigen::Matrix<double, MEAS_SIZE, 1> Serror_y;
-
-    /**
-     * @brief Estimation state observation.
-     */
-    Eigen::Matrix<double, MEAS_SIZE, STATE_SIZE> C;
-
-    /**
-     * @brief S^-1*C.
-     */
-    Eigen::Matrix<double, MEAS_SIZE, STATE_SIZE> SC;
-
-    /**
-     * @brief Estimation state observation noise
-     */
-    Eigen::Matrix<double, MEAS_SIZE, MEAS_SIZE> R;
-
     /**
      * @brief 3x3 identity.
      */
     Eigen::Matrix<double, 3, 3> eye3;
 
-    /**
-     * @brief Innovation (or pre-fit residual) covariance.
-     */
-    Eigen::Matrix<double, MEAS_SIZE, MEAS_SIZE> S;
-
-    /**
-     * @brief Kalman gain.
-     */
-    Eigen::Matrix<double, STATE_SIZE, MEAS_SIZE> K;
-
     /**
      * @brief If assume the ground is flat.
      */
@@ -33,9 +33,7 @@
 #include "robots/qr_robot.h"
 #include "gait/qr_openloop_gait_generator.h"
 #include "estimators/qr_moving_window_filter.hpp"
-
-/* this is a external lib, but using some variables defined in qr_filter.hpp*/
-#include "TinyEKF.h"
+#include "estimators/qr_kalman_filter.hpp"
 
 
 namespace Quadruped {
@@ -138,19 +136,9 @@ private:
     Vec3<float> estimatedAngularVelocity;
 
     /**
-     * @brief Moving window filter in x-axis for the kalman filter.
-     */
-    qrMovingWindowFilter<double, 1> velocityFilterX;
-
-    /**
-     * @brief Moving window filter in y-axis for the kalman filter.
-     */
-    qrMovingWindowFilter<double, 1> velocityFilterY;
-
-    /**
-     * @brief Moving window filter in z-axis for the kalman filter.
+     * @brief Moving window filter for the output of the kalman filter.
      */
-    qrMovingWindowFilter<double, 1> velocityFilterZ;
+    qrMovingWindowFilter<float, 3> velocityFilter;
 
     /**
      * @brief Moving window filter for liner acceleration.
@@ -159,8 +147,15 @@ private:
     
     /**
      * @brief Kalman filter for the velocity estimation.
+     * The state is the base velocity in world frame, and each contact leg observes it.
+     */
+    qrKalmanFilter<float, 3, 3> filter;
+
+    /**
+     * @brief Chi-square gate on the observed velocity of each contact leg, e.g. to reject a slipping foot.
+     * A non-positive value accepts all the contact legs.
      */
-    TinyEKF<3,3> *filter;
+    float gateThreshold;
 
 };
 
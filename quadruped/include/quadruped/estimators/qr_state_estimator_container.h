@@ -25,14 +25,40 @@
 #ifndef QR_STATE_ESTIMATOR_CONTAINER_H
 #define QR_STATE_ESTIMATOR_CONTAINER_H
 
+#include <chrono>
+
 #include "estimators/qr_anomaly_detection.h"
 #include "estimators/qr_base_state_estimator.h"
 #include "estimators/qr_ground_surface_estimator.h"
 #include "estimators/qr_robot_estimator.h"
+#include "estimators/qr_momentum_observer.h"
+#include "utils/qr_running_stats.h"
 
 
 namespace Quadruped {
 
+/**
+ * @brief Rate and cost of an estimator in qrStateEstimatorContainer.
+ */
+struct qrEstimatorStats {
+
+    /**
+     * @brief Name of the estimator, also the key of its rate in taskRates of user_parameters.yaml.
+     */
+    std::string name;
+
+    /**
+     * @brief Period and offset of the estimator in ticks of the container.
+     */
+    qrTaskRate rate;
+
+    /**
+     * @brief Time of each update since the last report (unit: s).
+     */
+    qrRunningStats cost;
+
+};
+
 /**
 * @brief Main State Estimator Class
 *   Contains all GenericEstimators, and can run them
@@ -62,24 +88,71 @@ public:
      * @brief reset all contained GenericEstimators
      */
     void Reset() {
+        if (source) {
+            source->Reset();
+        }
         resetTime = 0;
         timeSinceReset = 0.;
-        groundEstimator->Reset(timeSinceReset);
-        contactDetection->Reset(timeSinceReset);
-        robotEstimator->Reset(timeSinceReset);
+        tick = 0;
+        for (auto estimator : _estimators) {
+            estimator->Reset(timeSinceReset);
+        }
         std::cout << "StateEstimatorContainer Reset" << std::endl;
     };
     
     /**
-     * @brief update all contained GenericEstimators
+     * @brief update the contained GenericEstimators which are due in this tick,
+     * the others hold their last estimates.
      */
     void Update() {
         timeSinceReset = quadruped->GetTimeSinceReset() - resetTime;
-        // contactDetection->Update(timeSinceReset);
-        groundEstimator->Update(timeSinceReset);
-        robotEstimator->Update(timeSinceReset);
+        for (size_t i = 0; i < _estimators.size(); ++i) {
+            qrEstimatorStats &stats = _estimatorStats[i];
+            if (!stats.rate.IsDue(tick)) {
+                continue;
+            }
+            auto start = std::chrono::steady_clock::now();
+            _estimators[i]->Update(timeSinceReset);
+            stats.cost.Update(std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count());
+        }
+        ++tick;
+        ++reportTicks;
     };
+
+    /**
+     * @brief Add an estimator to be updated by the container, in the order of adding.
+     * @param name: name of the estimator, the key of its rate in taskRates.
+     * @param estimator: the estimator.
+     * @param defaultRate: rate used if the estimator is not configured in user_parameters.yaml.
+     */
+    void AddEstimator(const std::string &name, qrBaseStateEstimator *estimator, qrTaskRate defaultRate = qrTaskRate());
+
+    /**
+     * @brief Print the rate and the cost of each estimator since the last report, then restart the report.
+     */
+    void PrintCostReport();
     
+    /**
+     * @brief Make this container a copy of the one updated by the estimation stage of the pipelined runner.
+     * Its estimators are never updated, but receive the results of the source by CopyEstimatesFrom(),
+     * and resetting this container also resets the source.
+     * @param sourceIn: the container updated by the estimation stage.
+     */
+    void SetSource(qrStateEstimatorContainer *sourceIn) {
+        source = sourceIn;
+    };
+
+    /**
+     * @brief Copy the estimation results of the source container.
+     */
+    void CopyEstimatesFrom(const qrStateEstimatorContainer &other) {
+        resetTime = other.resetTime;
+        timeSinceReset = other.timeSinceReset;
+        groundEstimator->CopyEstimates(*other.groundEstimator);
+        robotEstimator->CopyEstimates(*other.robotEstimator);
+        momentumObserver->CopyEstimates(*other.momentumObserver);
+    };
+
     /**
      * @brief remove all contained GenericEstimators
      */
@@ -88,6 +161,7 @@ public:
             delete estimator;
         }
         _estimators.clear();
+        _estimatorStats.clear();
     };
 
     /**
@@ -116,6 +190,13 @@ public:
         return groundEstimator;
     };
 
+    /**
+     * @brief get the generalized momentum observer of the external forces
+     */
+    inline qrMomentumObserver* GetMomentumObserver() {
+        return momentumObserver;
+    };
+
 private:
 
     /**
@@ -138,6 +219,21 @@ private:
      */
     std::vector<qrBaseStateEstimator*> _estimators;
 
+    /**
+     * @brief rate and cost of each of _estimators
+     */
+    std::vector<qrEstimatorStats> _estimatorStats;
+
+    /**
+     * @brief number of updates since the last reset
+     */
+    unsigned long tick = 0;
+
+    /**
+     * @brief number of updates since the last cost report
+     */
+    unsigned long reportTicks = 0;
+
     /**
      * @brief estimate the 3D plane where the feet contact
      */
@@ -153,6 +249,11 @@ private:
      */
     qrRobotEstimator *robotEstimator;
 
+    /**
+     * @brief generalized momentum observer of the external forces
+     */
+    qrMomentumObserver *momentumObserver;
+
     /**
      * @brief the time when the timer restarted
      */
@@ -163,6 +264,11 @@ private:
      */
     float timeSinceReset;
 
+    /**
+     * @brief The container whose results are copied into this one, nullptr if this container is updated itself.
+     */
+    qrStateEstimatorContainer *source = nullptr;
+
 };
 
 } // namespace Quadruped
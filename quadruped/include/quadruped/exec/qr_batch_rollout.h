@@ -0,0 +1,232 @@
+// The MIT License
+
+// Copyright (c) 2022
+// Robot Motion and Vision Laboratory at East China Normal University
+// Contact: tophill.robotics@gmail.com
+
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#ifndef QR_BATCH_ROLLOUT_H
+#define QR_BATCH_ROLLOUT_H
+
+#include <string>
+#include <vector>
+#include <yaml-cpp/yaml.h>
+
+
+namespace Quadruped {
+
+/**
+ * @brief One configuration value overridden in a rollout.
+ */
+struct qrRolloutParameter {
+
+    /**
+     * @brief Config file relative to the config directory, e.g. "a1_sim/main.yaml".
+     */
+    std::string file;
+
+    /**
+     * @brief Path of the key in the file, separated by '/', e.g. "const_twist/linear".
+     */
+    std::string key;
+
+    /**
+     * @brief The value written to the key.
+     */
+    YAML::Node value;
+};
+
+/**
+ * @brief The parameter set and the length of one rollout.
+ */
+struct qrRolloutSpec {
+
+    /**
+     * @brief Name of the rollout, also used for its config directory.
+     */
+    std::string name;
+
+    /**
+     * @brief Overrides applied on top of the base configuration.
+     */
+    std::vector<qrRolloutParameter> parameters;
+
+    /**
+     * @brief Simulated time of the locomotion, after the robot has stood up, in seconds.
+     */
+    float duration = 10.f;
+};
+
+/**
+ * @brief Result of one rollout.
+ */
+struct qrRolloutMetrics {
+
+    /**
+     * @brief Print the metrics in one line.
+     */
+    void Print() const;
+
+    /**
+     * @brief Name of the rollout.
+     */
+    std::string name;
+
+    /**
+     * @brief Whether the robot fell, the rollout stops at the fall.
+     */
+    bool fell = false;
+
+    /**
+     * @brief Simulated locomotion time at the fall.
+     */
+    float fallTime = 0.f;
+
+    /**
+     * @brief Simulated locomotion time that was run.
+     */
+    float duration = 0.f;
+
+    /**
+     * @brief Number of control ticks that were run.
+     */
+    unsigned int ticks = 0;
+
+    /**
+     * @brief RMS error between the desired and the true base velocity in base frame.
+     */
+    float linearVelocityRmse = 0.f;
+
+    /**
+     * @brief RMS error between the desired and the true yaw rate.
+     */
+    float yawRateRmse = 0.f;
+
+    /**
+     * @brief Mechanical energy of the motors, the integral of |torque * joint velocity|, in J.
+     */
+    float energy = 0.f;
+
+    /**
+     * @brief Average wall time of the controller update in one tick, in seconds.
+     */
+    double meanTickLatency = 0.;
+
+    /**
+     * @brief 99th percentile of the wall time of the controller update in one tick, in seconds.
+     */
+    double p99TickLatency = 0.;
+
+    /**
+     * @brief Worst wall time of the controller update in one tick, in seconds.
+     */
+    double maxTickLatency = 0.;
+
+    /**
+     * @brief Why the rollout could not run, empty on success.
+     */
+    std::string error;
+};
+
+/**
+ * @brief Runs many independent control stacks, each on a headless simulated robot, in parallel.
+ * Every rollout owns its robot, estimators, gait generator and FSM, and reads its own copy of
+ * the configuration with the overrides of its spec applied. The rollouts run in lock-step
+ * simulated time, so the results do not depend on the load of the machine.
+ * The only state of a solver shared by the whole process is the message handler of qpOASES,
+ * which the vendored qpOASES keeps per thread for this reason.
+ */
+class qrBatchRollout {
+
+public:
+
+    /**
+     * @brief Constructor of class qrBatchRollout.
+     * @param homeDir: directory holding the base config directory.
+     * @param robotName: name of the robot config directory, e.g. "a1_sim".
+     * The rollouts have no command input, so they follow the constant twist of main.yaml.
+     * @param workDir: directory where the per-rollout configurations are written.
+     * @param numWorkers: number of worker threads, 0 for one per core.
+     */
+    qrBatchRollout(const std::string &homeDir, const std::string &robotName,
+                   const std::string &workDir = "/tmp/qr_rollouts/", unsigned int numWorkers = 0);
+
+    /**
+     * @brief Run all rollouts and wait for them.
+     * @param specs: one entry per rollout.
+     * @return the metrics, in the order of the specs.
+     */
+    std::vector<qrRolloutMetrics> Run(const std::vector<qrRolloutSpec> &specs);
+
+    /**
+     * @brief Run one rollout on the calling thread.
+     * @param spec: the rollout to run.
+     * @param index: index of the rollout in the batch, makes its config directory unique.
+     * @return the metrics of the rollout.
+     */
+    qrRolloutMetrics RunOne(const qrRolloutSpec &spec, unsigned int index);
+
+    /**
+     * @brief Base roll or pitch beyond which the robot is considered fallen, in rad.
+     */
+    float maxTilt = 0.6f;
+
+    /**
+     * @brief Base height below which the robot is considered fallen, in m.
+     */
+    float minHeight = 0.10f;
+
+    /**
+     * @brief Copy the base configuration to the rollout directory and apply the overrides.
+     * The copy is set up for a single thread in simulated time, without realtime setup or periodic prints,
+     * unless the overrides say otherwise.
+     * @param homeDir: directory holding the base config directory, ends with '/'.
+     * @param parameters: the overrides.
+     * @param rolloutDir: the home directory of the rollout, ends with '/'.
+     */
+    static void PrepareConfig(const std::string &homeDir, const std::vector<qrRolloutParameter> &parameters,
+                              const std::string &rolloutDir);
+
+private:
+
+    /**
+     * @brief Directory holding the base config directory, ends with '/'.
+     */
+    std::string homeDir;
+
+    /**
+     * @brief Name of the robot config directory.
+     */
+    std::string robotName;
+
+    /**
+     * @brief Directory of the per-rollout configurations, ends with '/'.
+     */
+    std::string workDir;
+
+    /**
+     * @brief Number of worker threads.
+     */
+    unsigned int numWorkers;
+};
+
+} // namespace Quadruped
+
+#endif // QR_BATCH_ROLLOUT_H
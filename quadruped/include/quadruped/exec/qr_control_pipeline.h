@@ -0,0 +1,248 @@
+// The MIT License
+
+// Copyright (c) 2022
+// Robot Motion and Vision Laboratory at East China Normal University
+// Contact: tophill.robotics@gmail.com
+
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#ifndef QR_CONTROL_PIPELINE_H
+#define QR_CONTROL_PIPELINE_H
+
+#include <chrono>
+#include <thread>
+
+#include "robots/qr_robot_mirror.h"
+#include "gait/qr_gait.h"
+#include "estimators/qr_state_estimator_container.h"
+#include "exec/qr_event_count.h"
+#include "exec/qr_realtime.h"
+#include "utils/qr_running_stats.h"
+
+
+namespace Quadruped {
+
+/**
+ * @brief Accumulated timing of the control ticks, printed by qrRobotRunner.
+ * All times are sums over the ticks (unit: second), except the latency, which is kept per tick.
+ */
+struct qrTickStats {
+
+    /**
+     * @brief Clear the accumulated values.
+     */
+    void Reset();
+
+    /**
+     * @brief Print the average stage times, the achieved loop frequency
+     * and the frequency bound of the sequential and the pipelined tick.
+     */
+    void Print() const;
+
+    /**
+     * @brief Seconds elapsed since the given time point.
+     */
+    static double Since(const std::chrono::steady_clock::time_point &start) {
+        return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    };
+
+    /**
+     * @brief Number of ticks accumulated.
+     */
+    unsigned int ticks = 0;
+
+    /**
+     * @brief Number of ticks whose estimation ran on the estimation thread.
+     */
+    unsigned int overlappedTicks = 0;
+
+    /**
+     * @brief Time of the estimator updates on the calling thread.
+     */
+    double estimation = 0;
+
+    /**
+     * @brief Time of ReceiveObservation and estimator updates on the estimation thread.
+     */
+    double overlappedEstimation = 0;
+
+    /**
+     * @brief Time of the desired state command and the FSM.
+     */
+    double control = 0;
+
+    /**
+     * @brief Time of sending the command, and of receiving the observation in a sequential tick.
+     */
+    double actuation = 0;
+
+    /**
+     * @brief Time the calling thread waits for the estimation thread.
+     */
+    double wait = 0;
+
+    /**
+     * @brief Time of copying the snapshots between the stages.
+     */
+    double handoff = 0;
+
+    /**
+     * @brief Wall time between the starts of two ticks, including the sleep of the caller.
+     */
+    double period = 0;
+
+    /**
+     * @brief Wall time from the start of Update() to the end of Step() of each tick.
+     */
+    qrRunningStats latency;
+
+    /**
+     * @brief Distribution of the latency, for its tail.
+     */
+    qrQuantileSketch latencyQuantiles;
+
+};
+
+/**
+ * @brief Two-stage pipeline of qrRobotRunner.
+ * The estimation thread receives the observation of tick k+1 and updates the estimators,
+ * while the calling thread runs the FSM of tick k on a snapshot: a qrRobotMirror and a
+ * copy of the estimators. The gait generator is handed the other way, so the estimators
+ * see the leg states of the last finished control stage. The snapshots are preallocated and
+ * exchanged at the start of every tick, while the estimation thread is idle, so that no stage
+ * ever touches an object that the other stage is writing. The stages are started and joined
+ * through two event counts, so a thread that waits for the other stage spins briefly and then sleeps.
+ * Only the normal locomotion state is pipelined; other ticks run sequentially on the calling thread.
+ */
+class qrControlPipeline {
+
+public:
+
+    /**
+     * @brief Constructor of class qrControlPipeline. Starts the estimation thread.
+     * @param robotIn: robot that owns the hardware, written by the estimation stage.
+     * @param mirrorIn: snapshot of robotIn read by the control stage.
+     * @param stateEstimatorsIn: estimators updated by the estimation stage.
+     * @param controlEstimatorsIn: snapshot of stateEstimatorsIn read by the control stage.
+     * @param gaitGeneratorIn: gait generator updated by the control stage.
+     * @param estimationGaitIn: snapshot of gaitGeneratorIn read by the estimation stage.
+     * @param realtimeSetup: used to configure the estimation thread.
+     * @param cpuIn: core of the estimation thread, -1 for no pinning.
+     */
+    qrControlPipeline(qrRobot *robotIn,
+                      qrRobotMirror *mirrorIn,
+                      qrStateEstimatorContainer *stateEstimatorsIn,
+                      qrStateEstimatorContainer *controlEstimatorsIn,
+                      qrGaitGenerator *gaitGeneratorIn,
+                      qrGaitGenerator *estimationGaitIn,
+                      qrRealtimeSetup &realtimeSetup,
+                      int cpuIn);
+
+    /**
+     * @brief Stop and join the estimation thread.
+     */
+    ~qrControlPipeline();
+
+    /**
+     * @brief Exchange the snapshots, then start estimating the next tick if overlap is set.
+     * @param overlap: whether this tick can be pipelined.
+     * @param stats: where the estimation and handoff time are added.
+     */
+    void BeginTick(bool overlap, qrTickStats &stats);
+
+    /**
+     * @brief Wait for the estimation stage, then send the command.
+     * A tick that was not overlapped sends the command and receives the observation as usual.
+     * @param action: motor commands.
+     * @param motorControlMode: control mode of the commands.
+     * @param stats: where the actuation and wait time are added.
+     */
+    void EndTick(const Eigen::MatrixXf &action, MotorMode motorControlMode, qrTickStats &stats);
+
+    /**
+     * @brief Wait for the estimation stage and fall back to a sequential tick.
+     * Called by the mirror before a state of the FSM talks to the hardware directly.
+     */
+    void Drain();
+
+private:
+
+    /**
+     * @brief Loop of the estimation thread.
+     */
+    void Run();
+
+    /**
+     * @brief Block until the estimation thread has finished the requested stage.
+     */
+    void Wait();
+
+    /**
+     * @brief The estimation stage: observation and estimators.
+     */
+    void Estimate();
+
+    qrRobot *robot;
+
+    qrRobotMirror *mirror;
+
+    qrStateEstimatorContainer *stateEstimators;
+
+    qrStateEstimatorContainer *controlEstimators;
+
+    qrGaitGenerator *gaitGenerator;
+
+    qrGaitGenerator *estimationGait;
+
+    qrRealtimeSetup &realtimeSetup;
+
+    int cpu;
+
+    /**
+     * @brief Number of estimation stages requested by the calling thread, cancelled to stop the estimation thread.
+     */
+    qrEventCount requested;
+
+    /**
+     * @brief Number of estimation stages finished by the estimation thread.
+     */
+    qrEventCount finished;
+
+    /**
+     * @brief Time of the last estimation stage, published by the advance of finished.
+     */
+    double estimationTime;
+
+    /**
+     * @brief Whether an estimation stage was started in this tick.
+     */
+    bool launched;
+
+    /**
+     * @brief Whether the observation held by the robot has been estimated.
+     */
+    bool estimated;
+
+    std::thread worker;
+
+};
+
+} // Namespace Quadruped
+
+#endif // QR_CONTROL_PIPELINE_H
@@ -0,0 +1,109 @@
+// The MIT License
+
+// Copyright (c) 2022
+// Robot Motion and Vision Laboratory at East China Normal University
+// Contact: tophill.robotics@gmail.com
+
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#ifndef QR_EVENT_COUNT_H
+#define QR_EVENT_COUNT_H
+
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
+
+
+namespace Quadruped {
+
+/**
+ * @brief A counter that one thread advances and other threads wait on, to hand the stages of a tick between threads.
+ * A waiter first polls the counter a bounded number of times, which is enough when the other stage is about
+ * to finish, and then blocks on a condition variable. So a SCHED_FIFO thread that waits for long gives its
+ * core to the threads of lower priority, e.g. the logger and the telemetry, instead of spinning on it.
+ * Advance() takes the mutex only when a thread is blocked, so the hand-off stays lock-free when both sides are busy.
+ */
+class qrEventCount {
+
+public:
+
+    /**
+     * @brief Constructor of class qrEventCount. The count starts at zero.
+     * @param spinCountIn: number of polls before a waiter blocks.
+     */
+    qrEventCount(unsigned int spinCountIn = 1000);
+
+    /**
+     * @brief Current count, with acquire semantics.
+     */
+    inline unsigned long Get() const {
+        return count.load(std::memory_order_acquire);
+    };
+
+    /**
+     * @brief Increment the count with release semantics and wake the blocked waiters.
+     */
+    void Advance();
+
+    /**
+     * @brief Wait until the count differs from a value seen before, or Cancel() is called.
+     * @param seen: the count seen by the caller.
+     * @return the new count, or seen if cancelled.
+     */
+    unsigned long WaitForChange(unsigned long seen);
+
+    /**
+     * @brief Wait until the count reaches a target, or Cancel() is called.
+     * @param target: the count to wait for.
+     */
+    void WaitFor(unsigned long target);
+
+    /**
+     * @brief Release all the current and future waiters, used to stop a worker thread.
+     */
+    void Cancel();
+
+private:
+
+    /**
+     * @brief Poll, then block until ready() or cancelled.
+     */
+    template<class Predicate>
+    void Wait(Predicate ready);
+
+    std::atomic<unsigned long> count;
+
+    /**
+     * @brief Number of threads blocked, or about to block, on the condition variable.
+     */
+    std::atomic<unsigned int> waiters;
+
+    std::atomic<bool> cancelled;
+
+    unsigned int spinCount;
+
+    std::mutex mutex;
+
+    std::condition_variable condition;
+
+};
+
+} // Namespace Quadruped
+
+#endif // QR_EVENT_COUNT_H
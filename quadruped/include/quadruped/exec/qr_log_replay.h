@@ -0,0 +1,155 @@
+// The MIT License
+
+// Copyright (c) 2022
+// Robot Motion and Vision Laboratory at East China Normal University
+// Contact: tophill.robotics@gmail.com
+
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#ifndef QR_LOG_REPLAY_H
+#define QR_LOG_REPLAY_H
+
+#include <string>
+#include <vector>
+#include <Eigen/Dense>
+
+#include "exec/qr_batch_rollout.h"
+#include "exec/qr_control_pipeline.h"
+
+
+namespace Quadruped {
+
+/**
+ * @brief Result of replaying a flight log.
+ */
+struct qrReplayReport {
+
+    /**
+     * @brief Print the command error and the stage timing.
+     */
+    void Print() const;
+
+    /**
+     * @brief Path of the replayed log.
+     */
+    std::string log;
+
+    /**
+     * @brief Number of records that were replayed.
+     */
+    unsigned int ticks = 0;
+
+    /**
+     * @brief Largest error of each row of the command, i.e. p, Kp, d, Kd and tau, over the motors and ticks.
+     */
+    Eigen::Matrix<float, 5, 1> maxError = Eigen::Matrix<float, 5, 1>::Zero();
+
+    /**
+     * @brief RMS error of each row of the command over the motors and ticks.
+     */
+    Eigen::Matrix<float, 5, 1> rmsError = Eigen::Matrix<float, 5, 1>::Zero();
+
+    /**
+     * @brief Largest error of the estimated base position and of the estimated base velocity in world frame,
+     * over the ticks.
+     */
+    Eigen::Matrix<float, 2, 1> maxEstimateError = Eigen::Matrix<float, 2, 1>::Zero();
+
+    /**
+     * @brief Number of ticks whose command differs from the recording by more than the tolerance.
+     */
+    unsigned int divergentTicks = 0;
+
+    /**
+     * @brief Recorded tick of the first divergent command, meaningless if divergentTicks is zero.
+     */
+    uint32_t firstDivergentTick = 0;
+
+    /**
+     * @brief Stage timing of the replayed ticks.
+     */
+    qrTickStats stages;
+
+    /**
+     * @brief Wall time of the replay, in seconds.
+     */
+    double wallTime = 0.;
+
+    /**
+     * @brief Why the replay could not run, empty on success.
+     */
+    std::string error;
+};
+
+/**
+ * @brief Re-runs the full control stack on the robot inputs of a flight log, as fast as possible,
+ * and compares the motor commands and the estimated state it produces with the recorded ones.
+ * The virtual clock follows the recorded intervals between the ticks. The FSM mode and the filtered
+ * operator command of each record are fed to the stack as the hard coded command, so the replay needs
+ * neither ROS nor a remote controller. The stack is built and stood up on the first record, so the
+ * states set up before the log starts, e.g. the estimator filters, may make the commands differ slightly
+ * even for a log recorded by the same build.
+ */
+class qrLogReplay {
+
+public:
+
+    /**
+     * @brief Constructor of class qrLogReplay.
+     * @param homeDir: directory holding the config directory of the recording.
+     * @param robotName: name of the robot config directory, e.g. "a1_sim".
+     * @param workDir: directory where the configuration of the replay is written.
+     */
+    qrLogReplay(const std::string &homeDir, const std::string &robotName,
+                const std::string &workDir = "/tmp/qr_replay/");
+
+    /**
+     * @brief Replay a log.
+     * @param logPath: the flight log.
+     * @param parameters: overrides applied on top of the configuration, e.g. to try a controller change.
+     * @return the comparison with the recording and the timing.
+     */
+    qrReplayReport Run(const std::string &logPath, const std::vector<qrRolloutParameter> &parameters = {});
+
+    /**
+     * @brief Largest difference of a command value from the recording that is not counted as divergent.
+     */
+    float tolerance = 5e-2f;
+
+private:
+
+    /**
+     * @brief Directory holding the config directory, ends with '/'.
+     */
+    std::string homeDir;
+
+    /**
+     * @brief Name of the robot config directory.
+     */
+    std::string robotName;
+
+    /**
+     * @brief Directory of the replay configuration, ends with '/'.
+     */
+    std::string workDir;
+};
+
+} // namespace Quadruped
+
+#endif // QR_LOG_REPLAY_H
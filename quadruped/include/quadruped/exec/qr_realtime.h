@@ -0,0 +1,177 @@
+// The MIT License
+
+// Copyright (c) 2022
+// Robot Motion and Vision Laboratory at East China Normal University
+// Contact: tophill.robotics@gmail.com
+
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#ifndef QR_REALTIME_H
+#define QR_REALTIME_H
+
+#include <string>
+#include <vector>
+
+#include "controllers/qr_state_dataflow.h"
+
+
+namespace Quadruped {
+
+/**
+ * @brief What qrRealtimeSetup has actually applied to the process.
+ * Every item may fail independently, e.g. without CAP_SYS_NICE or CAP_IPC_LOCK.
+ */
+struct qrRealtimeReport {
+
+    /**
+     * @brief Whether helper threads are restricted to the helper cores.
+     */
+    bool helperIsolated = false;
+
+    /**
+     * @brief Whether the control thread runs under SCHED_FIFO.
+     */
+    bool schedulerApplied = false;
+
+    /**
+     * @brief Whether the control thread is pinned to the control core.
+     */
+    bool affinityApplied = false;
+
+    /**
+     * @brief Whether mlockall succeeded.
+     */
+    bool memoryLocked = false;
+
+    /**
+     * @brief Stack actually prefaulted (unit: byte).
+     */
+    size_t stackPrefaulted = 0;
+
+    /**
+     * @brief Heap actually prefaulted (unit: byte).
+     */
+    size_t heapPrefaulted = 0;
+
+    /**
+     * @brief Reasons of the failed items.
+     */
+    std::vector<std::string> warnings;
+
+};
+
+/**
+ * @brief Opt-in real-time bootstrap of the controller process.
+ * Usage: call IsolateHelperThreads() in main before ros::init and before creating the robot,
+ * so that the ROS spinner and SDK I/O threads inherit the helper cpu mask.
+ * Then call SetupControlThread() from the thread that runs the control loop,
+ * which is done by qrRobotRunner when useRealtime is set.
+ * Each step degrades gracefully and is recorded in the report.
+ */
+class qrRealtimeSetup {
+
+public:
+
+    /**
+     * @brief Constructor of class qrRealtimeSetup.
+     * @param userParameters: real-time configs loaded from user_parameters.yaml.
+     */
+    qrRealtimeSetup(const qrUserParameters &userParameters);
+
+    /**
+     * @brief Restrict the calling thread to the helper cores.
+     * Threads created afterwards by this thread inherit the mask.
+     * @return true if the mask is applied.
+     */
+    bool IsolateHelperThreads();
+
+    /**
+     * @brief Lock memory, prefault stack and heap,
+     * set SCHED_FIFO priority and pin the calling thread to the control core.
+     * @return report of what was applied.
+     */
+    const qrRealtimeReport &SetupControlThread();
+
+    /**
+     * @brief Pin the calling thread to the given core and give it the control priority,
+     * for threads that run part of the control tick.
+     * @param cpu: the core to pin to, -1 for no pinning.
+     * @param name: thread name used in the warnings.
+     * @return true if everything requested is applied.
+     */
+    bool SetupWorkerThread(int cpu, const std::string &name);
+
+    /**
+     * @brief Print what was applied and what was skipped.
+     */
+    void PrintReport() const;
+
+    /**
+     * @brief Getter method of member report.
+     */
+    inline const qrRealtimeReport &GetReport() const {
+        return report;
+    };
+
+    /**
+     * @brief Whether the real-time mode is enabled in config.
+     */
+    inline bool IsEnabled() const {
+        return enable;
+    };
+
+private:
+
+    /**
+     * @brief Lock all current and future pages, and keep freed heap inside the process.
+     */
+    void LockMemory();
+
+    /**
+     * @brief Touch the stack of the calling thread page by page.
+     */
+    void PrefaultStack();
+
+    /**
+     * @brief Touch a heap block page by page, then return it to malloc.
+     * Since trim and mmap are disabled, the pages stay mapped for later allocations.
+     */
+    void PrefaultHeap();
+
+    bool enable;
+
+    int priority;
+
+    int controlCpu;
+
+    std::vector<int> helperCpus;
+
+    bool lockMemory;
+
+    size_t stackSize;
+
+    size_t heapSize;
+
+    qrRealtimeReport report;
+
+};
+
+} // Namespace Quadruped
+
+#endif // QR_REALTIME_H
@@ -25,16 +25,14 @@
 #ifndef QR_ROBOT_RUNNER_H
 #define QR_ROBOT_RUNNER_H
 
+#include <chrono>
 #include <iostream>
 #include <typeinfo>
 #include <yaml-cpp/yaml.h>
 
 #include "robots/qr_robot_a1.h"
 #include "robots/qr_robot_go1.h"
-#include "robots/qr_robot_a1_sim.h"
-#include "robots/qr_robot_lite2_sim.h"
 #include "robots/qr_robot_lite2.h"
-#include "robots/qr_robot_sim.h"
 
 #include "estimators/qr_state_estimator_container.h"
 #include "controllers/qr_locomotion_controller.h"
@@ -42,13 +40,23 @@
 #include "planner/qr_pose_planner.h"
 #include "planner/qr_foothold_planner.h"
 #include "action/qr_action.h"
-#include "ros/qr_cmd_vel_receiver.h"
-#include "ros/qr_switch_mode_receiver.h"
+#include "controllers/qr_command_input.h"
 #include "utils/qr_tools.h"
 #include "utils/physics_transform.h"
 #include "fsm/qr_control_fsm.hpp"
+#include "exec/qr_realtime.h"
+#include "exec/qr_control_pipeline.h"
+#include "exec/qr_task_scheduler.h"
+#include "robots/qr_robot_mirror.h"
+#include "utils/qr_alloc_tracker.h"
+#include "utils/qr_flight_recorder.h"
+#include "utils/qr_telemetry_publisher.h"
 
 
+namespace ros {
+class NodeHandle;
+}
+
 using namespace Quadruped;
 
 /**
@@ -72,6 +80,20 @@ class qrRobotRunner {
 
 public:
 
+    /**
+     * @brief Constructor of class qrRobotRunner, which builds the control stack and stands the robot up.
+     * @param quadruped: the robot.
+     * @param homeDir: directory holding the config directory, ends with '/'.
+     * @param commandInput: source of the operator commands, owned by the runner, or nullptr to follow
+     * the constant twist of main.yaml.
+     */
+    qrRobotRunner(qrRobot* quadruped, std::string& homeDir, qrCommandInput* commandInput = nullptr);
+
+    /**
+     * @brief Constructor of class qrRobotRunner, with the gamepad read from the ROS joy node.
+     * Defined by the ROS adapter library.
+     * @param nh: ROS node handle, used to subscribe the joy node.
+     */
     qrRobotRunner(qrRobot* quadruped, std::string& homeDir, ros::NodeHandle& nh);
 
     bool Update();
@@ -95,18 +117,134 @@ public:
     inline qrGaitGenerator* GetGaitGenerator() {
       return gaitGenerator;
     }
+
+    inline qrRealtimeSetup& GetRealtimeSetup() {
+      return realtimeSetup;
+    }
+
+    /**
+     * @brief The robot that the control stack reads and commands, the mirror when pipelined.
+     * The operator state, e.g. fsmMode, is set on it, as the mirror pushes its own to the robot.
+     */
+    inline qrRobot* GetControlRobot() {
+      return controlRobot;
+    }
+
+    /**
+     * @brief Heap allocations between Update() and Step() of the last tick.
+     */
+    inline const qrAllocStats& GetAllocStats() const {
+      return allocStats;
+    }
+
+    /**
+     * @brief Stage timing accumulated since the last print.
+     */
+    inline const qrTickStats& GetTickStats() const {
+      return tickStats;
+    }
+
+    /**
+     * @brief Scheduler of the control tick. Tasks added before the first Update() join the tick.
+     */
+    inline qrTaskScheduler& GetScheduler() {
+      return scheduler;
+    }
+
+    /**
+     * @brief Getter method of the flight recorder.
+     * @return the recorder, nullptr if flightRecorderPath is empty.
+     */
+    inline qrFlightRecorder* GetFlightRecorder() {
+      return flightRecorder;
+    }
+
+    /**
+     * @brief Getter method of the telemetry sink.
+     * @return the sink, by default the LCM publisher, nullptr if telemetryUrl is empty.
+     */
+    inline qrTelemetrySink* GetTelemetrySink() {
+      return telemetry;
+    }
+
+    /**
+     * @brief Stream the telemetry to another sink, e.g. the transport of an embedding executive.
+     * @param sink: the sink, owned by the runner, nullptr to stop the telemetry.
+     */
+    void SetTelemetrySink(qrTelemetrySink* sink);
 private:
 
+    /**
+     * @brief Register a stage of the locomotion controller to the scheduler.
+     * The stage only works in the ticks where the FSM runs the locomotion controller.
+     * @param name: name of the task, also the key of its rate in taskRates.
+     * @param func: the work of the stage.
+     * @param dependencies: names of the tasks that run before this one.
+     * @param defaultRate: rate used if the task is not configured in user_parameters.yaml.
+     */
+    void AddLocomotionStage(const std::string &name,
+                            std::function<void()> func,
+                            const std::vector<std::string> &dependencies,
+                            qrTaskRate defaultRate = qrTaskRate());
+
+    /**
+     * @brief Write the inputs, estimates and commands of this tick to the flight recorder.
+     */
+    void RecordTick();
+
+    /**
+     * @brief Hand the state and commands of this tick to the telemetry, if a channel publishes in this tick.
+     * @param latency: wall time of the previous tick, as this one has not been actuated yet (unit: s).
+     */
+    void PublishTelemetry(float latency);
+
     qrRobot* quadruped;
 
     qrGaitGenerator* gaitGenerator;
 
     qrUserParameters userParameters;
 
+    qrRealtimeSetup realtimeSetup;
+
+    /**
+     * @brief Snapshot of quadruped read by the control stack, nullptr unless pipelined.
+     */
+    qrRobotMirror* robotMirror;
+
+    /**
+     * @brief Robot the control stack is built on, robotMirror if pipelined, otherwise quadruped.
+     */
+    qrRobot* controlRobot;
+
     qrStateEstimatorContainer* stateEstimators;
 
+    /**
+     * @brief Estimators read by the control stack, a snapshot of stateEstimators if pipelined.
+     */
+    qrStateEstimatorContainer* controlEstimators;
+
+    /**
+     * @brief Snapshot of gaitGenerator read by stateEstimators if pipelined.
+     */
+    qrGaitGenerator* estimationGait;
+
+    /**
+     * @brief Runs the estimation of the next tick on another thread, nullptr unless pipelined.
+     */
+    qrControlPipeline* pipeline;
+
+    /**
+     * @brief Runs the tasks of the control tick at their configured rates.
+     */
+    qrTaskScheduler scheduler;
+
     qrDesiredStateCommand* desiredStateCommand;
 
+    /**
+     * @brief Source of the operator commands, nullptr if none.
+     */
+    qrCommandInput* commandInput;
+
     qrControlFSM<float>* controlFSM;
 
     float resetTime;
@@ -115,6 +253,40 @@ private:
 
     std::vector<qrMotorCommand> hybridAction;
 
+    /**
+     * @brief hybridAction as the matrix taken by qrRobot::Step, sized once in the constructor.
+     */
+    Eigen::MatrixXf hybridCommand;
+
+    qrAllocStats allocStats;
+
+    qrTickStats tickStats;
+
+    /**
+     * @brief Start of the current tick.
+     */
+    std::chrono::steady_clock::time_point tickStart;
+
+    /**
+     * @brief Start of the control stages of the current tick.
+     */
+    std::chrono::steady_clock::time_point controlStart;
+
+    /**
+     * @brief Wall time of the last actuated tick (unit: s).
+     */
+    double lastLatency = 0;
+
+    /**
+     * @brief Per-tick recorder of state and commands, nullptr if disabled.
+     */
+    qrFlightRecorder* flightRecorder;
+
+    /**
+     * @brief Sink of per-tick state and commands, by default published over LCM, nullptr if disabled.
+     */
+    qrTelemetrySink* telemetry;
+
 };
 
 #endif //QR_ROBOT_RUNNER_H
@@ -0,0 +1,191 @@
+// The MIT License
+
+// Copyright (c) 2022
+// Robot Motion and Vision Laboratory at East China Normal University
+// Contact: tophill.robotics@gmail.com
+
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#ifndef QR_TASK_SCHEDULER_H
+#define QR_TASK_SCHEDULER_H
+
+#include <functional>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "controllers/qr_state_dataflow.h"
+#include "exec/qr_event_count.h"
+#include "exec/qr_realtime.h"
+
+
+namespace Quadruped {
+
+/**
+ * @brief A component of the control tick registered to qrTaskScheduler.
+ */
+struct qrTask {
+
+    /**
+     * @brief Unique name, also the key of its rate in user_parameters.yaml.
+     */
+    std::string name;
+
+    /**
+     * @brief The work of the task.
+     */
+    std::function<void()> func;
+
+    /**
+     * @brief Names of the tasks that must finish before this one in the same tick.
+     */
+    std::vector<std::string> dependencies;
+
+    /**
+     * @brief Period and offset of the task.
+     */
+    qrTaskRate rate;
+
+    /**
+     * @brief Depth in the dependency graph. Tasks of the same level are independent.
+     */
+    int level = 0;
+
+};
+
+/**
+ * @brief Multi-rate scheduler of the control tick.
+ * Components register a task with its dependencies, and the rate is read from taskRates in user_parameters.yaml.
+ * Build() sorts the tasks into levels of a static DAG. Every tick, the due tasks of a level run in parallel,
+ * and the next level starts when the whole level has finished. Within a level, the i-th due task always
+ * runs on thread i % (threads + 1), where thread 0 is the caller, so the execution is deterministic.
+ * Idle workers and the caller waiting for a level spin briefly and then sleep on a qrEventCount.
+ * A task that is not due keeps its last outputs, which its dependents read as usual.
+ */
+class qrTaskScheduler {
+
+public:
+
+    /**
+     * @brief Constructor of class qrTaskScheduler.
+     * @param userParametersIn: provides the number of threads and the task rates.
+     * @param realtimeSetupIn: used to configure the worker threads.
+     */
+    qrTaskScheduler(const qrUserParameters &userParametersIn, qrRealtimeSetup &realtimeSetupIn);
+
+    /**
+     * @brief Stop and join the worker threads.
+     */
+    ~qrTaskScheduler();
+
+    /**
+     * @brief Register a task. Must be called before Build().
+     * @param name: unique name of the task.
+     * @param func: the work of the task.
+     * @param dependencies: names of the tasks that run before this one.
+     * @param defaultRate: rate used if the task is not configured in user_parameters.yaml.
+     */
+    void AddTask(const std::string &name,
+                 std::function<void()> func,
+                 const std::vector<std::string> &dependencies = {},
+                 qrTaskRate defaultRate = qrTaskRate());
+
+    /**
+     * @brief Sort the tasks into levels and start the worker threads.
+     * Throws std::runtime_error on an unknown dependency or a cycle.
+     */
+    void Build();
+
+    /**
+     * @brief Run the due tasks of the current tick, then advance the tick.
+     */
+    void Run();
+
+    /**
+     * @brief Whether a task runs in the current tick.
+     * @param name: name of the task.
+     */
+    bool IsDue(const std::string &name) const;
+
+    /**
+     * @brief Getter method of member tick.
+     */
+    inline unsigned long GetTick() const {
+        return tick;
+    };
+
+    /**
+     * @brief Print the levels, rates and threads of the tasks.
+     */
+    void PrintSchedule() const;
+
+private:
+
+    /**
+     * @brief Loop of a worker thread.
+     * @param threadId: index of the worker, from 1.
+     */
+    void WorkerLoop(unsigned int threadId);
+
+    /**
+     * @brief Run the due tasks of the current level assigned to a thread.
+     * @param threadId: 0 for the caller.
+     */
+    void RunShare(unsigned int threadId);
+
+    unsigned int threadNum;
+
+    const qrUserParameters &userParameters;
+
+    qrRealtimeSetup &realtimeSetup;
+
+    std::vector<qrTask> tasks;
+
+    /**
+     * @brief Task indices of each level, in registration order.
+     */
+    std::vector<std::vector<int>> levels;
+
+    /**
+     * @brief Due tasks of the level being run, preallocated by Build().
+     */
+    std::vector<int> dueTasks;
+
+    unsigned long tick;
+
+    bool built;
+
+    /**
+     * @brief Advanced by the caller to start a level on the workers, cancelled to stop them.
+     */
+    qrEventCount generation;
+
+    /**
+     * @brief Advanced by each worker that finishes a level. It is never reset,
+     * so a level has finished when it reaches threadNum times the generation.
+     */
+    qrEventCount finished;
+
+    std::vector<std::thread> workers;
+
+};
+
+} // Namespace Quadruped
+
+#endif // QR_TASK_SCHEDULER_H
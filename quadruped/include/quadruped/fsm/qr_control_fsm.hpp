@@ -72,12 +72,14 @@ public:
      * @param gaitScheduler: pointer to gait scheduler.
      * @param desiredStateCommand: pointer to desired state command.
      * @param userParameters: pointer to user parameters.
+     * @param homeDir: directory of the configuration files, empty to find it from the executable path, see GetHomeDir.
      */
     qrControlFSM(Quadruped::qrRobot *quadruped,
                  Quadruped::qrStateEstimatorContainer *stateEstimator,
                  Quadruped::qrGaitGenerator *gaitScheduler,
                  Quadruped::qrDesiredStateCommand *desiredStateCommand,
-                 qrUserParameters *userParameters);
+                 qrUserParameters *userParameters,
+                 const std::string &homeDir = "");
 
     ~qrControlFSM() = default;
 
@@ -98,10 +100,25 @@ public:
     }
 
     /**
-     * @brief Step the ControlFSM once. It will be in one state or on transition.
+     * @brief First half of a step of the ControlFSM: handle the joystick request
+     * and check whether the current state runs or transitions in this tick.
+     * The controller stages of the locomotion state run after it, see RunsLocomotionStages().
+     */
+    void BeginTick();
+
+    /**
+     * @brief Second half of a step of the ControlFSM: run the current state or its transition
+     * on the outputs of the controller stages, then check the commands.
      * @param hybridAction: A return value of the desired motor command.
      */
-    void RunFSM(std::vector<Quadruped::qrMotorCommand> &hybridAction);
+    void EndTick(std::vector<Quadruped::qrMotorCommand> &hybridAction);
+
+    /**
+     * @brief Whether the controller stages of the locomotion state run in this tick, decided by BeginTick().
+     */
+    bool RunsLocomotionStages() const {
+        return locomotionStages;
+    }
 
     /**
      * @brief Check the robot state before the calculation of commands in this control loop.
@@ -131,6 +148,21 @@ public:
         return statesList.locomotion->GetLocomotionController();
     }
 
+    /**
+     * @brief Getter method of the locomotion state.
+     */
+    qrFSMStateLocomotion<T>* GetLocomotionState() const {
+        return statesList.locomotion;
+    }
+
+    /**
+     * @brief Whether the FSM is running the normal behaviour of the locomotion state,
+     * i.e. neither transitioning nor stopped.
+     */
+    bool IsInNormalLocomotion() const {
+        return operatingMode == FSM_OperatingMode::NORMAL && currentState->stateName == FSM_StateName::LOCOMOTION;
+    }
+
     /**
      * @brief Print current FSM status
      * @param opt: the options of printing the status
@@ -144,6 +176,16 @@ private:
      */
     FSM_OperatingMode operatingMode;
 
+    /**
+     * @brief Whether the current state runs in this tick, decided by BeginTick().
+     */
+    bool runState = false;
+
+    /**
+     * @brief Whether the controller stages of the locomotion state run in this tick.
+     */
+    bool locomotionStages = false;
+
     /**
      * @brief Data needed for FSM.
      */
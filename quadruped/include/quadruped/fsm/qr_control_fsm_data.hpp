@@ -62,6 +62,11 @@ struct qrControlFSMData {
    */
   qrUserParameters* userParameters;
 
+  /**
+   * @brief Directory the configuration files are read from. Empty to use the quadruped package path.
+   */
+  std::string homeDir;
+
   /**
    * @brief The motor commands calculated in this control loop.
    */
@@ -62,6 +62,21 @@ public:
     void OnEnter();
 
     /**
+     * @brief Prepare the controller stages of this tick, which run between
+     * qrControlFSM::BeginTick and qrControlFSM::EndTick.
+     * @param transitioning: whether Transition() runs in this tick instead of Run().
+     * @return whether the controller stages run in this tick.
+     */
+    bool PrepareStages(bool transitioning);
+
+    /**
+     * @brief Solve the Whole Body Controller if it is enabled,
+     * unless the MPC has solved in this tick or the state is transitioning.
+     */
+    void SolveWBC();
+
+    /**
+     * @brief Compose the leg commands from the outputs of the controller stages.
      * @see qrFSMState::Run
      */
     virtual void Run();
@@ -113,6 +128,13 @@ private:
      * @return currently just return true.
      */
     bool StandLoop();
+
+    /**
+     * @brief Whether SwitchMode() and StandLoop() read the controller in this iteration of the transition.
+     */
+    bool UpdatesInTransition() const {
+        return iter < 1000 && iter < this->transitionDuration * 1000;
+    }
     
     /**
      * @brief Pointer to LocomotionController.
@@ -134,6 +156,16 @@ private:
      */
     unsigned long iter = 0;
 
+    /**
+     * @brief Whether the controller stages of this tick run for a transition rather than for Run().
+     */
+    bool stagesInTransition = false;
+
+    /**
+     * @brief Whether the Whole Body Controller has solved since entering the state.
+     */
+    bool wbcSolved = false;
+
 };
 
 #endif // QR_FSM_STATE_LOCOMOTION_H
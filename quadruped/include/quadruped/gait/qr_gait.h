@@ -25,6 +25,8 @@
 #ifndef QR_GAIT_GENERATOR_H
 #define QR_GAIT_GENERATOR_H
 
+#include <array>
+
 #include "robots/qr_robot.h"
 
 /**
@@ -36,6 +38,12 @@ namespace Quadruped {
 class qrGaitGenerator {
 
 public:
+
+    /**
+     * @brief Number of time slots of the contact schedule in a gait cycle.
+     */
+    static constexpr int CONTACT_SCHEDULE_SLOTS = 1000;
+
     /**
     * @brief Default constructor that constructs a qrGaitGenerator object.
     */
@@ -84,6 +92,7 @@ public:
         desiredLegState = curLegState;
         firstStanceAngles = robot->standUpMotorAngles;
         contactStartPhase.setZero();
+        BuildContactSchedule();
     };
 
     /**
@@ -98,6 +107,55 @@ public:
      */
     virtual void Schedule(float currentTime) {}
 
+    /**
+     * @brief Copy the leg states and phases of another gait generator.
+     * Used to hand the gait of the control stage to the estimators of the pipelined runner.
+     * @param other: the gait generator to copy from.
+     */
+    void CopyLegStates(const qrGaitGenerator &other)
+    {
+        timeSinceReset = other.timeSinceReset;
+        phaseInFullCycle = other.phaseInFullCycle;
+        normalizedPhase = other.normalizedPhase;
+        legState = other.legState;
+        desiredLegState = other.desiredLegState;
+        lastLegState = other.lastLegState;
+        curLegState = other.curLegState;
+        detectedLegState = other.detectedLegState;
+        trueSwingStartPhaseInSwingCycle = other.trueSwingStartPhaseInSwingCycle;
+        trueSwingStartPhaseInFullCycle = other.trueSwingStartPhaseInFullCycle;
+        trueSwingEndPhaseInFullCycle = other.trueSwingEndPhaseInFullCycle;
+        contactScheduleSlot = other.contactScheduleSlot;
+        if (!other.contactSchedulePeriodic) {
+            contactSchedule = other.contactSchedule;
+        }
+    };
+
+    /**
+     * @brief Precompute the contact schedule of a gait cycle from the gait parameters.
+     * It should be called whenever these parameters change, Reset() does it.
+     */
+    void BuildContactSchedule();
+
+    /**
+     * @brief Get the planned contacts from the current time slot on.
+     * Bit legId of the i-th element is set if the leg is planned to be in stance i slots later.
+     * @note The window is valid for CONTACT_SCHEDULE_SLOTS elements, i.e. a full gait cycle.
+     * @return pointer to the contact bitmask of the current time slot.
+     */
+    const u8 *GetContactSchedule() const {
+        return contactSchedule.data() + contactScheduleSlot;
+    };
+
+    /**
+     * @brief Number of time slots of a duration in gait cycles.
+     * @param phase: fraction of the gait cycle.
+     * @return number of slots, rounded to the nearest one.
+     */
+    static int ContactScheduleSlots(float phase) {
+        return int(phase * CONTACT_SCHEDULE_SLOTS + 0.5f);
+    };
+
     /**
      * @brief The yaml object for loading a yaml config file.
      */
@@ -297,6 +355,43 @@ public:
      * @brief target joint angles of robot for stance.
      */
     Eigen::Matrix<float,12,1> firstStanceAngles;
+
+protected:
+
+    /**
+     * @brief Locate the current time slot of the contact schedule.
+     * If the legs have different gait periods, the schedule is refilled from the given time on instead.
+     * @param time: the time the leg phases are computed from, i.e. phaseInFullCycle = initialLegPhase + time / fullCyclePeriod.
+     */
+    void UpdateContactScheduleSlot(float time);
+
+    /**
+     * @brief Fill the contact schedule with the contacts planned from a time on.
+     * @param startTime: time of the first slot.
+     * @param slots: number of slots to fill, at most 2 * CONTACT_SCHEDULE_SLOTS.
+     */
+    void FillContactSchedule(float startTime, int slots);
+
+    /**
+     * @brief Contact bitmasks of two consecutive gait cycles,
+     * so that a window of up to a full cycle never wraps around.
+     */
+    std::array<u8, 2 * CONTACT_SCHEDULE_SLOTS> contactSchedule{};
+
+    /**
+     * @brief Duration of the gait cycle the contact schedule is built on, that is the gait period of the first periodic leg.
+     */
+    float contactSchedulePeriod = 1.f;
+
+    /**
+     * @brief Whether all the periodic legs share the gait period, so that the contact schedule repeats after it.
+     */
+    bool contactSchedulePeriodic = true;
+
+    /**
+     * @brief Time slot of the contact schedule at the last Update().
+     */
+    int contactScheduleSlot = 0;
 };
 
 } // Namespace Quadruped
@@ -124,7 +124,7 @@ public:
      * @brief Compute desired foothold.
      * @param swingFootIds: the leg which is swing.
      */
-    void ComputeHeuristicFootHold(std::vector<u8> swingFootIds);
+    void ComputeHeuristicFootHold(const std::vector<u8> &swingFootIds);
 
     /**
      * @brief Compute desired foothold by MIT mehtod.
@@ -26,7 +26,6 @@
 #define QR_POSE_PLANNER_H
 
 #include <map>
-#include <set>
 
 #include "robots/qr_robot.h"
 #include "estimators/qr_state_estimator_container.h"
@@ -45,6 +44,24 @@ class qrPosePlanner {
 
 public:
 
+    EIGEN_MAKE_ALIGNED_OPERATOR_NEW
+
+    /**
+     * @brief Maximum number of contact legs of the support polygon.
+     */
+    static constexpr int MAX_CONTACTS = NumLeg;
+
+    /**
+     * @brief Vector of the constraints, N support polygon edges followed by N minimum and N maximum leg lengths,
+     * stored without heap allocation.
+     */
+    using ConstraintVec = Eigen::Matrix<float, Eigen::Dynamic, 1, 0, 3 * MAX_CONTACTS, 1>;
+
+    /**
+     * @brief Jacobian of the constraints w.r.t. the base position and orientation.
+     */
+    using ConstraintJacobian = Eigen::Matrix<float, Eigen::Dynamic, 6, 0, 3 * MAX_CONTACTS, 6>;
+
     /**
      * @brief Reset time for footStepper.
      */
@@ -145,9 +162,9 @@ public:
     int N = 4;
 
     /**
-     * @brief Valid contact point of leg's Id.
+     * @brief Leg id in counter clock order of the first N vertices of the support polygon.
      */
-    std::set<int> validContactPointId;
+    int contactPointIds[MAX_CONTACTS];
 
     /**
      * @brief Allowed minimum length of leg.
@@ -163,22 +180,59 @@ public:
      * @brief Used for gradient computation.
      * Asp 's size maybe (3,3) or (4, 3)
      */
-    Eigen::MatrixXf Asp;
+    Eigen::Matrix<float, Eigen::Dynamic, 3, 0, MAX_CONTACTS, 3> Asp;
 
     /**
      * @brief Used for gradient computation.
      */
-    Eigen::MatrixXf bsp;
+    Eigen::Matrix<float, Eigen::Dynamic, 1, 0, MAX_CONTACTS, 1> bsp;
 
     /**
      * @brief Used for QP solve.
      */
-    Eigen::MatrixXf G;
+    ConstraintVec G;
+
+    /**
+     * @brief Gradient of G.
+     */
+    ConstraintJacobian gradientG;
 
     /**
      * @brief Lagrangue factors.
      */
-    Eigen::MatrixXf Lambda;
+    ConstraintVec Lambda;
+
+    /**
+     * @brief Lagrangue factors of the last solution for each leg in counter clock order,
+     * of its support polygon edge, its minimum length and its maximum length.
+     * Used to warm start Lambda when the contact legs change.
+     */
+    Eigen::Matrix<float, 3, MAX_CONTACTS> legLambda;
+
+    /**
+     * @brief Whether rIB and quat hold a solution to warm start the next Update().
+     */
+    bool hasSolution = false;
+
+    /**
+     * @brief The last solution is not used as warm start if it is farther from the estimated base position.
+     */
+    float warmStartRadius = 0.1f;
+
+    /**
+     * @brief Maximum number of SQP iterations.
+     */
+    int maxIterations = 20;
+
+    /**
+     * @brief The SQP stops when the norm of its step is below this value.
+     */
+    float convergenceTolerance = 1e-5f;
+
+    /**
+     * @brief Number of SQP iterations of the last Update().
+     */
+    int iterations = 0;
 
     /**
      * @brief FootPosition in base frame.
@@ -201,19 +255,19 @@ public:
     bool swingK[4];
 
     /**
-     * @brief Points of the support polygon in world frame.
+     * @brief Points of the support polygon in world frame, the first N columns are used.
      */
-    std::vector<Vec3<float>> supportPolygonVertices;
+    Eigen::Matrix<float, 3, MAX_CONTACTS> supportPolygonVertices;
 
     /**
-     * @brief Projected points of the support polygon in world frame.
+     * @brief Projected points of the support polygon in world frame, the first N columns are used.
      */
-    std::vector<Vec3<float>> projectedSupportPolygonVertices;
+    Eigen::Matrix<float, 3, MAX_CONTACTS> projectedSupportPolygonVertices;
 
     /**
-     * @brief Length of array from foot tip to base.
+     * @brief Length of array from foot tip to base, the first N columns are used.
      */
-    std::vector<Vec3<float>> g;
+    Eigen::Matrix<float, 3, MAX_CONTACTS> g;
 
     /**
      * @brief Used for support polygon computation.
@@ -315,6 +369,7 @@ public:
         pose << robot->GetBasePosition(), robot->GetBaseRollPitchYaw(); // poseDest;
         poseDest << footPoseWorld.row(0).mean(), footPoseWorld.row(1).mean(), bodyHight, 0, 0, 0;
         twist << 0,0,0,0,0,0;
+        hasSolution = false;
         std::cout <<"resetTime = "<<resetTime <<  ", reset poseDest = " << poseDest.transpose() << std::endl;
         segment.Reset(pose, poseDest);
     };
@@ -387,19 +442,19 @@ public:
      * @brief Compute Gradient of G for QP.
      * @return Gradient of G.
      */
-    Eigen::MatrixXf ComputeGradientG();
+    const ConstraintJacobian &ComputeGradientG();
 
     /**
-     * @brief Compute Hessian of G for QP.
-     * @return Hessian of G.
+     * @brief Compute the sum of the Hessians of G weighted by Lambda for QP.
+     * @return Weighted sum of the Hessians of G.
      */
-    std::vector<Mat6<float>> ComputeHessianG();
-    
+    Mat6<float> ComputeHessianGSum();
+
     /**
      * @brief Compute G.
      * @return G.
      */
-    Eigen::MatrixXf ComputeG();
+    const ConstraintVec &ComputeG();
 
     /**
      * @brief Compute F.
@@ -421,13 +476,13 @@ public:
      * @param gradientF.
      * @param gradientG.
      * @param GValue.
-     * @return desired pose and Lagrange factor.
+     * @return step of the desired pose, the Lagrange factors are written into Lambda.
      */
-    std::tuple<Vec6<float>,Eigen::MatrixXf> QpSolver(Mat6<float>& hessF,
-                                                     Mat6<float>& hessGSum,
-                                                     Vec6<float>& gradientF,
-                                                     Eigen::MatrixXf& gradientG,
-                                                     Eigen::MatrixXf& GValue);
+    Vec6<float> QpSolver(const Mat6<float>& hessF,
+                         const Mat6<float>& hessGSum,
+                         const Vec6<float>& gradientF,
+                         const ConstraintJacobian& gradientG,
+                         const ConstraintVec& GValue);
 
     /**
      * @brief Permutate matrix cols in counter clock order.
@@ -57,6 +57,13 @@ public:
      */
     qrRobot();
 
+    /**
+     * @brief Constructor of class qrRobot.
+     * @param timeSource: the time source of the robot timer, e.g. qrTimeSource::MANUAL_TIME
+     * for a simulated robot that advances the time by itself.
+     */
+    qrRobot(qrTimeSource timeSource);
+
     /**
      * @brief Constructor of class qrRobot.
      * @param robot_name: type of the robot.
@@ -204,7 +211,7 @@ public:
      * @param contact_force: contact force of the leg.
      * @return joint torques, totally 3 joints.
      */
-    std::map<int, float> MapContactForceToJointTorques(int leg_id, Vec3<float> contact_force);
+    Vec3<float> MapContactForceToJointTorques(int leg_id, Vec3<float> contact_force);
 
     /**
      * @brief Convert vector to signed vectors according to different legs.
@@ -229,6 +236,14 @@ public:
         return false;
     };
 
+    /**
+     * @brief Evaluate the contact Jacobians, mass matrix, gravity and coriolis terms of the dynamic model
+     * at the current state of the robot. The evaluation is skipped if the state is the one of the last evaluation,
+     * so that the estimators and the whole body controller share one evaluation per tick.
+     * @return true if the model is evaluated by this call.
+     */
+    bool UpdateDynamicsModel();
+
     /**
      * @brief Get foot position in base frame of robot.
      * @return foot position in base frame.
@@ -357,6 +372,26 @@ public:
         return timer.GetTimeSinceReset();
     };
 
+    /**
+     * @brief Advance the manual time of the robot, and the tick with it in milliseconds,
+     * so that the estimators compute their time step from the simulated time.
+     * Does nothing if the timer does not use the manual time.
+     * @param dt: duration in seconds.
+     */
+    void AdvanceTime(float dt);
+
+    /**
+     * @brief Busy wait until the time since reset reaches the required time.
+     * Returns at once for the manual time, since nobody else would advance it.
+     * @param time: time since reset to wait for.
+     */
+    void WaitUntil(float time) {
+        if (timer.IsManualTime()) {
+            return;
+        }
+        while (GetTimeSinceReset() < time) {}
+    };
+
     /**
      * @brief File path to robot config file。
      */
@@ -631,6 +666,16 @@ public:
      */
     FloatingBaseModel<float> model;
 
+    /**
+     * @brief The state at which the dynamic model was last evaluated by UpdateDynamicsModel().
+     */
+    FBModelState<float> modelState;
+
+    /**
+     * @brief Whether the dynamic model has been evaluated at modelState.
+     */
+    bool modelEvaluated = false;
+
     /**
      * @brief Low-level state including imu data encoder data.
      */
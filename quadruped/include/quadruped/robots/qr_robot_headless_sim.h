@@ -0,0 +1,217 @@
+// The MIT License
+
+// Copyright (c) 2022
+// Robot Motion and Vision Laboratory at East China Normal University
+// Contact: tophill.robotics@gmail.com
+
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#ifndef QR_ROBOT_HEADLESS_SIM_H
+#define QR_ROBOT_HEADLESS_SIM_H
+
+#include "robots/qr_robot.h"
+
+
+namespace Quadruped {
+
+/**
+ * @brief A simulated robot whose physics runs in-process, without gazebo or ROS.
+ * The rigid body dynamics is the articulated body algorithm of FloatingBaseModel,
+ * the ground is the plane z = 0 modeled by spring-damper contacts with Coulomb friction.
+ * Each ApplyAction advances the simulation and the manual time of the robot timer by timeStep,
+ * so the controller and the physics run in lock-step and as fast as the CPU allows.
+ */
+class qrRobotHeadlessSim: public qrRobot {
+
+public:
+
+    /**
+     * @brief Constructor of class qrRobotHeadlessSim.
+     * The robot parameters are read from the same config file as the gazebo robots,
+     * the optional node "sim_params" sets the parameters of the simulation.
+     * @param configFilePath: config file path.
+     */
+    qrRobotHeadlessSim(std::string configFilePath);
+
+    ~qrRobotHeadlessSim() = default;
+
+    /**
+     * @see qrRobot::ReceiveObservation
+     */
+    void ReceiveObservation() override;
+
+    /**
+     * @see qrRobot::ApplyAction
+     */
+    void ApplyAction(const Eigen::MatrixXf &motorCommands, MotorMode motorControlMode) override;
+
+    /**
+     * @see qrRobot::ApplyAction
+     */
+    void ApplyAction(const std::vector<qrMotorCommand> &motorCommands, MotorMode motorControlMode) override;
+
+    /**
+     * @see qrRobot::Step
+     */
+    void Step(const Eigen::MatrixXf &action, MotorMode motorControlMode) override;
+
+    /**
+     * @see qrRobot::Step
+     */
+    void Step(const std::vector<qrMotorCommand> &motorCommands, MotorMode motorControlMode) override;
+
+    /**
+     * @see qrRobot::BuildDynamicModel
+     */
+    virtual bool BuildDynamicModel() override;
+
+    /**
+     * @brief Put the robot back to its initial state, lying on the ground with the legs folded
+     * at the sit down angles, and reset the simulation time.
+     */
+    void ResetSimulation();
+
+    /**
+     * @brief Advance the physics and the robot time by a duration with the current motor command.
+     * @param duration: simulated time to advance, in seconds.
+     */
+    void Simulate(float duration);
+
+    /**
+     * @brief Getter method of the simulated time.
+     * @return time since ResetSimulation in seconds.
+     */
+    double GetSimulationTime() const {
+        return simTime;
+    };
+
+    /**
+     * @brief Getter method of the state of the simulated robot.
+     */
+    const FBModelState<float>& GetSimulationState() const {
+        return simState;
+    };
+
+private:
+
+    /**
+     * @brief Add the bodies and the contact points of the robot to a floating base model.
+     * The controller model and the physics model are built by the same function.
+     * @param fbModel: the model to build.
+     */
+    void BuildFloatingBaseModel(FloatingBaseModel<float> &fbModel);
+
+    /**
+     * @brief Compute the ground reaction forces at the contact points
+     * and apply them to the bodies of the physics model as external forces.
+     * The kinematics of the model should be up to date.
+     */
+    void ComputeGroundForces();
+
+    /**
+     * @brief Compute the motor torques from the current hybrid command and the joint states,
+     * limited by the maximum torque.
+     */
+    void ComputeMotorTorques();
+
+    /**
+     * @brief Integrate the physics model once by semi-implicit Euler.
+     * @param dt: time step of integration.
+     */
+    void Integrate(float dt);
+
+    /**
+     * @brief The model used by the physics, independent from the controller model.
+     */
+    FloatingBaseModel<float> simModel;
+
+    /**
+     * @brief The state of the simulated robot.
+     */
+    FBModelState<float> simState;
+
+    /**
+     * @brief The derivative of the state from the last integration.
+     */
+    FBModelStateDerivative<float> simStateDerivative;
+
+    /**
+     * @brief Current hybrid command, each column is (p, Kp, d, Kd, tau) of one motor.
+     */
+    Eigen::Matrix<float, 5, NumMotor> motorCommand;
+
+    /**
+     * @brief Torques applied on the joints in the last integration.
+     */
+    DVec<float> jointTorques;
+
+    /**
+     * @brief Ground reaction force at each contact point in world frame.
+     */
+    std::vector<Vec3<float>> contactForces;
+
+    /**
+     * @brief Anchor of the tangential spring of each contact point, set at touchdown.
+     */
+    std::vector<Vec3<float>> contactAnchors;
+
+    /**
+     * @brief Whether each contact point is below the ground.
+     */
+    std::vector<bool> contactActive;
+
+    /**
+     * @brief Time step of the physics integration.
+     */
+    float simTimeStep = 0.0005f;
+
+    /**
+     * @brief Stiffness and damping of the ground along the normal.
+     */
+    float groundK = 2e4f;
+
+    float groundD = 5e2f;
+
+    /**
+     * @brief Stiffness and damping of the ground along the tangent.
+     */
+    float groundKt = 1e4f;
+
+    float groundDt = 2e2f;
+
+    /**
+     * @brief Coefficient of friction of the ground.
+     */
+    float groundMu = 0.7f;
+
+    /**
+     * @brief Maximum torque of the motors.
+     */
+    float maxTorque = 33.5f;
+
+    /**
+     * @brief Time since ResetSimulation.
+     */
+    double simTime = 0.0;
+
+};
+
+} // namespace Quadruped
+
+#endif // QR_ROBOT_HEADLESS_SIM_H
@@ -80,10 +80,20 @@ public:
     SendToRobot lite2Sender;
 
     /**
-     * @brief Lite2 robot state.
+     * @brief Lite2 robot state, a consistent copy of the latest received packet.
      */
     RobotState lowState_lite2;
 
+    /**
+     * @brief Sequence number of the packet in lowState_lite2.
+     */
+    uint64_t stateSeq = 0;
+
+    /**
+     * @brief Number of observations that found no new packet since the last one.
+     */
+    uint64_t staleStateCount = 0;
+
 };
 
 } // namespace Quadruped
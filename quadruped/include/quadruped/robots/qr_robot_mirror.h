@@ -0,0 +1,127 @@
+// The MIT License
+
+// Copyright (c) 2022
+// Robot Motion and Vision Laboratory at East China Normal University
+// Contact: tophill.robotics@gmail.com
+
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#ifndef QR_ROBOT_MIRROR_H
+#define QR_ROBOT_MIRROR_H
+
+#include <functional>
+
+#include "robots/qr_robot.h"
+
+
+namespace Quadruped {
+
+/**
+ * @brief Snapshot of another robot, used by the control stage of the pipelined runner.
+ * The source robot keeps receiving observations and being estimated on the estimation thread,
+ * while the controllers read this copy, which is refreshed once per tick by Pull().
+ * Outputs that the control stack writes into the robot are copied back by Push().
+ * Calls that need the hardware are forwarded to the source after draining the pipeline.
+ */
+class qrRobotMirror: public qrRobot {
+
+public:
+
+    /**
+     * @brief Constructor of class qrRobotMirror.
+     * Model parameters are copied once from the source.
+     * @param sourceIn: the robot that owns the hardware interface.
+     */
+    qrRobotMirror(qrRobot *sourceIn);
+
+    ~qrRobotMirror() = default;
+
+    /**
+     * @brief Copy observation and estimation results from the source robot.
+     * Must be called while nobody is writing the source.
+     */
+    void Pull();
+
+    /**
+     * @brief Copy the fields written by the control stack back to the source robot.
+     * Must be called while nobody is reading the source.
+     */
+    void Push();
+
+    /**
+     * @brief Set the function to call before forwarding a hardware call to the source.
+     * @param hook: usually drains the estimation stage.
+     */
+    void SetSyncHook(std::function<void()> hook) {
+        syncHook = hook;
+    };
+
+    /**
+     * @brief Getter method of member source.
+     */
+    inline qrRobot *GetSource() {
+        return source;
+    };
+
+    void Reset() override;
+
+    /**
+     * @brief Build the dynamic model of the source robot, unless it is built already, and copy it.
+     * The model copied in the constructor is empty, as the source builds its model on demand.
+     * @return true if the source has a model.
+     */
+    bool BuildDynamicModel() override;
+
+    void ReceiveObservation() override;
+
+    void ApplyAction(const Eigen::MatrixXf &motorCommands, MotorMode motorControlMode) override;
+
+    void ApplyAction(const std::vector<qrMotorCommand> &motorCommands, MotorMode motorControlMode) override;
+
+    void Step(const Eigen::MatrixXf &action, MotorMode motorControlMode) override;
+
+    void Step(const std::vector<qrMotorCommand> &motorCommands, MotorMode motorControlMode) override;
+
+private:
+
+    /**
+     * @brief Copy the parameters loaded from the robot config.
+     */
+    void CopyParameters();
+
+    /**
+     * @brief Drain the pipeline and push the control outputs before touching the source.
+     */
+    void Sync();
+
+    /**
+     * @brief The robot that owns the hardware interface.
+     */
+    qrRobot *source;
+
+    /**
+     * @brief Called before any hardware call is forwarded to the source.
+     */
+    std::function<void()> syncHook;
+
+};
+
+} // Namespace Quadruped
+
+#endif // QR_ROBOT_MIRROR_H
@@ -0,0 +1,93 @@
+// The MIT License
+
+// Copyright (c) 2022
+// Robot Motion and Vision Laboratory at East China Normal University
+// Contact: tophill.robotics@gmail.com
+
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#ifndef QR_ROBOT_REPLAY_H
+#define QR_ROBOT_REPLAY_H
+
+#include "robots/qr_robot_headless_sim.h"
+#include "utils/qr_flight_recorder.h"
+
+
+namespace Quadruped {
+
+/**
+ * @brief A robot whose observations are read from a flight log instead of sensors.
+ * It shares the robot description of qrRobotHeadlessSim, but nothing is simulated:
+ * ReceiveObservation keeps the observation of the last loaded record, and ApplyAction
+ * only keeps the command and advances the manual time by timeStep. So the actions that
+ * step the robot on their own, e.g. standing up, do not consume records.
+ */
+class qrRobotReplay: public qrRobotHeadlessSim {
+
+public:
+
+    /**
+     * @brief Constructor of class qrRobotReplay.
+     * @param configFilePath: config file path of the robot that recorded the log.
+     */
+    qrRobotReplay(std::string configFilePath);
+
+    ~qrRobotReplay() = default;
+
+    /**
+     * @brief Load the robot inputs of a record as the current observation,
+     * i.e. the IMU, the joint states and the foot forces, and the base position of a simulated robot.
+     * @param record: the record to load.
+     */
+    void LoadRecord(const qrFlightRecord &record);
+
+    /**
+     * @brief The observation comes from LoadRecord, there is nothing to receive.
+     */
+    void ReceiveObservation() override;
+
+    /**
+     * @see qrRobot::ApplyAction
+     */
+    void ApplyAction(const Eigen::MatrixXf &motorCommands, MotorMode motorControlMode) override;
+
+    /**
+     * @see qrRobot::ApplyAction
+     */
+    void ApplyAction(const std::vector<qrMotorCommand> &motorCommands, MotorMode motorControlMode) override;
+
+    /**
+     * @brief Getter method of the last applied command.
+     * @return each column is (p, Kp, d, Kd, tau) of one motor.
+     */
+    const Eigen::Matrix<float, 5, NumMotor>& GetLastCommand() const {
+        return lastCommand;
+    };
+
+private:
+
+    /**
+     * @brief The last applied hybrid command.
+     */
+    Eigen::Matrix<float, 5, NumMotor> lastCommand;
+};
+
+} // namespace Quadruped
+
+#endif // QR_ROBOT_REPLAY_H
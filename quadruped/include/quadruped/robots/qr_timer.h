@@ -28,7 +28,6 @@
 #include <assert.h>
 #include <stdint.h>
 #include <time.h>
-#include <ros/ros.h>
 
 
 class qrTimer {
@@ -84,45 +83,98 @@ private:
 };
 
 
-class qrRosTimer: public qrTimer {
+class qrManualTimer: public qrTimer {
 
 public:
 
     /**
-     * @brief Constructor of class qrRosTimer
+     * @brief Constructor of class qrManualTimer. The time starts at zero and only
+     * moves forward when it is advanced, e.g. by a simulator in lock-step with the controller.
      */
-    qrRosTimer() {
-        startRos = ros::Time::now().toSec();
+    qrManualTimer(): now(0), startManual(0) {
     };
 
-    virtual ~qrRosTimer() = default;
+    virtual ~qrManualTimer() = default;
 
     /**
      * @see qrTimer::GetTimeSinceReset
      */
     virtual double GetTimeSinceReset() {
-        double timeSinceReset = ros::Time::now().toSec() - startRos;
-        return timeSinceReset;
+        return now - startManual;
     };
 
     /**
      * @see qrTimer::ResetStartTime
      */
     virtual double ResetStartTime() {
-        startRos = ros::Time::now().toSec();
-        return startRos;
+        startManual = now;
+        return startManual;
+    };
+
+    /**
+     * @brief Move the time forward.
+     * @param dt: duration in seconds.
+     */
+    void Advance(double dt) {
+        now += dt;
+    };
+
+    /**
+     * @brief Getter method of the time since the timer is created.
+     */
+    double GetTime() const {
+        return now;
+    };
+
+    /**
+     * @brief Set the time and the start time, to follow another manual timer.
+     */
+    void SetTime(double nowIn, double startIn) {
+        now = nowIn;
+        startManual = startIn;
+    };
+
+    /**
+     * @brief Getter method of the start time.
+     */
+    double GetStartTime() const {
+        return startManual;
     };
 
 private:
 
     /**
-     * @brief Start time in ROS.
+     * @brief Current time.
      */
-    double startRos;
+    double now;
 
+    /**
+     * @brief Start time.
+     */
+    double startManual;
+
+};
+
+
+/**
+ * @brief The time sources that qrTimerInterface can read.
+ * MANUAL_TIME only advances when it is told to, so that a simulated robot
+ * and the controllers can run in lock-step, faster than real time.
+ * ROS_TIME is read by qrRosTimer once the ROS adapter is loaded, and falls back to the clock otherwise.
+ */
+enum class qrTimeSource {
+    CLOCK_TIME,
+    ROS_TIME,
+    MANUAL_TIME
 };
 
 
+/**
+ * @brief Creates a timer which reads a time source, see qrTimerInterface::SetTimerFactory.
+ */
+typedef qrTimer *(*qrTimerFactory)();
+
+
 class qrTimerInterface {
 
 public:
@@ -131,15 +183,16 @@ public:
      * @brief Constructor of class TimerInterface.
      * @param useRosTimeIn: whether to use ROS timer tools.
      */
-    qrTimerInterface(bool useRosTimeIn=false) : useRosTime(useRosTimeIn), timerPtr(nullptr) {
-        if (useRosTime) {
-            timerPtr = new qrRosTimer();
-        } else {
-            timerPtr = new qrTimer();
-        }
+    qrTimerInterface(bool useRosTimeIn=false) :
+        qrTimerInterface(useRosTimeIn ? qrTimeSource::ROS_TIME : qrTimeSource::CLOCK_TIME) {
+    };
 
-        startTime = 0;
-        timeSinceReset = 0;
+    /**
+     * @brief Constructor of class TimerInterface.
+     * @param timeSourceIn: which time source to read.
+     */
+    qrTimerInterface(qrTimeSource timeSourceIn) : timerPtr(nullptr), manualTimerPtr(nullptr) {
+        SetTimeSource(timeSourceIn);
     };
 
     /**
@@ -158,12 +211,97 @@ public:
         startTime = timerPtr->ResetStartTime();
     };
 
+    /**
+     * @brief Replace the timer by a new one which reads the required time source.
+     * The new timer is reset.
+     * @param timeSourceIn: which time source to read.
+     */
+    void SetTimeSource(qrTimeSource timeSourceIn) {
+        delete timerPtr;
+        timeSource = timeSourceIn;
+        useRosTime = (timeSource == qrTimeSource::ROS_TIME);
+        manualTimerPtr = nullptr;
+        if (timeSource == qrTimeSource::MANUAL_TIME) {
+            manualTimerPtr = new qrManualTimer();
+            timerPtr = manualTimerPtr;
+        } else if (timerFactories[static_cast<int>(timeSource)]) {
+            timerPtr = timerFactories[static_cast<int>(timeSource)]();
+        } else {
+            /* Without a factory, e.g. when no ROS adapter is loaded for the ROS time, read the clock. */
+            timerPtr = new qrTimer();
+        }
+
+        startTime = 0;
+        timeSinceReset = 0;
+    };
+
+    qrTimeSource GetTimeSource() const {
+        return timeSource;
+    };
+
+    bool IsManualTime() const {
+        return manualTimerPtr != nullptr;
+    };
+
+    /**
+     * @brief Advance the manual time. Does nothing for the other time sources,
+     * since they follow the wall clock.
+     * @param dt: duration in seconds.
+     * @return the time since the manual timer is created, or zero.
+     */
+    double AdvanceTime(double dt) {
+        if (!manualTimerPtr) {
+            return 0;
+        }
+        manualTimerPtr->Advance(dt);
+        return manualTimerPtr->GetTime();
+    };
+
+    /**
+     * @brief Follow the manual time of another timer, e.g. for a copy of the robot.
+     * Does nothing if the other timer does not use the manual time.
+     * @param other: the timer to follow.
+     */
+    void FollowTime(const qrTimerInterface &other) {
+        if (!other.manualTimerPtr) {
+            return;
+        }
+        if (!manualTimerPtr) {
+            SetTimeSource(qrTimeSource::MANUAL_TIME);
+        }
+        manualTimerPtr->SetTime(other.manualTimerPtr->GetTime(), other.manualTimerPtr->GetStartTime());
+    };
+
+    /**
+     * @brief Set how the timers of a time source are created, e.g. the ROS adapter reads the ROS time
+     * for qrTimeSource::ROS_TIME. The timers already created are not changed. The manual time cannot be replaced.
+     * @param timeSourceIn: the time source.
+     * @param factory: creates the timer, nullptr to read the clock.
+     */
+    static void SetTimerFactory(qrTimeSource timeSourceIn, qrTimerFactory factory) {
+        if (timeSourceIn != qrTimeSource::MANUAL_TIME) {
+            timerFactories[static_cast<int>(timeSourceIn)] = factory;
+        }
+    };
+
 private:
 
+    /**
+     * @brief Factory of each time source, nullptr for the clock.
+     */
+    static qrTimerFactory timerFactories[3];
+
     bool useRosTime;
 
+    qrTimeSource timeSource;
+
     qrTimer* timerPtr;
 
+    /**
+     * @brief The same timer as timerPtr if the time source is manual, otherwise nullptr.
+     */
+    qrManualTimer* manualTimerPtr;
+
     double startTime;
 
     double timeSinceReset;
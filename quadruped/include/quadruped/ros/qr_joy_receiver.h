@@ -0,0 +1,83 @@
+// The MIT License
+
+// Copyright (c) 2022
+// Robot Motion and Vision Laboratory at East China Normal University
+// Contact: tophill.robotics@gmail.com
+
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#ifndef QR_JOY_RECEIVER_H
+#define QR_JOY_RECEIVER_H
+
+#include <string>
+
+#include <ros/ros.h>
+#include <sensor_msgs/Joy.h>
+
+#include "controllers/qr_command_input.h"
+#include "controllers/qr_desired_state_command.hpp"
+
+
+namespace Quadruped {
+
+/**
+ * @brief Receive the gamepad state from the ROS joy_node, and hand it to the desired state command.
+ */
+class qrJoyReceiver: public qrCommandInput {
+
+public:
+
+    /**
+     * @brief Constructor of class qrJoyReceiver.
+     * @param nhIn: ROS node handle. This is used to subscribe the joy node when connected.
+     */
+    qrJoyReceiver(ros::NodeHandle &nhIn);
+
+    ~qrJoyReceiver() = default;
+
+    /**
+     * @brief Subscribe the joy node. The callbacks run when the node handle is spun.
+     * @see qrCommandInput::Connect
+     */
+    void Connect(qrDesiredStateCommand *commandIn) override;
+
+    /**
+     * @brief the callback function called when the joy command received
+     * @param joy_msg: joy command message from ROS joy_node
+     */
+    void JoyCallback(const sensor_msgs::Joy::ConstPtr &joy_msg);
+
+    ros::NodeHandle &nh;
+
+    ros::Subscriber joySub;
+
+    std::string joyTopic = "/joy";
+
+private:
+
+    /**
+     * @brief The desired state command updated by the joy commands, nullptr until connected.
+     */
+    qrDesiredStateCommand *command = nullptr;
+
+};
+
+} // Namespace Quadruped
+
+#endif // QR_JOY_RECEIVER_H
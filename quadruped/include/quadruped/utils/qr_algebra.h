@@ -111,12 +111,13 @@ bool almostEqual(const T &a, const T b, T tol) {
 
 /**
  * @brief Compute the pseudo inverse of a matrix.
+ * With a matrix of bounded size, e.g. WbcMat, the SVD and all temporaries stay on the stack.
  * @param matrix: input matrix.
  * @param sigmaThreshold: threshold for singular values being zero.
  * @param invMatrix: output matrix.
  */
-template <typename T>
-void pseudoInverse(const DMat<T>& matrix, double sigmaThreshold, DMat<T>& invMatrix) {
+template <typename MatrixType>
+void pseudoInverse(const MatrixType& matrix, double sigmaThreshold, MatrixType& invMatrix) {
     if (matrix.rows()==1 && matrix.cols()==1) {
         invMatrix.resize(1, 1);
         if (matrix.coeff(0, 0) > sigmaThreshold) {
@@ -127,10 +128,10 @@ void pseudoInverse(const DMat<T>& matrix, double sigmaThreshold, DMat<T>& invMat
         return;
     }
 
-    Eigen::JacobiSVD<DMat<T>> svd(matrix, Eigen::ComputeThinU | Eigen::ComputeThinV);
+    Eigen::JacobiSVD<MatrixType> svd(matrix, Eigen::ComputeThinU | Eigen::ComputeThinV);
     /* not sure if we need to svd.sort()... probably not. */
     const int nrows(svd.singularValues().rows());
-    DMat<T> invS = DMat<T>::Zero(nrows, nrows);
+    MatrixType invS = MatrixType::Zero(nrows, nrows);
     for (int ii(0); ii < nrows; ++ii) {
         if (svd.singularValues().coeff(ii) > sigmaThreshold) {
             invS.coeffRef(ii, ii) = 1.0 / svd.singularValues().coeff(ii);
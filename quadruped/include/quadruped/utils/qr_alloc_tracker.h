@@ -0,0 +1,99 @@
+// The MIT License
+
+// Copyright (c) 2022
+// Robot Motion and Vision Laboratory at East China Normal University
+// Contact: tophill.robotics@gmail.com
+
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#ifndef QR_ALLOC_TRACKER_H
+#define QR_ALLOC_TRACKER_H
+
+#include <stddef.h>
+
+
+namespace Quadruped {
+
+/**
+ * @brief What to do on the first heap allocation inside a tracked tick.
+ */
+enum AllocPolicy {
+    ALLOC_COUNT = 0,      // only count allocations and bytes
+    ALLOC_BACKTRACE,      // additionally print a backtrace of the first allocation
+    ALLOC_ABORT           // print a backtrace and abort
+};
+
+/**
+ * @brief Allocation statistics of a tracked tick.
+ */
+struct qrAllocStats {
+
+    /**
+     * @brief Number of malloc family calls, including those behind operator new.
+     */
+    size_t allocations = 0;
+
+    /**
+     * @brief Requested bytes of these calls.
+     */
+    size_t bytes = 0;
+
+    /**
+     * @brief Allocations of the solvers served by the qrSolverArena, which do not touch the heap.
+     */
+    size_t solverAllocations = 0;
+
+};
+
+/**
+ * @brief Per-thread heap allocation tracker for the control tick.
+ * When built with -DTRACK_ALLOCATION=ON, the malloc family is interposed by libquadruped,
+ * and every allocation made by a thread between BeginTick() and EndTick() is counted.
+ * Otherwise every method is a no-op and Enabled() returns false.
+ */
+class qrAllocTracker {
+
+public:
+
+    /**
+     * @brief Whether the interposer is compiled in.
+     */
+    static bool Enabled();
+
+    /**
+     * @brief Set what happens on the first allocation in a tick. Shared by all threads.
+     */
+    static void SetPolicy(AllocPolicy policy);
+
+    /**
+     * @brief Start counting allocations of the calling thread.
+     */
+    static void BeginTick();
+
+    /**
+     * @brief Stop counting allocations of the calling thread.
+     * @return statistics since the last BeginTick().
+     */
+    static qrAllocStats EndTick();
+
+};
+
+} // Namespace Quadruped
+
+#endif // QR_ALLOC_TRACKER_H
@@ -139,6 +139,25 @@ using D6Mat = typename Eigen::Matrix<T, 6, Eigen::Dynamic>;
 template<typename T>
 using D3Mat = typename Eigen::Matrix<T, 3, Eigen::Dynamic>;
 
+/* Dynamically sized matrix of at most MaxRows x MaxCols, stored inline so that resizing never allocates. */
+template<typename T, int MaxRows, int MaxCols>
+using BMat = typename Eigen::Matrix<T, Eigen::Dynamic, Eigen::Dynamic, Eigen::ColMajor, MaxRows, MaxCols>;
+
+/* Dynamically sized vector of at most MaxRows entries, stored inline. */
+template<typename T, int MaxRows>
+using BVec = typename Eigen::Matrix<T, Eigen::Dynamic, 1, Eigen::ColMajor, MaxRows, 1>;
+
+/* Bound of the whole body controller, 4 contacts with 6 inequality constraints each, 18 generalized velocities. */
+constexpr int WbcMaxDim = 24;
+
+/* Matrix of the whole body controller. */
+template<typename T>
+using WbcMat = BMat<T, WbcMaxDim, WbcMaxDim>;
+
+/* Vector of the whole body controller. */
+template<typename T>
+using WbcVec = BVec<T, WbcMaxDim>;
+
 template<typename T>
 using Isometry3 = typename Eigen::Transform<T, 3, Eigen::Isometry>;
 
@@ -0,0 +1,351 @@
+// The MIT License
+
+// Copyright (c) 2022
+// Robot Motion and Vision Laboratory at East China Normal University
+// Contact: tophill.robotics@gmail.com
+
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#ifndef QR_FLIGHT_RECORDER_H
+#define QR_FLIGHT_RECORDER_H
+
+#include <atomic>
+#include <cstdint>
+#include <ostream>
+#include <string>
+#include <thread>
+#include <vector>
+
+
+namespace Quadruped {
+
+/**
+ * @brief The schema of a flight record, as (type, name, count).
+ * Adding a field here adds it to the record, to the file header and to the CSV export.
+ */
+#define QR_FLIGHT_RECORD_FIELDS(FIELD)                                              \
+    /* robot inputs of the tick */                                                 \
+    FIELD(uint32_t, tick, 1)                                                       \
+    FIELD(float, time, 1)                                                          \
+    FIELD(float, rpy, 3)                                                           \
+    FIELD(float, gyro, 3)                                                          \
+    FIELD(float, accelerometer, 3)                                                 \
+    FIELD(float, motorAngles, 12)                                                  \
+    FIELD(float, motorVelocities, 12)                                              \
+    FIELD(float, motorAccelerations, 12)                                           \
+    FIELD(float, motorTorques, 12)                                                 \
+    FIELD(float, footForces, 4)                                                    \
+    FIELD(float, footContacts, 4)                                                  \
+    /* estimated state, from stateDataFlow */                                      \
+    FIELD(float, basePosition, 3)                                                  \
+    FIELD(float, baseVInWorldFrame, 3)                                             \
+    FIELD(float, baseWInWorldFrame, 3)                                             \
+    FIELD(float, baseLinearAcceleration, 3)                                        \
+    FIELD(float, heightInControlFrame, 1)                                          \
+    FIELD(float, groundOrientation, 4)                                             \
+    FIELD(float, footPositionsInBaseFrame, 12)                                     \
+    FIELD(float, estimatedFootForce, 12)                                           \
+    /* desired state */                                                            \
+    FIELD(float, stateDes, 12)                                                     \
+    FIELD(float, vDesInBodyFrame, 3)                                               \
+    FIELD(float, wDesInBodyFrame, 3)                                               \
+    FIELD(float, commandVelocity, 3) /* operator command after filtering */        \
+    FIELD(float, commandOmega, 3)                                                  \
+    FIELD(float, fsmMode, 1)                                                       \
+    /* controller outputs */                                                       \
+    FIELD(float, mpcForces, 12)                                                    \
+    FIELD(float, wbcTorques, 12)                                                   \
+    FIELD(float, motorCommands, 60) /* p, Kp, d, Kd, tau of each motor */
+
+/**
+ * @brief One tick of robot state and commands. Plain data, so a record is copied as is
+ * into the ring buffer and the file.
+ */
+struct qrFlightRecord {
+#define QR_FLIGHT_RECORD_MEMBER(type, name, count) type name[count];
+    QR_FLIGHT_RECORD_FIELDS(QR_FLIGHT_RECORD_MEMBER)
+#undef QR_FLIGHT_RECORD_MEMBER
+};
+
+/**
+ * @brief Description of a field of the record, stored in the file header.
+ */
+struct qrFlightField {
+
+    /**
+     * @brief Name of the field.
+     */
+    char name[32];
+
+    /**
+     * @brief Offset of the field in the record, in bytes.
+     */
+    uint32_t offset;
+
+    /**
+     * @brief Number of values of the field.
+     */
+    uint32_t count;
+
+    /**
+     * @brief 0 for float values, 1 for uint32 values.
+     */
+    uint32_t type;
+};
+
+/**
+ * @brief Records one qrFlightRecord per tick into a preallocated ring buffer. A background thread
+ * flushes the ring into a memory-mapped file, chunk by chunk.
+ * The control thread is the only producer and never blocks: if the ring is full, the record is dropped.
+ *
+ * The file is a header page holding the schema, followed by chunks of a fixed size.
+ * Each chunk starts with the number of records it holds, which is updated after the records
+ * are written, so a file cut short by a crash stays readable up to the last flush.
+ */
+class qrFlightRecorder {
+
+public:
+
+    /**
+     * @brief Constructor of class qrFlightRecorder. Creates the file and starts the flush thread.
+     * @param path: path of the file to write, truncated if it exists.
+     * @param capacity: number of records in the ring buffer.
+     * @param recordsPerChunk: number of records in one chunk of the file.
+     */
+    qrFlightRecorder(const std::string &path, unsigned int capacity = 4096, unsigned int recordsPerChunk = 1024);
+
+    /**
+     * @brief Flush the remaining records and close the file.
+     */
+    ~qrFlightRecorder();
+
+    qrFlightRecorder(const qrFlightRecorder &) = delete;
+
+    qrFlightRecorder &operator=(const qrFlightRecorder &) = delete;
+
+    /**
+     * @brief Get the slot of the next record, to be filled in place by the control thread.
+     * @return the slot, or nullptr if the ring is full.
+     */
+    qrFlightRecord *BeginRecord() {
+        unsigned long h = head.load(std::memory_order_relaxed);
+        if (h - tail.load(std::memory_order_acquire) >= ring.size()) {
+            ++dropped;
+            return nullptr;
+        }
+        return &ring[h % ring.size()];
+    };
+
+    /**
+     * @brief Publish the record returned by the last BeginRecord to the flush thread.
+     */
+    void CommitRecord() {
+        head.store(head.load(std::memory_order_relaxed) + 1, std::memory_order_release);
+    };
+
+    /**
+     * @brief Number of records dropped because the ring was full.
+     */
+    unsigned long GetDropped() const {
+        return dropped;
+    };
+
+    /**
+     * @brief Number of records written to the file.
+     */
+    unsigned long GetWritten() const {
+        return tail.load(std::memory_order_acquire);
+    };
+
+    /**
+     * @brief The schema of qrFlightRecord.
+     */
+    static const std::vector<qrFlightField> &GetFields();
+
+private:
+
+    /**
+     * @brief The flush thread. Copies the committed records into the mapped chunks.
+     */
+    void Run();
+
+    /**
+     * @brief Copy the committed records into the file.
+     * @return whether there were records to copy.
+     */
+    bool Flush();
+
+    /**
+     * @brief Unmap the current chunk and map a new one at the end of the file.
+     */
+    void NextChunk();
+
+    /**
+     * @brief The preallocated records.
+     */
+    std::vector<qrFlightRecord> ring;
+
+    /**
+     * @brief Number of records committed by the control thread.
+     */
+    std::atomic<unsigned long> head;
+
+    /**
+     * @brief Number of records copied to the file by the flush thread.
+     */
+    std::atomic<unsigned long> tail;
+
+    /**
+     * @brief Number of dropped records, only touched by the control thread.
+     */
+    unsigned long dropped;
+
+    /**
+     * @brief Descriptor of the file.
+     */
+    int fd;
+
+    /**
+     * @brief Number of records in one chunk.
+     */
+    unsigned int recordsPerChunk;
+
+    /**
+     * @brief Offset of the first chunk in the file, after the header.
+     */
+    size_t dataOffset;
+
+    /**
+     * @brief Size of one chunk in bytes, a multiple of the page size.
+     */
+    size_t chunkSize;
+
+    /**
+     * @brief Number of chunks in the file.
+     */
+    size_t chunkCount;
+
+    /**
+     * @brief The mapping of the chunk being written, nullptr before the first record.
+     */
+    char *chunk;
+
+    /**
+     * @brief Number of records in the chunk being written.
+     */
+    unsigned int chunkRecords;
+
+    /**
+     * @brief Whether the flush thread should keep running.
+     */
+    std::atomic<bool> running;
+
+    /**
+     * @brief The flush thread.
+     */
+    std::thread thread;
+};
+
+/**
+ * @brief Reads a file written by qrFlightRecorder. The schema is taken from the file,
+ * so files written by older versions of the record stay readable.
+ */
+class qrFlightLog {
+
+public:
+
+    /**
+     * @brief Constructor of class qrFlightLog. Maps the file and indexes its records.
+     * @param path: path of the file.
+     */
+    qrFlightLog(const std::string &path);
+
+    ~qrFlightLog();
+
+    qrFlightLog(const qrFlightLog &) = delete;
+
+    qrFlightLog &operator=(const qrFlightLog &) = delete;
+
+    /**
+     * @brief Number of records in the file.
+     */
+    size_t Size() const {
+        return records.size();
+    };
+
+    /**
+     * @brief Schema of the records in the file.
+     */
+    const std::vector<qrFlightField> &GetFields() const {
+        return fields;
+    };
+
+    /**
+     * @brief Find a field by name.
+     * @return the field, or nullptr if the file does not have it.
+     */
+    const qrFlightField *FindField(const std::string &name) const;
+
+    /**
+     * @brief Value of a field in a record.
+     * @param record: index of the record.
+     * @param field: the field, from GetFields or FindField.
+     * @param index: index of the value in the field.
+     */
+    double Value(size_t record, const qrFlightField &field, unsigned int index = 0) const;
+
+    /**
+     * @brief Copy a record into a qrFlightRecord. Fields that are not in the file are zero.
+     * @param record: index of the record.
+     * @param out: the record to fill.
+     */
+    void Read(size_t record, qrFlightRecord &out) const;
+
+    /**
+     * @brief Write all records as CSV, with one column per value, e.g. motorAngles_0.
+     * @param os: the output stream.
+     */
+    void ExportCsv(std::ostream &os) const;
+
+private:
+
+    /**
+     * @brief The mapped file.
+     */
+    const char *data;
+
+    /**
+     * @brief Size of the mapped file.
+     */
+    size_t size;
+
+    /**
+     * @brief Schema of the records in the file.
+     */
+    std::vector<qrFlightField> fields;
+
+    /**
+     * @brief Pointers to the records in the mapped file.
+     */
+    std::vector<const char *> records;
+};
+
+} // namespace Quadruped
+
+#endif // QR_FLIGHT_RECORDER_H
@@ -511,6 +511,132 @@ public:
 
 };
 
+/**
+ * @brief Clamped B-spline of a fixed degree and number of control points.
+ * The spline is converted into one polynomial per knot span when the knots and control points are set,
+ * so that evaluating a point and its derivatives is a few Horner steps without any heap allocation.
+ * @example
+ *  robotics::math::qrBSpline<float, 3, 9> spline;
+ *  spline.SetKnots(knots);                // only when the knots change
+ *  spline.SetControlPoints(controlPoints); // at the start of each swing
+ *  spline.GetPoint(u, p, v, a);
+ */
+template<typename T, int Degree, int NumControlPoints, int Dim = 3>
+class qrBSpline {
+
+public:
+
+    static_assert(Degree >= 1 && NumControlPoints > Degree, "a B-spline needs more control points than its degree");
+
+    static constexpr int NumKnots = NumControlPoints + Degree + 1;
+
+    static constexpr int NumSpans = NumControlPoints - Degree;
+
+    using VecD = Eigen::Matrix<T, Dim, 1>;
+
+    EIGEN_MAKE_ALIGNED_OPERATOR_NEW
+
+    /**
+     * @brief Set the knot vector and precompute the polynomial coefficients of the basis functions of each span.
+     * @param knotsIn: non-decreasing knots, the first and the last Degree+1 ones are usually repeated.
+     */
+    void SetKnots(const T (&knotsIn)[NumKnots]) {
+        for (int i = 0; i < NumKnots; ++i) {
+            knots[i] = knotsIn[i];
+        }
+        for (int s = 0; s < NumSpans; ++s) {
+            ComputeBasis(s + Degree, basis[s]);
+        }
+    }
+
+    /**
+     * @brief Set the control points, the coefficients of the span polynomials are computed at once.
+     * @param controlPoints: control points in columns.
+     */
+    void SetControlPoints(const Eigen::Matrix<T, Dim, NumControlPoints> &controlPoints) {
+        for (int s = 0; s < NumSpans; ++s) {
+            coefficients[s].noalias() = controlPoints.template middleCols<Degree + 1>(s) * basis[s];
+        }
+    }
+
+    /**
+     * @brief Gets the point and its first two derivatives w.r.t. the parameter.
+     * @param u: parameter of the spline, clamped into the knot range.
+     * @param p: point.
+     * @param v: first derivative.
+     * @param a: second derivative.
+     */
+    void GetPoint(T u, VecD &p, VecD &v, VecD &a) const {
+        u = std::min(std::max(u, knots[Degree]), knots[NumControlPoints]);
+        int s = 0;
+        while (s < NumSpans - 1 && u >= knots[s + Degree + 1]) {
+            ++s;
+        }
+        const T t = u - knots[s + Degree];
+        const Eigen::Matrix<T, Dim, Degree + 1> &c = coefficients[s];
+        p = c.col(Degree);
+        v.setZero();
+        a.setZero();
+        for (int k = Degree - 1; k >= 0; --k) {
+            a = a * t + 2 * v;
+            v = v * t + p;
+            p = p * t + c.col(k);
+        }
+    }
+
+private:
+
+    /**
+     * @brief Monomial coefficients, in the offset from the start of the span, of the Degree+1 basis functions
+     * that are nonzero on span [knots[m], knots[m+1]), by the Cox-de Boor recursion.
+     * @param m: index of the first knot of the span.
+     * @param B: row j holds the coefficients of the basis function of control point m-Degree+j.
+     */
+    void ComputeBasis(int m, Eigen::Matrix<T, Degree + 1, Degree + 1> &B) const {
+        /* N[j] is the basis function of index m-p+j of the current degree p. */
+        Eigen::Matrix<T, Degree + 1, Degree + 1> N = Eigen::Matrix<T, Degree + 1, Degree + 1>::Zero();
+        N(Degree, 0) = 1;
+        for (int p = 1; p <= Degree; ++p) {
+            Eigen::Matrix<T, Degree + 1, Degree + 1> next = Eigen::Matrix<T, Degree + 1, Degree + 1>::Zero();
+            for (int j = Degree - p; j <= Degree; ++j) {
+                int i = m - Degree + j;
+                /* (u - knots[i]) / (knots[i+p] - knots[i]) * N(i, p-1) */
+                T left = knots[i + p] - knots[i];
+                if (left > 0) {
+                    const auto f = N.row(j);
+                    next.row(j).template tail<Degree>() += f.template head<Degree>() / left;
+                    next.row(j) += f * ((knots[m] - knots[i]) / left);
+                }
+                /* (knots[i+p+1] - u) / (knots[i+p+1] - knots[i+1]) * N(i+1, p-1) */
+                T right = knots[i + p + 1] - knots[i + 1];
+                if (j < Degree && right > 0) {
+                    const auto f = N.row(j + 1);
+                    next.row(j).template tail<Degree>() -= f.template head<Degree>() / right;
+                    next.row(j) += f * ((knots[i + p + 1] - knots[m]) / right);
+                }
+            }
+            N = next;
+        }
+        B = N;
+    }
+
+    /**
+     * @brief Knot vector.
+     */
+    T knots[NumKnots] = {};
+
+    /**
+     * @brief Basis coefficients of each span, depending only on the knots.
+     */
+    Eigen::Matrix<T, Degree + 1, Degree + 1> basis[NumSpans];
+
+    /**
+     * @brief Polynomial coefficients of each span, column k multiplies the k-th power of the offset in the span.
+     */
+    Eigen::Matrix<T, Dim, Degree + 1> coefficients[NumSpans];
+
+};
+
 /**
  * @brief Linear interpolation between y0 and yf.  x is between 0 and 1.
  */
@@ -59,7 +59,7 @@ void fprintf_color(PrintColor color, FILE* stream, const char *fmt, ...);
 template <typename T>
 std::string pretty_string(T vv) {
     static int const buflen(32);
-    static char buf[buflen];
+    char buf[buflen];
     memset(buf, 0, sizeof(buf));
     snprintf(buf, buflen - 1, "% 6.6f  ", vv);
     std::string str(buf);
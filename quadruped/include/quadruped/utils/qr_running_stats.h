@@ -0,0 +1,240 @@
+// The MIT License
+
+// Copyright (c) 2022
+// Robot Motion and Vision Laboratory at East China Normal University
+// Contact: tophill.robotics@gmail.com
+
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#ifndef QR_RUNNING_STATS_H
+#define QR_RUNNING_STATS_H
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstdint>
+#include <limits>
+
+
+namespace Quadruped {
+
+/**
+ * @brief Count, mean, variance and range of a stream of samples, updated in O(1) with
+ * the algorithm of Welford, without keeping the samples. Numerically stable over hours of samples.
+ */
+class qrRunningStats {
+
+public:
+
+    /**
+     * @brief Add a sample.
+     * @param x: the sample.
+     */
+    void Update(double x) {
+        ++count;
+        double delta = x - mean;
+        mean += delta / count;
+        m2 += delta * (x - mean);
+        min = std::min(min, x);
+        max = std::max(max, x);
+    };
+
+    /**
+     * @brief Add the samples of another statistics, e.g. kept by another thread.
+     * @param other: the statistics to merge.
+     */
+    void Merge(const qrRunningStats &other);
+
+    /**
+     * @brief Forget all samples.
+     */
+    void Reset();
+
+    /**
+     * @brief Getter method of the number of samples.
+     */
+    unsigned long GetCount() const {
+        return count;
+    };
+
+    /**
+     * @brief Mean of the samples, zero without samples.
+     */
+    double GetMean() const {
+        return mean;
+    };
+
+    /**
+     * @brief Population variance of the samples, zero without samples.
+     */
+    double GetVariance() const {
+        return count > 0 ? m2 / count : 0.;
+    };
+
+    /**
+     * @brief Population standard deviation of the samples.
+     */
+    double GetStandardDeviation() const {
+        return std::sqrt(GetVariance());
+    };
+
+    /**
+     * @brief Sum of the samples.
+     */
+    double GetSum() const {
+        return mean * count;
+    };
+
+    /**
+     * @brief Smallest sample, +inf without samples.
+     */
+    double GetMin() const {
+        return min;
+    };
+
+    /**
+     * @brief Largest sample, -inf without samples.
+     */
+    double GetMax() const {
+        return max;
+    };
+
+private:
+
+    unsigned long count = 0;
+
+    double mean = 0.;
+
+    /**
+     * @brief Sum of the squared differences from the mean.
+     */
+    double m2 = 0.;
+
+    double min = std::numeric_limits<double>::infinity();
+
+    double max = -std::numeric_limits<double>::infinity();
+};
+
+/**
+ * @brief Quantiles of a stream of samples in fixed memory.
+ * The magnitudes are counted in logarithmic buckets, so that any quantile is returned with
+ * a bounded relative error, whatever the distribution and the number of samples.
+ * The buckets live in the object, updating is O(1) and never allocates, so a sketch can
+ * run in the control loop.
+ */
+class qrQuantileSketch {
+
+public:
+
+    /**
+     * @brief Number of buckets for each sign.
+     */
+    static constexpr int NumBuckets = 2048;
+
+    /**
+     * @brief Constructor of class qrQuantileSketch.
+     * With the defaults, the magnitudes from 1e-9 to 6e8 are covered with 1% relative error.
+     * @param relativeAccuracy: relative error of the returned quantiles.
+     * @param minValue: smallest magnitude told apart from zero. The magnitudes beyond
+     * minValue * gamma^(NumBuckets-1), gamma = (1 + relativeAccuracy) / (1 - relativeAccuracy),
+     * are counted in the last bucket.
+     */
+    qrQuantileSketch(double relativeAccuracy = 0.01, double minValue = 1e-9);
+
+    /**
+     * @brief Add a sample.
+     * @param x: the sample.
+     */
+    void Update(double x) {
+        ++count;
+        double magnitude = std::abs(x);
+        if (magnitude < minValue) {
+            ++zeroCount;
+        } else if (x > 0) {
+            ++positive[Index(magnitude)];
+        } else {
+            ++negative[Index(magnitude)];
+        }
+    };
+
+    /**
+     * @brief Add the samples of another sketch with the same accuracy and minimum value.
+     * @param other: the sketch to merge.
+     */
+    void Merge(const qrQuantileSketch &other);
+
+    /**
+     * @brief Forget all samples.
+     */
+    void Reset();
+
+    /**
+     * @brief Getter method of the number of samples.
+     */
+    unsigned long GetCount() const {
+        return count;
+    };
+
+    /**
+     * @brief Estimate a quantile. O(NumBuckets), so it is meant for reports.
+     * @param q: the quantile in [0, 1], e.g. 0.99.
+     * @return the quantile, zero without samples.
+     */
+    double GetQuantile(double q) const;
+
+private:
+
+    /**
+     * @brief Bucket of a magnitude not smaller than minValue.
+     */
+    int Index(double magnitude) const {
+        int index = static_cast<int>(std::ceil(std::log(magnitude / minValue) / logGamma));
+        return std::min(std::max(index, 0), NumBuckets - 1);
+    };
+
+    /**
+     * @brief Magnitude that represents a bucket, within the relative accuracy of all its samples.
+     */
+    double Value(int index) const;
+
+    double gamma;
+
+    double logGamma;
+
+    double minValue;
+
+    unsigned long count = 0;
+
+    /**
+     * @brief Number of samples whose magnitude is below minValue.
+     */
+    unsigned long zeroCount = 0;
+
+    /**
+     * @brief Number of samples in each bucket, bucket i holds the magnitudes
+     * in (minValue * gamma^(i-1), minValue * gamma^i].
+     */
+    std::array<uint32_t, NumBuckets> positive;
+
+    std::array<uint32_t, NumBuckets> negative;
+};
+
+} // namespace Quadruped
+
+#endif // QR_RUNNING_STATS_H
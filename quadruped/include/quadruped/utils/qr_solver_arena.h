@@ -0,0 +1,105 @@
+// The MIT License
+
+// Copyright (c) 2022
+// Robot Motion and Vision Laboratory at East China Normal University
+// Contact: tophill.robotics@gmail.com
+
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+
+#ifndef QR_SOLVER_ARENA_H
+#define QR_SOLVER_ARENA_H
+
+#include <stddef.h>
+
+
+namespace Quadruped {
+
+/**
+ * @brief Per-thread stack arena that serves operator new/delete of the third party solvers,
+ * i.e. qpOASES in the MPC and QuadProg++ in the WBC, which allocate their workspace in every solve.
+ * When built with -DSOLVER_ARENA=ON, libquadruped_core is linked with operator new/delete wrapped (-Wl,--wrap),
+ * and the allocations of a thread inside a qrSolverAllocScope are carved from a slab reserved for that thread.
+ * The slab is released in LIFO order, a block freed out of order is reclaimed once the blocks above it are freed.
+ * An allocation that does not fit falls back to the heap.
+ * Memory allocated in a scope must be freed by code of libquadruped_core, as only its operator delete is wrapped.
+ */
+class qrSolverArena {
+
+public:
+
+    /**
+     * @brief Size of the slab of one thread (unit: byte).
+     */
+    static constexpr size_t SLAB_SIZE = 1 << 20;
+
+    /**
+     * @brief Number of slabs, i.e. threads that hold a slab at the same time.
+     */
+    static constexpr int SLAB_COUNT = 32;
+
+    /**
+     * @brief Whether the wrapper of operator new/delete is linked in.
+     */
+    static bool Enabled();
+
+    /**
+     * @brief Carve a block from the slab of the calling thread.
+     * @param size: requested bytes.
+     * @return the block aligned to 16 bytes, or nullptr outside of a qrSolverAllocScope or if the slab is full.
+     */
+    static void *Allocate(size_t size);
+
+    /**
+     * @brief Give back a block of any slab, from any thread.
+     * @param ptr: the block.
+     * @return false if ptr is not in the arena, the caller frees it to the heap then.
+     */
+    static bool Release(void *ptr);
+
+    /**
+     * @brief Number of blocks served to the calling thread since it started.
+     */
+    static size_t Allocations();
+
+    /**
+     * @brief High water mark of the slab of the calling thread (unit: byte).
+     */
+    static size_t PeakBytes();
+
+};
+
+/**
+ * @brief Marks a call into a third party solver that allocates by itself.
+ * While an instance lives, the calling thread serves operator new from its qrSolverArena.
+ * The scopes nest.
+ */
+class qrSolverAllocScope {
+
+public:
+
+    qrSolverAllocScope();
+
+    ~qrSolverAllocScope();
+
+};
+
+} // Namespace Quadruped
+
+#endif // QR_SOLVER_ARENA_H
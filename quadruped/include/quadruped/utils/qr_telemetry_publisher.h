@@ -0,0 +1,218 @@
+// The MIT License
+
+// Copyright (c) 2022
+// Robot Motion and Vision Laboratory at East China Normal University
+// Contact: tophill.robotics@gmail.com
+
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#ifndef QR_TELEMETRY_PUBLISHER_H
+#define QR_TELEMETRY_PUBLISHER_H
+
+#include <atomic>
+#include <cstdint>
+#include <map>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <lcm/lcm-cpp.hpp>
+
+#include "utils/qr_telemetry_sink.h"
+
+
+namespace Quadruped {
+
+/**
+ * @brief Streams qr_telemetry_lcmt messages over LCM for live monitoring, outside of the control loop.
+ * Each channel has its own rate, decimated from the control frequency.
+ * The control thread fills a sample of a preallocated ring in place, only in the ticks that some channel
+ * publishes, and never blocks: if the ring is full, the sample is dropped.
+ * A background thread encodes each sample once and publishes it on the channels it is due on.
+ */
+class qrTelemetryPublisher: public qrTelemetrySink {
+
+public:
+
+    /**
+     * @brief Constructor of class qrTelemetryPublisher. Connects to LCM and starts the publisher thread.
+     * @param url: LCM provider, e.g. "udpm://239.255.76.67:7667?ttl=0" for the local network,
+     * or "memq://" for subscribers in this process.
+     * @param channels: rate of each channel (unit: Hz), rates below or equal to 0 disable the channel.
+     * @param controlFrequency: frequency of the control loop (unit: Hz).
+     * @param capacity: number of samples in the ring buffer.
+     */
+    qrTelemetryPublisher(const std::string &url,
+                         const std::map<std::string, float> &channels,
+                         float controlFrequency,
+                         unsigned int capacity = 256);
+
+    /**
+     * @brief Publish the remaining samples and stop the publisher thread.
+     */
+    ~qrTelemetryPublisher();
+
+    qrTelemetryPublisher(const qrTelemetryPublisher &) = delete;
+
+    qrTelemetryPublisher &operator=(const qrTelemetryPublisher &) = delete;
+
+    /**
+     * @brief Count one control tick and get the sample of this tick, to be filled in place by the control thread.
+     * @return the sample, or nullptr if no channel publishes in this tick or the ring is full.
+     */
+    qr_telemetry_lcmt *BeginSample() override {
+        uint32_t due = 0;
+        for (size_t i = 0; i < periods.size(); ++i) {
+            if (ticks % periods[i] == 0) {
+                due |= 1u << i;
+            }
+        }
+        ++ticks;
+        if (!due) {
+            return nullptr;
+        }
+
+        unsigned long h = head.load(std::memory_order_relaxed);
+        if (h - tail.load(std::memory_order_acquire) >= ring.size()) {
+            ++dropped;
+            return nullptr;
+        }
+        qrTelemetrySample &sample = ring[h % ring.size()];
+        sample.channels = due;
+        return &sample.message;
+    };
+
+    /**
+     * @brief Publish the sample returned by the last BeginSample to the publisher thread.
+     */
+    void CommitSample() override {
+        head.store(head.load(std::memory_order_relaxed) + 1, std::memory_order_release);
+    };
+
+    /**
+     * @brief Number of samples dropped because the ring was full.
+     */
+    unsigned long GetDropped() const {
+        return dropped;
+    };
+
+    /**
+     * @brief Number of messages published, over all channels.
+     */
+    unsigned long GetPublished() const {
+        return published.load(std::memory_order_acquire);
+    };
+
+    /**
+     * @brief The LCM instance of the publisher, to subscribe in this process with the memq provider.
+     */
+    lcm::LCM &GetLcm() {
+        return lcm;
+    };
+
+private:
+
+    /**
+     * @brief A message and the channels it is published on.
+     */
+    struct qrTelemetrySample {
+
+        qr_telemetry_lcmt message;
+
+        /**
+         * @brief Bit i is set if the sample is due on channel i.
+         */
+        uint32_t channels;
+    };
+
+    /**
+     * @brief The publisher thread. Publishes the committed samples.
+     */
+    void Run();
+
+    /**
+     * @brief Encode and publish the committed samples.
+     * @return whether there were samples to publish.
+     */
+    bool Flush();
+
+    /**
+     * @brief The LCM instance, only used by the publisher thread.
+     */
+    lcm::LCM lcm;
+
+    /**
+     * @brief Names of the enabled channels.
+     */
+    std::vector<std::string> channels;
+
+    /**
+     * @brief Decimation of each channel (unit: tick).
+     */
+    std::vector<unsigned int> periods;
+
+    /**
+     * @brief The preallocated samples.
+     */
+    std::vector<qrTelemetrySample> ring;
+
+    /**
+     * @brief Number of samples committed by the control thread.
+     */
+    std::atomic<unsigned long> head;
+
+    /**
+     * @brief Number of samples published by the publisher thread.
+     */
+    std::atomic<unsigned long> tail;
+
+    /**
+     * @brief Number of ticks counted by BeginSample.
+     */
+    unsigned long ticks;
+
+    /**
+     * @brief Number of dropped samples, only touched by the control thread.
+     */
+    unsigned long dropped;
+
+    /**
+     * @brief Number of published messages.
+     */
+    std::atomic<unsigned long> published;
+
+    /**
+     * @brief Buffer of the encoded message, only used by the publisher thread.
+     */
+    std::vector<uint8_t> buffer;
+
+    /**
+     * @brief Whether the publisher thread should keep running.
+     */
+    std::atomic<bool> running;
+
+    /**
+     * @brief The publisher thread.
+     */
+    std::thread thread;
+};
+
+} // namespace Quadruped
+
+#endif // QR_TELEMETRY_PUBLISHER_H
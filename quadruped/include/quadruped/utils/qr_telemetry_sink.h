@@ -0,0 +1,59 @@
+// The MIT License
+
+// Copyright (c) 2022
+// Robot Motion and Vision Laboratory at East China Normal University
+// Contact: tophill.robotics@gmail.com
+
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#ifndef QR_TELEMETRY_SINK_H
+#define QR_TELEMETRY_SINK_H
+
+#include "lcm_types/qr_telemetry_lcmt.hpp"
+
+
+namespace Quadruped {
+
+/**
+ * @brief Where the runner streams the state and commands of the control ticks, e.g. qrTelemetryPublisher over LCM.
+ * Only the message type is shared with LCM: the generated qr_telemetry_lcmt is plain data, so a sink may
+ * forward it on any transport. Both methods are called by the control thread and must not block.
+ */
+class qrTelemetrySink {
+
+public:
+
+    virtual ~qrTelemetrySink() = default;
+
+    /**
+     * @brief Count one control tick and get the message of this tick, to be filled in place by the control thread.
+     * @return the message, or nullptr if nothing is sent in this tick.
+     */
+    virtual qr_telemetry_lcmt *BeginSample() = 0;
+
+    /**
+     * @brief Send the message returned by the last BeginSample.
+     */
+    virtual void CommitSample() = 0;
+
+};
+
+} // namespace Quadruped
+
+#endif // QR_TELEMETRY_SINK_H
@@ -32,8 +32,6 @@
 #include <unistd.h>
 #include <termios.h>
 
-#include <ros/ros.h>
-
 #include "utils/qr_visualization.h"
 #include "utils/qr_print.hpp"
 
@@ -56,16 +54,10 @@ int getch1();
 
 } // Namespace robotics
 
-#ifdef _useros
-/**
- * @brief A toolkit for loading yaml config file correctly.
- */
-std::string GetHomeDir(std::string homeName = "quadruped-robot/");
-#else
 /**
  * @brief A toolkit for loading yaml config file correctly.
+ * The quadruped package of a catkin workspace is preferred, i.e. homeName + "src/quadruped/", if it exists.
  */
 std::string GetHomeDir(std::string homeName = "quadruped-robot/");
-#endif
 
 #endif // QR_TOOLS_H
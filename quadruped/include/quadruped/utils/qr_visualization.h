@@ -29,7 +29,12 @@
 #include <vector>
 #include <string>
 
+#include "utils/qr_running_stats.h"
 
+
+/**
+ * @brief Mean and variance of a signal, updated online without keeping the samples.
+ */
 class StatisticAnalysis {
 
 public:
@@ -40,10 +45,18 @@ public:
 
     void Update(float in);
 
+    /**
+     * @brief Forget the samples.
+     * @param mean: the mean returned before the next sample.
+     */
     void Reset(float mean=0.f);
 
     float GetMean();
 
+    /**
+     * @brief Compute the statistics of the samples so far, can be called at any time.
+     * @return standard deviation.
+     */
     float GetStandradVar();
 
     void PrintStatistics();
@@ -60,7 +73,7 @@ public:
 
     int num;
 
-    std::vector<float> data;
+    Quadruped::qrRunningStats stats;
 
 };
 
@@ -68,12 +81,27 @@ class Visualization2D {
 
 public:
 
+    /**
+     * @brief Draws the curves of a Visualization2D, e.g. with matplotlib.
+     */
+    typedef void (*Plotter)(const Visualization2D &);
+
     Visualization2D();
 
     ~Visualization2D() = default;
 
+    /**
+     * @brief Plot the curves with the plotter and exit.
+     * Without a plotter, e.g. when the ROS adapter is not loaded, only the sizes of the curves are printed.
+     */
     void Show();
 
+    /**
+     * @brief Set the plotter of Show. The ROS adapter sets the matplotlib plotter when it is loaded.
+     * @param plotterIn: the plotter, nullptr to plot nothing.
+     */
+    static void SetPlotter(Plotter plotterIn);
+
     void SetLabelNames(std::vector<std::string>);
 
     std::vector<float> datax;
@@ -84,6 +112,13 @@ public:
 
     StatisticAnalysis sa[6];
 
+private:
+
+    /**
+     * @brief The plotter of Show.
+     */
+    static Plotter plotter;
+
 };
 
 #endif // QR_VISUALIZATION_H
@@ -0,0 +1,296 @@
+// The MIT License
+
+// Copyright (c) 2022
+// Robot Motion and Vision Laboratory at East China Normal University
+// Contact: tophill.robotics@gmail.com
+
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+#include "qr_batch_evaluator.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cstring>
+#include <limits>
+#include <stdexcept>
+#include <thread>
+
+
+namespace Quadruped {
+
+qrBatchEvaluator::qrBatchEvaluator(const std::string &homeDirIn, const std::string &robotName, int horizonIn,
+                                   unsigned int numWorkersIn):
+    horizon(horizonIn),
+    numWorkers(numWorkersIn)
+{
+    std::string homeDir = homeDirIn;
+    if (!homeDir.empty() && homeDir.back() != '/') {
+        homeDir += "/";
+    }
+    if (numWorkers == 0) {
+        numWorkers = std::max(1u, std::thread::hardware_concurrency());
+    }
+
+    /* The rows are evaluated in parallel, by the workers and by the Python threads that call in without the GIL,
+     * so Eigen must not start OpenMP threads of its own for the products of a row.
+     */
+    Eigen::setNbThreads(1);
+
+    YAML::Node stanceParams = YAML::LoadFile(homeDir + "config/" + robotName + "/stance_leg_controller.yaml")
+                                  ["stance_leg_params"]["advanced_trot"];
+    std::vector<float> v = stanceParams["Q"].as<std::vector<float>>();
+    std::copy(v.begin(), v.begin() + 12, mpcWeights);
+    v = stanceParams["acc_weight"].as<std::vector<float>>();
+    accWeight = Eigen::Map<Vec6<float>>(&v[0]);
+
+    for (unsigned int i = 0; i < numWorkers; ++i) {
+        qrWorker *worker = new qrWorker();
+        worker->robot = new qrRobotReplay(homeDir + "config/" + robotName + "/" + robotName + ".yaml");
+        worker->robot->BuildDynamicModel();
+
+        qrRobot *robot = worker->robot;
+        Vec3<float> inertia(robot->totalInertia(0, 0), robot->totalInertia(1, 1), robot->totalInertia(2, 2));
+        worker->mpcProblem.SetupProblem(0.06, horizon, 0.45, robot->totalMass * 9.81, robot->totalMass,
+                                        inertia.data(), mpcWeights, 4e-6);
+        workers.push_back(worker);
+    }
+}
+
+
+qrBatchEvaluator::~qrBatchEvaluator()
+{
+    for (qrWorker *worker : workers) {
+        delete worker->robot;
+        delete worker;
+    }
+}
+
+
+void qrBatchEvaluator::FootPositions(qrBatchIn q, qrBatchOut out)
+{
+    CheckShape("q", q.rows(), q.cols(), q.rows(), NumMotor);
+    CheckShape("out", out.rows(), out.cols(), q.rows(), 12);
+    ForEach(q.rows(), [&](qrWorker &worker, long i) {
+        Eigen::Map<Mat34<float>>(out.row(i).data()) =
+            worker.robot->FootPositionsInBaseFrame(Eigen::Map<const Vec12<float>>(q.row(i).data()));
+    });
+}
+
+
+void qrBatchEvaluator::Jacobians(qrBatchIn q, qrBatchOut out)
+{
+    CheckShape("q", q.rows(), q.cols(), q.rows(), NumMotor);
+    CheckShape("out", out.rows(), out.cols(), q.rows(), 36);
+    ForEach(q.rows(), [&](qrWorker &worker, long i) {
+        Eigen::Map<const Vec12<float>> angles(q.row(i).data());
+        for (int leg = 0; leg < NumLeg; ++leg) {
+            Vec3<float> legAngles = angles.segment<3>(3 * leg);
+            Eigen::Map<Eigen::Matrix<float, 3, 3, Eigen::RowMajor>>(out.row(i).data() + 9 * leg) =
+                worker.robot->AnalyticalLegJacobian(legAngles, leg);
+        }
+    });
+}
+
+
+void qrBatchEvaluator::InverseKinematics(qrBatchIn footPositions, qrBatchOut out)
+{
+    CheckShape("footPositions", footPositions.rows(), footPositions.cols(), footPositions.rows(), 12);
+    CheckShape("out", out.rows(), out.cols(), footPositions.rows(), NumMotor);
+    ForEach(footPositions.rows(), [&](qrWorker &worker, long i) {
+        Eigen::Map<const Mat34<float>> feet(footPositions.row(i).data());
+        Vec3<int> jointIdx;
+        Vec3<float> jointAngles;
+        for (int leg = 0; leg < NumLeg; ++leg) {
+            worker.robot->ComputeMotorAnglesFromFootLocalPosition(leg, feet.col(leg), jointIdx, jointAngles);
+            for (int j = 0; j < 3; ++j) {
+                out(i, jointIdx[j]) = jointAngles[j];
+            }
+        }
+    });
+}
+
+
+void qrBatchEvaluator::MassMatrix(qrBatchIn states, qrBatchOut out)
+{
+    CheckShape("states", states.rows(), states.cols(), states.rows(), qrBatchState::DIM);
+    CheckShape("out", out.rows(), out.cols(), states.rows(), 18 * 18);
+    ForEach(states.rows(), [&](qrWorker &worker, long i) {
+        LoadState(worker, states.row(i).data());
+        FloatingBaseModel<float> &model = worker.robot->model;
+        model.setState(worker.modelState);
+        Eigen::Map<Eigen::Matrix<float, 18, 18, Eigen::RowMajor>>(out.row(i).data()) = model.massMatrix();
+    });
+}
+
+
+void qrBatchEvaluator::Coriolis(qrBatchIn states, qrBatchOut out)
+{
+    CheckShape("states", states.rows(), states.cols(), states.rows(), qrBatchState::DIM);
+    CheckShape("out", out.rows(), out.cols(), states.rows(), 18);
+    ForEach(states.rows(), [&](qrWorker &worker, long i) {
+        LoadState(worker, states.row(i).data());
+        FloatingBaseModel<float> &model = worker.robot->model;
+        model.setState(worker.modelState);
+        out.row(i) = model.generalizedCoriolisForce().transpose();
+    });
+}
+
+
+void qrBatchEvaluator::ContactJacobians(qrBatchIn states, qrBatchOut out)
+{
+    CheckShape("states", states.rows(), states.cols(), states.rows(), qrBatchState::DIM);
+    CheckShape("out", out.rows(), out.cols(), states.rows(), 4 * 3 * 18);
+    const int footLinks[4] = {linkID::FR, linkID::FL, linkID::HR, linkID::HL};
+    ForEach(states.rows(), [&](qrWorker &worker, long i) {
+        LoadState(worker, states.row(i).data());
+        FloatingBaseModel<float> &model = worker.robot->model;
+        model.setState(worker.modelState);
+        model.contactJacobians();
+        for (int leg = 0; leg < NumLeg; ++leg) {
+            Eigen::Map<Eigen::Matrix<float, 3, 18, Eigen::RowMajor>>(out.row(i).data() + 54 * leg) =
+                model._Jc[footLinks[leg]];
+        }
+    });
+}
+
+
+void qrBatchEvaluator::ContactForce(qrBatchIn states, qrBatchIn desiredAcc, qrBatchIn contacts, qrBatchOut out)
+{
+    const long n = states.rows();
+    CheckShape("states", states.rows(), states.cols(), n, qrBatchState::DIM);
+    CheckShape("desiredAcc", desiredAcc.rows(), desiredAcc.cols(), n, 6);
+    CheckShape("contacts", contacts.rows(), contacts.cols(), n, NumLeg);
+    CheckShape("out", out.rows(), out.cols(), n, 12);
+    ForEach(n, [&](qrWorker &worker, long i) {
+        LoadState(worker, states.row(i).data());
+        Eigen::Matrix<bool, 4, 1> contact = Eigen::Map<const Vec4<float>>(contacts.row(i).data()).array() > 0.5f;
+        Eigen::Map<Mat34<float>> force(out.row(i).data());
+        try {
+            force = ComputeContactForce(worker.robot, Eigen::Map<const Vec6<float>>(desiredAcc.row(i).data()),
+                                        contact, accWeight, {0.f, 0.f, 1.f}, {1.f, 0.f, 0.f}, {0.f, 1.f, 0.f});
+        } catch (const std::domain_error &) {
+            force.setConstant(std::numeric_limits<float>::quiet_NaN());
+        }
+    });
+}
+
+
+void qrBatchEvaluator::SolveMPC(qrBatchIn states, qrBatchIn trajectories, qrBatchIn gaits, qrBatchOut out)
+{
+    const long n = states.rows();
+    CheckShape("states", states.rows(), states.cols(), n, qrBatchState::DIM);
+    CheckShape("trajectories", trajectories.rows(), trajectories.cols(), n, 12 * horizon);
+    CheckShape("gaits", gaits.rows(), gaits.cols(), n, NumLeg * horizon);
+    CheckShape("out", out.rows(), out.cols(), n, 12);
+    ForEach(n, [&](qrWorker &worker, long i) {
+        LoadState(worker, states.row(i).data());
+        qrRobot *robot = worker.robot;
+        auto &dataFlow = robot->stateDataFlow;
+        Vec3<float> p = robot->GetBasePosition();
+        Quat<float> q = robot->GetBaseOrientation();
+        Vec3<float> rpy = robot->GetBaseRollPitchYaw();
+        Eigen::Matrix<float, 3, 4> r = dataFlow.baseRMat * (robot->GetFootPositionsInBaseFrame().colwise() - robot->comOffset);
+
+        /* SolveMPCKernel does not write its inputs, it only lacks the const qualifiers. */
+        worker.mpcProblem.SolveMPCKernel(p, dataFlow.baseVInWorldFrame, q, dataFlow.baseWInWorldFrame, r, rpy,
+                                         const_cast<float *>(trajectories.row(i).data()),
+                                         const_cast<float *>(gaits.row(i).data()));
+        for (int j = 0; j < 12; ++j) {
+            out(i, j) = worker.mpcProblem.GetMPCSolution(j);
+        }
+    });
+}
+
+
+void qrBatchEvaluator::LoadState(qrWorker &worker, const float *state)
+{
+    qrRobotReplay *robot = worker.robot;
+    Eigen::Map<const Vec3<float>> rpy(state + qrBatchState::RPY);
+    Eigen::Map<const Vec3<float>> vWorld(state + qrBatchState::LINEAR_VELOCITY);
+    Eigen::Map<const Vec3<float>> wWorld(state + qrBatchState::ANGULAR_VELOCITY);
+    Mat3<float> rotMat = robotics::math::rpyToRotMat(rpy).transpose();
+
+    /* The robot inputs of a record, then the estimated state, as the bench and the replay load it. */
+    qrFlightRecord record;
+    memset(&record, 0, sizeof(record));
+    Eigen::Map<Vec3<float>>(record.rpy) = rpy;
+    Eigen::Map<Vec3<float>>(record.gyro) = rotMat.transpose() * wWorld;
+    Eigen::Map<Vec3<float>>(record.accelerometer) << 0.f, 0.f, 9.81f;
+    Eigen::Map<Vec12<float>>(record.motorAngles) = Eigen::Map<const Vec12<float>>(state + qrBatchState::Q);
+    Eigen::Map<Vec12<float>>(record.motorVelocities) = Eigen::Map<const Vec12<float>>(state + qrBatchState::QD);
+    Eigen::Map<Vec3<float>>(record.basePosition) = Eigen::Map<const Vec3<float>>(state + qrBatchState::POSITION);
+    robot->LoadRecord(record);
+
+    auto &dataFlow = robot->stateDataFlow;
+    robot->basePosition = Eigen::Map<const Vec3<float>>(state + qrBatchState::POSITION);
+    dataFlow.baseVInWorldFrame = vWorld;
+    dataFlow.baseWInWorldFrame = wWorld;
+    robot->baseVelocityInBaseFrame = dataFlow.baseRMat.transpose() * vWorld;
+
+    FBModelState<float> &modelState = worker.modelState;
+    modelState.bodyOrientation = robot->GetBaseOrientation();
+    modelState.bodyPosition = robot->GetBasePosition();
+    modelState.bodyVelocity << robot->GetBaseRollPitchYawRate(), robot->GetBaseVelocityInBaseFrame();
+    modelState.q = robot->GetMotorAngles();
+    modelState.qd = robot->GetMotorVelocities();
+}
+
+
+void qrBatchEvaluator::ForEach(long n, const std::function<void(qrWorker &, long)> &eval)
+{
+    std::lock_guard<std::mutex> lock(workersMutex);
+    unsigned int threadNum = std::min<long>(numWorkers, n);
+    if (threadNum <= 1) {
+        for (long i = 0; i < n; ++i) {
+            eval(*workers[0], i);
+        }
+        return;
+    }
+
+    /* The rows are handed out in chunks, so that the counter is not contended for the cheap kernels. */
+    const long chunk = std::max(1L, n / (8 * long(threadNum)));
+    std::atomic<long> next(0);
+    auto work = [&](qrWorker &worker) {
+        for (long begin = next.fetch_add(chunk); begin < n; begin = next.fetch_add(chunk)) {
+            for (long i = begin; i < std::min(n, begin + chunk); ++i) {
+                eval(worker, i);
+            }
+        }
+    };
+
+    std::vector<std::thread> threads;
+    for (unsigned int i = 1; i < threadNum; ++i) {
+        threads.emplace_back(work, std::ref(*workers[i]));
+    }
+    work(*workers[0]);
+    for (auto &thread : threads) {
+        thread.join();
+    }
+}
+
+
+void qrBatchEvaluator::CheckShape(const char *name, long rows, long cols, long n, long expectedCols)
+{
+    if (rows != n || cols != expectedCols) {
+        throw std::invalid_argument(std::string(name) + " must be " + std::to_string(n) + " x "
+                                    + std::to_string(expectedCols) + ", not " + std::to_string(rows)
+                                    + " x " + std::to_string(cols));
+    }
+}
+
+} // namespace Quadruped
@@ -0,0 +1,216 @@
+// The MIT License
+
+// Copyright (c) 2022
+// Robot Motion and Vision Laboratory at East China Normal University
+// Contact: tophill.robotics@gmail.com
+
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#ifndef QR_BATCH_EVALUATOR_H
+#define QR_BATCH_EVALUATOR_H
+
+#include <functional>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include "robots/qr_robot_replay.h"
+#include "controllers/mpc/qr_mpc_interface.h"
+#include "controllers/balance_controller/qr_qp_torque_optimizer.h"
+
+
+namespace Quadruped {
+
+/**
+ * @brief A batch of float arrays, one state per row, as NumPy lays out a C-contiguous float32 array.
+ */
+using qrBatchIn = Eigen::Ref<const Eigen::Matrix<float, Eigen::Dynamic, Eigen::Dynamic, Eigen::RowMajor>>;
+
+/**
+ * @brief A batch of outputs, one state per row, written in place.
+ */
+using qrBatchOut = Eigen::Ref<Eigen::Matrix<float, Eigen::Dynamic, Eigen::Dynamic, Eigen::RowMajor>>;
+
+/**
+ * @brief Layout of a row of the state batch, i.e. the state of the robot as the controllers read it.
+ * The velocities are in world frame, as in stateDataFlow.
+ */
+namespace qrBatchState {
+constexpr int POSITION = 0;
+constexpr int RPY = 3;
+constexpr int LINEAR_VELOCITY = 6;
+constexpr int ANGULAR_VELOCITY = 9;
+constexpr int Q = 12;
+constexpr int QD = 24;
+constexpr int DIM = 36;
+} // namespace qrBatchState
+
+/**
+ * @brief Evaluates the kernels of the control stack on a batch of states.
+ * Each worker has a replay robot and an MPC problem of its own, so the states are evaluated
+ * concurrently without locks. The batches are read and written in place, and the calls do not touch
+ * Python, so the bindings release the GIL around them.
+ */
+class qrBatchEvaluator {
+
+public:
+
+    /**
+     * @brief Constructor of class qrBatchEvaluator.
+     * @param homeDir: directory of the configuration files.
+     * @param robotName: robot of the configuration, e.g. a1_sim.
+     * @param horizon: steps of the MPC problem.
+     * @param numWorkers: threads evaluating a batch, 0 for one per core.
+     */
+    qrBatchEvaluator(const std::string &homeDir, const std::string &robotName, int horizon = 10,
+                     unsigned int numWorkers = 1);
+
+    ~qrBatchEvaluator();
+
+    qrBatchEvaluator(const qrBatchEvaluator &) = delete;
+
+    qrBatchEvaluator &operator=(const qrBatchEvaluator &) = delete;
+
+    /**
+     * @brief Foot positions in base frame from the joint angles.
+     * @param q: N x 12 joint angles.
+     * @param out: N x 12, the columns of the 3 x 4 foot positions, leg after leg.
+     */
+    void FootPositions(qrBatchIn q, qrBatchOut out);
+
+    /**
+     * @brief Jacobians of the feet in base frame.
+     * @param q: N x 12 joint angles.
+     * @param out: N x 36, the row-major 3 x 3 Jacobian of each leg.
+     */
+    void Jacobians(qrBatchIn q, qrBatchOut out);
+
+    /**
+     * @brief Joint angles from the foot positions in base frame.
+     * @param footPositions: N x 12, laid out as the output of FootPositions.
+     * @param out: N x 12 joint angles.
+     */
+    void InverseKinematics(qrBatchIn footPositions, qrBatchOut out);
+
+    /**
+     * @brief Mass matrix of the floating base model.
+     * @param states: N x qrBatchState::DIM.
+     * @param out: N x 324, the row-major 18 x 18 mass matrix.
+     */
+    void MassMatrix(qrBatchIn states, qrBatchOut out);
+
+    /**
+     * @brief Generalized coriolis and centrifugal force of the floating base model.
+     * @param states: N x qrBatchState::DIM.
+     * @param out: N x 18.
+     */
+    void Coriolis(qrBatchIn states, qrBatchOut out);
+
+    /**
+     * @brief Contact Jacobians of the feet in world frame from the floating base model.
+     * @param states: N x qrBatchState::DIM.
+     * @param out: N x 216, the row-major 3 x 18 Jacobian of each foot.
+     */
+    void ContactJacobians(qrBatchIn states, qrBatchOut out);
+
+    /**
+     * @brief The contact forces of the QP torque stance leg controller, see ComputeContactForce.
+     * @param states: N x qrBatchState::DIM.
+     * @param desiredAcc: N x 6, desired linear and angular acceleration of the base in world frame.
+     * @param contacts: N x 4, a leg is in contact if its value is above 0.5.
+     * @param out: N x 12, the force each foot applies in world frame, NaN where the QP has no solution.
+     */
+    void ContactForce(qrBatchIn states, qrBatchIn desiredAcc, qrBatchIn contacts, qrBatchOut out);
+
+    /**
+     * @brief The ground reaction forces of the first step of the MPC problem, see qrMPCProblem::SolveMPCKernel.
+     * @param states: N x qrBatchState::DIM.
+     * @param trajectories: N x (12 * horizon), desired (rpy, position, angular velocity, linear velocity) of each step.
+     * @param gaits: N x (4 * horizon), whether each leg is in stance at each step.
+     * @param out: N x 12, the reaction force of each foot in world frame.
+     */
+    void SolveMPC(qrBatchIn states, qrBatchIn trajectories, qrBatchIn gaits, qrBatchOut out);
+
+    /**
+     * @brief Steps of the MPC problem.
+     */
+    int GetHorizon() const {
+        return horizon;
+    };
+
+    /**
+     * @brief Number of threads evaluating a batch.
+     */
+    unsigned int GetNumWorkers() const {
+        return numWorkers;
+    };
+
+private:
+
+    /**
+     * @brief What a worker evaluates the states with.
+     */
+    struct qrWorker {
+
+        EIGEN_MAKE_ALIGNED_OPERATOR_NEW
+
+        qrRobotReplay *robot;
+
+        qrMPCProblem mpcProblem;
+
+        FBModelState<float> modelState;
+    };
+
+    /**
+     * @brief Load a row of the state batch into the robot and the state of its dynamic model.
+     */
+    void LoadState(qrWorker &worker, const float *state);
+
+    /**
+     * @brief Run eval(worker, i) for i in [0, n), the rows being shared out among the workers.
+     */
+    void ForEach(long n, const std::function<void(qrWorker &, long)> &eval);
+
+    /**
+     * @brief Check that the batch has n rows of cols columns, and throw std::invalid_argument if not.
+     */
+    static void CheckShape(const char *name, long rows, long cols, long n, long expectedCols);
+
+    int horizon;
+
+    unsigned int numWorkers;
+
+    std::vector<qrWorker *> workers;
+
+    /**
+     * @brief Serializes the calls on the same evaluator, which share the workers.
+     */
+    std::mutex workersMutex;
+
+    /**
+     * @brief Weights of the stance leg controllers in stance_leg_controller.yaml.
+     */
+    float mpcWeights[12];
+
+    Vec6<float> accWeight;
+};
+
+} // namespace Quadruped
+
+#endif // QR_BATCH_EVALUATOR_H
@@ -0,0 +1,157 @@
+// The MIT License
+
+// Copyright (c) 2022
+// Robot Motion and Vision Laboratory at East China Normal University
+// Contact: tophill.robotics@gmail.com
+
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+#include <pybind11/pybind11.h>
+#include <pybind11/eigen.h>
+#include <pybind11/numpy.h>
+
+#include "qr_batch_evaluator.h"
+
+namespace py = pybind11;
+using namespace Quadruped;
+
+
+namespace {
+
+/**
+ * @brief The output batch of a call, allocated if the caller has not given one.
+ * A given array is written in place, so it must be a writeable C-contiguous float32 array.
+ */
+qrBatchOut OutputOf(py::object &out, long rows, long cols)
+{
+    if (out.is_none()) {
+        out = py::array_t<float, py::array::c_style>({rows, cols});
+    }
+    try {
+        return out.cast<qrBatchOut>();
+    } catch (const py::cast_error &) {
+        throw py::type_error("out must be a writeable C-contiguous float32 array");
+    }
+}
+
+} // Anonymous namespace
+
+
+/* The batches are mapped as Eigen::Ref, so C-contiguous float32 arrays are read and written without copy.
+ * The other arrays are converted to float32 first. The evaluation itself runs without the GIL,
+ * and the arrays are only touched with the GIL held.
+ */
+PYBIND11_MODULE(quadruped_py, m) {
+    m.doc() = "Batched evaluation of the kernels of the quadruped control stack.";
+
+    /* pybind11 looks the NumPy API up on the first array, importing numpy. That must not happen in a call
+     * from a thread, as another thread may wait on the lookup with the GIL held.
+     */
+    py::dtype::of<float>();
+
+    m.attr("STATE_POSITION") = qrBatchState::POSITION;
+    m.attr("STATE_RPY") = qrBatchState::RPY;
+    m.attr("STATE_LINEAR_VELOCITY") = qrBatchState::LINEAR_VELOCITY;
+    m.attr("STATE_ANGULAR_VELOCITY") = qrBatchState::ANGULAR_VELOCITY;
+    m.attr("STATE_Q") = qrBatchState::Q;
+    m.attr("STATE_QD") = qrBatchState::QD;
+    m.attr("STATE_DIM") = qrBatchState::DIM;
+
+    py::class_<qrBatchEvaluator>(m, "BatchEvaluator")
+        .def(py::init<const std::string &, const std::string &, int, unsigned int>(),
+             py::arg("home_dir"), py::arg("robot_name"), py::arg("horizon") = 10, py::arg("num_workers") = 1,
+             "Load the robot of home_dir/config/robot_name. num_workers threads evaluate a batch, 0 for one per core.")
+        .def_property_readonly("horizon", &qrBatchEvaluator::GetHorizon)
+        .def_property_readonly("num_workers", &qrBatchEvaluator::GetNumWorkers)
+        .def("foot_positions", [](qrBatchEvaluator &self, qrBatchIn q, py::object out) {
+            qrBatchOut result = OutputOf(out, q.rows(), 12);
+            {
+                py::gil_scoped_release release;
+                self.FootPositions(q, result);
+            }
+            return out;
+        }, py::arg("q"), py::arg("out") = py::none(),
+        "N x 12 joint angles -> N x 12 foot positions in base frame, the columns of the 3 x 4 matrix.")
+        .def("jacobians", [](qrBatchEvaluator &self, qrBatchIn q, py::object out) {
+            qrBatchOut result = OutputOf(out, q.rows(), 36);
+            {
+                py::gil_scoped_release release;
+                self.Jacobians(q, result);
+            }
+            return out;
+        }, py::arg("q"), py::arg("out") = py::none(),
+        "N x 12 joint angles -> N x 36 foot Jacobians in base frame, a row-major 3 x 3 matrix per leg.")
+        .def("inverse_kinematics", [](qrBatchEvaluator &self, qrBatchIn footPositions, py::object out) {
+            qrBatchOut result = OutputOf(out, footPositions.rows(), 12);
+            {
+                py::gil_scoped_release release;
+                self.InverseKinematics(footPositions, result);
+            }
+            return out;
+        }, py::arg("foot_positions"), py::arg("out") = py::none(),
+        "N x 12 foot positions in base frame -> N x 12 joint angles.")
+        .def("mass_matrix", [](qrBatchEvaluator &self, qrBatchIn states, py::object out) {
+            qrBatchOut result = OutputOf(out, states.rows(), 18 * 18);
+            {
+                py::gil_scoped_release release;
+                self.MassMatrix(states, result);
+            }
+            return out;
+        }, py::arg("states"), py::arg("out") = py::none(),
+        "N x STATE_DIM states -> N x 324 row-major 18 x 18 mass matrices of the floating base model.")
+        .def("coriolis", [](qrBatchEvaluator &self, qrBatchIn states, py::object out) {
+            qrBatchOut result = OutputOf(out, states.rows(), 18);
+            {
+                py::gil_scoped_release release;
+                self.Coriolis(states, result);
+            }
+            return out;
+        }, py::arg("states"), py::arg("out") = py::none(),
+        "N x STATE_DIM states -> N x 18 coriolis and centrifugal forces of the floating base model.")
+        .def("contact_jacobians", [](qrBatchEvaluator &self, qrBatchIn states, py::object out) {
+            qrBatchOut result = OutputOf(out, states.rows(), 4 * 3 * 18);
+            {
+                py::gil_scoped_release release;
+                self.ContactJacobians(states, result);
+            }
+            return out;
+        }, py::arg("states"), py::arg("out") = py::none(),
+        "N x STATE_DIM states -> N x 216 foot contact Jacobians, a row-major 3 x 18 matrix per leg.")
+        .def("contact_force", [](qrBatchEvaluator &self, qrBatchIn states, qrBatchIn desiredAcc,
+                                 qrBatchIn contacts, py::object out) {
+            qrBatchOut result = OutputOf(out, states.rows(), 12);
+            {
+                py::gil_scoped_release release;
+                self.ContactForce(states, desiredAcc, contacts, result);
+            }
+            return out;
+        }, py::arg("states"), py::arg("desired_acc"), py::arg("contacts"), py::arg("out") = py::none(),
+        "N x STATE_DIM states, N x 6 desired base accelerations and N x 4 contacts -> N x 12 foot forces of "
+        "the QP stance leg controller in world frame, NaN where the QP has no solution.")
+        .def("solve_mpc", [](qrBatchEvaluator &self, qrBatchIn states, qrBatchIn trajectories,
+                             qrBatchIn gaits, py::object out) {
+            qrBatchOut result = OutputOf(out, states.rows(), 12);
+            {
+                py::gil_scoped_release release;
+                self.SolveMPC(states, trajectories, gaits, result);
+            }
+            return out;
+        }, py::arg("states"), py::arg("trajectories"), py::arg("gaits"), py::arg("out") = py::none(),
+        "N x STATE_DIM states, N x (12 * horizon) desired trajectories and N x (4 * horizon) gaits -> "
+        "N x 12 ground reaction forces of the first MPC step in world frame.");
+}
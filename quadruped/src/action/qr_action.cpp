@@ -30,9 +30,9 @@ namespace Action {
 
 void StandUp(qrRobot *robot, float standUpTime, float totalTime, float timeStep)
 {
-    qrTimer timer;
-    float startTime = timer.GetTimeSinceReset();// robot->GetTimeSinceReset();
-    float endTime = startTime + standUpTime;
+    /* Follow the robot time, which may be the simulated time of a robot running in lock-step. */
+    float startTime = robot->GetTimeSinceReset();
+    float endTime = startTime + totalTime;
     Eigen::Matrix<float, 12, 1> motorAnglesBeforeStandUP = robot->GetMotorAngles();
     std::cout << "motorAnglesBeforeStandUP: \n" << motorAnglesBeforeStandUP.transpose() << std::endl;
     std::cout << "---------------------Standing Up---------------------" << std::endl;
@@ -42,7 +42,7 @@ void StandUp(qrRobot *robot, float standUpTime, float totalTime, float timeStep)
 
     Visualization2D& vis = robot->stateDataFlow.visualizer;
 
-  for (float t = startTime; t < totalTime; t += timeStep) {
+  for (float t = startTime; t < endTime; t += timeStep) {
         float blendRatio = (t - startTime) / standUpTime;
 
         if (blendRatio < 1.0f) {
@@ -68,7 +68,7 @@ void StandUp(qrRobot *robot, float standUpTime, float totalTime, float timeStep)
         } else {
             robot->Step(robot->standUpMotorAngles, MotorMode::POSITION_MODE);
         }
-    while (timer.GetTimeSinceReset() < t + timeStep) {}
+    robot->WaitUntil(t + timeStep);
     }
     std::cout << "robot->GetMotorAngles: \n" << robot->GetMotorAngles().transpose() << std::endl;
     std::cout << "---------------------Stand Up Finished---------------------" << std::endl;
@@ -90,7 +90,7 @@ void SitDown(qrRobot *robot, float sitDownTime, float timeStep)
         Eigen::Matrix<float, 12, 1> action;
         action = blendRatio * robot->sitDownMotorAngles + (1 - blendRatio) * motorAnglesBeforeSitDown;
         robot->Step(action, MotorMode::POSITION_MODE);
-        while (robot->GetTimeSinceReset() < t + timeStep) {}
+        robot->WaitUntil(t + timeStep);
     }
     std::cout << "---------------------Sit down Finished---------------------" << std::endl;
 }
@@ -113,7 +113,7 @@ void KeepStand(qrRobot *robot, float KeepStandTime, float timeStep)
         motorAngles = blendRatio * motorAnglesAfterKeepStand + (1 - blendRatio) * motorAnglesBeforeKeepStand;
 
         robot->Step(motorAngles, MotorMode::POSITION_MODE);
-        while (robot->GetTimeSinceReset() < t + timeStep) {}
+        robot->WaitUntil(t + timeStep);
     }
 }
 
@@ -57,6 +57,7 @@ TorqueStanceLegController::TorqueStanceLegController(qrRobot *robot,
     this->computeForceInWorldFrame = userParameters.computeForceInWorldFrame;
 
     this->param = YAML::LoadFile(configFilepath);
+    action.resize(NumMotor);
 
     Reset(0.f);
 }
@@ -477,7 +478,7 @@ void TorqueStanceLegController::UpdateDesCommand()
 }
     
 
-std::tuple<std::map<int, qrMotorCommand>, Eigen::Matrix<float, 3, 4>> TorqueStanceLegController::GetAction()
+std::tuple<const std::vector<qrMotorCommand>&, Eigen::Matrix<float, 3, 4>> TorqueStanceLegController::GetAction()
 {
     ++count;
 
@@ -500,8 +501,7 @@ std::tuple<std::map<int, qrMotorCommand>, Eigen::Matrix<float, 3, 4>> TorqueStan
         contactForces << ComputeContactForce(robot, groundEstimator, desiredDdq, contacts, accWeight);
     }
 
-    std::map<int, qrMotorCommand> action;
-    std::map<int, float> motorTorques;
+    Vec3<float> motorTorques;
     Eigen::Matrix<float, 12, 1> kps = robot->GetMotorKps();
     Eigen::Matrix<float, 12, 1> kds = robot->GetMotorKdp();
 
@@ -520,9 +520,9 @@ std::tuple<std::map<int, qrMotorCommand>, Eigen::Matrix<float, 3, 4>> TorqueStan
                              0.0 * kps(3 * legId + motorId),
                              0.0,
                              0.5 * kds(3 * legId + motorId),
-                             motorTorques[3 * legId + motorId]};
+                             motorTorques[motorId]};
                 } else if ((N < 4 && moveBasePhase < 0.7) || robot->stop) {
-                    temp = {0, 0, 0., kds(3 * legId + motorId) * 0.0, motorTorques[3 * legId + motorId]};
+                    temp = {0, 0, 0., kds(3 * legId + motorId) * 0.0, motorTorques[motorId]};
                 } else {
                     /* When moveBasePhase > 0.7 */
                     temp = {0., 0., 0., 0., 0.};
@@ -532,16 +532,15 @@ std::tuple<std::map<int, qrMotorCommand>, Eigen::Matrix<float, 3, 4>> TorqueStan
             break;
         default:
             /* Trotting with force balance. */
-            for (map<int, float>::iterator it = motorTorques.begin(); it != motorTorques.end(); ++it) {
-                temp = {0., 0., 0., 0., it->second};
-                action[it->first] = temp;
+            for (int motorId = 0; motorId < 3; motorId++) {
+                temp = {0., 0., 0., 0., motorTorques[motorId]};
+                action[motorId + 3 * legId] = temp;
             }
             break;
         }
     }
 
-    std::tuple<std::map<int, qrMotorCommand>, Eigen::Matrix<float, 3, 4>> actionContactForce(action, contactForces);
-    return actionContactForce;
+    return {action, contactForces};
 }
 
 } // namespace Quadruped
@@ -23,6 +23,7 @@
 // SOFTWARE.
 
 #include "controllers/mpc/qr_mpc_interface.h"
+#include "utils/qr_solver_arena.h"
 #include <unsupported/Eigen/MatrixFunctions>
 
 #define BIG_NUMBER 5e10
@@ -31,78 +32,6 @@ using Eigen::Dynamic;
 using Eigen::Matrix;
 using robotics::math::crossMatrix;
 
-/// The problem configuration, for example, horizon length, weight and other robot infomation.
-static Quadruped::ProblemConfig problemConfig;
-
-/// Basic robot states, for example, pose, twist, rotation matrix and so on.
-static Quadruped::MPCRobotState robotState;
-
-/// Whether the MPC problem has been solved by qpOASES.
-static int has_solved = 0;
-
-/// State matrix consists of %horizon states.
-static Matrix<float, Eigen::Dynamic, 13> Aqp;
-
-/// Transform matrix consists of 4 * %horizon forces
-static Matrix<float, Eigen::Dynamic, Eigen::Dynamic> Bqp;
-
-/// Transform matrix in discrete form.
-static Matrix<float, 13, 12> Bdt;
-
-/// State matrix in discrete form.
-static Matrix<float, 13, 13> Adt;
-
-/// Auxilliary matrix while calculating discrete dynamics.
-static Matrix<float, 25, 25> ABc, expmm;
-
-/// The predictive state trajectory.
-static Matrix<float, Eigen::Dynamic, 1> X_d;
-
-/// Upper bound for the constraint of forces.
-static Matrix<float, Eigen::Dynamic, 1> U_b;
-
-/// Friction cone and force limit matrix for constraint of forces.
-static Matrix<float, Eigen::Dynamic, Eigen::Dynamic> fmat;
-
-/// Hessian matrix used in QP form of MPC problem.
-static Matrix<float, Eigen::Dynamic, Eigen::Dynamic> qH;
-
-/// Linear term used in QP form of MPC problem.
-static Matrix<float, Eigen::Dynamic, 1> qg;
-
-/// A matrix with small value for constructing Hessian matrix.
-static Matrix<float, Eigen::Dynamic, Eigen::Dynamic> Idendity12Horizon;
-
-/// Hessian matrix in qpOASES form.
-static qpOASES::real_t *H_qpoases = nullptr;
-
-/// g vector in qpOASES form.
-static qpOASES::real_t *g_qpoases = nullptr;
-
-/// Constraint matrix in qpOASES form.
-static qpOASES::real_t *A_qpoases = nullptr;
-
-/// Lower bound vector in qpOASES form.
-static qpOASES::real_t *lb_qpoases = nullptr;
-
-/// Upper bound vector in qpOASES form
-static qpOASES::real_t *ub_qpoases = nullptr;
-
-/// Solution of MPC in qpOASES form.
-static qpOASES::real_t *q_soln = nullptr;
-
-/// Current robot state, including pose and twist, along with a gravity component.
-static Eigen::Matrix<float, 13, 1> x0;
-
-/// State Matrix of simplified dynamics in continuous time.
-static Eigen::Matrix<float, 13, 13> A_ct;
-
-/// Transform Matrix of simplified dynamics in continuous time.
-static Eigen::Matrix<float, 13, 12> B_ct_r;
-
-/// Temporary matrix to construct the Hessian matrix.
-static Eigen::MatrixXf temp;
-
 namespace  {
 
 /**
@@ -124,7 +53,7 @@ inline void EigenToFloatArray(float *dst, float *src, s32 n_items)
  * @param rows: number of rows in Eigen matrix.
  * @param cols: number of columns in Eigen matrix.
  */
-void EigenToOASES(qpOASES::real_t *dst, Matrix<float, Dynamic, Dynamic> src, s16 rows, s16 cols)
+void EigenToOASES(qpOASES::real_t *dst, const Eigen::Ref<const Eigen::MatrixXf> &src, s16 rows, s16 cols)
 {
     s32 a = 0;
     for (s16 r = 0; r < rows; ++r) {
@@ -157,7 +86,7 @@ void MPCRobotState::print()
 }
 
 
-void SetupProblem(double dt, int horizon, double frictionCoeff, double fMax, double totalMass, float *inertia, float *weights, float alpha)
+void qrMPCProblem::SetupProblem(double dt, int horizon, double frictionCoeff, double fMax, double totalMass, float *inertia, float *weights, float alpha)
 {
     printf("SetupProblem: f_max = %f, mass = %f, horizon = %d\n", fMax, totalMass, horizon);
     problemConfig.totalMass = totalMass;
@@ -175,7 +104,18 @@ void SetupProblem(double dt, int horizon, double frictionCoeff, double fMax, dou
 }
 
 
-void ResizeQPMats(s16 horizon)
+qrMPCProblem::~qrMPCProblem()
+{
+    free(H_qpoases);
+    free(g_qpoases);
+    free(A_qpoases);
+    free(lb_qpoases);
+    free(ub_qpoases);
+    free(q_soln);
+}
+
+
+void qrMPCProblem::ResizeQPMats(s16 horizon)
 {
     int mcount = 0;
     int h2 = horizon * horizon;
@@ -207,6 +147,7 @@ void ResizeQPMats(s16 horizon)
     mcount = 0;
     
     temp.resize(12 * horizon, 13 * horizon);
+    trajError.resize(13 * horizon);
 
     Aqp.setZero();
     Bqp.setZero();
@@ -254,7 +195,7 @@ void ResizeQPMats(s16 horizon)
 }
 
 
-void ConvertToDiscreteQP(Matrix<float, 13, 13> Ac, Matrix<float, 13, 12> Bc, float dt, s16 horizon)
+void qrMPCProblem::ConvertToDiscreteQP(Matrix<float, 13, 13> Ac, Matrix<float, 13, 12> Bc, float dt, s16 horizon)
 {
     /* The equation of the dynamics is:
      * d[x, u]^T/dt = [ A B | 0 0 ] [x u]^T.
@@ -331,9 +272,9 @@ void ComputeContinuousTimeStateSpaceMatrices(
 }
 
 
-void SolveMPCKernel(Vec3<float>& p, Vec3<float>& v, Quat<float>& q, Vec3<float>& w,
-                            Eigen::Matrix<float,3,4> &r, Vec3<float>& rpy,
-                            float *state_trajectory, float *gait)
+void qrMPCProblem::SolveMPCKernel(Vec3<float>& p, Vec3<float>& v, Quat<float>& q, Vec3<float>& w,
+                                  Eigen::Matrix<float,3,4> &r, Vec3<float>& rpy,
+                                  float *state_trajectory, float *gait)
 {
     /* Setup robot state for MPC. */
     ::EigenToFloatArray(robotState.gait, gait, 4 * problemConfig.horizon);
@@ -356,7 +297,7 @@ void SolveMPCKernel(Vec3<float>& p, Vec3<float>& v, Quat<float>& q, Vec3<float>&
 }
 
 
-void SolveMPC(ProblemConfig *setup)
+void qrMPCProblem::SolveMPC(ProblemConfig *setup)
 {
     /* Initial state with gravity. */
     x0 << robotState.rpy, robotState.p, robotState.w, robotState.v, -9.8f;
@@ -408,8 +349,11 @@ void SolveMPC(ProblemConfig *setup)
     /* H = 2(Bqp^T * L * Bqp + K).
      * g = 2 * Bqp^T * L * ( Aqp *x0 - xd).
      */
-    qH = temp * Bqp + (2 * setup->alpha) * Idendity12Horizon;
-    qg = temp * (Aqp * x0 - X_d);
+    qH.noalias() = temp * Bqp;
+    qH += (2 * setup->alpha) * Idendity12Horizon;
+    trajError.noalias() = Aqp * x0;
+    trajError -= X_d;
+    qg.noalias() = temp * trajError;
 
     int num_constraints = 20 * setup->horizon; /* Every leg has 5 constraints. */
     int num_variables = 12 * setup->horizon; /* 4 force vectors. */
@@ -424,7 +368,8 @@ void SolveMPC(ProblemConfig *setup)
         lb_qpoases[i] = 0.0f;
     }
 
-    /* Setup qpOASES to solve the problem. */
+    /* Setup qpOASES to solve the problem, it allocates its workspace in every solve, from the solver arena. */
+    qrSolverAllocScope solverScope;
     qpOASES::int_t nWSR = 100;
     qpOASES::QProblem problem(num_variables, num_constraints);
     qpOASES::Options option;
@@ -443,7 +388,7 @@ void SolveMPC(ProblemConfig *setup)
 }
 
 
-double GetMPCSolution(int index)
+double qrMPCProblem::GetMPCSolution(int index)
 {
     if (!has_solved) return 0.f;
     double *qs = q_soln;
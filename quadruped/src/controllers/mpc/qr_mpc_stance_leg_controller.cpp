@@ -87,11 +87,13 @@ void MPCStanceLegController::Reset(float t)
     Vec3<float> inertia;
     inertia << robot->totalInertia(0,0), robot->totalInertia(1,1), robot->totalInertia(2,2);
 
-    SetupProblem(dtMPC, horizonLength, 0.45, maxForce, robot->totalMass, inertia.data(), weights, alpha);
+    mpcProblem.SetupProblem(dtMPC, horizonLength, 0.45, maxForce, robot->totalMass, inertia.data(), weights, alpha);
 
-    iterationCounter = 0;
-
-    mpcUpdated = false;
+    /* Until the first solve, the stance legs share the weight evenly. */
+    for (int legId = 0; legId < NumLeg; ++legId) {
+        f.col(legId) << 0, 0, float(maxForce / 4);
+        f_ff.col(legId) = -robot->stateDataFlow.baseRMat.transpose() * f.col(legId);
+    }
 
     if (useWBC) {
         auto& wbcData = robot->stateDataFlow.wbcData;
@@ -100,7 +102,7 @@ void MPCStanceLegController::Reset(float t)
         }
 
         /* In one iteration, MPC or WBC is conducted to ensure the frequency. */
-        wbcData.allowAfterMPC = !mpcUpdated;
+        wbcData.allowAfterMPC = true;
 
         wbcData.pBody_des[0] = posDesiredinWorld[0];
         wbcData.pBody_des[1] = posDesiredinWorld[1];
@@ -122,37 +124,38 @@ void MPCStanceLegController::Reset(float t)
 
         wbcData.contact_state.setOnes();
     }
-    std::cout << "[MPC] Reset: iterationCounter = " << iterationCounter << std::endl;
+    std::cout << "[MPC] Reset" << std::endl;
 }
 
 
-std::tuple<std::map<int, qrMotorCommand>, Eigen::Matrix<float, 3, 4>> MPCStanceLegController::GetAction()
+void MPCStanceLegController::Update(float currentTime)
 {
-    std::map<int, qrMotorCommand> legCommand;
+    TorqueStanceLegController::Update(currentTime);
 
-    /* Run the MPC and the result will be stored in member %f_ff. */
-    Run(legCommand, 0, 0);
+    /* Plan the reference of the MPC, which is solved at its own rate by SolveMPC(). */
+    Run(action, 0, 0);
+}
 
-    std::map<int, float> motorTorques;
 
+std::tuple<const std::vector<qrMotorCommand>&, Eigen::Matrix<float, 3, 4>> MPCStanceLegController::GetAction()
+{
     /* Map exerting force to joint torque using Tor = J^T * F. */
     for (int legId = 0; legId < NumLeg; ++legId) {
-        motorTorques = this->robot->MapContactForceToJointTorques(legId, f_ff.col(legId));
+        Vec3<float> motorTorques = this->robot->MapContactForceToJointTorques(legId, f_ff.col(legId));
 
-        for (std::map<int, float>::iterator it = motorTorques.begin(); it != motorTorques.end(); ++it) {
-            if (gaitGenerator->legState[legId] == LegState::EARLY_CONTACT && it->first % 3 == 0) {
-                // MotorCommand temp{0., 0., 0., 1.0, it->second};
-                qrMotorCommand temp{0., 100.0, 0., 3.0, it->second};
-                legCommand[it->first] = temp;
+        for (int motorId = 0; motorId < NumMotorOfOneLeg; ++motorId) {
+            int jointId = motorId + legId * NumMotorOfOneLeg;
+            if (gaitGenerator->legState[legId] == LegState::EARLY_CONTACT && motorId == 0) {
+                // MotorCommand temp{0., 0., 0., 1.0, motorTorques[motorId]};
+                action[jointId] = {0., 100.0, 0., 3.0, motorTorques[motorId]};
             } else {
-                // MotorCommand temp{0., 0., 0., 1.0, it->second};
-                qrMotorCommand temp{0., 0., 0., 3.0, it->second};
-                legCommand[it->first] = temp;
+                // MotorCommand temp{0., 0., 0., 1.0, motorTorques[motorId]};
+                action[jointId] = {0., 0., 0., 3.0, motorTorques[motorId]};
             }
         }
     }
 
-    return {legCommand, f_ff};
+    return {action, f_ff};
 }
 
 void MPCStanceLegController::SetupCommand()
@@ -204,7 +207,7 @@ void MPCStanceLegController::SetupCommand()
 }
 
 
-void MPCStanceLegController::Run(std::map<int, qrMotorCommand> &legCommand, int gaitType, int robotMode)
+void MPCStanceLegController::Run(std::vector<qrMotorCommand> &legCommand, int gaitType, int robotMode)
 {
 
     SetupCommand();
@@ -279,22 +282,17 @@ void MPCStanceLegController::Run(std::map<int, qrMotorCommand> &legCommand, int
         vDesWorld[axis] = res.xd;
     }
 
-    /* Update MPC table. */
-    Vec4<float> progress = gaitGenerator->phaseInFullCycle;
-    float dPhase = 1.0 / (numHorizonL * horizonLength);
+    /* Update MPC table from the contact schedule of the gait. MPC only considers the stance leg. */
+    const u8 *contactSchedule = gaitGenerator->GetContactSchedule();
+    int slotsPerStep = qrGaitGenerator::ContactScheduleSlots(1.0 / (numHorizonL * horizonLength));
+    u8 earlyContacts = 0;
+    for (int j = 0; j < NumLeg; ++j) {
+        earlyContacts |= u8(gaitGenerator->legState[j] == LegState::EARLY_CONTACT) << j;
+    }
     for (int i = 0; i < horizonLength; i++) {
+        u8 contacts = contactSchedule[i * slotsPerStep] | earlyContacts;
         for (int j = 0; j < NumLeg; ++j) {
-            float ithMPCPhase = progress[j] + i * dPhase;
-            while (ithMPCPhase > 1.0) {
-                ithMPCPhase -= 1.0;
-            }
-
-            /* MPC only considers the stance leg. */
-            if (ithMPCPhase < gaitGenerator->dutyFactor[j] || gaitGenerator->legState[j] == LegState::EARLY_CONTACT) {
-                mpcTable(i, j) = 1;
-            } else {
-                mpcTable(i, j) = 0;
-            }
+            mpcTable(i, j) = float((contacts >> j) & 1);
         }
     }
 
@@ -302,12 +300,10 @@ void MPCStanceLegController::Run(std::map<int, qrMotorCommand> &legCommand, int
         mpcTable(0, legId) = float(contactState[legId]);
     }
 
-    UpdateMPC(robot);
-
     if (useWBC) {
 
-        /* In one iteration, MPC or WBC is conducted to ensure the time per iteration. */
-        seResult.wbcData.allowAfterMPC = !mpcUpdated;
+        /* In one iteration, MPC or WBC is conducted to ensure the time per iteration, see SolveMPC(). */
+        seResult.wbcData.allowAfterMPC = true;
 
         Vec3<float> offsetP = seResult.baseRMat * Vec3<float>(0.018f, 0, 0);
         seResult.wbcData.pBody_des[0] = posDesiredinWorld[0] + offsetP[0];
@@ -330,54 +326,47 @@ void MPCStanceLegController::Run(std::map<int, qrMotorCommand> &legCommand, int
 
         seResult.wbcData.contact_state = contactState;
     }
-    ++iterationCounter;
 }
 
 
-void MPCStanceLegController::UpdateMPC(qrRobot *robot)
+void MPCStanceLegController::SolveMPC()
 {
-    /* To ensure the frequency, MPC is calculated twice in an MPC horizon.
-     * MPC is calculated at every first 50 iterations.
-     * We found that the effect is as same as that of calculating MPC every iteration. */
-    if (iterationCounter % (iterationsInaMPC / 2) == 0 || iterationCounter < 50) {
-
-        /* Set limitation to the desired pose position in world frame. */
-        Vec3<float> p = robot->GetBasePosition();
-
-        const float max_posx_error = 0.1f;
-        const float max_posy_error = 0.1f;
-        float xStart = posDesiredinWorld[0];
-        float yStart = posDesiredinWorld[1];
-
-        xStart = clip(xStart, p[0] - max_posx_error, p[0] + max_posx_error);
-        yStart = clip(yStart, p[1] - max_posy_error, p[1] + max_posy_error);
-
-        posDesiredinWorld[0] = xStart;
-        posDesiredinWorld[1] = yStart;
-
-        Vec3<float> omega_des(0, 0, yawTurnRate);
-
-        /* Initial trajectory: desired roll pitch yaw, pose, angular velosity and linear velocity. */
-        float trajInitial[12] = {rpyComp[0],   rpyComp[1],   yawDesTrue,
-                                 xStart,       yStart,       bodyHeight,
-                                 omega_des[0], omega_des[1], omega_des[2],
-                                 vDesWorld[0], vDesWorld[1], 0.f};
-
-        /* Predict the future state by accmulating the velocity. */
-        for (int i = 0; i < horizonLength; ++i) {
-            for (int j = 0; j < 12; ++j) trajAll[12 * i + j] = trajInitial[j];
-            if (i == 0) {
-                trajAll[2] = yawDesTrue;
-            } else {
-                trajAll[12 * i + 2] = trajAll[12 * (i - 1) + 2] + dtMPC * yawTurnRate;
-                trajAll[12 * i + 3] = trajAll[12 * (i - 1) + 3] + dtMPC * vDesWorld[0];
-                trajAll[12 * i + 4] = trajAll[12 * (i - 1) + 4] + dtMPC * vDesWorld[1];
-            }
+    /* Set limitation to the desired pose position in world frame. */
+    Vec3<float> p = robot->GetBasePosition();
+
+    const float max_posx_error = 0.1f;
+    const float max_posy_error = 0.1f;
+    float xStart = posDesiredinWorld[0];
+    float yStart = posDesiredinWorld[1];
+
+    xStart = clip(xStart, p[0] - max_posx_error, p[0] + max_posx_error);
+    yStart = clip(yStart, p[1] - max_posy_error, p[1] + max_posy_error);
+
+    posDesiredinWorld[0] = xStart;
+    posDesiredinWorld[1] = yStart;
+
+    Vec3<float> omega_des(0, 0, yawTurnRate);
+
+    /* Initial trajectory: desired roll pitch yaw, pose, angular velosity and linear velocity. */
+    float trajInitial[12] = {rpyComp[0],   rpyComp[1],   yawDesTrue,
+                             xStart,       yStart,       bodyHeight,
+                             omega_des[0], omega_des[1], omega_des[2],
+                             vDesWorld[0], vDesWorld[1], 0.f};
+
+    /* Predict the future state by accmulating the velocity. */
+    for (int i = 0; i < horizonLength; ++i) {
+        for (int j = 0; j < 12; ++j) trajAll[12 * i + j] = trajInitial[j];
+        if (i == 0) {
+            trajAll[2] = yawDesTrue;
+        } else {
+            trajAll[12 * i + 2] = trajAll[12 * (i - 1) + 2] + dtMPC * yawTurnRate;
+            trajAll[12 * i + 3] = trajAll[12 * (i - 1) + 3] + dtMPC * vDesWorld[0];
+            trajAll[12 * i + 4] = trajAll[12 * (i - 1) + 4] + dtMPC * vDesWorld[1];
         }
-        SolveDenseMPC(robot);
-        mpcUpdated = true;
-    } else {
-      mpcUpdated = false;
+    }
+    SolveDenseMPC(robot);
+    if (useWBC) {
+        robot->stateDataFlow.wbcData.allowAfterMPC = false;
     }
 }
 
@@ -396,12 +385,12 @@ void MPCStanceLegController::SolveDenseMPC(qrRobot *robot)
     Eigen::Matrix<float, 3, 4> foot2ComInWorldFrame = seResult.baseRMat * (footPosInBaseFrame.colwise() - robot->comOffset);
     float *r = foot2ComInWorldFrame.data();
 
-    SolveMPCKernel(pos, seResult.baseVInWorldFrame, quat, seResult.baseWInWorldFrame, foot2ComInWorldFrame, rpy, trajAll, mpcTable.data());
+    mpcProblem.SolveMPCKernel(pos, seResult.baseVInWorldFrame, quat, seResult.baseWInWorldFrame, foot2ComInWorldFrame, rpy, trajAll, mpcTable.data());
 
     /* Transform from reacting force to acting force of motors. */
     for (int leg = 0; leg < NumLeg; ++leg) {
         for (int axis = 0; axis < 3; ++axis) {
-            f(axis, leg) = GetMPCSolution(leg * 3 + axis);
+            f(axis, leg) = mpcProblem.GetMPCSolution(leg * 3 + axis);
         }
         f_ff.col(leg) = -seResult.baseRMat.transpose() * f.col(leg);
 
@@ -27,7 +27,7 @@
 
 using robotics::math::clip;
 
-Quadruped::qrDesiredStateCommand::qrDesiredStateCommand(ros::NodeHandle &nhIn, qrRobot* robotIn):nh(nhIn)
+Quadruped::qrDesiredStateCommand::qrDesiredStateCommand(qrRobot* robotIn)
 {
     stateDes.setZero();
     stateCur.setZero();
@@ -57,25 +57,23 @@ Quadruped::qrDesiredStateCommand::qrDesiredStateCommand(ros::NodeHandle &nhIn, q
     bodyUp = 0;
     movementMode = 0;
 
-    gamepadCommandSub = nh.subscribe(topicName, 10, &qrDesiredStateCommand::JoyCallback, this);
-
     printf("[Desired State Command] init finish...\n");
 }
 
 
-void Quadruped::qrDesiredStateCommand::JoyCallback(const sensor_msgs::Joy::ConstPtr &joy_msg)
+void Quadruped::qrDesiredStateCommand::ReceiveGamepad(const std::vector<float> &axes, const std::vector<int> &buttons)
 {
     joyCmdVz = 0;
 
     /* If A key is pressed, joy control will be enabled or disabled
      * currently the joy control is enabled by default
      */
-    if (joy_msg->buttons[0] == 1) {
+    if (buttons[0] == 1) {
         if (!joyCtrlOnRequest) {
-            ROS_INFO("You have open joy control!!!\n");
+            printf("[Desired State Command] You have open joy control!!!\n");
             joyCtrlOnRequest = true;
         } else {
-            ROS_INFO("You have turned off joy control!!!\n");
+            printf("[Desired State Command] You have turned off joy control!!!\n");
             joyCtrlOnRequest = false;
         }
     }
@@ -84,8 +82,8 @@ void Quadruped::qrDesiredStateCommand::JoyCallback(const sensor_msgs::Joy::Const
 
     if (joyCtrlOnRequest || rosCmdRequest) {
         /* X key. */
-        if (joy_msg->buttons[2] == 1) {
-            ROS_INFO("You have change the gait !!!\n");
+        if (buttons[2] == 1) {
+            printf("[Desired State Command] You have change the gait !!!\n");
             if (movementMode == 0) {
                 movementMode = 1;
             }
@@ -95,30 +93,30 @@ void Quadruped::qrDesiredStateCommand::JoyCallback(const sensor_msgs::Joy::Const
         /* User control the robot locomotion direction and velocity. */
         if (joyCtrlOnRequest) {
             /* Right joy stick up/down. */
-            joyCmdVx = joy_msg->axes[4] * MAX_VELX;
+            joyCmdVx = axes[4] * MAX_VELX;
 
             /* Right joy stick horizontal movement. */
-            joyCmdVy = joy_msg->axes[3] * MAX_VELY;
+            joyCmdVy = axes[3] * MAX_VELY;
 
             /* Left joy stick horizontal movement. */
-            joyCmdYawRate = joy_msg->axes[0] * MAX_YAWRATE;
+            joyCmdYawRate = axes[0] * MAX_YAWRATE;
 
             /* left cross button left/right movement
              * if you want to enable it, use:
-             * joy_msg->axes[6] * JOY_CMD_ROLL_MAX * (-1);
+             * axes[6] * JOY_CMD_ROLL_MAX * (-1);
              */
             joyCmdRollRate = 0;
 
             /* left cross button up/down movement
              * if you want to enable it, use:
-             * joy_msg->axes[7] * JOY_CMD_PITCH_MAX;
+             * axes[7] * JOY_CMD_PITCH_MAX;
              */
             joyCmdPitchRate = 0;
         }
 
         /* If B key is pressed, the quadruped will stop troting and stand by MPC controller. */
-        if (joy_msg->buttons[1] == 1) {
-            ROS_INFO("You have pressed the stop button!!!!\n");
+        if (buttons[1] == 1) {
+            printf("[Desired State Command] You have pressed the stop button!!!!\n");
             if (movementMode == 1) {
                 movementMode = 0;
                 joyCtrlStateChangeRequest = true;
@@ -134,8 +132,8 @@ void Quadruped::qrDesiredStateCommand::JoyCallback(const sensor_msgs::Joy::Const
         /* If Y key is pressed when the quadruped is sitting down,
          * no commands will be sent to quadruped and it will lie on the ground.
          */
-        if (joy_msg->buttons[3] == 1) {
-            ROS_INFO("You have pressed the exit button!!!!\n");
+        if (buttons[3] == 1) {
+            printf("[Desired State Command] You have pressed the exit button!!!!\n");
             if (movementMode == 0 && bodyUp <= 0) {
                 joyCmdExit = true;
                 joyCtrlStateChangeRequest = true;
@@ -146,8 +144,8 @@ void Quadruped::qrDesiredStateCommand::JoyCallback(const sensor_msgs::Joy::Const
         /* If Rb key is pressed when quadruped is standing by MPC,
          * quadruped will switch to position mode and can sit down and stand up with position mode.
          */
-        if (joy_msg->buttons[5] == 1) {
-            ROS_INFO("You have pressed the up/down button!!!!\n");
+        if (buttons[5] == 1) {
+            printf("[Desired State Command] You have pressed the up/down button!!!!\n");
             if (movementMode == 0) {
                 if (bodyUp==0) {
                     bodyUp = 1;
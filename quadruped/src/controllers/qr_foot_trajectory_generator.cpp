@@ -27,26 +27,25 @@
 
 namespace Quadruped {
 
-qrFootBSplinePatternGenerator::qrFootBSplinePatternGenerator(qrSplineInfo &splineInfo)
+qrFootBSplinePatternGenerator::qrFootBSplinePatternGenerator()
+{
+    controlPointsTemplate << -10, -10.3, -13, -15, 0,   11, 10.5, 10.2, 10,
+                               0,     0,   0,   0, 0,    0,    0,    0,  0,
+                               0,   0.2,   2,   7, 7.8,  8,    4,    1,  0;
+
+    controlPoints = controlPointsTemplate;
+
+    const float knots[] = {0.,    0.,    0.,    0.,
+                           0.3/6, 1.3/6, 2.5/6, 3.0/6, 4.0/6,
+                           1,     1,     1,     1};
+    crv.SetKnots(knots);
+    crv.SetControlPoints(controlPoints);
+}
+
+
+qrFootBSplinePatternGenerator::qrFootBSplinePatternGenerator(qrSplineInfo &splineInfo):
+    qrFootBSplinePatternGenerator()
 {
-    controlPointsTemplate = {
-        glm::vec3(-10  , 0, 0),
-        glm::vec3(-10.3, 0, 0.2),
-        glm::vec3(-13  , 0, 2),
-        glm::vec3(-15  , 0, 7),
-        glm::vec3(0    , 0, 7.8),
-        glm::vec3(11   , 0, 8),
-        glm::vec3(10.5 , 0, 4),
-        glm::vec3(10.2 , 0, 1),
-        glm::vec3(10   , 0, 0)};
-
-    crv.control_points = controlPointsTemplate;
-
-    crv.knots = {0.,    0.,    0.,    0.,
-                 0.3/6, 1.3/6, 2.5/6, 3.0/6, 4.0/6,
-                 1,     1,     1,     1};
-    crv.degree = 3;
-    glm::vec3 pt1 = tinynurbs::curvePoint(crv, 0.f);
 }
 
 
@@ -92,8 +91,6 @@ void qrFootBSplinePatternGenerator::UpdateSpline(
     float target_appex,
     const Eigen::Vector3f &target_pos)
 {
-    std::vector<glm::vec3> &controlPoints =  crv.control_points;
-    std::vector<float> &knots = crv.knots;
     target_appex *= 100.f;
     startPos << 0.f, 0.f, 0.f;
     endPos = RTheta* (target_pos * 100.f);
@@ -105,16 +102,15 @@ void qrFootBSplinePatternGenerator::UpdateSpline(
         float zRatio = abs(z_length_left) / 8.f;
         float x_mid = (endPos[0] + startPos[0])/2;
         float z_offset = startPos[2];
-        for(int i=0; i<controlPointsTemplate.size();++i) {
-            controlPoints[i].x = controlPointsTemplate[i].x * xRatio + x_mid;
-            controlPoints[i].z = controlPointsTemplate[i].z * zRatio + z_offset;
-
-        }
+        controlPoints.row(0) = controlPointsTemplate.row(0) * xRatio;
+        controlPoints.row(0).array() += x_mid;
+        controlPoints.row(2) = controlPointsTemplate.row(2) * zRatio;
+        controlPoints.row(2).array() += z_offset;
 
-        controlPoints[8].z = endPos[2];
-        controlPoints[7].z = controlPoints[8].z + controlPointsTemplate[7].z/8 * z_length_right;
-        controlPoints[6].z = controlPoints[8].z + controlPointsTemplate[6].z/8 * z_length_right;
-        controlPoints[5].z = controlPoints[8].z + controlPointsTemplate[5].z/8 * z_length_right;
+        controlPoints(2, 8) = endPos[2];
+        controlPoints(2, 7) = controlPoints(2, 8) + controlPointsTemplate(2, 7)/8 * z_length_right;
+        controlPoints(2, 6) = controlPoints(2, 8) + controlPointsTemplate(2, 6)/8 * z_length_right;
+        controlPoints(2, 5) = controlPoints(2, 8) + controlPointsTemplate(2, 5)/8 * z_length_right;
 
     } else {
         /* Walk down. */
@@ -123,15 +119,17 @@ void qrFootBSplinePatternGenerator::UpdateSpline(
         float zRatio = abs(z_length_right) / 8.f;
         float x_mid = (endPos[0] + startPos[0])/2;
         float z_offset = endPos[2];
-        for(int i=0; i<controlPointsTemplate.size();++i) {
-            controlPoints[i].x = controlPointsTemplate[i].x * xRatio + x_mid;
-            controlPoints[i].z = controlPointsTemplate[i].z * zRatio + z_offset;
-        }
-        controlPoints[0].z = startPos[2];
-        controlPoints[1].z = controlPoints[0].z + 0.2 /8 *z_length_left;
-        controlPoints[2].z = controlPoints[0].z + 2.0/8 *z_length_left;
-        controlPoints[3].z = controlPoints[0].z + 7.0/8 *z_length_left;
+        controlPoints.row(0) = controlPointsTemplate.row(0) * xRatio;
+        controlPoints.row(0).array() += x_mid;
+        controlPoints.row(2) = controlPointsTemplate.row(2) * zRatio;
+        controlPoints.row(2).array() += z_offset;
+        controlPoints(2, 0) = startPos[2];
+        controlPoints(2, 1) = controlPoints(2, 0) + 0.2 /8 *z_length_left;
+        controlPoints(2, 2) = controlPoints(2, 0) + 2.0/8 *z_length_left;
+        controlPoints(2, 3) = controlPoints(2, 0) + 7.0/8 *z_length_left;
     }
+    /* the polynomial coefficients of the spline are computed once per swing. */
+    crv.SetControlPoints(controlPoints);
 }
 
 
@@ -147,18 +145,12 @@ bool qrFootBSplinePatternGenerator::GenerateTrajectory(
     if (dt < - 1e-3 || dt >= duration + 1e-3)
         return false;
 
-    auto pv = tinynurbs::curveDerivatives(crv, 1, dt);
+    crv.GetPoint(dt, foot_pos, foot_vel, foot_acc);
 
     /* convert cm to m. */
-    foot_pos[0] = pv[0].x / 100;
-    foot_pos[1] = pv[0].y / 100;
-    foot_pos[2] = pv[0].z / 100;
-    foot_vel[0] = pv[1].x / 100;
-    foot_vel[1] = pv[1].y / 100;
-    foot_vel[2] = pv[1].z / 100;
-
-    foot_pos = RTheta.transpose() * foot_pos + Tp;
-    foot_vel = RTheta.transpose() * foot_vel;
+    foot_pos = RTheta.transpose() * foot_pos / 100 + Tp;
+    foot_vel = RTheta.transpose() * foot_vel / 100;
+    foot_acc = RTheta.transpose() * foot_acc / 100;
     return true;
 }
 
@@ -283,40 +275,77 @@ SwingFootTrajectory::SwingFootTrajectory(
     Vec3<float> startPosIn,
     Vec3<float> endPosIn,
     float duration,
-    float maxClearance):
+    float maxClearance)
+{
+    Reset(splineInfoIn, startPosIn, endPosIn, duration, maxClearance);
+}
+
+
+SwingFootTrajectory::SwingFootTrajectory(const SwingFootTrajectory &item)
+{
+    *this = item;
+}
 
-    splineInfo(splineInfoIn),
-    startPos(startPosIn),
-    endPos(endPosIn),
-    stepParams(duration, 0., 0.)
+
+SwingFootTrajectory &SwingFootTrajectory::operator=(const SwingFootTrajectory &item)
+{
+    mid = item.mid;
+    startPos = item.startPos;
+    endPos = item.endPos;
+    stepParams = item.stepParams;
+    splineInfo = item.splineInfo;
+    parabolaGenerator = item.parabolaGenerator;
+    cubicGenerator = item.cubicGenerator;
+    bSplineGenerator = item.bSplineGenerator;
+    /* point to the generator of this object, not the one of item. */
+    footTarjGen = GetGenerator(splineInfo.splineType);
+    return *this;
+}
+
+
+void SwingFootTrajectory::Reset(
+    const qrSplineInfo &splineInfoIn,
+    const Vec3<float> &startPosIn,
+    const Vec3<float> &endPosIn,
+    float duration,
+    float maxClearance)
 {
+    splineInfo.splineType = splineInfoIn.splineType;
+    splineInfo.degree = splineInfoIn.degree;
+    startPos = startPosIn;
+    endPos = endPosIn;
+    stepParams = qrStepParameters(duration, 0., 0.);
     mid = std::max(endPos[2], startPos[2]) + maxClearance;
 
     switch (splineInfo.splineType)
     {
     case SplineType::BSpline:
         stepParams.height = std::min(0.2f, std::max(0.1f, maxClearance + abs(endPos[2] - startPos[2])));
-        footTarjGen = new qrFootBSplinePatternGenerator(splineInfo);
         break;
     case SplineType::CubicPolygon:
         stepParams = qrStepParameters(duration, mid, 0.);
-        footTarjGen = new qrFootCubicPatternGenerator();
         break;
     default:
         stepParams.height = maxClearance;
-        footTarjGen = new qrFootParabolaPatternGenerator();
         break;
     }
+    footTarjGen = GetGenerator(splineInfo.splineType);
 
     footTarjGen->SetParameters(0., startPos, endPos, stepParams);
 }
 
 
-SwingFootTrajectory::SwingFootTrajectory(const SwingFootTrajectory &item)
+qrFootSplinePatternGenerator *SwingFootTrajectory::GetGenerator(SplineType splineType)
 {
-    mid = item.mid;
-    stepParams = item.stepParams;
-    footTarjGen->SetParameters(0., item.startPos, item.endPos, stepParams);
+    switch (splineType)
+    {
+    case SplineType::BSpline:
+        return &bSplineGenerator;
+    case SplineType::CubicPolygon:
+        return &cubicGenerator;
+    default:
+        return &parabolaGenerator;
+    }
 }
 
 bool SwingFootTrajectory::GenerateTrajectoryPoint(
@@ -49,6 +49,9 @@ qrLocomotionController::qrLocomotionController(
 {
     resetTime = robot->GetTimeSinceReset();
     timeSinceReset = 0.;
+    action.resize(NumMotor);
+    swingAction.setZero();
+    isSwingMotor.setZero();
     BindCommand();
 }
 
@@ -67,6 +70,15 @@ void qrLocomotionController::Reset()
 
 
 void qrLocomotionController::Update()
+{
+    UpdateGait();
+    UpdateSwing();
+    UpdateStance();
+    SolveMPC();
+}
+
+
+void qrLocomotionController::UpdateGait()
 {
     if (!robot->stop) {
         timeSinceReset = robot->GetTimeSinceReset() - resetTime;
@@ -120,41 +132,55 @@ void qrLocomotionController::Update()
             break;
         }
     }
+}
+
+
+void qrLocomotionController::UpdateSwing()
+{
     swingLegController->Update(timeSinceReset);
+
+    /* The stance leg controller reads the foot targets planned here. */
+    const auto swing = swingLegController->GetAction();
+    swingAction = std::get<0>(swing);
+    isSwingMotor = std::get<1>(swing);
+}
+
+
+void qrLocomotionController::UpdateStance()
+{
     stanceLegController->Update(timeSinceReset);
 }
 
 
-std::tuple<std::vector<qrMotorCommand>, Eigen::Matrix<float, 3, 4>> qrLocomotionController::GetAction()
+void qrLocomotionController::SolveMPC()
 {
-    action.clear();
+    stanceLegController->SolveMPC();
+}
 
-    /* Returns the control ouputs (e.g. positions/torques) for all motors. type: map */
-    auto swingAction = swingLegController->GetAction();
 
-    auto [stanceAction, qpSol] = stanceLegController->GetAction(); // map<int, MotorCommand>
+std::tuple<const std::vector<qrMotorCommand>&, Eigen::Matrix<float, 3, 4>> qrLocomotionController::GetAction()
+{
+    /* Returns the control ouputs (e.g. positions/torques) for all motors. */
+    const auto stance = stanceLegController->GetAction();
+    const std::vector<qrMotorCommand> &stanceAction = std::get<0>(stance);
 
-    std::vector<qrMotorCommand> action;
     for (int joint_id = 0; joint_id < NumMotor; ++joint_id) {
-        auto it = swingAction.find(joint_id);
-        if (it != swingAction.end()) {
-            action.push_back(it->second);
+        if (isSwingMotor[joint_id]) {
+            action[joint_id] = qrMotorCommand(swingAction.col(joint_id));
         } else {
-            action.push_back(stanceAction[joint_id]);
+            action[joint_id] = stanceAction[joint_id];
         }
     }
-    return {action, qpSol};
+    return {action, std::get<1>(stance)};
 }
     
 
-std::tuple<std::vector<qrMotorCommand>, Eigen::Matrix<float, 3, 4>> qrLocomotionController::GetFakeAction()
+std::tuple<const std::vector<qrMotorCommand>&, Eigen::Matrix<float, 3, 4>> qrLocomotionController::GetFakeAction()
 {
-    action.clear();
     Eigen::Matrix<float, 3, 4> qpSol = Eigen::Matrix<float, 3, 4>::Zero();
-    std::vector<qrMotorCommand> action;
     /* Copy motors' actions from subcontrollers to output variable. */
     for (int joint_id = 0; joint_id < NumMotor; ++joint_id) {
-        action.push_back({0,0,0,0,0});
+        action[joint_id] = {0,0,0,0,0};
     }
     return {action, qpSol};
 }
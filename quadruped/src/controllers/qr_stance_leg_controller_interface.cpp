@@ -99,7 +99,15 @@ void qrStanceLegControllerInterface::Update(float current_time)
 }
 
 
-std::tuple<std::map<int, qrMotorCommand>, Eigen::Matrix<float, 3, 4>> qrStanceLegControllerInterface::GetAction()
+void qrStanceLegControllerInterface::SolveMPC()
+{
+    if (c == c2) {
+        static_cast<MPCStanceLegController*>(c2)->SolveMPC();
+    }
+}
+
+
+std::tuple<const std::vector<qrMotorCommand>&, Eigen::Matrix<float, 3, 4>> qrStanceLegControllerInterface::GetAction()
 {
     return c->GetAction();
 }
@@ -41,6 +41,10 @@ qrUserParameters::qrUserParameters(std::string filePath)
     initialVariance = userConfig["initialVariance"].as<float>();
     
     movingWindowFilterSize = userConfig["movingWindowFilterSize"].as<int>();
+
+    velocityGateThreshold = userConfig["velocityGateThreshold"].as<float>(velocityGateThreshold);
+
+    momentumObserverGain = userConfig["momentumObserverGain"].as<float>(momentumObserverGain);
     
     desiredHeight = userConfig["desiredHeight"].as<float>();
     
@@ -58,11 +62,54 @@ qrUserParameters::qrUserParameters(std::string filePath)
     computeForceInWorldFrame = userConfig["computeForceInWorldFrame"].as<bool>();
     
     useWBC = userConfig["useWBC"].as<bool>();
+
+    useInEKF = userConfig["useInEKF"].as<bool>(useInEKF);
+    useCMUFilter = userConfig["useCMUFilter"].as<bool>(useCMUFilter);
+
+    useRealtime = userConfig["useRealtime"].as<bool>(false);
+    realtimePriority = userConfig["realtimePriority"].as<int>(realtimePriority);
+    controlCpu = userConfig["controlCpu"].as<int>(controlCpu);
+    helperCpus = userConfig["helperCpus"].as<std::vector<int>>(helperCpus);
+    lockMemory = userConfig["lockMemory"].as<bool>(lockMemory);
+    prefaultStackSize = userConfig["prefaultStackSize"].as<unsigned int>(prefaultStackSize);
+    prefaultHeapSize = userConfig["prefaultHeapSize"].as<unsigned int>(prefaultHeapSize);
+
+    allocPolicy = userConfig["allocPolicy"].as<int>(allocPolicy);
+
+    usePipeline = userConfig["usePipeline"].as<bool>(usePipeline);
+    estimationCpu = userConfig["estimationCpu"].as<int>(estimationCpu);
+    tickStatsInterval = userConfig["tickStatsInterval"].as<unsigned int>(tickStatsInterval);
+
+    schedulerThreads = userConfig["schedulerThreads"].as<unsigned int>(schedulerThreads);
+    flightRecorderPath = userConfig["flightRecorderPath"].as<std::string>(flightRecorderPath);
+    flightRecorderCapacity = userConfig["flightRecorderCapacity"].as<unsigned int>(flightRecorderCapacity);
+    telemetryUrl = userConfig["telemetryUrl"].as<std::string>(telemetryUrl);
+    telemetryCapacity = userConfig["telemetryCapacity"].as<unsigned int>(telemetryCapacity);
+    telemetryChannels = userConfig["telemetryChannels"].as<std::map<std::string, float>>(telemetryChannels);
+    if (userConfig["taskRates"]) {
+        /* Each task is given as name: [period, offset], the offset may be omitted. */
+        for (const auto &task : userConfig["taskRates"]) {
+            std::vector<unsigned int> rate = task.second.as<std::vector<unsigned int>>();
+            qrTaskRate &taskRate = taskRates[task.first.as<std::string>()];
+            taskRate.period = rate.size() > 0 ? rate[0] : 1;
+            taskRate.offset = rate.size() > 1 ? rate[1] : 0;
+        }
+    }
     
     std::cout << "init UserParameters finish\n" ;
 }
 
 
+qrTaskRate qrUserParameters::GetTaskRate(const std::string &name, qrTaskRate defaultRate) const
+{
+    auto it = taskRates.find(name);
+    if (it == taskRates.end()) {
+        return defaultRate;
+    }
+    return it->second;
+}
+
+
 Quadruped::qrStateDataFlow::qrStateDataFlow()
 {
     footPositionsInBaseFrame.setZero();
@@ -52,6 +52,9 @@ qrRaibertSwingLegController::qrRaibertSwingLegController(
     swingLegConfig = YAML::LoadFile(config_path);
     footOffset = swingLegConfig["swing_leg_params"]["foot_offset"].as<float>();
     this->userParameters = &user_parameters;
+    swingFootIds.reserve(NumLeg);
+    swingActions.setZero();
+    isSwingMotor.setConstant(false);
 
     // this->Reset(0);
 }
@@ -93,7 +96,7 @@ void qrRaibertSwingLegController::Reset(float current_time)
     if (robot->controlParams["mode"]!=LocomotionMode::WALK_LOCOMOTION) {
         splineInfo.splineType = SplineType::XYLinear_ZParabola;
         for (int i = 0; i < NumLeg; ++i) {
-            swingFootTrajectories[i] = SwingFootTrajectory(splineInfo, phaseSwitchFootLocalPos.col(i),
+            swingFootTrajectories[i].Reset(splineInfo, phaseSwitchFootLocalPos.col(i),
                 phaseSwitchFootLocalPos.col(i), 1.f, 0.15);
         }
     }
@@ -170,7 +173,7 @@ void qrRaibertSwingLegController::Update(float current_time)
 
                 // SplineInfo splineInfo;
                 splineInfo.splineType = SplineType::BSpline;
-                swingFootTrajectories[legId] = SwingFootTrajectory(splineInfo, footSourcePosition, footTargetPosition, 1.f, 0.15);
+                swingFootTrajectories[legId].Reset(splineInfo, footSourcePosition, footTargetPosition, 1.f, 0.15);
                 cout << "[SwingLegController::Update leg " << legId << "  update footHoldInWorldFrame: \n"
                     << footHoldInWorldFrame.col(legId) << endl;
                 // cout << "[SwingLegController::Update leg " << legId << "  update footHoldInControlFrame: \n"
@@ -192,7 +195,7 @@ void qrRaibertSwingLegController::Update(float current_time)
                 } else {
                     splineInfo.splineType = SplineType::XYLinear_ZParabola; // BSpline, XYLinear_ZParabola
                 }
-                swingFootTrajectories[legId] = SwingFootTrajectory(splineInfo, phaseSwitchFootLocalPos.col(legId), phaseSwitchFootLocalPos.col(legId), 1.f, 0.15);
+                swingFootTrajectories[legId].Reset(splineInfo, phaseSwitchFootLocalPos.col(legId), phaseSwitchFootLocalPos.col(legId), 1.f, 0.15);
             }
         }
     } break;
@@ -238,7 +241,7 @@ void qrRaibertSwingLegController::Update(float current_time)
 
 }
 
-map<int, Matrix<float, 5, 1>> qrRaibertSwingLegController::GetAction()
+std::tuple<const Eigen::Matrix<float, 5, NumMotor>&, const Eigen::Matrix<bool, NumMotor, 1>&> qrRaibertSwingLegController::GetAction()
 {
     auto& stateData = robot->stateDataFlow;
     Matrix<float, 3, 1> baseVelocity;
@@ -423,7 +426,7 @@ map<int, Matrix<float, 5, 1>> qrRaibertSwingLegController::GetAction()
         }
     }
 
-    std::map<int, Matrix<float, 5, 1>> actions;
+    isSwingMotor.setConstant(false);
     Matrix<float, 12, 1> kps, kds;
     kps = robot->GetMotorKps();
     kds = robot->GetMotorKdp();
@@ -454,11 +457,12 @@ map<int, Matrix<float, 5, 1>> qrRaibertSwingLegController::GetAction()
         }
 
         if (flag) {
-            actions[it->first] << std::get<0>(posVelId), kps[it->first], std::get<1>(posVelId),kds[it->first], 0;
+            swingActions.col(it->first) << std::get<0>(posVelId), kps[it->first], std::get<1>(posVelId),kds[it->first], 0;
+            isSwingMotor[it->first] = true;
         }
     }
 
-    return actions;
+    return {swingActions, isSwingMotor};
 }
 
 } // Namespace Quadruped
@@ -29,8 +29,8 @@ template<typename T>
 qrMultitaskProjection<T>::qrMultitaskProjection(size_t dim_qdot):
     thresholdInv(0.001), dimQDot(dim_qdot), numActJoint(dim_qdot - 6)
 {
-    identityMat = DMat<T>::Identity(dimQDot, dimQDot);
-    Nc = DMat<T>::Identity(dimQDot, dimQDot);
+    identityMat = WbcMat<T>::Identity(dimQDot, dimQDot);
+    Nc = WbcMat<T>::Identity(dimQDot, dimQDot);
 }
 
 
@@ -45,7 +45,7 @@ bool qrMultitaskProjection<T>::FindConfiguration(
     Nc.setIdentity();
 
     if (!contact_list.empty()) {
-        DMat<T> Jc, Jc_i;
+        WbcMat<T> Jc, Jc_i;
         size_t num_rows = 0;
 
         /* Construct the contact jacobian Jc. */
@@ -61,8 +61,8 @@ bool qrMultitaskProjection<T>::FindConfiguration(
     }
 
     /* Get first delta_q and q_dot that satisfying the contact constraint. */
-    DVec<T> delta_q, qdot;
-    DMat<T> Jt, JtPre, JtPre_pinv, N_nx, N_pre;
+    WbcVec<T> delta_q, qdot;
+    WbcMat<T> Jt, JtPre, JtPre_pinv, N_nx, N_pre;
 
     qrTask<T> *task = task_list[0];
     task->GetJt(Jt);
@@ -71,8 +71,8 @@ bool qrMultitaskProjection<T>::FindConfiguration(
     
     delta_q = JtPre_pinv * (task->GetPosErr());
     qdot = JtPre_pinv * (task->GetDesiredVel());
-    DVec<T> prev_delta_q = delta_q;
-    DVec<T> prev_qdot = qdot;
+    WbcVec<T> prev_delta_q = delta_q;
+    WbcVec<T> prev_qdot = qdot;
 
     BuildProjectionMatrix(JtPre, N_nx);
     N_pre.noalias() = Nc * N_nx;
@@ -107,16 +107,16 @@ bool qrMultitaskProjection<T>::FindConfiguration(
 
 
 template<typename T>
-void qrMultitaskProjection<T>::BuildProjectionMatrix(const DMat<T> &J, DMat<T> &N)
+void qrMultitaskProjection<T>::BuildProjectionMatrix(const WbcMat<T> &J, WbcMat<T> &N)
 {
-    DMat<T> J_pinv;
+    WbcMat<T> J_pinv;
     PseudoInverse(J, J_pinv);
     N.noalias() = identityMat - J_pinv * J;
 }
 
 
 template<typename T>
-void qrMultitaskProjection<T>::PseudoInverse(const DMat<T> &J, DMat<T> &Jinv)
+void qrMultitaskProjection<T>::PseudoInverse(const WbcMat<T> &J, WbcMat<T> &Jinv)
 {
     pseudoInverse(J, thresholdInv, Jinv);
 }
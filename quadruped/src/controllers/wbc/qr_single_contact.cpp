@@ -36,11 +36,11 @@ qrSingleContact<T>::qrSingleContact(FloatingBaseModel<T> *robot, int pt):
 {
     indexFz = dimContact - 1;
 
-    desiredFr = DVec<T>::Zero(dimContact);
-    Jc = DMat<T>(dimContact, 18);
-    JcDotQdot = DVec<T>::Zero(dimContact);
+    desiredFr = WbcVec<T>::Zero(dimContact);
+    Jc = WbcMat<T>(dimContact, 18);
+    JcDotQdot = WbcVec<T>::Zero(dimContact);
 
-    Uf = DMat<T>::Zero(dimU, dimContact);
+    Uf = WbcMat<T>::Zero(dimU, dimContact);
 
     /* Uf matrix seems like:
      * |  0   0   1  |
@@ -105,7 +105,7 @@ bool qrSingleContact<T>::UpdateUf()
 template<typename T>
 bool qrSingleContact<T>::UpdateIneqVec()
 {
-    ineqVec = DVec<T>::Zero(dimU);
+    ineqVec = WbcVec<T>::Zero(dimU);
     ineqVec[5] = -maxFz;
     return true;
 }
@@ -32,16 +32,14 @@ qrWbcLocomotionController<T>::qrWbcLocomotionController(FloatingBaseModel<T> &mo
 {
     fullConfig.setZero();
     zeroVec3.setZero();
-    modelState.q = DVec<T>::Zero(NumMotor);
-    modelState.qd = DVec<T>::Zero(NumMotor);
 
     multitask = new qrMultitaskProjection<T>(dimConfig);
     wbic = new qrWholeBodyImpulseCtrl<T>(dimConfig, &contactList, &taskList);
 
     wbicExtraData = new qrWBICExtraData<T>();
     // wbicExtraData->weightFb = DVec<T>::Constant(BaseFreedomDim, 1);
-    wbicExtraData->weightFb = DVec<T>::Constant(BaseFreedomDim, 0.1);
-    wbicExtraData->weightFr = DVec<T>::Constant(12, 1);
+    wbicExtraData->weightFb = WbcVec<T>::Constant(BaseFreedomDim, 0.1);
+    wbicExtraData->weightFr = WbcVec<T>::Constant(12, 1);
 
     taskBodyOri = new qrTaskBodyOrientation<T>(&fbModel);
     taskBodyPos = new qrTaskBodyPosition<T>(&fbModel);
@@ -107,28 +105,23 @@ qrWbcLocomotionController<T>::~qrWbcLocomotionController()
 template<typename T>
 void qrWbcLocomotionController<T>::Run(void *precomputeData)
 {
-    /* WBC is computed every 3 iterations. */
-    if (iteration % 2 == 0) {
-        qrWbcCtrlData *beforeWbcData = static_cast<qrWbcCtrlData *>(precomputeData);
-        // std::cout <<"pBody_des = " << beforeWbcData->pBody_des.transpose() << std::endl;
-        // std::cout <<"vBody_des = " << beforeWbcData->vBody_des.transpose() << std::endl;
-        // std::cout <<"pBody_RPY_des = " << beforeWbcData->pBody_RPY_des.transpose() << std::endl;
-        // std::cout <<"vBody_Ori_des = " << beforeWbcData->vBody_Ori_des.transpose() << std::endl;
-        // std::cout <<"contact_state = " << beforeWbcData->contact_state.transpose() << std::endl;
-
-        /* Update floating base model. */
-        UpdateModel(controlFSMData->quadruped);
-
-        /* Update Task & Contact Jacobian and Command. */
-        ContactTaskUpdate(static_cast<qrWbcCtrlData *>(precomputeData), controlFSMData);
-
-        /* Null space projection. Get desired position and velocity for PD controller. */
-        multitask->FindConfiguration(
-            fullConfig, taskList, contactList, desiredJPos, desiredJVel);
-        wbic->MakeTorque(jointTorqueCmd, wbicExtraData);
-    }
+    qrWbcCtrlData *beforeWbcData = static_cast<qrWbcCtrlData *>(precomputeData);
+    // std::cout <<"pBody_des = " << beforeWbcData->pBody_des.transpose() << std::endl;
+    // std::cout <<"vBody_des = " << beforeWbcData->vBody_des.transpose() << std::endl;
+    // std::cout <<"pBody_RPY_des = " << beforeWbcData->pBody_RPY_des.transpose() << std::endl;
+    // std::cout <<"vBody_Ori_des = " << beforeWbcData->vBody_Ori_des.transpose() << std::endl;
+    // std::cout <<"contact_state = " << beforeWbcData->contact_state.transpose() << std::endl;
+
+    /* Update floating base model. */
+    UpdateModel(controlFSMData->quadruped);
 
-    UpdateLegCMD(controlFSMData);
+    /* Update Task & Contact Jacobian and Command. */
+    ContactTaskUpdate(static_cast<qrWbcCtrlData *>(precomputeData), controlFSMData);
+
+    /* Null space projection. Get desired position and velocity for PD controller. */
+    multitask->FindConfiguration(
+        fullConfig, taskList, contactList, desiredJPos, desiredJVel);
+    wbic->MakeTorque(jointTorqueCmd, wbicExtraData);
 
     ++iteration;
 }
@@ -137,31 +130,9 @@ void qrWbcLocomotionController<T>::Run(void *precomputeData)
 template<typename T>
 void qrWbcLocomotionController<T>::UpdateModel(Quadruped::qrRobot *robot)
 {
-    /* Setup base and joint information of the floating base system. */
-    modelState.bodyOrientation = robot->GetBaseOrientation();
-    modelState.bodyPosition = robot->GetBasePosition();
-    auto vBody = robot->GetBaseVelocityInBaseFrame();
-    auto q = robot->GetMotorAngles();
-    auto dq = robot->GetMotorVelocities();
-    auto omegaBody = robot->GetBaseRollPitchYawRate();
-    for (size_t i = 0; i < 3; ++i) {
-        modelState.bodyVelocity[i] = omegaBody[i];// in body frame
-        modelState.bodyVelocity[i + 3] = vBody[i];
-
-        for (size_t leg = 0; leg < NumLeg; ++leg) {
-            size_t motorId = 3 * leg + i;
-            modelState.q[motorId] = q[motorId];
-            modelState.qd[motorId] = dq[motorId];
-            fullConfig[motorId + BaseFreedomDim] = modelState.q[motorId];
-        }
-    }
-
-    /* Update the floating base model. */
-    fbModel.setState(modelState);
-    fbModel.contactJacobians();
-    fbModel.massMatrix();
-    fbModel.generalizedGravityForce();
-    fbModel.generalizedCoriolisForce();
+    /* Update the floating base model, unless the estimators have evaluated it at this state already. */
+    robot->UpdateDynamicsModel();
+    fullConfig.segment(BaseFreedomDim, NumMotor) = robot->modelState.q.template cast<T>();
 
     /* Update WBIC data from floating base model. */
     wbic->GetModelRes(fbModel);
@@ -187,7 +158,7 @@ void qrWbcLocomotionController<T>::ContactTaskUpdate(qrWbcCtrlData *ctrlData, qr
 
     for (size_t leg = 0; leg < NumLeg; ++leg) {
         if (ctrlData->contact_state[leg]) {
-            footContact[leg]->SetDesiredFr((DVec<T>)(ctrlData->Fr_des[leg]));
+            footContact[leg]->SetDesiredFr(ctrlData->Fr_des[leg]);
             footContact[leg]->UpdateContactSpec();
             contactList.push_back(footContact[leg]);
         } else {
@@ -205,6 +176,7 @@ template<typename T>
 void qrWbcLocomotionController<T>::UpdateLegCMD(qrControlFSMData<T> *data)
 {
     std::vector<Quadruped::qrMotorCommand> &cmd = data->legCmd;
+    wbcCtrlData->jointTorqueCmd = jointTorqueCmd.template cast<float>();
 
     for (int leg = 0; leg < NumLeg; ++leg) {
         for (int j = 0; j < NumMotorOfOneLeg; ++j) {
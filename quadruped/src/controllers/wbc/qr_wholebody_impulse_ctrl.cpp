@@ -24,6 +24,7 @@
 
 #include "controllers/wbc/qr_wholebody_impulse_ctrl.hpp"
 
+#include "utils/qr_solver_arena.h"
 #include "utils/qr_cpptypes.h"
 
 
@@ -37,12 +38,18 @@ qrWholeBodyImpulseCtrl<T>::qrWholeBodyImpulseCtrl(
     dimQdot(dim_qdot),
     numActJoint(dim_qdot - dimFb)
 {
-    Sf = DMat<T>::Zero(BaseFreedomDim, dimQdot);
+    Sf = WbcMat<T>::Zero(BaseFreedomDim, dimQdot);
     Sf.block(0, 0, 6, 6).setIdentity();
-    identityMat = DMat<T>::Identity(dimQdot, dimQdot);
+    identityMat = WbcMat<T>::Identity(dimQdot, dimQdot);
 
     contactList = contact_list;
     taskLisk = task_list;
+
+    /* Each contact of qrSingleContact adds 3 reaction forces and 6 inequality constraints. */
+    for (size_t i = 0; i <= NumLeg; ++i) {
+        ResizeProblem(qpProblems[i], dimFb + 3 * i, dimFb, i > 0 ? 6 * i : 1);
+    }
+    qp = &qpProblems[0];
 }
 
 
@@ -74,9 +81,9 @@ void qrWholeBodyImpulseCtrl<T>::MakeTorque(DVec<T> &cmd, void *extraInput)
     /* Get dynamically consistent pseudo inverse matrix of jacobian,
      * and then compute the inital projection matrix for acceleration.
      */
-    DVec<T> qddot_pre;
-    DMat<T> JcBar;
-    DMat<T> Npre;
+    WbcVec<T> qddot_pre;
+    WbcMat<T> JcBar;
+    WbcMat<T> Npre;
     if (dimFr > 0) {
         ContactBuilding();
         SetInequalityConstraint(); /* Setup Inequality constraints by the way. */
@@ -84,13 +91,13 @@ void qrWholeBodyImpulseCtrl<T>::MakeTorque(DVec<T> &cmd, void *extraInput)
         qddot_pre = JcBar * (-JCDotQdot);
         Npre.noalias() = identityMat - JcBar * JC;
     } else {
-        qddot_pre = DVec<T>::Zero(dimQdot);
+        qddot_pre = WbcVec<T>::Zero(dimQdot);
         Npre = identityMat;
     }
 
     qrTask<T> *task;
-    DMat<T> Jt, JtBar, JtPre;
-    DVec<T> JtDotQdot, xddot;
+    WbcMat<T> Jt, JtBar, JtPre;
+    WbcVec<T> JtDotQdot, xddot;
 
     /* Null-space projection for accleration command. */
     for (size_t i = 0; i < taskLisk->size(); ++i) {
@@ -110,23 +117,27 @@ void qrWholeBodyImpulseCtrl<T>::MakeTorque(DVec<T> &cmd, void *extraInput)
 
     SetEqualityConstraint(qddot_pre);/* Setup the dynamics constraint. */
 
-    T f = solve_quadprog(qpG, qpg0, qpCE, qpce0, qpCI, qpci0, qpz);
+    {
+        /* QuadProg++ allocates its working matrices in every solve, from the solver arena. */
+        Quadruped::qrSolverAllocScope solverScope;
+        solve_quadprog(qp->G, qp->g0, qp->CE, qp->ce0, qp->CI, qp->ci0, qp->z);
+    }
 
     /* qddot = qddot_cmd + delta_q */
     for (size_t i = 0; i < dimFb; ++i) {
-        qddot_pre[i] += qpz[i];
+        qddot_pre[i] += qp->z[i];
     }
 
     GetSolution(qddot_pre, cmd);
 
-    extraData->optimizedResult = DVec<T>(dimOptimal);
+    extraData->optimizedResult.resize(dimOptimal);
     for (size_t i = 0; i < dimOptimal; ++i) {
-        extraData->optimizedResult[i] = qpz[i];
+        extraData->optimizedResult[i] = qp->z[i];
     }
 }
 
 template<typename T>
-void qrWholeBodyImpulseCtrl<T>::SetEqualityConstraint(const DVec<T> &qddot)
+void qrWholeBodyImpulseCtrl<T>::SetEqualityConstraint(const WbcVec<T> &qddot)
 {
     if (dimFr > 0) {
         /* The dynamicsCE will seems like: [ A6x6 | -Sf * JC^T ]. */
@@ -141,9 +152,9 @@ void qrWholeBodyImpulseCtrl<T>::SetEqualityConstraint(const DVec<T> &qddot)
     /* Convert to quadprogpp matrix/vector. */
     for (size_t i = 0; i < dimEqConstraint; ++i) {
         for (size_t j = 0; j < dimOptimal; ++j) {
-            qpCE[j][i] = CE(i, j);
+            qp->CE[j][i] = CE(i, j);
         }
-        qpce0[i] = -ce0[i];
+        qp->ce0[i] = -ce0[i];
     }
 }
 
@@ -160,9 +171,9 @@ void qrWholeBodyImpulseCtrl<T>::SetInequalityConstraint()
     /* Convert to quadprogpp matrix/vector. */
     for (size_t i(0); i < dimIneqConstraint; ++i) {
         for (size_t j(0); j < dimOptimal; ++j) {
-            qpCI[j][i] = CI(i, j);
+            qp->CI[j][i] = CI(i, j);
         }
-        qpci0[i] = -ci0[i];
+        qp->ci0[i] = -ci0[i];
     }
 }
 
@@ -170,10 +181,10 @@ void qrWholeBodyImpulseCtrl<T>::SetInequalityConstraint()
 template<typename T>
 void qrWholeBodyImpulseCtrl<T>::ContactBuilding()
 {
-    DMat<T> Uf;
-    DVec<T> Uf_ieq_vec;
-    DMat<T> Jc;
-    DVec<T> JcDotQdot;
+    WbcMat<T> Uf;
+    WbcVec<T> Uf_ieq_vec;
+    WbcMat<T> Jc;
+    WbcVec<T> JcDotQdot;
     size_t dim_accumul_rf = 0, dim_accumul_uf = 0;
     size_t dim_new_rf = 0, dim_new_uf = 0;
 
@@ -207,16 +218,16 @@ void qrWholeBodyImpulseCtrl<T>::ContactBuilding()
 
 
 template<typename T>
-void qrWholeBodyImpulseCtrl<T>::GetSolution(const DVec<T> &qddot, DVec<T> &cmd)
+void qrWholeBodyImpulseCtrl<T>::GetSolution(const WbcVec<T> &qddot, DVec<T> &cmd)
 {
-    DVec<T> tot_tau;
+    WbcVec<T> tot_tau;
 
     if (dimFr > 0) {
-        extraData->optimalFr = DVec<T>(dimFr);
+        extraData->optimalFr.resize(dimFr);
 
         /* Store total reaction force to extra data. */
         for (size_t i = 0; i < dimFr; ++i) {
-            extraData->optimalFr[i] = qpz[i + dimFb] + desiredFr[i];
+            extraData->optimalFr[i] = qp->z[i + dimFb] + desiredFr[i];
         }
         tot_tau = A * qddot + Coriolis + Gravity - JC.transpose() * extraData->optimalFr;
     } else {
@@ -237,12 +248,12 @@ void qrWholeBodyImpulseCtrl<T>::SetCost()
      * All stored into a diagnose matrix.
      */
     for (size_t i = 0; i < dimFb; ++i) {
-        qpG[i + idx_offset][i + idx_offset] = extraData->weightFb[i];
+        qp->G[i + idx_offset][i + idx_offset] = extraData->weightFb[i];
     }
 
     idx_offset += dimFb;
     for (size_t i = 0; i < dimFr; ++i) {
-        qpG[i + idx_offset][i + idx_offset] = extraData->weightFr[i];
+        qp->G[i + idx_offset][i + idx_offset] = extraData->weightFr[i];
     }
 }
 
@@ -260,40 +271,46 @@ void qrWholeBodyImpulseCtrl<T>::SetOptimizationSize()
     dimOptimal = dimFb + dimFr;/* 6 + 3 * ContactNum */
     dimEqConstraint = dimFb;
 
-    qpG.resize(0., dimOptimal, dimOptimal);
-    qpg0.resize(0., dimOptimal);
-    qpCE.resize(0., dimOptimal, dimEqConstraint);
-    qpce0.resize(0., dimEqConstraint);
+    qp = &qpProblems[std::min(contactList->size(), (size_t)NumLeg)];
+    ResizeProblem(*qp, dimOptimal, dimEqConstraint, dimFr > 0 ? dimIneqConstraint : 1);
 
-    CE = DMat<T>::Zero(dimEqConstraint, dimOptimal);
-    ce0 = DVec<T>(dimEqConstraint);
+    CE = WbcMat<T>::Zero(dimEqConstraint, dimOptimal);
+    ce0 = WbcVec<T>(dimEqConstraint);
     if (dimFr > 0) {
-        qpCI.resize(0., dimOptimal, dimIneqConstraint);
-        qpci0.resize(0., dimIneqConstraint);
-        CI = DMat<T>::Zero(dimIneqConstraint, dimOptimal);
-        ci0 = DVec<T>(dimIneqConstraint);
+        CI = WbcMat<T>::Zero(dimIneqConstraint, dimOptimal);
+        ci0 = WbcVec<T>(dimIneqConstraint);
 
-        JC = DMat<T>(dimFr, dimQdot);
-        JCDotQdot = DVec<T>(dimFr);
-        desiredFr = DVec<T>(dimFr);
+        JC = WbcMat<T>(dimFr, dimQdot);
+        JCDotQdot = WbcVec<T>(dimFr);
+        desiredFr = WbcVec<T>(dimFr);
 
-        UF = DMat<T>(dimIneqConstraint, dimFr);
+        UF = WbcMat<T>(dimIneqConstraint, dimFr);
         UF.setZero();
-        ineqVec = DVec<T>(dimIneqConstraint);
-    } else {
-        qpCI.resize(0., dimOptimal, 1);
-        qpci0.resize(0., 1);
+        ineqVec = WbcVec<T>(dimIneqConstraint);
     }
 }
 
 
 template<typename T>
-void qrWholeBodyImpulseCtrl<T>::WeightedInverse(const DMat<T> &J, const DMat<T> &Winv, DMat<T> &Jinv, double threshold)
+void qrWholeBodyImpulseCtrl<T>::ResizeProblem(QuadProgProblem &problem, size_t dimOpt, size_t dimEq, size_t dimIneq)
+{
+    problem.z.resize(0., dimOpt);
+    problem.G.resize(0., dimOpt, dimOpt);
+    problem.g0.resize(0., dimOpt);
+    problem.CE.resize(0., dimOpt, dimEq);
+    problem.ce0.resize(0., dimEq);
+    problem.CI.resize(0., dimOpt, dimIneq);
+    problem.ci0.resize(0., dimIneq);
+}
+
+
+template<typename T>
+void qrWholeBodyImpulseCtrl<T>::WeightedInverse(const WbcMat<T> &J, const WbcMat<T> &Winv, WbcMat<T> &Jinv, double threshold)
 {
     /* J_bar = A_inv * J^T ( J * A_inv * J^T)^(-1). */
-    DMat<T> temp(Winv * J.transpose());
-    DMat<T> lambda(J * temp);
-    DMat<T> lambda_inv;
+    WbcMat<T> temp(Winv * J.transpose());
+    WbcMat<T> lambda(J * temp);
+    WbcMat<T> lambda_inv;
     pseudoInverse(lambda, threshold, lambda_inv);
     Jinv.noalias() = temp * lambda_inv;
 }
@@ -29,9 +29,9 @@ template<typename T>
 qrTaskBodyOrientation<T>::qrTaskBodyOrientation(const FloatingBaseModel<T> *fb_model):
     qrTask<T>(3), fbModel(fb_model)
 {
-    TK::Jt = DMat<T>::Zero(TK::dimTask, this->dimConfig);
+    TK::Jt = WbcMat<T>::Zero(TK::dimTask, this->dimConfig);
     TK::Jt.block(0, 0, 3, 3).setIdentity();
-    TK::JtDotQdot = DVec<T>::Zero(TK::dimTask);
+    TK::JtDotQdot = WbcVec<T>::Zero(TK::dimTask);
 
     errScale = DVec<T>::Constant(TK::dimTask, 1.);
     Kp = DVec<T>::Constant(TK::dimTask, 50.);
@@ -40,7 +40,7 @@ qrTaskBodyOrientation<T>::qrTaskBodyOrientation(const FloatingBaseModel<T> *fb_m
 
 
 template<typename T>
-bool qrTaskBodyOrientation<T>::UpdateCommand(const void *des_pos, const DVec<T> &des_vel, const DVec<T> &des_acc)
+bool qrTaskBodyOrientation<T>::UpdateCommand(const void *des_pos, const WbcVec<T> &des_vel, const WbcVec<T> &des_acc)
 {
     Quat<T> *ori_cmd = (Quat<T> *)des_pos;
     Quat<T> link_ori = (fbModel->_state.bodyOrientation);
@@ -29,9 +29,9 @@ template <typename T>
 qrTaskBodyPosition<T>::qrTaskBodyPosition(const FloatingBaseModel<T>* fb_model):
     qrTask<T>(3), fbModel(fb_model)
 {
-    TK::Jt = DMat<T>::Zero(TK::dimTask, this->dimConfig);
+    TK::Jt = WbcMat<T>::Zero(TK::dimTask, this->dimConfig);
     TK::Jt.block(0, 3, 3, 3).setIdentity();
-    TK::JtDotQdot = DVec<T>::Zero(TK::dimTask);
+    TK::JtDotQdot = WbcVec<T>::Zero(TK::dimTask);
 
     errScale = DVec<T>::Constant(TK::dimTask, 1.);
     Kp = DVec<T>::Constant(TK::dimTask, 30.);
@@ -40,7 +40,7 @@ qrTaskBodyPosition<T>::qrTaskBodyPosition(const FloatingBaseModel<T>* fb_model):
 
 
 template <typename T>
-bool qrTaskBodyPosition<T>::UpdateCommand(const void* des_pos, const DVec<T>& des_vel, const DVec<T>& des_acc) {
+bool qrTaskBodyPosition<T>::UpdateCommand(const void* des_pos, const WbcVec<T>& des_vel, const WbcVec<T>& des_acc) {
     Vec3<T>* pos_cmd = (Vec3<T>*)des_pos;
     Vec3<T> link_pos = fbModel->_state.bodyPosition; /* Body position in world frame. */
 
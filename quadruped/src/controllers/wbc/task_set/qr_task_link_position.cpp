@@ -32,8 +32,8 @@ qrTaskLinkPosition<T>::qrTaskLinkPosition(const FloatingBaseModel<T> *fb_model,
     linkIndex(link_idx),
     virtualDepend(virtual_depend)
 {
-    TK::Jt = DMat<T>::Zero(TK::dimTask, this->dimConfig);
-    TK::JtDotQdot = DVec<T>::Zero(TK::dimTask);
+    TK::Jt = WbcMat<T>::Zero(TK::dimTask, this->dimConfig);
+    TK::JtDotQdot = WbcVec<T>::Zero(TK::dimTask);
 
     errScale = DVec<T>::Constant(TK::dimTask, 1.);
     Kp = DVec<T>::Constant(TK::dimTask, 100.);
@@ -42,7 +42,7 @@ qrTaskLinkPosition<T>::qrTaskLinkPosition(const FloatingBaseModel<T> *fb_model,
 
 
 template<typename T>
-bool qrTaskLinkPosition<T>::UpdateCommand(const void *des_pos, const DVec<T> &des_vel, const DVec<T> &des_acc)
+bool qrTaskLinkPosition<T>::UpdateCommand(const void *des_pos, const WbcVec<T> &des_vel, const WbcVec<T> &des_acc)
 {
     Vec3<T> *pos_cmd = (Vec3<T> *)des_pos;/* des_pos is in world frame. */
     Vec3<T> link_pos;
@@ -70,7 +70,7 @@ bool qrTaskLinkPosition<T>::UpdateTaskJacobian()
     /* Get the Jc from the floating base model. */
     TK::Jt = fbModel->_Jc[linkIndex];
     if (!virtualDepend) {
-        TK::Jt.block(0, 0, 3, 6) = DMat<T>::Zero(3, 6);
+        TK::Jt.block(0, 0, 3, 6).setZero();
     }
     return true;
 }
@@ -564,7 +564,7 @@ void FloatingBaseModel<T>::contactJacobians() {
     _Jcdqd[k] = spatialToLinearAcceleration(ac, vc);
 
     // rows for linear velcoity in the world
-    D3Mat<T> Xout = Xc.template bottomRows<3>();
+    Eigen::Matrix<T, 3, 6> Xout = Xc.template bottomRows<3>();
     // std::cout << "k=" << k<< ", Xout = " << Xout << std::endl;
     
     // from tips to base
@@ -604,7 +604,7 @@ void FloatingBaseModel<T>::biasAccelerations() {
  * @return G (_nDof x 1 vector)
  */
 template <typename T>
-DVec<T> FloatingBaseModel<T>::generalizedGravityForce() {
+const DVec<T>& FloatingBaseModel<T>::generalizedGravityForce() {
   compositeInertias();
 
   SVec<T> aGravity;
@@ -630,7 +630,7 @@ DVec<T> FloatingBaseModel<T>::generalizedGravityForce() {
  * @return Cqd (_nDof x 1 vector)
  */
 template <typename T>
-DVec<T> FloatingBaseModel<T>::generalizedCoriolisForce() {
+const DVec<T>& FloatingBaseModel<T>::generalizedCoriolisForce() {
   biasAccelerations();
 
   // Floating base force
@@ -771,7 +771,7 @@ void FloatingBaseModel<T>::compositeInertias() {
  * @return H (_nDof x _nDof matrix)
  */
 template <typename T>
-DMat<T> FloatingBaseModel<T>::massMatrix() {
+const DMat<T>& FloatingBaseModel<T>::massMatrix() {
   compositeInertias();
   _H.setZero();
 
@@ -931,7 +931,7 @@ void FloatingBaseModel<T>::runABA(const DVec<T> &tau,
   _a[5] += afb;
 
   // joint accelerations
-  dstate.qdd = DVec<T>(_nDof - 6);
+  dstate.qdd.resize(_nDof - 6);
   for (size_t i = 6; i < _nDof; i++) {
     dstate.qdd[i - 6] =
         (_u[i] - _Utot[i].transpose() * _a[_parents[i]]) / _d[i];
@@ -205,7 +205,12 @@ void qrContactDetection::Update(float currentTime)
     }
 
     // torque/force
-    Vec4<float> externalTorques = JointObserver(currentTime);
+    Vec4<float> externalTorques;
+    if (momentumObserver && momentumObserver->IsReady()) {
+        externalTorques = GMObserver(currentTime);
+    } else {
+        externalTorques = JointObserver(currentTime);
+    }
     auto forces = robot->GetFootForce();
     /* compute contact probility using terque */
     for (int legId=0; legId< NumLeg; ++legId) {
@@ -290,9 +295,14 @@ void qrContactDetection::UpdateSlip(float currentTime)
 }
 
 
-void qrContactDetection::GMObserver(float currentTime)
+Vec4<float> qrContactDetection::GMObserver(float currentTime)
 {
-    // todo
+    const Eigen::Matrix<float, NumMotor, 1> jointTorques = momentumObserver->GetExternalJointTorques();
+    for (int legId=0; legId < NumLeg; ++legId) {
+        externalTorques[legId] = jointTorques[3*legId + 2];
+    }
+    lastTime = currentTime;
+    return externalTorques;
 }
 
 
@@ -0,0 +1,198 @@
+// The MIT License
+
+// Copyright (c) 2022
+// Robot Motion and Vision Laboratory at East China Normal University
+// Contact: tophill.robotics@gmail.com
+
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include "estimators/qr_elevation_map.h"
+
+#include <algorithm>
+#include <limits>
+
+
+namespace Quadruped {
+
+qrElevationMap::qrElevationMap(float resolutionIn, float measurementVarianceIn, float processVarianceIn):
+    resolution(resolutionIn),
+    measurementVariance(measurementVarianceIn),
+    processVariance(processVarianceIn),
+    height(SIZE * SIZE, 0.f),
+    variance(SIZE * SIZE, std::numeric_limits<float>::infinity()),
+    revision(0),
+    copySource(nullptr),
+    copyRevision(0)
+{
+    Reset();
+}
+
+
+void qrElevationMap::Reset()
+{
+    centerX = 0;
+    centerY = 0;
+    std::fill(height.begin(), height.end(), 0.f);
+    std::fill(variance.begin(), variance.end(), std::numeric_limits<float>::infinity());
+    ++revision;
+}
+
+
+void qrElevationMap::ClearColumn(int ix)
+{
+    for (int iy = 0; iy < SIZE; ++iy) {
+        variance[Offset(ix, iy)] = std::numeric_limits<float>::infinity();
+    }
+}
+
+
+void qrElevationMap::ClearRow(int iy)
+{
+    for (int ix = 0; ix < SIZE; ++ix) {
+        variance[Offset(ix, iy)] = std::numeric_limits<float>::infinity();
+    }
+}
+
+
+void qrElevationMap::Recenter(float x, float y)
+{
+    const int newCenterX = CellIndex(x);
+    const int newCenterY = CellIndex(y);
+    const int dx = newCenterX - centerX;
+    const int dy = newCenterY - centerY;
+    if (dx == 0 && dy == 0) {
+        return;
+    }
+
+    if (std::abs(dx) >= SIZE || std::abs(dy) >= SIZE) {
+        std::fill(variance.begin(), variance.end(), std::numeric_limits<float>::infinity());
+    } else {
+        /* Only the cells scrolling in are cleared, the others keep their storage. */
+        for (int ix = std::min(centerX, newCenterX); ix < std::max(centerX, newCenterX); ++ix) {
+            ClearColumn(dx > 0 ? ix + SIZE / 2 : ix - SIZE / 2);
+        }
+        for (int iy = std::min(centerY, newCenterY); iy < std::max(centerY, newCenterY); ++iy) {
+            ClearRow(dy > 0 ? iy + SIZE / 2 : iy - SIZE / 2);
+        }
+    }
+    centerX = newCenterX;
+    centerY = newCenterY;
+    ++revision;
+}
+
+
+void qrElevationMap::Fuse(const Vec3<float> &point)
+{
+    const int ix = CellIndex(point[0]);
+    const int iy = CellIndex(point[1]);
+    if (!Contains(ix, iy)) {
+        return;
+    }
+    const int offset = Offset(ix, iy);
+    float &h = height[offset];
+    float &v = variance[offset];
+    if (std::isinf(v)) {
+        h = point[2];
+        v = measurementVariance;
+    } else {
+        v += processVariance;
+        float k = v / (v + measurementVariance);
+        h += k * (point[2] - h);
+        v *= (1 - k);
+    }
+    ++revision;
+}
+
+
+bool qrElevationMap::GetHeight(float x, float y, float &z) const
+{
+    const int ix = CellIndex(x);
+    const int iy = CellIndex(y);
+    if (!Contains(ix, iy)) {
+        return false;
+    }
+    const int offset = Offset(ix, iy);
+    if (std::isinf(variance[offset])) {
+        return false;
+    }
+    z = height[offset];
+    return true;
+}
+
+
+float qrElevationMap::GetVariance(float x, float y) const
+{
+    const int ix = CellIndex(x);
+    const int iy = CellIndex(y);
+    if (!Contains(ix, iy)) {
+        return std::numeric_limits<float>::infinity();
+    }
+    return variance[Offset(ix, iy)];
+}
+
+
+int qrElevationMap::FitPlane(const Vec2<float> &center, float radius, Vec3<float> &a) const
+{
+    /* Weighted least squares over the known cells, accumulated as normal equations. */
+    Mat3<double> ATA = Mat3<double>::Zero();
+    Vec3<double> ATb = Vec3<double>::Zero();
+    int cellNum = 0;
+    const int xBegin = std::max(CellIndex(center[0] - radius), centerX - SIZE / 2);
+    const int xEnd = std::min(CellIndex(center[0] + radius), centerX + SIZE / 2 - 1);
+    const int yBegin = std::max(CellIndex(center[1] - radius), centerY - SIZE / 2);
+    const int yEnd = std::min(CellIndex(center[1] + radius), centerY + SIZE / 2 - 1);
+    for (int iy = yBegin; iy <= yEnd; ++iy) {
+        for (int ix = xBegin; ix <= xEnd; ++ix) {
+            const int offset = Offset(ix, iy);
+            if (std::isinf(variance[offset])) {
+                continue;
+            }
+            const double w = 1.0 / std::max(variance[offset], 1e-8f);
+            const Vec3<double> row(1.0, (ix + 0.5) * resolution - center[0], (iy + 0.5) * resolution - center[1]);
+            ATA.noalias() += w * row * row.transpose();
+            ATb += w * height[offset] * row;
+            ++cellNum;
+        }
+    }
+
+    /* At least three cells which are not on a line. */
+    if (cellNum < 3 || std::abs(ATA.determinant()) < 1e-12 * std::pow(ATA.trace(), 3)) {
+        return 0;
+    }
+    a = ATA.ldlt().solve(ATb).cast<float>();
+    return cellNum;
+}
+
+
+void qrElevationMap::CopyFrom(const qrElevationMap &other)
+{
+    /* The revisions of two maps count independently, so they are only compared against the same source. */
+    if (&other == this || (copySource == &other && other.revision == copyRevision && revision == copyRevision)) {
+        return;
+    }
+    centerX = other.centerX;
+    centerY = other.centerY;
+    std::copy(other.height.begin(), other.height.end(), height.begin());
+    std::copy(other.variance.begin(), other.variance.end(), variance.begin());
+    revision = other.revision;
+    copySource = &other;
+    copyRevision = other.revision;
+}
+
+} // Namespace Quadruped
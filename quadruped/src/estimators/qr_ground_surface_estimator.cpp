@@ -32,6 +32,11 @@ qrGroundSurfaceEstimator::qrGroundSurfaceEstimator(qrRobot *robotIn, std::string
     footStepperConfig = YAML::LoadFile(terrainConfigPath);
     terrain.footHoldOffset = footStepperConfig["foothold_offset"].as<float>();
     robot->footHoldOffset = terrain.footHoldOffset;
+    elevationMap = qrElevationMap(footStepperConfig["elevation_map_resolution"].as<float>(0.04f),
+                                  footStepperConfig["elevation_map_variance"].as<float>(1e-4f),
+                                  footStepperConfig["elevation_map_process_variance"].as<float>(1e-4f));
+    mapFitRadius = footStepperConfig["elevation_map_fit_radius"].as<float>(0.3f);
+    mapFitMinCells = footStepperConfig["elevation_map_fit_min_cells"].as<int>(4);
     Reset(0.f);
     std::cout << "init groundEsitmator finish\n" << std::endl;
 }
@@ -40,6 +45,9 @@ qrGroundSurfaceEstimator::qrGroundSurfaceEstimator(qrRobot *robotIn, std::string
 void qrGroundSurfaceEstimator::Update(float currentTime)
 {   
     Eigen::Matrix<bool, 4, 1> contactState = robot->GetFootContact();
+    Vec3<float> basePosition = robot->GetBasePosition();
+    elevationMap.Recenter(basePosition[0], basePosition[1]);
+
     bool shouldUpdate = false;
     int N=0;
     int i=0;
@@ -47,29 +55,77 @@ void qrGroundSurfaceEstimator::Update(float currentTime)
         if (contactState[i]) {
             if ((!lastContactState[i])) {
                 shouldUpdate = true;
+                /* Every touchdown is a sample of the terrain. */
+                Vec3<float> footPositionInBaseFrame = robot->GetFootPositionsInBaseFrame().col(i);
+                elevationMap.Fuse(basePosition + robot->stateDataFlow.baseRMat * footPositionInBaseFrame);
             }
             ++N;
         }
     }
     lastContactState = contactState;
-    if (N <= 3 || !shouldUpdate) {
+    if (!shouldUpdate) {
         return;
     }
-    Eigen::Matrix<double, 3, 4> footPositionsInBaseFrame = robot->GetFootPositionsInBaseFrame().cast<double>();
-    bodyPositionInWorldFrame = robot->GetBasePosition(); 
+    bodyPositionInWorldFrame = basePosition;
     bodyPositionInWorldFrame[2] = robot->stateDataFlow.heightInControlFrame;
-    pZ = footPositionsInBaseFrame.row(2);
-    W.col(1) = footPositionsInBaseFrame.row(0);
-    W.col(2) = footPositionsInBaseFrame.row(1);
+    if (!UpdatePlaneFromMap()) {
+        if (N <= 3) {
+            return;
+        }
+        Eigen::Matrix<double, 3, 4> footPositionsInBaseFrame = robot->GetFootPositionsInBaseFrame().cast<double>();
+        pZ = footPositionsInBaseFrame.row(2);
+        W.col(1) = footPositionsInBaseFrame.row(0);
+        W.col(2) = footPositionsInBaseFrame.row(1);
 
-    /* the plane : z(x, y) = a[0] + a[1]x + a[2]y */
-    Mat3<double> ww = W.transpose()* W;
-    a = ww.inverse()* W.transpose()*pZ;
+        /* the plane : z(x, y) = a[0] + a[1]x + a[2]y */
+        a = (W.transpose() * W).ldlt().solve(W.transpose() * pZ);
+    }
     GetNormalVector(true);
     ComputeControlFrame();
 }
 
 
+bool qrGroundSurfaceEstimator::UpdatePlaneFromMap()
+{
+    Vec3<double> basePosition = robot->GetBasePosition().cast<double>();
+    Vec3<float> b;
+    if (elevationMap.FitPlane(basePosition.head<2>().cast<float>(), mapFitRadius, b) < mapFitMinCells) {
+        return false;
+    }
+
+    /* The plane z = b0 + b1 (x - cx) + b2 (y - cy) in world frame, through q with normal nw.
+       In base frame, q_b = R^T (q - p) and n_b = R^T nw, so z(x, y) = a0 + a1 x + a2 y with
+       a1 = -n_b.x / n_b.z, a2 = -n_b.y / n_b.z, a0 = q_b.z - a1 q_b.x - a2 q_b.y. */
+    Mat3<double> R = robot->stateDataFlow.baseRMat.cast<double>();
+    Vec3<double> q(basePosition[0], basePosition[1], b[0]);
+    Vec3<double> qInBaseFrame = R.transpose() * (q - basePosition);
+    Vec3<double> nInBaseFrame = R.transpose() * Vec3<double>(-b[1], -b[2], 1.0);
+    if (std::abs(nInBaseFrame[2]) < 1e-3) {
+        return false;
+    }
+    a[1] = -nInBaseFrame[0] / nInBaseFrame[2];
+    a[2] = -nInBaseFrame[1] / nInBaseFrame[2];
+    a[0] = qInBaseFrame[2] - a[1] * qInBaseFrame[0] - a[2] * qInBaseFrame[1];
+    return true;
+}
+
+
+void qrGroundSurfaceEstimator::CopyEstimates(const qrGroundSurfaceEstimator &other)
+{
+    a = other.a;
+    W = other.W;
+    pZ = other.pZ;
+    n = other.n;
+    bodyPositionInWorldFrame = other.bodyPositionInWorldFrame;
+    controlFrame = other.controlFrame;
+    controlFrameRPY = other.controlFrameRPY;
+    controlFrameOrientation = other.controlFrameOrientation;
+    lastContactState = other.lastContactState;
+    elevationMap.CopyFrom(other.elevationMap);
+    terrain.terrainType = other.terrain.terrainType;
+}
+
+
 void qrGroundSurfaceEstimator::Reset(float currentTime)
 {
     terrain.terrainType = static_cast<TerrainType>(footStepperConfig["terrain_type"].as<int>());
@@ -123,6 +179,8 @@ void qrGroundSurfaceEstimator::Reset(float currentTime)
                     0, 0, 1, 0,
                     0, 0, 0, 1;
     lastContactState << 0, 0, 0, 0;
+    elevationMap.Reset();
+    elevationMap.Recenter(bodyPositionInWorldFrame[0], bodyPositionInWorldFrame[1]);
 
     robot->stateDataFlow.groundRMat.setIdentity();
     robot->stateDataFlow.groundOrientation << 1.f, 0.f, 0.f, 0.f;
@@ -0,0 +1,259 @@
+// The MIT License
+
+// Copyright (c) 2022
+// Robot Motion and Vision Laboratory at East China Normal University
+// Contact: tophill.robotics@gmail.com
+
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include "estimators/qr_invariant_ekf.h"
+
+namespace Quadruped {
+
+/**
+ * @brief Exponential map of SO(3) and its left Jacobian.
+ */
+static void ExpSO3(const Vec3<double> &w, Mat3<double> &R, Mat3<double> &Jl)
+{
+    const Mat3<double> I = Mat3<double>::Identity();
+    double angle = w.norm();
+    if (angle < 1e-10) {
+        R = I;
+        Jl = I;
+        return;
+    }
+    Mat3<double> W = robotics::math::vectorToSkewMat(w);
+    Mat3<double> W2 = W * W;
+    double angle2 = angle * angle;
+    double oneMinusCos = (1 - cos(angle)) / angle2;
+    R = I + (sin(angle) / angle) * W + oneMinusCos * W2;
+    Jl = I + oneMinusCos * W + ((angle - sin(angle)) / (angle2 * angle)) * W2;
+}
+
+/**
+ * @brief Exponential map of SE_K(3) of fixed size.
+ */
+static void ExpSEK3(const Eigen::Matrix<double, qrInvariantEKF::DIM_XI, 1> &xi,
+                    Eigen::Matrix<double, qrInvariantEKF::DIM_X, qrInvariantEKF::DIM_X> &dX)
+{
+    Mat3<double> R, Jl;
+    ExpSO3(xi.head<3>(), R, Jl);
+    dX.setIdentity();
+    dX.block<3, 3>(0, 0) = R;
+    for (int i = 0; i < qrInvariantEKF::DIM_X - 3; ++i) {
+        dX.block<3, 1>(0, 3 + i) = Jl * xi.segment<3>(3 + 3 * i);
+    }
+}
+
+
+qrInvariantEKF::qrInvariantEKF(qrRobot *robotIn):
+    robot(robotIn)
+{
+    /* Same defaults as the NoiseParams of extern/invariant-ekf. */
+    gyroscopeCov = 0.01 * 0.01 * Mat3<double>::Identity();
+    accelerometerCov = 0.1 * 0.1 * Mat3<double>::Identity();
+    gyroscopeBiasCov = 0.00001 * 0.00001 * Mat3<double>::Identity();
+    accelerometerBiasCov = 0.0001 * 0.0001 * Mat3<double>::Identity();
+    contactCov = 0.1 * 0.1 * Mat3<double>::Identity();
+    kinematicsCov = 0.01 * 0.01 * Mat3<double>::Identity();
+    gravity << 0, 0, -9.81;
+
+    /* Constant terms of the error dynamics. */
+    A.setZero();
+    A.block<3, 3>(3, 0) = robotics::math::vectorToSkewMat(gravity);
+    A.block<3, 3>(6, 3).setIdentity();
+    Adj.setIdentity();
+
+    Z.resize(0);
+    Reset(0);
+}
+
+
+void qrInvariantEKF::Reset(float currentTime)
+{
+    X.setIdentity();
+    X.block<3, 3>(0, 0) = robot->stateDataFlow.baseRMat.cast<double>();
+    X.block<3, 1>(0, 3).setZero();
+    X.block<3, 1>(0, 4) = robot->GetBasePosition().cast<double>();
+    theta.setZero();
+
+    P.setZero();
+    P.block<3, 3>(0, 0) = 0.03 * 0.03 * Mat3<double>::Identity();
+    P.block<3, 3>(3, 3) = 0.01 * 0.01 * Mat3<double>::Identity();
+    P.block<3, 3>(6, 6) = 0.01 * 0.01 * Mat3<double>::Identity();
+    P.block<3, 3>(DIM_XI, DIM_XI) = 0.0001 * 0.0001 * Mat3<double>::Identity();
+    P.block<3, 3>(DIM_XI + 3, DIM_XI + 3) = 0.0025 * 0.0025 * Mat3<double>::Identity();
+
+    Eigen::Matrix<double, 3, NumLeg> footPositions = robot->GetFootPositionsInBaseFrame().cast<double>();
+    const Vec4<bool> &contacts = robot->GetFootContact();
+    for (int legId = 0; legId < NumLeg; ++legId) {
+        InitializeFoot(legId, footPositions.col(legId));
+        footInState[legId] = contacts[legId];
+    }
+    lastTimestamp = 0;
+}
+
+
+double qrInvariantEKF::ComputeDeltaTime(uint32_t tick)
+{
+    double deltaTime;
+    if ((double)lastTimestamp < 1e-5) {
+        /* First timestamp received, return an estimated delta_time. */
+        deltaTime = robot->timeStep;
+    } else {
+        deltaTime = (tick - lastTimestamp) / 1000.;
+    }
+    lastTimestamp = tick;
+    return deltaTime;
+}
+
+
+void qrInvariantEKF::Update(float currentTime)
+{
+    double deltaTime = ComputeDeltaTime(robot->GetTick());
+    Propagate(robot->GetBaseRollPitchYawRate().cast<double>(), robot->baseAccInBaseFrame.cast<double>(), deltaTime);
+    CorrectKinematics(robot->GetFootPositionsInBaseFrame().cast<double>(), robot->GetFootContact());
+}
+
+
+void qrInvariantEKF::Propagate(const Vec3<double> &w, const Vec3<double> &a, double dt)
+{
+    Vec3<double> wUnbiased = w - theta.head<3>();
+    Vec3<double> aUnbiased = a - theta.tail<3>();
+    Mat3<double> R = X.block<3, 3>(0, 0);
+    Vec3<double> v = X.block<3, 1>(0, 3);
+    Vec3<double> p = X.block<3, 1>(0, 4);
+
+    /* Linearized invariant error dynamics, only the bias terms depend on the state. */
+    A.block<3, 3>(0, DIM_XI) = -R;
+    A.block<3, 3>(3, DIM_XI + 3) = -R;
+    for (int i = 3; i < DIM_X; ++i) {
+        A.block<3, 3>(3 * i - 6, DIM_XI) = -robotics::math::vectorToSkewMat(Vec3<double>(X.block<3, 1>(0, i))) * R;
+    }
+
+    Qk.setZero();
+    Qk.block<3, 3>(0, 0) = gyroscopeCov;
+    Qk.block<3, 3>(3, 3) = accelerometerCov;
+    for (int legId = 0; legId < NumLeg; ++legId) {
+        Qk.block<3, 3>(9 + 3 * legId, 9 + 3 * legId) = contactCov;
+    }
+    Qk.block<3, 3>(DIM_XI, DIM_XI) = gyroscopeBiasCov;
+    Qk.block<3, 3>(DIM_XI + 3, DIM_XI + 3) = accelerometerBiasCov;
+
+    /* Adjoint of X, the linearization is at the state before propagation. */
+    for (int i = 0; i < DIM_X - 2; ++i) {
+        Adj.block<3, 3>(3 * i, 3 * i) = R;
+        if (i > 0) {
+            Adj.block<3, 3>(3 * i, 0) = robotics::math::vectorToSkewMat(Vec3<double>(X.block<3, 1>(0, 2 + i))) * R;
+        }
+    }
+
+    Phi.setIdentity();
+    Phi.noalias() += A * dt;
+    PhiAdj.noalias() = Phi * Adj;
+    PTemp.noalias() = Phi * P;
+    P.noalias() = PTemp * Phi.transpose();
+    PTemp.noalias() = PhiAdj * Qk;
+    P.noalias() += (PTemp * PhiAdj.transpose()) * dt;
+
+    /* Strapdown IMU motion model, the biases and the feet are constant. */
+    Mat3<double> dR, Jl;
+    ExpSO3(wUnbiased * dt, dR, Jl);
+    Vec3<double> acc = R * aUnbiased + gravity;
+    X.block<3, 3>(0, 0) = R * dR;
+    X.block<3, 1>(0, 3) = v + acc * dt;
+    X.block<3, 1>(0, 4) = p + v * dt + 0.5 * acc * dt * dt;
+}
+
+
+void qrInvariantEKF::CorrectKinematics(const Eigen::Matrix<double, 3, NumLeg> &footPositions, const Vec4<bool> &contacts)
+{
+    Mat3<double> R = X.block<3, 3>(0, 0);
+    Vec3<double> p = X.block<3, 1>(0, 4);
+    Mat3<double> footCov = R * kinematicsCov * R.transpose();
+
+    int measNum = 0;
+    for (int legId = 0; legId < NumLeg; ++legId) {
+        if (contacts[legId] && footInState[legId]) {
+            ++measNum;
+        }
+    }
+
+    if (measNum > 0) {
+        Z.resize(3 * measNum);
+        H.setZero(3 * measNum, DIM_P);
+        N.setZero(3 * measNum, 3 * measNum);
+        int row = 0;
+        for (int legId = 0; legId < NumLeg; ++legId) {
+            if (!(contacts[legId] && footInState[legId])) {
+                continue;
+            }
+            /* Right-invariant residual of the foot kinematics, R * p_bc + p - d. */
+            Z.segment<3>(row) = R * footPositions.col(legId) + p - X.block<3, 1>(0, 5 + legId);
+            H.block<3, 3>(row, 6) = -Mat3<double>::Identity();
+            H.block<3, 3>(row, 9 + 3 * legId) = Mat3<double>::Identity();
+            N.block<3, 3>(row, row) = footCov;
+            row += 3;
+        }
+
+        PHT.noalias() = P * H.transpose();
+        S = N;
+        S.noalias() += H * PHT;
+        K = S.llt().solve(PHT.transpose()).transpose();
+
+        Eigen::Matrix<double, DIM_P, 1> delta = K * Z;
+        Eigen::Matrix<double, DIM_X, DIM_X> dX;
+        ExpSEK3(delta.head<DIM_XI>(), dX);
+        X = dX * X;
+        theta += delta.tail<DIM_THETA>();
+
+        /* Joseph form. */
+        IKH.setIdentity();
+        IKH.noalias() -= K * H;
+        PTemp.noalias() = IKH * P;
+        P.noalias() = PTemp * IKH.transpose();
+        PHT.noalias() = K * N;
+        P.noalias() += PHT * K.transpose();
+    }
+
+    /* A foot leaves the state when it lifts and comes back when it touches down. */
+    for (int legId = 0; legId < NumLeg; ++legId) {
+        if (!contacts[legId]) {
+            footInState[legId] = false;
+        } else if (!footInState[legId]) {
+            InitializeFoot(legId, footPositions.col(legId));
+            footInState[legId] = true;
+        }
+    }
+}
+
+
+void qrInvariantEKF::InitializeFoot(int legId, const Vec3<double> &footPosition)
+{
+    Mat3<double> R = X.block<3, 3>(0, 0);
+    X.block<3, 1>(0, 5 + legId) = X.block<3, 1>(0, 4) + R * footPosition;
+
+    /* Same as augmenting the state with F = [I; copy of the position rows] and G = R. */
+    const int index = 9 + 3 * legId;
+    P.block<3, DIM_P>(index, 0) = P.block<3, DIM_P>(6, 0);
+    P.block<DIM_P, 3>(0, index) = P.block<DIM_P, 3>(0, 6);
+    P.block<3, 3>(index, index) = P.block<3, 3>(6, 6) + R * kinematicsCov * R.transpose();
+}
+
+} // Namespace Quadruped
@@ -0,0 +1,106 @@
+// The MIT License
+
+// Copyright (c) 2022
+// Robot Motion and Vision Laboratory at East China Normal University
+// Contact: tophill.robotics@gmail.com
+
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+#include "estimators/qr_momentum_observer.h"
+
+
+namespace Quadruped {
+
+qrMomentumObserver::qrMomentumObserver(qrRobot *robotIn, qrUserParameters *userParametersIn):
+    robot(robotIn),
+    gain(userParametersIn->momentumObserverGain)
+{
+    Reset(0.f);
+}
+
+
+void qrMomentumObserver::Reset(float currentTime)
+{
+    initialized = false;
+    lastTime = currentTime;
+    lastH.setZero();
+    initialMomentum.setZero();
+    integral.setZero();
+    residual.setZero();
+    contactForces.setZero();
+}
+
+
+void qrMomentumObserver::Update(float currentTime)
+{
+    robot->UpdateDynamicsModel();
+    const FloatingBaseModel<float> &model = robot->model;
+    if (model._nDof != DIM) {
+        return;
+    }
+
+    Eigen::Matrix<float, DIM, 1> qd;
+    qd << robot->modelState.bodyVelocity, robot->modelState.qd;
+    Eigen::Matrix<float, DIM, 1> tau;
+    tau << Vec6<float>::Zero(), robot->motortorque;
+
+    const Eigen::Map<const Eigen::Matrix<float, DIM, DIM>> H(model.getMassMatrix().data());
+    const Eigen::Map<const Eigen::Matrix<float, DIM, 1>> Cqd(model.getCoriolisForce().data());
+    const Eigen::Map<const Eigen::Matrix<float, DIM, 1>> G(model.getGravityForce().data());
+    const Eigen::Matrix<float, DIM, 1> momentum = H * qd;
+
+    if (!initialized) {
+        initialMomentum = momentum;
+        lastH = H;
+        lastTime = currentTime;
+        initialized = true;
+        return;
+    }
+
+    float deltaTime = currentTime - lastTime;
+    if (deltaTime <= 0.f) {
+        deltaTime = robot->timeStep;
+    }
+    /* dH/dt qd dt is approximated by the change of H since the last update. */
+    integral.noalias() += (tau - Cqd - G + residual) * deltaTime;
+    integral.noalias() += (H - lastH) * qd;
+    residual = gain * (momentum - initialMomentum - integral);
+    lastH = H;
+    lastTime = currentTime;
+
+    /* tau_ext of the joints of a leg is J^T f, J being the columns of the leg in the foot contact Jacobian. */
+    for (int legId = 0; legId < NumLeg; ++legId) {
+        const Mat3<float> J = model._Jc[model._footIndicesGC[legId]].block<3, 3>(0, BaseFreedomDim + 3 * legId);
+        Eigen::PartialPivLU<Mat3<float>> JtFactor(J.transpose());
+        if (std::abs(JtFactor.determinant()) < 1e-6f) {
+            /* the leg is singular, e.g. stretched, keep the last estimate. */
+            continue;
+        }
+        contactForces.col(legId) = JtFactor.solve(residual.segment<3>(BaseFreedomDim + 3 * legId));
+    }
+}
+
+
+void qrMomentumObserver::CopyEstimates(const qrMomentumObserver &other)
+{
+    initialized = other.initialized;
+    residual = other.residual;
+    contactForces = other.contactForces;
+}
+
+} // Namespace Quadruped
@@ -32,7 +32,10 @@ qrRobotEstimator::qrRobotEstimator(qrRobot *robotIn,
                                qrUserParameters *userParametersIn):
     robot(robotIn),
     velocityEstimator(robotIn, gaitGeneratorIn, userParametersIn),
-    poseEstimator(robotIn, gaitGeneratorIn, groundEstimatorIn, &velocityEstimator)
+    poseEstimator(robotIn, gaitGeneratorIn, groundEstimatorIn, &velocityEstimator),
+    invariantEKF(robotIn),
+    useInEKF(userParametersIn->useInEKF),
+    useCMUFilter(userParametersIn->useCMUFilter)
 {
     estimatedVelocity = velocityEstimator.GetEstimatedVelocity();
     estimatedAngularVelocity = velocityEstimator.GetEstimatedAngularVelocity();
@@ -58,6 +61,11 @@ void qrRobotEstimator::Reset(float currentTime)
     estimatedPosition = pose.head(3);
     estimatedRPY = pose.tail(3);
     lastTimestamp = 0;
+    if (useInEKF) {
+        invariantEKF.Reset(currentTime);
+    } else if (useCMUFilter) {
+        CMUInitState();
+    }
     std::cout << "reset pos= " << estimatedPosition.transpose() << std::endl;
 }
 
@@ -78,6 +86,14 @@ float qrRobotEstimator::ComputeDeltaTime(uint32_t tick)
 
 void qrRobotEstimator::Update(float currentTime)
 {
+    if (useInEKF) {
+        UpdateByInEKF(currentTime);
+        return;
+    }
+    if (useCMUFilter) {
+        UpdateByCMUFilter(currentTime);
+        return;
+    }
     velocityEstimator.Update(currentTime);
     poseEstimator.Update(currentTime);
     
@@ -91,6 +107,59 @@ void qrRobotEstimator::Update(float currentTime)
 }
 
 
+void qrRobotEstimator::UpdateByInEKF(float currentTime)
+{
+    invariantEKF.Update(currentTime);
+
+    Mat3<float> rotMat = invariantEKF.GetRotation().cast<float>();
+    Vec3<float> vInWorldFrame = invariantEKF.GetVelocity().cast<float>();
+    estimatedPosition = invariantEKF.GetPosition().cast<float>();
+    estimatedRPY = robotics::math::rotationMatrixToRPY(rotMat.transpose());
+    estimatedVelocity = rotMat.transpose() * vInWorldFrame; // base frame
+    estimatedAngularVelocity = robot->GetBaseRollPitchYawRate() - invariantEKF.GetGyroscopeBias().cast<float>(); // base frame
+
+    robot->stateDataFlow.baseVInWorldFrame = vInWorldFrame;
+    robot->stateDataFlow.baseWInWorldFrame = rotMat * estimatedAngularVelocity;
+    robot->baseVelocityInBaseFrame = estimatedVelocity;
+    robot->basePosition = estimatedPosition;
+    /* Keeps heightInControlFrame for the controllers. */
+    poseEstimator.EstimateRobotHeight();
+    ComputeZMP();
+}
+
+
+void qrRobotEstimator::UpdateByCMUFilter(float currentTime)
+{
+    CMUUpdate(ComputeDeltaTime(robot->GetTick()));
+
+    /* The filter estimates the position and velocity, the orientation is the one of the IMU. */
+    const Mat3<float> &rotMat = robot->stateDataFlow.baseRMat;
+    Vec3<float> vInWorldFrame = cmuFilter.x.segment<3>(3).cast<float>();
+    estimatedPosition = cmuFilter.x.head<3>().cast<float>();
+    estimatedRPY = robot->GetBaseRollPitchYaw();
+    estimatedVelocity = rotMat.transpose() * vInWorldFrame; // base frame
+    estimatedAngularVelocity = robot->GetBaseRollPitchYawRate(); // base frame
+
+    robot->stateDataFlow.baseVInWorldFrame = vInWorldFrame;
+    robot->stateDataFlow.baseWInWorldFrame = rotMat * estimatedAngularVelocity;
+    robot->baseVelocityInBaseFrame = estimatedVelocity;
+    robot->basePosition = estimatedPosition;
+    poseEstimator.EstimateRobotHeight();
+    ComputeZMP();
+}
+
+
+void qrRobotEstimator::CopyEstimates(const qrRobotEstimator &other)
+{
+    timeSinceReset = other.timeSinceReset;
+    estimatedPosition = other.estimatedPosition;
+    estimatedRPY = other.estimatedRPY;
+    estimatedVelocity = other.estimatedVelocity;
+    lastEstimatedVelocity = other.lastEstimatedVelocity;
+    estimatedAngularVelocity = other.estimatedAngularVelocity;
+}
+
+
 /** @brief Cart-On-Table Model: x_zmp = x_m-(z_m*dtdt_x_m)/(dtdt_z_m+g) */
 Vec3<float> qrRobotEstimator::ComputeZMP()
 {
@@ -110,6 +179,7 @@ void qrRobotEstimator::CMUInitState()
     // constructor
     eye3.setIdentity();
     // C is fixed
+    Eigen::Matrix<double, MEAS_SIZE, STATE_SIZE> &C = cmuFilter.H;
     C.setZero();
     for (int i = 0; i < NumLeg; ++i) {
         C.block<3,3>(i*3,0) = -eye3;     // -pos
@@ -119,6 +189,7 @@ void qrRobotEstimator::CMUInitState()
     }
 
     /* Q R are fixed */
+    Eigen::Matrix<double, STATE_SIZE, STATE_SIZE> &Q = cmuFilter.Q;
     Q.setIdentity();
     /* position transition */
     Q.block<3,3>(0,0) = 0.01*eye3;
@@ -127,6 +198,7 @@ void qrRobotEstimator::CMUInitState()
     for (int i = 0; i < NumLeg; ++i) {
         Q.block<3,3>(6+i*3,6+i*3) = PROCESS_NOISE_PFOOT*eye3;  // foot position transition
     }
+    Eigen::Matrix<double, MEAS_SIZE, MEAS_SIZE> &R = cmuFilter.R;
     R.setIdentity();
     for (int i = 0; i < NumLeg; ++i) {
         R.block<3,3>(i*3,i*3) = SENSOR_NOISE_PIMU_REL_FOOT*eye3;                     // fk estimation
@@ -134,7 +206,7 @@ void qrRobotEstimator::CMUInitState()
         R(NumLeg*6+i,NumLeg*6+i) = SENSOR_NOISE_ZFOOT;                               // height z estimation
     }
 
-    A.setIdentity();
+    cmuFilter.F.setIdentity();
     B.setZero();
 
     /* change R according to this flag, if we do not assume the robot moves on flat ground,
@@ -145,10 +217,8 @@ void qrRobotEstimator::CMUInitState()
         }
     }
 
-    P.setIdentity();
-    P = P * 3;
-
     /* set initial value of x */
+    Eigen::Matrix<double, STATE_SIZE, 1> x;
     x.setZero();
     x.segment<3>(0) = Eigen::Vector3d(0, 0, 0.27);
     Mat3<double> root_rot_mat = robot->stateDataFlow.baseRMat.cast<double>();
@@ -157,6 +227,7 @@ void qrRobotEstimator::CMUInitState()
         Eigen::Vector3d fk_pos = foot_pos_rel.block<3, 1>(0, i);
         x.segment<3>(6 + i * 3) = root_rot_mat * fk_pos + x.segment<3>(0);
     }
+    cmuFilter.Reset(x, 3 * Eigen::Matrix<double, STATE_SIZE, STATE_SIZE>::Identity());
 }
 
 
@@ -165,7 +236,7 @@ void qrRobotEstimator::CMUInitState()
 void qrRobotEstimator::CMUUpdate(double dt)
 {
     /* update A B using latest dt */
-    A.block<3, 3>(0, 3) = dt * eye3;
+    cmuFilter.F.block<3, 3>(0, 3) = dt * eye3;
     B.block<3, 3>(3, 0) = dt * eye3;
 
     /* control input u is Ra + ag */
@@ -185,6 +256,8 @@ void qrRobotEstimator::CMUUpdate(double dt)
     // }
 
     // update Q
+    Eigen::Matrix<double, STATE_SIZE, STATE_SIZE> &Q = cmuFilter.Q;
+    Eigen::Matrix<double, MEAS_SIZE, MEAS_SIZE> &R = cmuFilter.R;
     Q.block<3, 3>(0, 0) = PROCESS_NOISE_PIMU * dt / 20.0 * eye3; //IMU P 
     Q.block<3, 3>(3, 3) = PROCESS_NOISE_VIMU * dt * 9.8 / 20.0 * eye3; // IMU V
      /* update Q R for legs not in contact */
@@ -203,18 +276,10 @@ void qrRobotEstimator::CMUUpdate(double dt)
         }
     }
 
-    // process update
-    /* A and B are translate matrixs */
-    xbar = A*x + B*u ;
-
-    /* Pbar means state predict covariance martrix */
-    Pbar = A * P * A.transpose() + Q;
-
-    // measurement construction
-    yhat = C*xbar;
     // leg_v = (-J_rf*av-skew(omega)*p_rf);
     // r((i-1)*3+1:(i-1)*3+3) = body_v - R_er*leg_v;
-    // actual measurement
+    // actual measurement, the swing legs observe the velocity and height of the last estimate
+    const Eigen::Matrix<double, STATE_SIZE, 1> &x = cmuFilter.x;
     Eigen::Matrix<double,3,4> foot_pos_rel = robot->GetFootPositionsInBaseFrame().cast<double>();
     Eigen::Matrix<double,3,4> foot_vel_rel = robot->stateDataFlow.footVelocitiesInBaseFrame.cast<double>();
     Vec3<double> imu_ang_vel = robot->GetBaseRollPitchYawRate().cast<double>();
@@ -228,44 +293,21 @@ void qrRobotEstimator::CMUUpdate(double dt)
         y(NumLeg*6+i) = (1.0-estimated_contacts[i])*(x(2)+fk_pos(2)) + estimated_contacts[i]*0;         // height z estimation
     }
 
-    /* update kalman filter parameters */
-    S = C * Pbar *C.transpose() + R;
-    S = 0.5*(S+S.transpose());
-
-    error_y = y - yhat;
-    Serror_y = S.fullPivHouseholderQr().solve(error_y);
-    x = xbar + Pbar * C.transpose() * Serror_y;
+    // process update
+    /* A and B are translate matrixs */
+    cmuFilter.Predict(B * u);
 
-    SC = S.fullPivHouseholderQr().solve(C);
-    P = Pbar - Pbar * C.transpose() * SC * Pbar;
-    P = 0.5 * (P + P.transpose());
+    /* S is symmetric positive definite, so the filter factorizes it once by Cholesky
+       for both the state and the covariance update */
+    cmuFilter.Update(y);
 
     // reduce position drift
+    Eigen::Matrix<double, STATE_SIZE, STATE_SIZE> &P = cmuFilter.P;
     if (P.block<2, 2>(0, 0).determinant() > 1e-6) {
         P.block<2, 16>(0, 2).setZero();
         P.block<16, 2>(2, 0).setZero();
         P.block<2, 2>(0, 0) /= 10.0;
     }
-
-    // final step
-    // put estimated values back to A1CtrlStates& state
-    // for (int i = 0; i < NumLeg; ++i) {
-    //     if (estimated_contacts[i] < 0.5) {
-    //         robot->footContact[i] = false;
-    //     } else {
-    //         robot->footContact[i] = true;
-    //     }
-    // }
-    
-    // std::cout << x.transpose() <<std::endl;
-    // estimatedPosition = x.segment<3>(0).cast<float>();
-    // Vec3<double> vInWorldFrame = x.segment<3>(3);
-    // estimatedVelocity = (root_rot_mat.transpose()*vInWorldFrame).cast<float>(); // world frame->base frame
-    // robot->stateDataFlow.baseVInWorldFrame = vInWorldFrame.cast<float>();
-    // robot->basePosition = estimatedPosition;
-    // robot->baseVelocityInBaseFrame = estimatedVelocity;
-    // estimatedAngularVelocity = imu_ang_vel.cast<float>(); // base frame
-    // robot->stateDataFlow.baseWInWorldFrame = (root_rot_mat*imu_ang_vel).cast<float>();
 }
 
 } // Namespace Quadruped
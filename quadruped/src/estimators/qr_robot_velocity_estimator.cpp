@@ -32,27 +32,25 @@ qrRobotVelocityEstimator::qrRobotVelocityEstimator(
     qrUserParameters *userParametersIn):
 
     robot(robotIn),
-    gaitGenerator(gaitGeneratorIn)
+    gaitGenerator(gaitGeneratorIn),
+    filter(userParametersIn->initialVariance, userParametersIn->accelerometerVariance, userParametersIn->sensorVariance)
 {
     initialVariance = userParametersIn->initialVariance;
+    gateThreshold = userParametersIn->velocityGateThreshold;
     lastTimestamp = 0;
     estimatedVelocity << 0.f, 0.f, 0.f;
     estimatedAngularVelocity << 0.f, 0.f, 0.f;
     windowSize = userParametersIn->movingWindowFilterSize;
-    filter = new TinyEKF<3,3>(0.f, initialVariance, userParametersIn->accelerometerVariance, userParametersIn->sensorVariance);
-    velocityFilterX = qrMovingWindowFilter<double, 1>(windowSize);
-    velocityFilterY = qrMovingWindowFilter<double, 1>(windowSize);
-    velocityFilterZ = qrMovingWindowFilter<double, 1>(windowSize);
+    velocityFilter = qrMovingWindowFilter<float, 3>(windowSize);
     AccFilter = qrMovingWindowFilter<float, 3>(20);
 }
 
 
 void qrRobotVelocityEstimator::Reset(float currentTime)
 {
-    velocityFilterX.Reset();
-    velocityFilterY.Reset();
-    velocityFilterZ.Reset();
+    velocityFilter.Reset();
     AccFilter.Reset();
+    filter.Reset(Vec3<float>::Zero(), Mat3<float>::Identity() * initialVariance);
     lastTimestamp = 0;
     estimatedVelocity << 0.f, 0.f, 0.f;
     estimatedAngularVelocity << 0.f, 0.f, 0.f;
@@ -86,44 +84,41 @@ void qrRobotVelocityEstimator::Update(float currentTime)
     Mat3<float> rotMat = robotics::math::quaternionToRotationMatrix(baseOrientation).transpose();
     Vec3<float> calibratedAcc = rotMat * sensorAcc;
     calibratedAcc[2] -= 9.81;
-    double deltaV[3] = {calibratedAcc[0] * deltaTime, calibratedAcc[1] * deltaTime, calibratedAcc[2] * deltaTime};
+    /* the deltaV is the control input of the state transition function */
+    filter.Predict(calibratedAcc * deltaTime);
+
     // Correct estimation using contact legs
-    std::vector<Vec3<float>> observedVelocities;
     const Vec4<bool>& footContact = robot->GetFootContact();
     Eigen::Matrix<float,3,4> footPInBaseFrame = robot->GetFootPositionsInBaseFrame();
-    Eigen::Matrix<float,3,4> footVInBaseFrame = robot->stateDataFlow.footVelocitiesInBaseFrame; // foot relative to body
-    /* compute observed foot vleocity in base frame and get its average */
-    for (int legId = 0; legId < 4; ++legId) {
+    const Eigen::Matrix<float,3,4> &footVInBaseFrame = robot->stateDataFlow.footVelocitiesInBaseFrame; // foot relative to body
+    const Mat3<float> rpyRateSkew = robotics::math::vectorToSkewMat(rpyRate);
+    /* compute observed foot vleocity in base frame, gate it and get the average of the accepted legs */
+    Vec3<float> meanObservedVelocity = Vec3<float>::Zero();
+    int num = 0;
+    for (int legId = 0; legId < NumLeg; ++legId) {
         // if (footContact[leg_id] && gaitGenerator->desiredLegState[legId] == LegState::STANCE) {
         if (footContact[legId]) {
             /* W_v_B + R_wb * B_v_BF + cross(W_omega, W_r_BF) = W_v_F = 0;
                corss(R(v1), R(v2)) = R * cross(v1, v2), where R is rotation matrix(det(R)=1) */
-            Vec3<float> vB = footVInBaseFrame.col(legId) + robotics::math::vectorToSkewMat(rpyRate)*footPInBaseFrame.col(legId);
-            observedVelocities.push_back(-rotMat * vB);
+            Vec3<float> vB = footVInBaseFrame.col(legId) + rpyRateSkew * footPInBaseFrame.col(legId);
+            Vec3<float> observedVelocity = -rotMat * vB;
+            if (filter.IsInlier(observedVelocity, gateThreshold)) {
+                meanObservedVelocity += observedVelocity;
+                ++num;
+            }
         }
     }
-    int num = observedVelocities.size();
+    /* Since every leg observes the velocity with the same covariance R and the measurement matrix is identity,
+       fusing the mean of the accepted legs with R gives the same state as fusing the legs one by one with num * R. */
     if (num > 0) {
-        Vec3<float> MeanObservedVelocity = Vec3<float>::Zero();
-        for (auto &v: observedVelocities) {
-            MeanObservedVelocity += v;    // std::mean(observedVelocities);
-        }
-        MeanObservedVelocity /= num;
-        // filter.Update(deltaTime, MeanObservedVelocity);
-        /* the fitler is kalman filter, the deltav is a variable for state stransition function,
-                   while MeanObservedVelocity is the observed quantity, then the KF fuse them*/
-        double z[3] = {MeanObservedVelocity[0], MeanObservedVelocity[1], MeanObservedVelocity[2]};
-        filter->step(deltaV, z);
+        meanObservedVelocity /= num;
+        filter.Update(meanObservedVelocity);
     } else {
-        double z[3] = {estimatedVelocity[0], estimatedVelocity[1], estimatedVelocity[2]};
-        filter->step(deltaV, z);
+        /* no leg observes the velocity, hold it at the last smoothed estimate */
+        filter.Update(robot->stateDataFlow.baseVInWorldFrame);
     }
      /* the results of KF will move into moving window algorithm for smooth*/
-    float x[3] = {(float)filter->getX(0), (float)filter->getX(1), (float)filter->getX(2)};
-    float vx = velocityFilterX.CalculateAverage(x[0]);
-    float vy = velocityFilterY.CalculateAverage(x[1]);
-    float vz = velocityFilterZ.CalculateAverage(x[2]);
-    estimatedVelocity << vx, vy, vz; // world frame
+    estimatedVelocity = velocityFilter.CalculateAverage(filter.x); // world frame
     robot->stateDataFlow.baseVInWorldFrame = estimatedVelocity;
     estimatedVelocity = rotMat.transpose() * estimatedVelocity; // base frame
     estimatedAngularVelocity = robot->GetBaseRollPitchYawRate(); // base frame
@@ -132,4 +127,3 @@ void qrRobotVelocityEstimator::Update(float currentTime)
 }
 
 } // Namespace Quadruped
-
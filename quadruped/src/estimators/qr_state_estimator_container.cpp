@@ -24,6 +24,8 @@
 
 #include "estimators/qr_state_estimator_container.h"
 
+#include <cstdio>
+
 
 namespace Quadruped {
 
@@ -43,11 +45,48 @@ qrStateEstimatorContainer::qrStateEstimatorContainer(
     contactDetection = new qrContactDetection(quadruped,gaitGenerator, groundEstimator);
 
     robotEstimator = new qrRobotEstimator(quadruped, gaitGenerator, groundEstimator, userParametersIn);
+
+    momentumObserver = new qrMomentumObserver(quadruped, userParametersIn);
+    contactDetection->SetMomentumObserver(momentumObserver);
     
-    // _estimators.push_back(groundEsitmator);
-    // _estimators.push_back(contactDetection);
-    // _estimators.push_back(stateEstimator);
+    /* Contact detection and the momentum observer are off unless given a rate in user_parameters.yaml. */
+    AddEstimator("contact_detection", contactDetection, {0, 0});
+    AddEstimator("ground_estimator", groundEstimator);
+    AddEstimator("robot_estimator", robotEstimator);
+    /* After the robot estimator, which gives the base velocity of the generalized momentum. */
+    AddEstimator("momentum_observer", momentumObserver, {0, 0});
     std::cout << "init state estimator container!" << std::endl;
 }
 
+
+void qrStateEstimatorContainer::AddEstimator(const std::string &name,
+                                             qrBaseStateEstimator *estimator,
+                                             qrTaskRate defaultRate)
+{
+    qrEstimatorStats stats;
+    stats.name = name;
+    stats.rate = userParameters->GetTaskRate(name, defaultRate);
+    _estimators.push_back(estimator);
+    _estimatorStats.push_back(stats);
+}
+
+
+void qrStateEstimatorContainer::PrintCostReport()
+{
+    if (reportTicks == 0) {
+        return;
+    }
+    for (auto &stats : _estimatorStats) {
+        if (stats.cost.GetCount() > 0) {
+            printf("[Estimators] %s: every %u ticks, %lu runs, %.1f us per run (sigma %.1f us, max %.1f us), "
+                   "%.1f us per tick\n",
+                   stats.name.c_str(), stats.rate.period, stats.cost.GetCount(), stats.cost.GetMean() * 1e6,
+                   stats.cost.GetStandardDeviation() * 1e6, stats.cost.GetMax() * 1e6,
+                   stats.cost.GetSum() * 1e6 / reportTicks);
+        }
+        stats.cost.Reset();
+    }
+    reportTicks = 0;
+}
+
 } // Namespace Quadruped
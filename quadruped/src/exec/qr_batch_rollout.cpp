@@ -0,0 +1,297 @@
+// The MIT License
+
+// Copyright (c) 2022
+// Robot Motion and Vision Laboratory at East China Normal University
+// Contact: tophill.robotics@gmail.com
+
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include "exec/qr_batch_rollout.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cerrno>
+#include <chrono>
+#include <cmath>
+#include <dirent.h>
+#include <fstream>
+#include <map>
+#include <memory>
+#include <stdexcept>
+#include <sys/stat.h>
+#include <thread>
+
+#include "exec/qr_robot_runner.h"
+#include "robots/qr_robot_headless_sim.h"
+#include "utils/qr_running_stats.h"
+
+
+namespace {
+
+/**
+ * @brief Create a directory and its missing parents.
+ * @param path: the directory to create.
+ */
+void MakeDirectories(const std::string &path)
+{
+    for (size_t pos = path.find('/', 1); ; pos = path.find('/', pos + 1)) {
+        std::string dir = path.substr(0, pos);
+        if (!dir.empty() && mkdir(dir.c_str(), 0755) != 0 && errno != EEXIST) {
+            throw std::runtime_error("cannot create directory " + dir);
+        }
+        if (pos == std::string::npos) {
+            return;
+        }
+    }
+}
+
+/**
+ * @brief Copy the regular files of a directory tree.
+ * @param from: source directory, without the trailing '/'.
+ * @param to: destination directory, without the trailing '/'.
+ */
+void CopyDirectory(const std::string &from, const std::string &to)
+{
+    DIR *dir = opendir(from.c_str());
+    if (!dir) {
+        throw std::runtime_error("cannot open directory " + from);
+    }
+    MakeDirectories(to);
+    for (dirent *entry = readdir(dir); entry; entry = readdir(dir)) {
+        std::string name = entry->d_name;
+        if (name == "." || name == "..") {
+            continue;
+        }
+        struct stat info;
+        if (stat((from + "/" + name).c_str(), &info) != 0) {
+            continue;
+        }
+        if (S_ISDIR(info.st_mode)) {
+            CopyDirectory(from + "/" + name, to + "/" + name);
+        } else if (S_ISREG(info.st_mode)) {
+            std::ifstream src(from + "/" + name, std::ios::binary);
+            std::ofstream dst(to + "/" + name, std::ios::binary);
+            dst << src.rdbuf();
+        }
+    }
+    closedir(dir);
+}
+
+/**
+ * @brief Set a value in a YAML tree, creating the missing maps on the way.
+ * @param node: the current map.
+ * @param keys: the path of the key.
+ * @param depth: index of the key of %node in %keys.
+ * @param value: the value to set.
+ */
+void SetValue(YAML::Node node, const std::vector<std::string> &keys, size_t depth, const YAML::Node &value)
+{
+    if (depth + 1 == keys.size()) {
+        node[keys[depth]] = value;
+        return;
+    }
+    SetValue(node[keys[depth]], keys, depth + 1, value);
+}
+
+/**
+ * @brief Overwrite keys of a YAML file.
+ * @param path: the file to patch.
+ * @param overrides: pairs of a key path separated by '/' and its value.
+ */
+void PatchYaml(const std::string &path, const std::vector<std::pair<std::string, YAML::Node>> &overrides)
+{
+    YAML::Node root = YAML::LoadFile(path);
+    for (const auto &entry : overrides) {
+        std::vector<std::string> keys;
+        size_t start = 0;
+        for (size_t pos = entry.first.find('/'); pos != std::string::npos; pos = entry.first.find('/', start)) {
+            keys.push_back(entry.first.substr(start, pos - start));
+            start = pos + 1;
+        }
+        keys.push_back(entry.first.substr(start));
+        SetValue(root, keys, 0, entry.second);
+    }
+    std::ofstream out(path);
+    out << root << std::endl;
+}
+
+} // Anonymous namespace
+
+
+namespace Quadruped {
+
+void qrRolloutMetrics::Print() const
+{
+    if (!error.empty()) {
+        printf("[Rollout] %s failed: %s\n", name.c_str(), error.c_str());
+        return;
+    }
+    printf("[Rollout] %s %s after %.2f s, %u ticks. velocity rmse %.3f m/s, yaw rate rmse %.3f rad/s, "
+           "energy %.1f J, tick %.1f us (p99 %.1f us, max %.1f us)\n",
+           name.c_str(), fell ? "fell" : "finished", fell ? fallTime : duration, ticks,
+           linearVelocityRmse, yawRateRmse, energy, meanTickLatency * 1e6, p99TickLatency * 1e6,
+           maxTickLatency * 1e6);
+}
+
+
+qrBatchRollout::qrBatchRollout(const std::string &homeDirIn, const std::string &robotNameIn,
+                               const std::string &workDirIn, unsigned int numWorkersIn):
+    homeDir(homeDirIn),
+    robotName(robotNameIn),
+    workDir(workDirIn),
+    numWorkers(numWorkersIn)
+{
+    if (!homeDir.empty() && homeDir.back() != '/') {
+        homeDir += "/";
+    }
+    if (!workDir.empty() && workDir.back() != '/') {
+        workDir += "/";
+    }
+    if (numWorkers == 0) {
+        numWorkers = std::max(1u, std::thread::hardware_concurrency());
+    }
+}
+
+
+std::vector<qrRolloutMetrics> qrBatchRollout::Run(const std::vector<qrRolloutSpec> &specs)
+{
+    std::vector<qrRolloutMetrics> results(specs.size());
+
+    /* The rollouts already use all cores, so Eigen must not start threads of its own. */
+    Eigen::setNbThreads(1);
+
+    std::atomic<unsigned int> next(0);
+    auto work = [&]() {
+        for (unsigned int i = next++; i < specs.size(); i = next++) {
+            results[i] = RunOne(specs[i], i);
+        }
+    };
+
+    std::vector<std::thread> workers;
+    unsigned int threadNum = std::min<unsigned int>(numWorkers, specs.size());
+    for (unsigned int i = 0; i < threadNum; ++i) {
+        workers.emplace_back(work);
+    }
+    for (auto &worker : workers) {
+        worker.join();
+    }
+    return results;
+}
+
+
+qrRolloutMetrics qrBatchRollout::RunOne(const qrRolloutSpec &spec, unsigned int index)
+{
+    qrRolloutMetrics metrics;
+    metrics.name = spec.name;
+
+    try {
+        std::string rolloutDir = workDir + std::to_string(index) + "_" + spec.name + "/";
+        PrepareConfig(homeDir, spec.parameters, rolloutDir);
+
+        /* The runner owns the robot once it is constructed. */
+        std::unique_ptr<qrRobotHeadlessSim> robotOwner(
+            new qrRobotHeadlessSim(rolloutDir + "config/" + robotName + "/" + robotName + ".yaml"));
+        qrRobotHeadlessSim *robot = robotOwner.get();
+        std::unique_ptr<qrRobotRunner> runner(new qrRobotRunner(robot, rolloutDir));
+        robotOwner.release();
+
+        /* The first tick runs the stand up state of the FSM. Then, as there is no remote controller,
+         * the locomotion follows the constant twist of main.yaml.
+         */
+        runner->Update();
+        runner->Step();
+        qrDesiredStateCommand *desiredStateCommand = runner->GetDesiredStateCommand();
+        desiredStateCommand->setJoyCtrlState(RC_MODE::HARD_CODE);
+        robot->fsmMode = K_LOCOMOTION;
+
+        const float startTime = robot->GetTimeSinceReset();
+        float time = 0.f;
+        double velocityError = 0.;
+        double yawRateError = 0.;
+        qrRunningStats latency;
+        qrQuantileSketch latencyQuantiles;
+
+        while (time < spec.duration) {
+            auto tickStart = std::chrono::steady_clock::now();
+            runner->Update();
+            double tickLatency = qrTickStats::Since(tickStart);
+            runner->Step();
+
+            time = robot->GetTimeSinceReset() - startTime;
+            ++metrics.ticks;
+            latency.Update(tickLatency);
+            latencyQuantiles.Update(tickLatency);
+
+            /* Score the true state of the simulation, not the estimate the controller sees. */
+            const FBModelState<float> &state = robot->GetSimulationState();
+            Vec3<float> rpy = robotics::math::quatToRPY(state.bodyOrientation);
+            velocityError += (desiredStateCommand->vDesInBodyFrame - state.bodyVelocity.tail<3>()).squaredNorm();
+            yawRateError += std::pow(desiredStateCommand->wDesInBodyFrame[2] - state.bodyVelocity[2], 2);
+            metrics.energy += robot->motortorque.cwiseProduct(robot->GetMotorVelocities()).cwiseAbs().sum()
+                              * robot->timeStep;
+
+            if (state.bodyPosition[2] < minHeight || std::abs(rpy[0]) > maxTilt || std::abs(rpy[1]) > maxTilt) {
+                metrics.fell = true;
+                metrics.fallTime = time;
+                break;
+            }
+        }
+
+        metrics.duration = time;
+        if (metrics.ticks > 0) {
+            metrics.linearVelocityRmse = std::sqrt(velocityError / metrics.ticks);
+            metrics.yawRateRmse = std::sqrt(yawRateError / metrics.ticks);
+            metrics.meanTickLatency = latency.GetMean();
+            metrics.p99TickLatency = latencyQuantiles.GetQuantile(0.99);
+            metrics.maxTickLatency = latency.GetMax();
+        }
+    } catch (const std::exception &e) {
+        metrics.error = e.what();
+    }
+    return metrics;
+}
+
+
+void qrBatchRollout::PrepareConfig(const std::string &homeDir, const std::vector<qrRolloutParameter> &parameters,
+                                   const std::string &rolloutDir)
+{
+    const std::string configDir = rolloutDir + "config/";
+    CopyDirectory(homeDir + "config", rolloutDir + "config");
+
+    /* Each rollout is a single thread in simulated time, without realtime setup, periodic prints or telemetry.
+     * These come first, so that the parameters of the caller can still override them.
+     */
+    std::map<std::string, std::vector<std::pair<std::string, YAML::Node>>> overrides;
+    auto &userOverrides = overrides["user_parameters.yaml"];
+    userOverrides.emplace_back("useRealtime", YAML::Node(false));
+    userOverrides.emplace_back("usePipeline", YAML::Node(false));
+    userOverrides.emplace_back("schedulerThreads", YAML::Node(0));
+    userOverrides.emplace_back("tickStatsInterval", YAML::Node(0));
+    userOverrides.emplace_back("telemetryUrl", YAML::Node(""));
+
+    for (const auto &parameter : parameters) {
+        overrides[parameter.file].emplace_back(parameter.key, parameter.value);
+    }
+
+    for (const auto &file : overrides) {
+        PatchYaml(configDir + file.first, file.second);
+    }
+}
+
+} // namespace Quadruped
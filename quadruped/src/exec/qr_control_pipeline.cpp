@@ -0,0 +1,190 @@
+// The MIT License
+
+// Copyright (c) 2022
+// Robot Motion and Vision Laboratory at East China Normal University
+// Contact: tophill.robotics@gmail.com
+
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include "exec/qr_control_pipeline.h"
+
+#include <cstdio>
+#include <iostream>
+
+
+namespace Quadruped {
+
+void qrTickStats::Reset()
+{
+    *this = qrTickStats();
+}
+
+
+void qrTickStats::Print() const
+{
+    if (ticks == 0) {
+        return;
+    }
+    const double us = 1e6 / ticks;
+    double busy = (estimation + handoff + control + wait + actuation) * us;
+    double sequential = (estimation + overlappedEstimation + control + actuation) * us;
+    double loop = period * us;
+    printf("[Runner] %u ticks, %u pipelined. estimation %.1f us (thread %.1f us), control %.1f us, "
+           "actuation %.1f us, wait %.1f us, handoff %.1f us\n",
+           ticks, overlappedTicks, estimation * us, overlappedEstimation * us, control * us,
+           actuation * us, wait * us, handoff * us);
+    printf("[Runner] loop %.1f us (%.1f Hz), busy %.1f us (bound %.1f Hz), sequential %.1f us (bound %.1f Hz)\n",
+           loop, 1e6 / loop, busy, 1e6 / busy, sequential, 1e6 / sequential);
+    if (latency.GetCount() > 0) {
+        printf("[Runner] latency %.1f us (sigma %.1f us), p50 %.1f us, p99 %.1f us, p99.9 %.1f us, max %.1f us\n",
+               latency.GetMean() * 1e6, latency.GetStandardDeviation() * 1e6,
+               latencyQuantiles.GetQuantile(0.5) * 1e6, latencyQuantiles.GetQuantile(0.99) * 1e6,
+               latencyQuantiles.GetQuantile(0.999) * 1e6, latency.GetMax() * 1e6);
+    }
+}
+
+
+qrControlPipeline::qrControlPipeline(
+    qrRobot *robotIn,
+    qrRobotMirror *mirrorIn,
+    qrStateEstimatorContainer *stateEstimatorsIn,
+    qrStateEstimatorContainer *controlEstimatorsIn,
+    qrGaitGenerator *gaitGeneratorIn,
+    qrGaitGenerator *estimationGaitIn,
+    qrRealtimeSetup &realtimeSetupIn,
+    int cpuIn):
+
+    robot(robotIn),
+    mirror(mirrorIn),
+    stateEstimators(stateEstimatorsIn),
+    controlEstimators(controlEstimatorsIn),
+    gaitGenerator(gaitGeneratorIn),
+    estimationGait(estimationGaitIn),
+    realtimeSetup(realtimeSetupIn),
+    cpu(cpuIn),
+    estimationTime(0),
+    launched(false),
+    estimated(false)
+{
+    controlEstimators->SetSource(stateEstimators);
+    mirror->SetSyncHook([this]() { Drain(); });
+    worker = std::thread(&qrControlPipeline::Run, this);
+    std::cout << "[Pipeline] estimation thread started" << std::endl;
+}
+
+
+qrControlPipeline::~qrControlPipeline()
+{
+    Wait();
+    requested.Cancel();
+    worker.join();
+    mirror->SetSyncHook(nullptr);
+}
+
+
+void qrControlPipeline::Run()
+{
+    realtimeSetup.SetupWorkerThread(cpu, "estimation thread");
+
+    /* The caller waits for each stage before it requests the next one, so the stages are never skipped. */
+    unsigned long done = 0;
+    while (requested.WaitForChange(done) != done) {
+        auto start = std::chrono::steady_clock::now();
+        Estimate();
+        estimationTime = qrTickStats::Since(start);
+        ++done;
+        finished.Advance();
+    }
+}
+
+
+void qrControlPipeline::Wait()
+{
+    finished.WaitFor(requested.Get());
+}
+
+
+void qrControlPipeline::Estimate()
+{
+    robot->ReceiveObservation();
+    stateEstimators->Update();
+}
+
+
+void qrControlPipeline::BeginTick(bool overlap, qrTickStats &stats)
+{
+    auto start = std::chrono::steady_clock::now();
+
+    /* The control stage of the last tick has finished, hand its outputs to the estimators. */
+    mirror->Push();
+    estimationGait->CopyLegStates(*gaitGenerator);
+
+    /* The observation received by a sequential tick is estimated here, as the runner does without pipeline. */
+    if (!estimated) {
+        auto estimationStart = std::chrono::steady_clock::now();
+        stateEstimators->Update();
+        stats.estimation += qrTickStats::Since(estimationStart);
+        estimated = true;
+    }
+
+    mirror->Pull();
+    controlEstimators->CopyEstimatesFrom(*stateEstimators);
+    stats.handoff += qrTickStats::Since(start);
+
+    if (overlap) {
+        launched = true;
+        requested.Advance();
+        ++stats.overlappedTicks;
+    }
+}
+
+
+void qrControlPipeline::EndTick(const Eigen::MatrixXf &action, MotorMode motorControlMode, qrTickStats &stats)
+{
+    auto start = std::chrono::steady_clock::now();
+    if (launched) {
+        Wait();
+        launched = false;
+        stats.wait += qrTickStats::Since(start);
+        stats.overlappedEstimation += estimationTime;
+
+        /* The observation of the next tick is already received and estimated. */
+        start = std::chrono::steady_clock::now();
+        robot->ApplyAction(action, motorControlMode);
+        estimated = true;
+    } else {
+        robot->Step(action, motorControlMode);
+        estimated = false;
+    }
+    stats.actuation += qrTickStats::Since(start);
+}
+
+
+void qrControlPipeline::Drain()
+{
+    if (launched) {
+        Wait();
+        launched = false;
+    }
+
+    /* The caller is going to receive new observations through the mirror. */
+    estimated = false;
+}
+
+} // Namespace Quadruped
@@ -0,0 +1,110 @@
+// The MIT License
+
+// Copyright (c) 2022
+// Robot Motion and Vision Laboratory at East China Normal University
+// Contact: tophill.robotics@gmail.com
+
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include "exec/qr_event_count.h"
+
+
+namespace Quadruped {
+
+/**
+ * @brief Hint the core that the thread is polling, which saves power and frees the pipeline for its sibling.
+ */
+static inline void CpuRelax()
+{
+#if defined(__x86_64__) || defined(__i386__)
+    __builtin_ia32_pause();
+#elif defined(__aarch64__) || defined(__arm__)
+    asm volatile("yield" ::: "memory");
+#endif
+}
+
+
+qrEventCount::qrEventCount(unsigned int spinCountIn):
+    count(0),
+    waiters(0),
+    cancelled(false),
+    spinCount(spinCountIn)
+{
+}
+
+
+void qrEventCount::Advance()
+{
+    /* Both are sequentially consistent: either the waiter sees the new count before it blocks,
+     * or this thread sees the waiter and wakes it under the mutex.
+     */
+    count.fetch_add(1);
+    if (waiters.load() > 0) {
+        std::lock_guard<std::mutex> lock(mutex);
+        condition.notify_all();
+    }
+}
+
+
+unsigned long qrEventCount::WaitForChange(unsigned long seen)
+{
+    unsigned long current = seen;
+    Wait([&]() {
+        current = count.load();
+        return current != seen;
+    });
+    return current;
+}
+
+
+void qrEventCount::WaitFor(unsigned long target)
+{
+    Wait([&]() {
+        return count.load() >= target;
+    });
+}
+
+
+void qrEventCount::Cancel()
+{
+    cancelled.store(true);
+    std::lock_guard<std::mutex> lock(mutex);
+    condition.notify_all();
+}
+
+
+template<class Predicate>
+void qrEventCount::Wait(Predicate ready)
+{
+    for (unsigned int i = 0; i < spinCount; ++i) {
+        if (ready() || cancelled.load(std::memory_order_acquire)) {
+            return;
+        }
+        CpuRelax();
+    }
+
+    waiters.fetch_add(1);
+    {
+        std::unique_lock<std::mutex> lock(mutex);
+        condition.wait(lock, [&]() { return ready() || cancelled.load(); });
+    }
+    waiters.fetch_sub(1);
+}
+
+} // Namespace Quadruped
@@ -0,0 +1,169 @@
+// The MIT License
+
+// Copyright (c) 2022
+// Robot Motion and Vision Laboratory at East China Normal University
+// Contact: tophill.robotics@gmail.com
+
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include "exec/qr_log_replay.h"
+
+#include <chrono>
+#include <cmath>
+#include <memory>
+#include <stdexcept>
+
+#include "exec/qr_robot_runner.h"
+#include "robots/qr_robot_replay.h"
+#include "utils/qr_flight_recorder.h"
+
+
+namespace Quadruped {
+
+void qrReplayReport::Print() const
+{
+    if (!error.empty()) {
+        printf("[Replay] %s failed: %s\n", log.c_str(), error.c_str());
+        return;
+    }
+    printf("[Replay] %s: %u ticks in %.3f s (%.0f ticks/s), %u divergent",
+           log.c_str(), ticks, wallTime, wallTime > 0 ? ticks / wallTime : 0., divergentTicks);
+    if (divergentTicks > 0) {
+        printf(", first at tick %u", firstDivergentTick);
+    }
+    printf("\n[Replay] command error max/rms: p %.2e/%.2e, Kp %.2e/%.2e, d %.2e/%.2e, Kd %.2e/%.2e, "
+           "tau %.2e/%.2e\n",
+           maxError[0], rmsError[0], maxError[1], rmsError[1], maxError[2], rmsError[2],
+           maxError[3], rmsError[3], maxError[4], rmsError[4]);
+    printf("[Replay] estimate error max: position %.2e m, velocity %.2e m/s\n", maxEstimateError[0], maxEstimateError[1]);
+    stages.Print();
+}
+
+
+qrLogReplay::qrLogReplay(const std::string &homeDirIn, const std::string &robotNameIn,
+                         const std::string &workDirIn):
+    homeDir(homeDirIn),
+    robotName(robotNameIn),
+    workDir(workDirIn)
+{
+    if (!homeDir.empty() && homeDir.back() != '/') {
+        homeDir += "/";
+    }
+    if (!workDir.empty() && workDir.back() != '/') {
+        workDir += "/";
+    }
+}
+
+
+qrReplayReport qrLogReplay::Run(const std::string &logPath, const std::vector<qrRolloutParameter> &parameters)
+{
+    qrReplayReport report;
+    report.log = logPath;
+
+    try {
+        qrFlightLog log(logPath);
+        if (log.Size() == 0) {
+            throw std::runtime_error("the log has no record");
+        }
+
+        /* The replay must not record, the recorder could overwrite the log being replayed. */
+        std::vector<qrRolloutParameter> overrides = parameters;
+        overrides.push_back({"user_parameters.yaml", "flightRecorderPath", YAML::Node("")});
+        qrBatchRollout::PrepareConfig(homeDir, overrides, workDir);
+
+        qrFlightRecord record;
+        log.Read(0, record);
+
+        /* The runner stands the robot up on the first record, then owns the robot. */
+        std::unique_ptr<qrRobotReplay> robotOwner(
+            new qrRobotReplay(workDir + "config/" + robotName + "/" + robotName + ".yaml"));
+        qrRobotReplay *robot = robotOwner.get();
+        robot->LoadRecord(record);
+        std::unique_ptr<qrRobotRunner> runner(new qrRobotRunner(robot, workDir));
+        robotOwner.release();
+
+        qrDesiredStateCommand *desiredStateCommand = runner->GetDesiredStateCommand();
+        desiredStateCommand->setJoyCtrlState(RC_MODE::HARD_CODE);
+
+        /* Older logs have neither the FSM mode nor the filtered command, the hard coded twist was the command. */
+        const bool hasFsmMode = log.FindField("fsmMode") != nullptr;
+        const bool hasCommand = log.FindField("commandVelocity") != nullptr;
+        Eigen::Matrix<double, 5, 1> squaredError = Eigen::Matrix<double, 5, 1>::Zero();
+        float recordTime = 0.f;
+        float replayTime = 0.f;
+
+        auto start = std::chrono::steady_clock::now();
+        for (size_t i = 0; i < log.Size(); ++i) {
+            if (i > 0) {
+                log.Read(i, record);
+                /* The virtual clock keeps the recorded interval between two records. Applying the command
+                 * has already advanced it by one time step, and the actions that block in a tick, e.g.
+                 * standing up, advance it on their own, so it never goes back.
+                 */
+                float dt = replayTime + (record.time[0] - recordTime) - robot->GetTimeSinceReset();
+                if (dt > 0.f) {
+                    robot->AdvanceTime(dt);
+                }
+            }
+            robot->LoadRecord(record);
+            if (hasFsmMode) {
+                robot->fsmMode = static_cast<int>(record.fsmMode[0]);
+            }
+            desiredStateCommand->vDesInBodyFrame =
+                Eigen::Map<const Vec3<float>>(hasCommand ? record.commandVelocity : record.vDesInBodyFrame);
+            desiredStateCommand->wDesInBodyFrame =
+                Eigen::Map<const Vec3<float>>(hasCommand ? record.commandOmega : record.wDesInBodyFrame);
+
+            runner->Update();
+
+            /* The estimates are recorded at the end of the tick, before the command is applied. */
+            const qrRobot *controlRobot = runner->GetControlRobot();
+            Vec3<float> positionError = controlRobot->basePosition - Eigen::Map<const Vec3<float>>(record.basePosition);
+            Vec3<float> velocityError = controlRobot->stateDataFlow.baseVInWorldFrame
+                                        - Eigen::Map<const Vec3<float>>(record.baseVInWorldFrame);
+            report.maxEstimateError = report.maxEstimateError.cwiseMax(
+                Eigen::Matrix<float, 2, 1>(positionError.cwiseAbs().maxCoeff(), velocityError.cwiseAbs().maxCoeff()));
+
+            recordTime = record.time[0];
+            replayTime = robot->GetTimeSinceReset();
+            runner->Step();
+
+            Eigen::Matrix<float, 5, NumMotor> error =
+                robot->GetLastCommand() - Eigen::Map<const Eigen::Matrix<float, 5, NumMotor>>(record.motorCommands);
+            Eigen::Matrix<float, 5, 1> rowError = error.cwiseAbs().rowwise().maxCoeff();
+            report.maxError = report.maxError.cwiseMax(rowError);
+            squaredError += error.cast<double>().rowwise().squaredNorm();
+            if (rowError.maxCoeff() > tolerance) {
+                if (report.divergentTicks == 0) {
+                    report.firstDivergentTick = record.tick[0];
+                }
+                ++report.divergentTicks;
+            }
+            ++report.ticks;
+        }
+        report.wallTime = qrTickStats::Since(start);
+        report.rmsError = (squaredError / (report.ticks * NumMotor)).cwiseSqrt().cast<float>();
+        report.stages = runner->GetTickStats();
+    } catch (const std::exception &e) {
+        report.error = e.what();
+    }
+    return report;
+}
+
+} // namespace Quadruped
@@ -0,0 +1,246 @@
+// The MIT License
+
+// Copyright (c) 2022
+// Robot Motion and Vision Laboratory at East China Normal University
+// Contact: tophill.robotics@gmail.com
+
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include "exec/qr_realtime.h"
+
+#include <alloca.h>
+#include <errno.h>
+#include <malloc.h>
+#include <pthread.h>
+#include <sched.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <unistd.h>
+#include <algorithm>
+#include <iostream>
+
+
+namespace Quadruped {
+
+static std::string ErrorString(const std::string &what, int err)
+{
+    return what + ": " + strerror(err);
+}
+
+
+qrRealtimeSetup::qrRealtimeSetup(const qrUserParameters &userParameters):
+    enable(userParameters.useRealtime),
+    priority(userParameters.realtimePriority),
+    controlCpu(userParameters.controlCpu),
+    helperCpus(userParameters.helperCpus),
+    lockMemory(userParameters.lockMemory),
+    stackSize(userParameters.prefaultStackSize),
+    heapSize(userParameters.prefaultHeapSize)
+{
+}
+
+
+bool qrRealtimeSetup::IsolateHelperThreads()
+{
+    if (!enable || helperCpus.empty()) {
+        return false;
+    }
+
+    long cpuNum = sysconf(_SC_NPROCESSORS_ONLN);
+    cpu_set_t cpuSet;
+    CPU_ZERO(&cpuSet);
+    for (int cpu : helperCpus) {
+        if (cpu < 0 || cpu >= cpuNum || cpu == controlCpu) {
+            report.warnings.push_back("helper cpu " + std::to_string(cpu) + " is invalid, ignored");
+            continue;
+        }
+        CPU_SET(cpu, &cpuSet);
+    }
+    if (CPU_COUNT(&cpuSet) == 0) {
+        return false;
+    }
+
+    int err = pthread_setaffinity_np(pthread_self(), sizeof(cpu_set_t), &cpuSet);
+    if (err != 0) {
+        report.warnings.push_back(ErrorString("helper affinity", err));
+        return false;
+    }
+    report.helperIsolated = true;
+    return true;
+}
+
+
+const qrRealtimeReport &qrRealtimeSetup::SetupControlThread()
+{
+    if (!enable) {
+        return report;
+    }
+
+    /* Memory first, so that the stack and heap touched below stay resident. */
+    if (lockMemory) {
+        LockMemory();
+    }
+    PrefaultStack();
+    PrefaultHeap();
+
+    if (controlCpu >= 0) {
+        if (controlCpu >= sysconf(_SC_NPROCESSORS_ONLN)) {
+            report.warnings.push_back("control cpu " + std::to_string(controlCpu) + " does not exist");
+        } else {
+            cpu_set_t cpuSet;
+            CPU_ZERO(&cpuSet);
+            CPU_SET(controlCpu, &cpuSet);
+            int err = pthread_setaffinity_np(pthread_self(), sizeof(cpu_set_t), &cpuSet);
+            if (err != 0) {
+                report.warnings.push_back(ErrorString("control affinity", err));
+            } else {
+                report.affinityApplied = true;
+            }
+        }
+    }
+
+    struct sched_param param;
+    memset(&param, 0, sizeof(param));
+    param.sched_priority = std::min(std::max(priority, sched_get_priority_min(SCHED_FIFO)),
+                                    sched_get_priority_max(SCHED_FIFO));
+    int err = pthread_setschedparam(pthread_self(), SCHED_FIFO, &param);
+    if (err != 0) {
+        report.warnings.push_back(ErrorString("SCHED_FIFO", err));
+    } else {
+        report.schedulerApplied = true;
+    }
+
+    PrintReport();
+    return report;
+}
+
+
+bool qrRealtimeSetup::SetupWorkerThread(int cpu, const std::string &name)
+{
+    bool applied = true;
+    if (cpu >= 0) {
+        cpu_set_t cpuSet;
+        CPU_ZERO(&cpuSet);
+        CPU_SET(cpu, &cpuSet);
+        int err = cpu >= sysconf(_SC_NPROCESSORS_ONLN) ? EINVAL :
+                  pthread_setaffinity_np(pthread_self(), sizeof(cpu_set_t), &cpuSet);
+        if (err != 0) {
+            std::cout << "[Realtime] " << ErrorString(name + " affinity", err) << std::endl;
+            applied = false;
+        }
+    }
+
+    if (!enable) {
+        return applied;
+    }
+
+    struct sched_param param;
+    memset(&param, 0, sizeof(param));
+    param.sched_priority = std::min(std::max(priority, sched_get_priority_min(SCHED_FIFO)),
+                                    sched_get_priority_max(SCHED_FIFO));
+    int err = pthread_setschedparam(pthread_self(), SCHED_FIFO, &param);
+    if (err != 0) {
+        std::cout << "[Realtime] " << ErrorString(name + " SCHED_FIFO", err) << std::endl;
+        applied = false;
+    }
+    return applied;
+}
+
+
+void qrRealtimeSetup::LockMemory()
+{
+    if (mlockall(MCL_CURRENT | MCL_FUTURE) != 0) {
+        report.warnings.push_back(ErrorString("mlockall", errno));
+        return;
+    }
+    report.memoryLocked = true;
+
+    /* Never give heap back to the kernel and never serve malloc by mmap,
+     * otherwise page faults come back after free. */
+    mallopt(M_TRIM_THRESHOLD, -1);
+    mallopt(M_MMAP_MAX, 0);
+}
+
+
+void qrRealtimeSetup::PrefaultStack()
+{
+    if (stackSize == 0) {
+        return;
+    }
+
+    pthread_attr_t attr;
+    size_t threadStackSize = 0;
+    if (pthread_getattr_np(pthread_self(), &attr) == 0) {
+        pthread_attr_getstacksize(&attr, &threadStackSize);
+        pthread_attr_destroy(&attr);
+    }
+    size_t size = stackSize;
+    /* Leave some room for the frames above this one. */
+    if (threadStackSize > 0 && size + 64 * 1024 > threadStackSize) {
+        size = threadStackSize > 64 * 1024 ? threadStackSize - 64 * 1024 : 0;
+        report.warnings.push_back("stack prefault is clamped to " + std::to_string(size) + " bytes");
+    }
+
+    volatile unsigned char *stack = static_cast<volatile unsigned char *>(alloca(size));
+    const long pageSize = sysconf(_SC_PAGESIZE);
+    for (size_t i = 0; i < size; i += pageSize) {
+        stack[i] = 0;
+    }
+    report.stackPrefaulted = size;
+}
+
+
+void qrRealtimeSetup::PrefaultHeap()
+{
+    if (heapSize == 0) {
+        return;
+    }
+    if (!report.memoryLocked) {
+        report.warnings.push_back("heap prefault skipped since memory is not locked");
+        return;
+    }
+
+    unsigned char *heap = static_cast<unsigned char *>(malloc(heapSize));
+    if (heap == nullptr) {
+        report.warnings.push_back("heap prefault: malloc failed");
+        return;
+    }
+    const long pageSize = sysconf(_SC_PAGESIZE);
+    for (size_t i = 0; i < heapSize; i += pageSize) {
+        heap[i] = 0;
+    }
+    free(heap);
+    report.heapPrefaulted = heapSize;
+}
+
+
+void qrRealtimeSetup::PrintReport() const
+{
+    std::cout << "[Realtime] helper isolation: " << (report.helperIsolated ? "on" : "off")
+              << ", SCHED_FIFO(" << priority << "): " << (report.schedulerApplied ? "on" : "off")
+              << ", control cpu(" << controlCpu << "): " << (report.affinityApplied ? "on" : "off")
+              << ", mlockall: " << (report.memoryLocked ? "on" : "off")
+              << ", stack prefault: " << report.stackPrefaulted
+              << " B, heap prefault: " << report.heapPrefaulted << " B" << std::endl;
+    for (const std::string &warning : report.warnings) {
+        std::cout << "[Realtime] " << warning << std::endl;
+    }
+}
+
+} // Namespace Quadruped
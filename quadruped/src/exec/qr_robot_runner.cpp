@@ -25,10 +25,6 @@
 #include "exec/qr_robot_runner.h"
 
 
-float stairsTime = 13;
-float stairsVel = 0.1;
-
-
 qrLocomotionController *SetUpController(
     qrRobot *quadruped,
     qrGaitGenerator* gaitGenerator,
@@ -94,11 +90,24 @@ void UpdateControllerParams(qrLocomotionController *controller, Eigen::Vector3f
 }
 
 
-qrRobotRunner::qrRobotRunner(qrRobot* quadrupedIn, std::string& homeDir, ros::NodeHandle& nh):
+qrRobotRunner::qrRobotRunner(qrRobot* quadrupedIn, std::string& homeDir, qrCommandInput* commandInputIn):
     quadruped(quadrupedIn),
-    desiredStateCommand(new qrDesiredStateCommand(nh, quadruped)),
-    userParameters(homeDir+ "config/user_parameters.yaml")
+    userParameters(homeDir+ "config/user_parameters.yaml"),
+    realtimeSetup(userParameters),
+    robotMirror(userParameters.usePipeline ? new qrRobotMirror(quadrupedIn) : nullptr),
+    controlRobot(robotMirror ? robotMirror : quadrupedIn),
+    estimationGait(nullptr),
+    pipeline(nullptr),
+    scheduler(userParameters, realtimeSetup),
+    desiredStateCommand(new qrDesiredStateCommand(controlRobot)),
+    commandInput(commandInputIn),
+    flightRecorder(nullptr),
+    telemetry(nullptr)
 {
+    hybridCommand.resize(5, NumMotor);
+    if (commandInput) {
+        commandInput->Connect(desiredStateCommand);
+    }
     std::cout <<"[Runner] name: "  << quadruped->robotName <<std::endl;
     std::cout << homeDir + "config/" + quadruped->robotName + "/main.yaml" << std::endl;
     YAML::Node mainConfig = YAML::LoadFile(homeDir + "config/" + quadruped->robotName + "/main.yaml");
@@ -111,6 +120,7 @@ qrRobotRunner::qrRobotRunner(qrRobot* quadrupedIn, std::string& homeDir, ros::No
     desiredStateCommand->vDesInBodyFrame = desiredSpeed;
     desiredStateCommand->wDesInBodyFrame << 0,0, desiredTwistingSpeed;
     quadruped->timeStep = 1.0 / userParameters.controlFrequency;
+    controlRobot->timeStep = quadruped->timeStep;
     
     quadruped->ReceiveObservation();
     quadruped->ReceiveObservation();
@@ -119,37 +129,141 @@ qrRobotRunner::qrRobotRunner(qrRobot* quadrupedIn, std::string& homeDir, ros::No
     Action::StandUp(quadruped, 4.f, 5.f, 0.001);
     // Action::KeepStand(quadruped, 10,  0.001);
     //Action::ControlFoot(quadruped, nullptr, 15, 0.001);
+    if (robotMirror) {
+        robotMirror->Pull();
+    }
     
     if (quadruped->controlParams["mode"] == LocomotionMode::WALK_LOCOMOTION) {
-        gaitGenerator = new qrWalkGaitGenerator(quadruped, homeDir + "config/" + quadruped->robotName
+        gaitGenerator = new qrWalkGaitGenerator(controlRobot, homeDir + "config/" + quadruped->robotName
                                                         + "/openloop_gait_generator.yaml");
+        if (robotMirror) {
+            estimationGait = new qrWalkGaitGenerator(*static_cast<qrWalkGaitGenerator*>(gaitGenerator));
+        }
     } else {
-        gaitGenerator = new qrOpenLoopGaitGenerator(quadruped, homeDir + "config/" + quadruped->robotName
+        gaitGenerator = new qrOpenLoopGaitGenerator(controlRobot, homeDir + "config/" + quadruped->robotName
                                                          + "/openloop_gait_generator.yaml");
+        if (robotMirror) {
+            estimationGait = new qrOpenLoopGaitGenerator(*static_cast<qrOpenLoopGaitGenerator*>(gaitGenerator));
+        }
     }                                                                 
     std::cout << "init gaitGenerator finish\n" << std::endl;
     
-    stateEstimators = new qrStateEstimatorContainer(quadruped, gaitGenerator, &userParameters, 
+    stateEstimators = new qrStateEstimatorContainer(quadruped, robotMirror ? estimationGait : gaitGenerator, &userParameters, 
                                                         "config/" + quadruped->robotName + "/terrain.yaml", 
                                                         homeDir); 
-    controlFSM = new qrControlFSM<float>(quadruped, stateEstimators, gaitGenerator, desiredStateCommand, &userParameters);    
-    resetTime = quadruped->GetTimeSinceReset();
-    stateEstimators->Reset();
+    controlEstimators = stateEstimators;
+    if (robotMirror) {
+        /* The control stack reads a copy of the estimators, which is refreshed at the start of each tick. */
+        controlEstimators = new qrStateEstimatorContainer(controlRobot, gaitGenerator, &userParameters,
+                                                          "config/" + quadruped->robotName + "/terrain.yaml",
+                                                          homeDir);
+        controlEstimators->SetSource(stateEstimators);
+    }
+    controlFSM = new qrControlFSM<float>(controlRobot, controlEstimators, gaitGenerator, desiredStateCommand, &userParameters, homeDir);
+    resetTime = controlRobot->GetTimeSinceReset();
+    controlEstimators->Reset();
     // gaitGenerator->Reset(resetTime);
     controlFSM->Reset(resetTime);
-    stairsVel = userParameters.stairsVel;
-    stairsTime = userParameters.stairsTime;
-    
+
+    qrAllocTracker::SetPolicy(static_cast<AllocPolicy>(userParameters.allocPolicy));
+
+    /* The estimators and the desired state command are independent, the FSM reads both.
+     * Between the two halves of the FSM, the stages of the locomotion controller run in the order of their
+     * dependencies, each at its own rate. A stage that is not due keeps its last outputs.
+     */
+    std::vector<std::string> fsmDependencies = {"desired_state_command"};
+    if (!robotMirror) {
+        scheduler.AddTask("state_estimators", [this]() {
+            auto start = std::chrono::steady_clock::now();
+            stateEstimators->Update();
+            tickStats.estimation += qrTickStats::Since(start);
+        });
+        fsmDependencies.push_back("state_estimators");
+    }
+    scheduler.AddTask("desired_state_command", [this]() {
+        desiredStateCommand->Update();
+    });
+    scheduler.AddTask("fsm_transition", [this]() {
+        controlStart = std::chrono::steady_clock::now();
+        controlFSM->BeginTick();
+    }, fsmDependencies);
+
+    qrLocomotionController *locomotionController = controlFSM->GetLocomotionController();
+    AddLocomotionStage("gait", [locomotionController]() {
+        locomotionController->UpdateGait();
+    }, {"fsm_transition"});
+    AddLocomotionStage("swing", [locomotionController]() {
+        locomotionController->UpdateSwing();
+    }, {"gait"});
+    AddLocomotionStage("stance", [locomotionController]() {
+        locomotionController->UpdateStance();
+    }, {"swing"});
+    AddLocomotionStage("mpc", [locomotionController]() {
+        locomotionController->SolveMPC();
+    }, {"stance"}, locomotionController->stanceLegController->DefaultMPCRate());
+    qrFSMStateLocomotion<float> *locomotionState = controlFSM->GetLocomotionState();
+    AddLocomotionStage("wbc", [locomotionState]() {
+        locomotionState->SolveWBC();
+    }, {"mpc"}, {2, 1});
+
+    scheduler.AddTask("fsm", [this]() {
+        controlFSM->EndTick(hybridAction);
+        tickStats.control += qrTickStats::Since(controlStart);
+    }, {"wbc"});
+
+    /* The publishers read the state and commands of the tick once the FSM has set them. */
+    scheduler.AddTask("flight_recorder", [this]() {
+        if (flightRecorder) {
+            RecordTick();
+        }
+    }, {"fsm"});
+    scheduler.AddTask("telemetry", [this]() {
+        if (telemetry) {
+            PublishTelemetry(lastLatency);
+        }
+    }, {"fsm"});
+
+    /* Start the estimation thread before this thread is pinned, so that it does not inherit the control core. */
+    if (robotMirror) {
+        pipeline = new qrControlPipeline(quadruped, robotMirror, stateEstimators, controlEstimators,
+                                         gaitGenerator, estimationGait, realtimeSetup, userParameters.estimationCpu);
+    }
+
+    if (!userParameters.flightRecorderPath.empty()) {
+        flightRecorder = new qrFlightRecorder(userParameters.flightRecorderPath, userParameters.flightRecorderCapacity);
+    }
+    if (!userParameters.telemetryUrl.empty()) {
+        telemetry = new qrTelemetryPublisher(userParameters.telemetryUrl, userParameters.telemetryChannels,
+                                             userParameters.controlFrequency, userParameters.telemetryCapacity);
+    }
+
+    /* All controllers are allocated, now configure this thread as the control thread. */
+    scheduler.Build();
+    realtimeSetup.SetupControlThread();
 }
 
 
 bool qrRobotRunner::Update()
 {
-    stateEstimators->Update(); 
-    
-    desiredStateCommand->Update();
+    qrAllocTracker::BeginTick();
+
+    auto now = std::chrono::steady_clock::now();
+    if (tickStart.time_since_epoch().count() != 0) {
+        tickStats.period += std::chrono::duration<double>(now - tickStart).count();
+        ++tickStats.ticks;
+        if (userParameters.tickStatsInterval > 0 && tickStats.ticks >= userParameters.tickStatsInterval) {
+            tickStats.Print();
+            tickStats.Reset();
+            stateEstimators->PrintCostReport();
+        }
+    }
+    tickStart = now;
 
-    controlFSM->RunFSM(hybridAction);
+    if (pipeline) {
+        /* Estimate the next tick on the estimation thread while this tick is controlled on the snapshot. */
+        pipeline->BeginTick(controlFSM->IsInNormalLocomotion(), tickStats);
+    }
+    scheduler.Run();
 
     return true; 
 }
@@ -157,33 +271,161 @@ bool qrRobotRunner::Update()
 
 bool qrRobotRunner::Step()
 {
-    Visualization2D& vis = quadruped->stateDataFlow.visualizer;
+    Visualization2D& vis = controlRobot->stateDataFlow.visualizer;
     auto swingController = controlFSM->GetLocomotionController()->GetSwingLegController();
     auto torqueController = controlFSM->GetLocomotionController()->GetStanceLegController();
 
-    Vec4<float> f = quadruped->GetFootForce();
-    Vec3<float> w = quadruped->GetBaseRollPitchYawRate();
-    Vec3<float> rpy = quadruped->GetBaseRollPitchYaw();
-    Vec3<float> V = quadruped->GetBaseVelocityInBaseFrame();
-    auto footPositionB =  quadruped->GetFootPositionsInBaseFrame();
+    Vec4<float> f = controlRobot->GetFootForce();
+    Vec3<float> w = controlRobot->GetBaseRollPitchYawRate();
+    Vec3<float> rpy = controlRobot->GetBaseRollPitchYaw();
+    Vec3<float> V = controlRobot->GetBaseVelocityInBaseFrame();
+    auto footPositionB =  controlRobot->GetFootPositionsInBaseFrame();
     // auto footPositionW =  quadruped->GetFootPositionsInWorldFrame();
     // auto& fullModel = quadruped->model;
-    auto motorV = quadruped->GetMotorVelocities();
-    auto motorA = quadruped->GetMotorAngles();
+    auto motorV = controlRobot->GetMotorVelocities();
+    auto motorA = controlRobot->GetMotorAngles();
     auto foot_pos_target_last_time = swingController->foot_pos_target_last_time;
     auto mpcContacts = torqueController->contacts;
     // auto motorddq = quadruped->motorddq;
-    float t = quadruped->GetTimeSinceReset();
-    
-    quadruped->Step(qrMotorCommand::convertToMatix(hybridAction), HYBRID_MODE);
+    float t = controlRobot->GetTimeSinceReset();
+
+    hybridCommand = qrMotorCommand::convertToMatix(hybridAction);
+    if (pipeline) {
+        pipeline->EndTick(hybridCommand, HYBRID_MODE, tickStats);
+    } else {
+        auto start = std::chrono::steady_clock::now();
+        quadruped->Step(hybridCommand, HYBRID_MODE);
+        tickStats.actuation += qrTickStats::Since(start);
+    }
+
+    double latency = qrTickStats::Since(tickStart);
+    tickStats.latency.Update(latency);
+    tickStats.latencyQuantiles.Update(latency);
+    lastLatency = latency;
+
+    allocStats = qrAllocTracker::EndTick();
     return 1;
 }
 
 
+void qrRobotRunner::AddLocomotionStage(const std::string &name,
+                                       std::function<void()> func,
+                                       const std::vector<std::string> &dependencies,
+                                       qrTaskRate defaultRate)
+{
+    scheduler.AddTask(name, [this, func]() {
+        if (controlFSM->RunsLocomotionStages()) {
+            func();
+        }
+    }, dependencies, defaultRate);
+}
+
+
+void qrRobotRunner::RecordTick()
+{
+    qrFlightRecord *record = flightRecorder->BeginRecord();
+    if (!record) {
+        return;
+    }
+
+    /* What the control stack saw in this tick, i.e. the snapshot if pipelined. */
+    const qrRobot *robot = controlRobot;
+    const qrStateDataFlow &dataFlow = controlRobot->stateDataFlow;
+    record->tick[0] = controlRobot->GetTick();
+    record->time[0] = controlRobot->GetTimeSinceReset();
+    Eigen::Map<Vec3<float>>(record->rpy) = robot->baseRollPitchYaw;
+    Eigen::Map<Vec3<float>>(record->gyro) = robot->baseRollPitchYawRate;
+    Eigen::Map<Vec3<float>>(record->accelerometer) = robot->baseAccInBaseFrame;
+    Eigen::Map<Vec12<float>>(record->motorAngles) = robot->motorAngles;
+    Eigen::Map<Vec12<float>>(record->motorVelocities) = robot->motorVelocities;
+    Eigen::Map<Vec12<float>>(record->motorAccelerations) = robot->motorddq;
+    Eigen::Map<Vec12<float>>(record->motorTorques) = robot->motortorque;
+    Eigen::Map<Vec4<float>>(record->footForces) = robot->footForce;
+    Eigen::Map<Vec4<float>>(record->footContacts) = robot->footContact.cast<float>();
+
+    Eigen::Map<Vec3<float>>(record->basePosition) = robot->basePosition;
+    Eigen::Map<Vec3<float>>(record->baseVInWorldFrame) = dataFlow.baseVInWorldFrame;
+    Eigen::Map<Vec3<float>>(record->baseWInWorldFrame) = dataFlow.baseWInWorldFrame;
+    Eigen::Map<Vec3<float>>(record->baseLinearAcceleration) = dataFlow.baseLinearAcceleration;
+    record->heightInControlFrame[0] = dataFlow.heightInControlFrame;
+    Eigen::Map<Vec4<float>>(record->groundOrientation) = dataFlow.groundOrientation;
+    Eigen::Map<Eigen::Matrix<float, 3, 4>>(record->footPositionsInBaseFrame) = dataFlow.footPositionsInBaseFrame;
+    Eigen::Map<Eigen::Matrix<float, 3, 4>>(record->estimatedFootForce) = dataFlow.estimatedFootForce;
+
+    Eigen::Map<Vec12<float>>(record->stateDes) = desiredStateCommand->stateDes;
+    Eigen::Map<Vec3<float>>(record->vDesInBodyFrame) = desiredStateCommand->vDesInBodyFrame;
+    Eigen::Map<Vec3<float>>(record->wDesInBodyFrame) = desiredStateCommand->wDesInBodyFrame;
+    Eigen::Map<Vec3<float>>(record->commandVelocity) = desiredStateCommand->getFilteredVel();
+    Eigen::Map<Vec3<float>>(record->commandOmega) = desiredStateCommand->getFilteredOmega();
+    record->fsmMode[0] = robot->fsmMode;
+
+    for (int leg = 0; leg < NumLeg; ++leg) {
+        Eigen::Map<Vec3<float>>(record->mpcForces + 3 * leg) = dataFlow.wbcData.Fr_des[leg];
+    }
+    Eigen::Map<Vec12<float>>(record->wbcTorques) = dataFlow.wbcData.jointTorqueCmd;
+    Eigen::Map<Eigen::Matrix<float, 5, 12>>(record->motorCommands) = qrMotorCommand::convertToMatix(hybridAction);
+
+    flightRecorder->CommitRecord();
+}
+
+
+void qrRobotRunner::PublishTelemetry(float latency)
+{
+    qr_telemetry_lcmt *message = telemetry->BeginSample();
+    if (!message) {
+        return;
+    }
+
+    const qrRobot *robot = controlRobot;
+    const qrStateDataFlow &dataFlow = controlRobot->stateDataFlow;
+    message->utime = static_cast<int64_t>(controlRobot->GetTimeSinceReset() * 1e6);
+    message->tick = controlRobot->GetTick();
+    message->fsm_mode = robot->fsmMode;
+    message->latency = latency;
+    Eigen::Map<Vec3<float>>(message->rpy) = robot->baseRollPitchYaw;
+    Eigen::Map<Vec3<float>>(message->gyro) = robot->baseRollPitchYawRate;
+    Eigen::Map<Vec3<float>>(message->position) = robot->basePosition;
+    Eigen::Map<Vec3<float>>(message->velocity) = dataFlow.baseVInWorldFrame;
+    Eigen::Map<Vec3<float>>(message->omega) = dataFlow.baseWInWorldFrame;
+    Eigen::Map<Vec3<float>>(message->velocity_command) = desiredStateCommand->getFilteredVel();
+    Eigen::Map<Vec3<float>>(message->omega_command) = desiredStateCommand->getFilteredOmega();
+    Eigen::Map<Vec12<float>>(message->q) = robot->motorAngles;
+    Eigen::Map<Vec12<float>>(message->qd) = robot->motorVelocities;
+    Eigen::Map<Vec12<float>>(message->tau) = robot->motortorque;
+    for (int motor = 0; motor < NumMotor; ++motor) {
+        message->q_des[motor] = hybridAction[motor].p;
+        message->qd_des[motor] = hybridAction[motor].d;
+        message->tau_des[motor] = hybridAction[motor].tua;
+    }
+    Eigen::Map<Vec4<float>>(message->foot_force) = robot->footForce;
+    for (int leg = 0; leg < NumLeg; ++leg) {
+        message->contact[leg] = robot->footContact[leg];
+    }
+
+    telemetry->CommitSample();
+}
+
+
+void qrRobotRunner::SetTelemetrySink(qrTelemetrySink* sink)
+{
+    delete telemetry;
+    telemetry = sink;
+}
+
+
 qrRobotRunner::~qrRobotRunner()
 {
+    delete commandInput;
+    delete telemetry;
+    delete flightRecorder;
+    delete pipeline;
     delete quadruped;
     delete gaitGenerator;
     delete stateEstimators;
     delete controlFSM;
+    if (robotMirror) {
+        delete robotMirror;
+        delete controlEstimators;
+        delete estimationGait;
+    }
 }
@@ -0,0 +1,202 @@
+// The MIT License
+
+// Copyright (c) 2022
+// Robot Motion and Vision Laboratory at East China Normal University
+// Contact: tophill.robotics@gmail.com
+
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include "exec/qr_task_scheduler.h"
+
+#include <iostream>
+#include <stdexcept>
+
+
+namespace Quadruped {
+
+qrTaskScheduler::qrTaskScheduler(const qrUserParameters &userParametersIn, qrRealtimeSetup &realtimeSetupIn):
+    threadNum(userParametersIn.schedulerThreads),
+    userParameters(userParametersIn),
+    realtimeSetup(realtimeSetupIn),
+    tick(0),
+    built(false)
+{
+}
+
+
+qrTaskScheduler::~qrTaskScheduler()
+{
+    generation.Cancel();
+    for (auto &worker : workers) {
+        worker.join();
+    }
+}
+
+
+void qrTaskScheduler::AddTask(const std::string &name,
+                              std::function<void()> func,
+                              const std::vector<std::string> &dependencies,
+                              qrTaskRate defaultRate)
+{
+    if (built) {
+        throw std::runtime_error("[Scheduler] task " + name + " is added after Build()");
+    }
+    for (const auto &task : tasks) {
+        if (task.name == name) {
+            throw std::runtime_error("[Scheduler] task " + name + " is added twice");
+        }
+    }
+
+    qrTask task;
+    task.name = name;
+    task.func = func;
+    task.dependencies = dependencies;
+    task.rate = userParameters.GetTaskRate(name, defaultRate);
+    tasks.push_back(task);
+}
+
+
+void qrTaskScheduler::Build()
+{
+    if (built) {
+        return;
+    }
+
+    /* Level of a task is one more than the deepest of its dependencies. 0: unvisited, 1: visiting, 2: done. */
+    std::vector<int> state(tasks.size(), 0);
+    std::function<int(int)> computeLevel = [&](int i) -> int {
+        if (state[i] == 2) {
+            return tasks[i].level;
+        }
+        if (state[i] == 1) {
+            throw std::runtime_error("[Scheduler] dependency cycle at task " + tasks[i].name);
+        }
+        state[i] = 1;
+        int level = 0;
+        for (const auto &dependency : tasks[i].dependencies) {
+            int j = 0;
+            while (j < int(tasks.size()) && tasks[j].name != dependency) {
+                ++j;
+            }
+            if (j == int(tasks.size())) {
+                throw std::runtime_error("[Scheduler] task " + tasks[i].name + " depends on unknown task " + dependency);
+            }
+            level = std::max(level, computeLevel(j) + 1);
+        }
+        state[i] = 2;
+        tasks[i].level = level;
+        return level;
+    };
+
+    int maxLevel = -1;
+    for (int i = 0; i < int(tasks.size()); ++i) {
+        maxLevel = std::max(maxLevel, computeLevel(i));
+    }
+    levels.assign(maxLevel + 1, std::vector<int>());
+    for (int i = 0; i < int(tasks.size()); ++i) {
+        levels[tasks[i].level].push_back(i);
+    }
+    dueTasks.reserve(tasks.size());
+
+    for (unsigned int threadId = 1; threadId <= threadNum; ++threadId) {
+        workers.emplace_back(&qrTaskScheduler::WorkerLoop, this, threadId);
+    }
+    built = true;
+    PrintSchedule();
+}
+
+
+void qrTaskScheduler::Run()
+{
+    if (!built) {
+        Build();
+    }
+
+    for (const auto &level : levels) {
+        dueTasks.clear();
+        for (int i : level) {
+            if (tasks[i].rate.IsDue(tick)) {
+                dueTasks.push_back(i);
+            }
+        }
+
+        if (threadNum == 0 || dueTasks.size() < 2) {
+            for (int i : dueTasks) {
+                tasks[i].func();
+            }
+            continue;
+        }
+
+        /* Start the level on the workers, take the share of thread 0, then wait for the others. */
+        unsigned long target = finished.Get() + threadNum;
+        generation.Advance();
+        RunShare(0);
+        finished.WaitFor(target);
+    }
+    ++tick;
+}
+
+
+bool qrTaskScheduler::IsDue(const std::string &name) const
+{
+    for (const auto &task : tasks) {
+        if (task.name == name) {
+            return task.rate.IsDue(tick);
+        }
+    }
+    return false;
+}
+
+
+void qrTaskScheduler::WorkerLoop(unsigned int threadId)
+{
+    realtimeSetup.SetupWorkerThread(-1, "scheduler thread " + std::to_string(threadId));
+
+    /* The caller waits for every worker before it starts the next level, so no level is skipped. */
+    unsigned long seen = 0;
+    for (unsigned long current = generation.WaitForChange(seen); current != seen;
+         current = generation.WaitForChange(seen)) {
+        seen = current;
+        RunShare(threadId);
+        finished.Advance();
+    }
+}
+
+
+void qrTaskScheduler::RunShare(unsigned int threadId)
+{
+    for (size_t k = threadId; k < dueTasks.size(); k += threadNum + 1) {
+        tasks[dueTasks[k]].func();
+    }
+}
+
+
+void qrTaskScheduler::PrintSchedule() const
+{
+    std::cout << "[Scheduler] " << tasks.size() << " tasks, " << threadNum + 1 << " threads" << std::endl;
+    for (size_t l = 0; l < levels.size(); ++l) {
+        std::cout << "[Scheduler] level " << l << ":";
+        for (int i : levels[l]) {
+            std::cout << " " << tasks[i].name << "(" << tasks[i].rate.period << "/" << tasks[i].rate.offset << ")";
+        }
+        std::cout << std::endl;
+    }
+}
+
+} // Namespace Quadruped
@@ -31,13 +31,15 @@ qrControlFSM<T>::qrControlFSM(
     Quadruped::qrStateEstimatorContainer *stateEstimators,
     Quadruped::qrGaitGenerator *gaitScheduler,
     Quadruped::qrDesiredStateCommand *desiredStateCommand,
-    qrUserParameters *userParameters)
+    qrUserParameters *userParameters,
+    const std::string &homeDir)
 {
     data.quadruped = quadruped;
     data.stateEstimators = stateEstimators;
     data.gaitGenerator = gaitScheduler;
     data.desiredStateCommand = desiredStateCommand;
     data.userParameters = userParameters;
+    data.homeDir = homeDir;
 
     /* Add all FSM states into the statelist and initialize the FSM. */
     statesList.invalid = nullptr;
@@ -65,8 +67,10 @@ void qrControlFSM<T>::Initialize()
 
 
 template<typename T>
-void qrControlFSM<T>::RunFSM(std::vector<Quadruped::qrMotorCommand>& hybridAction)
+void qrControlFSM<T>::BeginTick()
 {
+    runState = false;
+    locomotionStages = false;
 
     /* If joy command has received, set up next FSM mode according to the received joy RC mode. */
     if(data.desiredStateCommand->getJoyCtrlStateChangeRequest()) {
@@ -93,24 +97,44 @@ void qrControlFSM<T>::RunFSM(std::vector<Quadruped::qrMotorCommand>& hybridActio
         data.desiredStateCommand->setJoyCtrlStateChangeRequest(false);
     }
 
+    if (operatingMode == FSM_OperatingMode::ESTOP) {
+        /* This part is used for emergency stop, will be added in the future. */
+        currentState->OnEnter();
+        nextStateName = currentState->stateName;
+        return;
+    }
+
+    /* Run normal controls of this state if no transition is detected.
+     * If a transition is required, the %CheckTransition() will return a different state name.
+     * Then the %operatingMode will set to TRANSITIONING
+     */
+    if (operatingMode == FSM_OperatingMode::NORMAL) {
+        nextStateName = currentState->CheckTransition();
+        if (nextStateName != currentState->stateName) {
+            operatingMode = FSM_OperatingMode::TRANSITIONING;
+            nextState = GetNextState(nextStateName);
+
+        } else if (currentState->transitionDuration > 0.1) {
+            operatingMode = FSM_OperatingMode::TRANSITIONING;
+        } else {
+            // Execute normal behaviour of the state in EndTick().
+            runState = true;
+        }
+    }
+
+    if (currentState == statesList.locomotion) {
+        locomotionStages = statesList.locomotion->PrepareStages(operatingMode == FSM_OperatingMode::TRANSITIONING);
+    }
+}
+
+
+template<typename T>
+void qrControlFSM<T>::EndTick(std::vector<Quadruped::qrMotorCommand>& hybridAction)
+{
     if (operatingMode != FSM_OperatingMode::ESTOP) {
 
-        /* Run normal controls of this state if no transition is detected.
-         * If a transition is required, the %CheckTransition() will return a different state name.
-         * Then the %operatingMode will set to TRANSITIONING
-         */
-        if (operatingMode == FSM_OperatingMode::NORMAL) {
-            nextStateName = currentState->CheckTransition();
-            if (nextStateName != currentState->stateName) {
-                operatingMode = FSM_OperatingMode::TRANSITIONING;
-                nextState = GetNextState(nextStateName);
-
-            } else if (currentState->transitionDuration > 0.1) {
-                operatingMode = FSM_OperatingMode::TRANSITIONING;
-            } else {
-                // Execute normal behaviour of the state.
-                currentState->Run();
-            }
+        if (runState) {
+            currentState->Run();
         }
 
         /* If the state needs transitioning, current state will set up transition data. */
@@ -136,11 +160,6 @@ void qrControlFSM<T>::RunFSM(std::vector<Quadruped::qrMotorCommand>& hybridActio
         } else {
             SafetyPostCheck();
         }
-
-    } else {
-        /* This part is used for emergency stop, will be added in the future. */
-        currentState->OnEnter();
-        nextStateName = currentState->stateName;
     }
             
     hybridAction = data.legCmd;
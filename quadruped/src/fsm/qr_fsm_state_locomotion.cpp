@@ -23,7 +23,7 @@
 // SOFTWARE.
 
 #include "fsm/qr_fsm_state_locomotion.hpp"
-#include <ros/package.h>
+#include "utils/qr_tools.h"
 
 
 using namespace Quadruped;
@@ -42,7 +42,10 @@ template<typename T>
 qrFSMStateLocomotion<T>::qrFSMStateLocomotion(qrControlFSMData<T> *controlFSMData):
     qrFSMState<T>(controlFSMData, FSM_StateName::LOCOMOTION, "LOCOMOTION")
 {
-    std::string homeDir = ros::package::getPath("quadruped") + "/";
+    std::string homeDir = controlFSMData->homeDir;
+    if (homeDir.empty()) {
+        homeDir = GetHomeDir();
+    }
     locomotionController = SetUpController(controlFSMData->quadruped, controlFSMData->gaitGenerator,
                                            controlFSMData->desiredStateCommand, controlFSMData->stateEstimators,
                                            controlFSMData->userParameters, homeDir);
@@ -68,6 +71,9 @@ qrFSMStateLocomotion<T>::qrFSMStateLocomotion(qrControlFSMData<T> *controlFSMDat
         wbcData->vBody_des.setZero();
         wbcData->aBody_des.setZero();
         for (int legId(0); legId < NumLeg; ++legId) {
+            wbcData->pFoot_des[legId].setZero();
+            wbcData->vFoot_des[legId].setZero();
+            wbcData->aFoot_des[legId].setZero();
             wbcData->Fr_des[legId].setZero();
         }
     }
@@ -122,19 +128,48 @@ void qrFSMStateLocomotion<T>::OnEnter()
         locomotionController->Reset();
         this->_data->stateEstimators->Reset();
     }
+    wbcSolved = false;
     printf("[FSM LOCOMOTION] On Enter\n");
 }
 
 
+template<typename T>
+bool qrFSMStateLocomotion<T>::PrepareStages(bool transitioning)
+{
+    stagesInTransition = transitioning;
+    if (!transitioning) {
+        return true;
+    }
+    if (this->nextStateName != FSM_StateName::LOCOMOTION || !UpdatesInTransition()) {
+        return false;
+    }
+
+    /* Slow down the quadruped before the gait switches or it stands, see SwitchMode() and StandLoop(). */
+    UpdateControllerParams(locomotionController, {0.f, 0.f, 0.f}, 0.f);
+    this->_data->desiredStateCommand->stateDes.segment(6, 6) << 0, 0, 0, 0, 0, 0;
+    return true;
+}
+
+
+template<typename T>
+void qrFSMStateLocomotion<T>::SolveWBC()
+{
+    if (stagesInTransition || !this->_data->userParameters->useWBC || !wbcData->allowAfterMPC
+        || this->_data->quadruped->controlParams["mode"] != LocomotionMode::ADVANCED_TROT) {
+        return;
+    }
+    wbcController->Run(wbcData);
+    wbcSolved = true;
+}
+
+
 template<typename T>
 void qrFSMStateLocomotion<T>::Run()
 {
-    /* Call the locomotion control logic for this iteration and get the results, including commands and reaction force
+    /* Get the results of the controller stages of this iteration, including commands and reaction force
      * Save the commands into FSM Data structure.
      */
-    locomotionController->Update();
-    auto [hybridAction, qpSol] = locomotionController->GetAction();
-    this->_data->legCmd = std::move(hybridAction);
+    this->_data->legCmd = std::get<0>(locomotionController->GetAction());
 
     
     if (this->_data->quadruped->controlParams["mode"] == LocomotionMode::ADVANCED_TROT) {
@@ -150,9 +185,9 @@ void qrFSMStateLocomotion<T>::Run()
             this->_data->legCmd[motorId].tua += tua;
         }
         
-        /* Run Whole Body Controller if WBC is enabled. */
-        if (this->_data->userParameters->useWBC && wbcData->allowAfterMPC) {
-            wbcController->Run(wbcData);
+        /* Apply the torques of the last Whole Body Controller solve if WBC is enabled. */
+        if (this->_data->userParameters->useWBC && wbcSolved) {
+            wbcController->UpdateLegCMD(this->_data);
         }
     }
 }
@@ -278,22 +313,16 @@ bool qrFSMStateLocomotion<T>::SwitchMode()
         iter = 0;
         this->transitionData.done = true;
         this->transitionDuration = 0;
-        ROS_INFO("transitionData.done");
+        printf("[LOCOMOTION] transitionData.done\n");
         return true;
     }
 
     int N = robot->GetFootContact().cast<int>().sum();
 
     if (iter < 1000) {
-        /* Slow Down the velocity of the quadruped in 1000 iterations if the quadruped is trotting. */
-        UpdateControllerParams(locomotionController, {0.f, 0.f, 0.f}, 0.f);
-        this->_data->desiredStateCommand->stateDes.segment(6, 6) << 0, 0, 0, 0, 0, 0;
-        
-        locomotionController->Update();
-
-        auto [hybridAction, qpSol] = locomotionController->GetAction();
-
-        this->transitionData.legCommand = std::move(hybridAction);
+        /* Slow Down the velocity of the quadruped in 1000 iterations if the quadruped is trotting.
+         * The controller stages have run on the zero command set by PrepareStages(). */
+        this->transitionData.legCommand = std::get<0>(locomotionController->GetAction());
         /* If four feet are on the groud, then continue to next stage. */
         if (N == 4) {
             iter = 1000;
@@ -320,18 +349,13 @@ bool qrFSMStateLocomotion<T>::StandLoop()
         iter = 0;
         this->transitionData.done = true;
         this->transitionDuration = 0;
-        ROS_INFO("transitionData.done");
+        printf("[LOCOMOTION] transitionData.done\n");
         return true;
     }
     
     int N = robot->GetFootContact().cast<int>().sum();
     if (iter < this->transitionDuration * 1000) {
-        UpdateControllerParams(locomotionController, {0.f, 0.f, 0.f}, 0.f);
-        this->_data->desiredStateCommand->stateDes.segment(6, 6) << 0, 0, 0, 0, 0, 0;
-        
-        locomotionController->Update();
-        auto [hybridAction, qpSol] = locomotionController->GetAction();
-        this->transitionData.legCommand = std::move(hybridAction);
+        this->transitionData.legCommand = std::get<0>(locomotionController->GetAction());
         if (N == 4) {
             iter = 1000;
         }
@@ -0,0 +1,92 @@
+// The MIT License
+
+// Copyright (c) 2022
+// Robot Motion and Vision Laboratory at East China Normal University
+// Contact: tophill.robotics@gmail.com
+
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+#include "gait/qr_gait.h"
+
+namespace Quadruped {
+
+void qrGaitGenerator::BuildContactSchedule()
+{
+    /* legs that never touch the ground, such as the userdefined legs, are not periodic. */
+    contactSchedulePeriod = 0.f;
+    contactSchedulePeriodic = true;
+    for (int legId = 0; legId < NumLeg; ++legId) {
+        if (initialLegState[legId] == LegState::USERDEFINED_SWING || fullCyclePeriod[legId] <= 0.f) {
+            continue;
+        }
+        if (contactSchedulePeriod == 0.f) {
+            contactSchedulePeriod = fullCyclePeriod[legId];
+        } else if (std::abs(fullCyclePeriod[legId] - contactSchedulePeriod) > 1e-4f * contactSchedulePeriod) {
+            contactSchedulePeriodic = false;
+        }
+    }
+    if (contactSchedulePeriod == 0.f) {
+        contactSchedulePeriod = 1.f;
+    }
+
+    if (contactSchedulePeriodic) {
+        FillContactSchedule(0.f, CONTACT_SCHEDULE_SLOTS);
+        std::copy(contactSchedule.begin(), contactSchedule.begin() + CONTACT_SCHEDULE_SLOTS,
+                  contactSchedule.begin() + CONTACT_SCHEDULE_SLOTS);
+    } else {
+        printf("[Gait] the legs have different gait periods, the contact schedule is refilled at every update.\n");
+        FillContactSchedule(0.f, 2 * CONTACT_SCHEDULE_SLOTS);
+    }
+    contactScheduleSlot = 0;
+}
+
+
+void qrGaitGenerator::UpdateContactScheduleSlot(float time)
+{
+    if (contactSchedulePeriodic) {
+        float cyclePhase = fmod(time, contactSchedulePeriod) / contactSchedulePeriod;
+        contactScheduleSlot = std::min(std::max(int(cyclePhase * CONTACT_SCHEDULE_SLOTS), 0), CONTACT_SCHEDULE_SLOTS - 1);
+    } else {
+        /* The contacts of the legs do not repeat after a period, so the window is planned from the given time on. */
+        FillContactSchedule(time, 2 * CONTACT_SCHEDULE_SLOTS);
+        contactScheduleSlot = 0;
+    }
+}
+
+
+void qrGaitGenerator::FillContactSchedule(float startTime, int slots)
+{
+    const float slotDuration = contactSchedulePeriod / CONTACT_SCHEDULE_SLOTS;
+    for (int slot = 0; slot < slots; ++slot) {
+        float time = startTime + slot * slotDuration;
+        u8 contacts = 0;
+        for (int legId = 0; legId < NumLeg; ++legId) {
+            if (initialLegState[legId] == LegState::USERDEFINED_SWING) {
+                continue;
+            }
+            float phase = initialLegPhase[legId] + time / fullCyclePeriod[legId];
+            phase -= std::floor(phase);
+            if (phase < dutyFactor[legId]) {
+                contacts |= (1 << legId);
+            }
+        }
+        contactSchedule[slot] = contacts;
+    }
+}
+
+} // Namespace Quadruped
@@ -204,6 +204,11 @@ void qrOpenLoopGaitGenerator::Update(float currentTime)
 
     }
 
+    /* While a leg waits for its touch down, Schedule() holds the gait and the planned contacts with it. */
+    if (allowSwitchLegState.cast<int>().sum() == 4) {
+        UpdateContactScheduleSlot(timeSinceReset);
+    }
+
     lastTime = currentTime;
 }
 
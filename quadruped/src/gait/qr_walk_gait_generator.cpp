@@ -284,6 +284,7 @@ void qrWalkGaitGenerator::Update(float currentTime)
         }
 
     }
+    UpdateContactScheduleSlot(currentTime);
     std::cout << "foot contact: " << robot->GetFootContact().transpose() << std::endl;
     std::cout << "curlegState " << curLegState.transpose() <<std::endl;
     std::cout << "desiredLegState " << desiredLegState.transpose() <<std::endl;
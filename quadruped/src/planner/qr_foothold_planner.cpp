@@ -109,7 +109,7 @@ Eigen::Matrix<float, 3, 4> qrFootholdPlanner::ComputeNextFootholds(Eigen::Matrix
 }
 
 
-void qrFootholdPlanner::ComputeHeuristicFootHold(std::vector<u8> swingFootIds)
+void qrFootholdPlanner::ComputeHeuristicFootHold(const std::vector<u8> &swingFootIds)
 {
     if (swingFootIds.empty()) {
         return;
@@ -133,7 +133,7 @@ void qrFootholdPlanner::ComputeHeuristicFootHold(std::vector<u8> swingFootIds)
     Eigen::Matrix<float, 3, 4> abadPosInBaseFrame = robot->hipOffset;
     Vec4<float> side_sign = {-1, 1, -1, 1}; // y-axis
 
-    for (u8& legId : swingFootIds) {
+    for (u8 legId : swingFootIds) {
         Vec3<float> hipOffset = abadPosInBaseFrame.col(legId); // hipPositions.col(legId);
         Vec3<float> twistingVector = {-hipOffset[1], hipOffset[0], 0.f};
         Vec3<float> hipHorizontalVelocity = comVelocity + w.cross(hipOffset); // yawDot * twistingVector; // in base frame
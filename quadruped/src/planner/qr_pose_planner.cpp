@@ -51,11 +51,14 @@ qrPosePlanner::qrPosePlanner(qrRobot *robotIn, qrGaitGenerator *gaitGeneratorIn,
     
     ToCounterClockOrder(rBH);
     
-    validContactPointId.clear();
-    Asp = Eigen::MatrixXf::Zero(N, 3);
-    bsp = Eigen::MatrixXf::Zero(N, 1);
-    G = Eigen::MatrixXf::Zero(3*N, 1);
-    Lambda = Eigen::MatrixXf::Ones(3*N, 1)/10.0;
+    Asp.setZero(N, 3);
+    bsp.setZero(N, 1);
+    G.setZero(3*N, 1);
+    Lambda = ConstraintVec::Ones(3*N, 1)/10.0;
+    legLambda.setConstant(0.1f);
+    supportPolygonVertices.setZero();
+    projectedSupportPolygonVertices.setZero();
+    g.setZero();
     so3Phi << 0,0,0;
     
     quat << 1,0,0,0;// 0.995, 0.0998,0,0; //roll=11.5du, 
@@ -83,6 +86,7 @@ Vec6<float> qrPosePlanner::Update(float currentTime)
     printf("pose planner contact = %d, %d, %d, %d\n", contactK[0],contactK[1],contactK[2],contactK[3]);
     ToCounterClockOrder(contactK);
 
+    Quat<float> lastQuat = quat; // orientation solved in the last call
     quat = robot->GetBaseOrientation();
     Vec3<float> robotComRpy = robot->GetBaseRollPitchYaw(); // world frame
     Mat3<float> Rb = robotics::math::quaternionToRotationMatrix(quat).transpose();
@@ -95,37 +99,40 @@ Vec6<float> qrPosePlanner::Update(float currentTime)
     rIBSource = robotEstimator->GetEstimatedPosition(); // in world frame
     std::cout << "rIBSource = " <<rIBSource.transpose() << std::endl; 
     poseSource << rIBSource, robotComRpy; // todo
-    // rIB << 0.f, 0.f, 0.f; // init at world frame 's origin
-    rIB = robotEstimator->GetEstimatedPosition(); // in world frame
-    rIB_ = ProjectV(rIB);
-    rBF = robot->GetFootPositionsInBaseFrame();
-    ToCounterClockOrder(rBF);
     rIF = robot->GetFootPositionsInWorldFrame();
     // rIF = rIF.colwise() - rIBSource; // world frame origin at body center
     std::cout << "rIF" << rIF << std::endl;
     // rIF = Rcb * rBF; // foot positions in source control frame
     ToCounterClockOrder(rIF);
+    if (hasSolution && (rIB - rIBSource).norm() < warmStartRadius) {
+        /* warm start from the last solution, which the base has been moving to. */
+        quat = lastQuat;
+        rBF = robotics::math::RigidTransform<float,4>({0.f,0.f,0.f}, quat, rIF.colwise() - rIB); // in base frame
+    } else {
+        // rIB << 0.f, 0.f, 0.f; // init at world frame 's origin
+        rIB = rIBSource; // in world frame
+        rBF = robot->GetFootPositionsInBaseFrame();
+        ToCounterClockOrder(rBF);
+    }
+    rIB_ = ProjectV(rIB);
     // rBCOM = robot->comOffset; // rICOM = rIB + Phi(rBCOM);
     rBCOM << 0., 0., 0.; // assume com is overlape with geometric center point.
     // rICOMoffset = robotics::math::TransformVecByQuat(quat, rBCOM);
     rICOMoffset = Rcb * rBCOM; // in control frame
     rICOMoffset_ = ProjectV(rICOMoffset);
     rSP_ << 0, 0, 0 ;
-    supportPolygonVertices.clear();
-    projectedSupportPolygonVertices.clear();
-    g.clear();
     contactLegNumber = 0;
-    validContactPointId.clear();
+    N = 0;
     for (int i=0; i<4 ;++i) { // i is counterwise order leg index (started from FR-leg).
         if (contactK[i]) {
-            validContactPointId.insert(i);
+            contactPointIds[N] = i;
             contactLegNumber++;
             Vec3<float> r = rIF.col(i); 
-            supportPolygonVertices.push_back(r); // in world frame origin at body center
+            supportPolygonVertices.col(N) = r; // in world frame origin at body center
             rSP_ += r;
-            Vec3<float> rIFB = rIB + robotics::math::TransformVecByQuat<float>(quat, rBH.col(i)) - r;
-            g.push_back(rIFB);
-            // g.push_back(rIB + Rcb * rBH.col(i) - r); // in control frame
+            g.col(N) = rIB + robotics::math::TransformVecByQuat<float>(quat, rBH.col(i)) - r;
+            // g.col(N) = rIB + Rcb * rBH.col(i) - r; // in control frame
+            N++;
         }
     }
     Vec3<float> centerOfQuadrangle = rIF.rowwise().mean();
@@ -134,16 +141,15 @@ Vec6<float> qrPosePlanner::Update(float currentTime)
     // rSP_[2] = std::max(-0.03f, (std::min(0.03f, bodyHight - rIBSource[2] - rIBSource[2] - Rcb(0,2)*rSP_[0] - Rcb(1,2)*rSP_[1]) / Rcb(2,2) + rIBSource[2])); // Rcb^T * X = Y, where Y is in control frame, and Y[2] = bodyHeight 
     rSP_[2] = bodyHight;
     std::cout << "rSP_ =  " << rSP_.transpose() << std::endl;
-    N = contactLegNumber;
     if (contactLegNumber==4) {
         /* check sp is or is not convex polygen; */
         int invalidId=-1;
         for (int sourceId=1; sourceId<=2; sourceId++) {
             int destId = (sourceId + 2) % 4;
-            Vec3<float>& checkPostive = supportPolygonVertices[sourceId-1];
-            Vec3<float>& checkNegative = supportPolygonVertices[sourceId+1];
-            Vec3<float>& sourcePoint = supportPolygonVertices[sourceId];
-            Vec3<float>& destPoint = supportPolygonVertices[destId];
+            Vec3<float> checkPostive = supportPolygonVertices.col(sourceId-1);
+            Vec3<float> checkNegative = supportPolygonVertices.col(sourceId+1);
+            Vec3<float> sourcePoint = supportPolygonVertices.col(sourceId);
+            Vec3<float> destPoint = supportPolygonVertices.col(destId);
             
             if ((destPoint[0] - sourcePoint[0])*(checkPostive[1] - sourcePoint[1]) - 
                     (destPoint[1] - sourcePoint[1])*(checkPostive[0] - sourcePoint[0]) > 0) {
@@ -160,39 +166,37 @@ Vec6<float> qrPosePlanner::Update(float currentTime)
         //* IF NOT CONVEX, COMPUTE ITS CLOSEURE. */
         if (invalidId>=0) {
             printf("invalidId = %d \n", invalidId);
-            supportPolygonVertices.erase(supportPolygonVertices.begin()+invalidId);
-            g.erase(g.begin()+invalidId);
+            for (int k=invalidId; k < N-1; ++k) {
+                supportPolygonVertices.col(k) = supportPolygonVertices.col(k+1);
+                g.col(k) = g.col(k+1);
+                contactPointIds[k] = contactPointIds[k+1];
+            }
             N--;
-            validContactPointId.erase(invalidId);
         }
     }
 
     for (int i=0; i< N; ++i) {
-        Vec3<float>& r = supportPolygonVertices[i];
-        projectedSupportPolygonVertices.push_back(ProjectV(r));
+        projectedSupportPolygonVertices.col(i) = ProjectV(supportPolygonVertices.col(i));
+    }
+    /* warm start the Lagrange factors of each leg from the last solution. */
+    Lambda.resize(3*N, 1);
+    for (int n=0; n<N; ++n) {
+        for (int k=0; k<3; ++k) {
+            Lambda(k*N + n) = legLambda(k, contactPointIds[n]);
+        }
     }
-    Lambda.conservativeResize(3*N, Eigen::NoChange);
 
     /* build a QP problem and solve it, get the desired pose and Lagrange factor */
-    for (int loop=0; loop < 20; ++loop) {
-        float f = ComputeF();
-        Eigen::MatrixXf GValue = ComputeG();
+    for (iterations=0; iterations < maxIterations;) {
+        const ConstraintVec &GValue = ComputeG();
         Mat6<float> hessF = ComputeHessianF();
-        std::vector<Mat6<float>> hessG = ComputeHessianG();
+        Mat6<float> hessGSum = ComputeHessianGSum();
         Vec6<float> gradientF = ComputeGradientF();
-        Eigen::MatrixXf gradientG = ComputeGradientG();
-        Mat6<float> hessGSum = Mat6<float>::Zero();
-        if (hessG.size() != Lambda.size()) {
-            throw std::domain_error("The size of hessG and Lambda does not match!");
-        }
-        for (int i=0; i<hessG.size(); ++i) {
-            hessGSum += Lambda(i) * hessG[i];
-        }
+        const ConstraintJacobian &gradientG = ComputeGradientG();
         // solve the min L, SQP. 
-        auto res = QpSolver(hessF, hessGSum, gradientF, gradientG, GValue);
+        Vec6<float> p = QpSolver(hessF, hessGSum, gradientF, gradientG, GValue);
+        ++iterations;
         // update state
-        Vec6<float> p = std::get<0>(res);
-        Eigen::MatrixXf u = std::get<1>(res);
         rIB += p.head(3); // in translated world frame
         so3Phi = p.tail(3);
         Quat<float> dQuat = robotics::math::so3ToQuat(so3Phi);
@@ -201,18 +205,21 @@ Vec6<float> qrPosePlanner::Update(float currentTime)
         rBF = robotics::math::RigidTransform<float,4>({0.f,0.f,0.f}, quat, rIF.colwise() - rIB); // in base frame
         rICOMoffset = robotics::math::TransformVecByQuat(quat, rBCOM);
         rICOMoffset_ = ProjectV(rICOMoffset);
-        g.clear();
-        for (int i : validContactPointId) { // i is counterwise order leg index (started from FR-leg).
+        for (int n=0; n<N; ++n) {
+            int i = contactPointIds[n]; // i is counterwise order leg index (started from FR-leg).
             Vec3<float> r = rIF.col(i);
-            g.push_back(rIB + robotics::math::TransformVecByQuat<float>(quat, rBH.col(i)) - r);
+            g.col(n) = rIB + robotics::math::TransformVecByQuat<float>(quat, rBH.col(i)) - r;
         }
-        for (int i=0; i<3*N; ++i) {
-            Lambda(i, 0) = u(i, 0);
+        if (p.norm() < convergenceTolerance) {
+            break;
         }
-        if (Lambda.size()!=3*N) {
-            throw std::domain_error("Lambda.size()!=3*N\n");
+    }
+    for (int n=0; n<N; ++n) {
+        for (int k=0; k<3; ++k) {
+            legLambda(k, contactPointIds[n]) = Lambda(k*N + n);
         }
     }
+    hasSolution = true;
 
     rpy = robotics::math::quatToRPY(quat); // TODO
     // rpy[1] = groundRPY[1];
@@ -222,7 +229,7 @@ Vec6<float> qrPosePlanner::Update(float currentTime)
     poseDest << rIB, rpy;
     Mat3<float> destR = robotics::math::rpyToRotMat(rpy).transpose();
     std::cout <<"poseSource = "<< poseSource.transpose() 
-              << "\n poseSDest = " << poseDest.transpose() <<std::endl; 
+              << "\n poseSDest = " << poseDest.transpose() << ", iterations = " << iterations << std::endl; 
     
     segment.Reset(poseSource, poseDest);
     // for (int i=0; i < 3; ++i) { 
@@ -233,11 +240,11 @@ Vec6<float> qrPosePlanner::Update(float currentTime)
 }
 
 
-std::tuple<Vec6<float>,Eigen::MatrixXf> qrPosePlanner::QpSolver(Mat6<float>& hessF,
-                                                              Mat6<float>& hessGSum,
-                                                              Vec6<float>& gradientF,
-                                                              Eigen::MatrixXf& gradientG,
-                                                              Eigen::MatrixXf& GValue)
+Vec6<float> qrPosePlanner::QpSolver(const Mat6<float>& hessF,
+                                    const Mat6<float>& hessGSum,
+                                    const Vec6<float>& gradientF,
+                                    const ConstraintJacobian& gradientG,
+                                    const ConstraintVec& GValue)
 {
     quadprogpp::Matrix<double> GG(6, 6);
     for (int i = 0; i < 6; i++) {
@@ -271,18 +278,18 @@ std::tuple<Vec6<float>,Eigen::MatrixXf> qrPosePlanner::QpSolver(Mat6<float>& hes
     for (int i=0; i<6; ++i) {
         p[i] = float(x[i]);
     }
-    Eigen::MatrixXf larg = Eigen::MatrixXf::Zero(3*N,1);
     for (int i=0; i < 3*N; ++i) {
-        larg(i, 0) = u[i];
+        Lambda(i) = u[i];
     }
-    return {p,larg};
+    return p;
 }
 
 
 Vec6<float> qrPosePlanner::ComputeGradientF()
 {
     Vec6<float> gradient = Vec6<float>::Zero();
-    for (int i : validContactPointId) {
+    for (int n=0; n<N; ++n) {
+        int i = contactPointIds[n];
         gradient.head(3)  +=  (rIB + robotics::math::TransformVecByQuat<float>(quat, rBF.col(i)) - rIF.col(i));
         Vec3<float> r = robotics::math::TransformVecByQuat<float>(quat, rBF.col(i));
         Mat3<float> rMAT = robotics::math::vectorToSkewMat(r);
@@ -298,7 +305,8 @@ Vec6<float> qrPosePlanner::ComputeGradientF()
 Eigen::Matrix<float, 6, 6> qrPosePlanner::ComputeHessianF() 
 {
     Eigen::Matrix<float, 6, 6> Hess = Eigen::Matrix<float, 6, 6>::Zero();
-    for (int i : validContactPointId) {
+    for (int n=0; n<N; ++n) {
+        int i = contactPointIds[n];
         Hess.block<3,3>(0,0) += Eigen::Matrix<float,3,3>::Identity();
         Vec3<float> r = robotics::math::TransformVecByQuat<float>(quat, rBF.col(i));
         Mat3<float> rMat = robotics::math::vectorToSkewMat(r);
@@ -326,41 +334,38 @@ Eigen::Matrix<float, 6, 6> qrPosePlanner::ComputeHessianF()
 }
 
 
-Eigen::MatrixXf qrPosePlanner::ComputeGradientG()
+const qrPosePlanner::ConstraintJacobian &qrPosePlanner::ComputeGradientG()
 {
-    Eigen::MatrixXf gradient = Eigen::MatrixXf::Zero(3*N, 3+3);   
+    ConstraintJacobian &gradient = gradientG;
+    gradient.setZero(3*N, 3+3);
     gradient.block(0, 0, N, 3) = Asp;
     gradient.block(0, 3, N, 3) = -Asp * robotics::math::vectorToSkewMat(rICOMoffset);
-    int n=0;
-    for(int i : validContactPointId) {
-        Vec3<float> gi = g[n];
+    for (int n=0; n<N; ++n) {
+        int i = contactPointIds[n];
+        Vec3<float> gi = g.col(n);
         gi.normalize();
         gradient.block(n+N, 0, 1, 3) =  gi.transpose();
         Vec3<float> rIBH = robotics::math::TransformVecByQuat<float>(quat, rBH.col(i));
         gradient.block(n+N, 3, 1, 3) =  -gi.transpose() * robotics::math::vectorToSkewMat(rIBH);
-        n++;
     }
     gradient.block(2*N,0,N,6) = -gradient.block(N,0,N,6);
     return gradient;
 }
 
 
-std::vector<Mat6<float>> qrPosePlanner::ComputeHessianG() 
+Mat6<float> qrPosePlanner::ComputeHessianGSum()
 {
-    std::vector<Mat6<float>> hessVec;
-    Eigen::MatrixXf AspT = Asp.transpose();
+    Mat6<float> hessSum = Mat6<float>::Zero();
     Mat3<float> rICOMoffsetMat = robotics::math::vectorToSkewMat(rICOMoffset);
     for (int i=0; i<N; ++i) {
-        Mat6<float> hess = Mat6<float>::Zero();
-        Mat3<float> AspTiMat = robotics::math::vectorToSkewMat(Vec3<float>(AspT.col(i)));
-        hess.block<3,3>(3,3) = (AspTiMat*rICOMoffsetMat + rICOMoffsetMat*AspTiMat) / 2;
-        hessVec.push_back(hess);
+        Mat3<float> AspTiMat = robotics::math::vectorToSkewMat(Vec3<float>(Asp.row(i).transpose()));
+        hessSum.block<3,3>(3,3) += Lambda(i) * (AspTiMat*rICOMoffsetMat + rICOMoffsetMat*AspTiMat) / 2;
     }
     
-    int n=0;
-    for (int i : validContactPointId) {
+    for (int n=0; n<N; ++n) {
+        int i = contactPointIds[n];
         Mat6<float> hess = Mat6<float>::Zero();
-        Vec3<float> gi = g[n];
+        Vec3<float> gi = g.col(n);
         float giNorm = gi.norm();
         Mat3<float> diffRMat = gi * gi.transpose();
         hess.block<3,3>(0,0) =  Mat3<float>::Identity() / giNorm -  diffRMat / pow(giNorm, 3);
@@ -373,26 +378,23 @@ std::vector<Mat6<float>> qrPosePlanner::ComputeHessianG()
         Mat3<float> DHi = ((rIBMat - rIFMat) * rIBHMat + rIBHMat * (rIBMat - rIFMat)) / 2.;
         Vec3<float> dGdPhi = - gi.transpose() * rIBHMat/giNorm;
         hess.block<3,3>(3,3) = (DHi/2.f - dGdPhi * dGdPhi.transpose())/giNorm;
-        hessVec.push_back(hess);
-        n++;
+        /* the maximum length constraint has the opposite Hessian of the minimum one. */
+        hessSum += (Lambda(N+n) - Lambda(2*N+n)) * hess;
     }
-    for (int i=0; i< N; ++i) {
-        hessVec.push_back(-hessVec[i+N]);
-    }
-    return hessVec;
+    return hessSum;
 }
 
 
-Eigen::MatrixXf qrPosePlanner::ComputeG()
+const qrPosePlanner::ConstraintVec &qrPosePlanner::ComputeG()
 {
-    G.conservativeResize(3*N, Eigen::NoChange);
-    Asp.conservativeResize(N, Eigen::NoChange);
-    bsp.conservativeResize(N, Eigen::NoChange);
+    G.resize(3*N, 1);
+    Asp.resize(N, 3);
+    bsp.resize(N, 1);
     // assuming this's a convex polygen
     if (N==3) {
-        Vec3<float> A = projectedSupportPolygonVertices[0];
-        Vec3<float> B = projectedSupportPolygonVertices[1];
-        Vec3<float> C = projectedSupportPolygonVertices[2];
+        Vec3<float> A = projectedSupportPolygonVertices.col(0);
+        Vec3<float> B = projectedSupportPolygonVertices.col(1);
+        Vec3<float> C = projectedSupportPolygonVertices.col(2);
         Vec3<float> O = (A+B+C) / 3.0;
         A = O + (1-eps) *(A-O);
         B = O + (1-eps) *(B-O);
@@ -407,10 +409,10 @@ Eigen::MatrixXf qrPosePlanner::ComputeG()
                C[0]*A[1]-A[0]*C[1];
     
     } else if (N==4) {
-        Vec3<float> A = projectedSupportPolygonVertices[0];
-        Vec3<float> B = projectedSupportPolygonVertices[1];
-        Vec3<float> C = projectedSupportPolygonVertices[2];
-        Vec3<float> D = projectedSupportPolygonVertices[3];
+        Vec3<float> A = projectedSupportPolygonVertices.col(0);
+        Vec3<float> B = projectedSupportPolygonVertices.col(1);
+        Vec3<float> C = projectedSupportPolygonVertices.col(2);
+        Vec3<float> D = projectedSupportPolygonVertices.col(3);
         Vec3<float> O = (A+B+C+D) / 4.0;
         A = O + (1-eps) *(A-O);
         B = O + (1-eps) *(B-O);
@@ -434,8 +436,7 @@ Eigen::MatrixXf qrPosePlanner::ComputeG()
     
     G.block(0,0, N,1) = Asp*(rIB + rICOMoffset) - bsp;
     for (int i=0; i<N; ++i) {
-        Vec3<float>& gi = g[i];
-        float giNorm = gi.norm();
+        float giNorm = g.col(i).norm();
         G(N+i, 0) = giNorm - lMin;
         G(2*N+i, 0) = lMax - giNorm;
     }
@@ -446,7 +447,8 @@ Eigen::MatrixXf qrPosePlanner::ComputeG()
 float qrPosePlanner::ComputeF()
 {
     float f=0;
-    for (int i : validContactPointId) {
+    for (int n=0; n<N; ++n) {
+        int i = contactPointIds[n];
         Vec3<float> r1 = rIB + robotics::math::TransformVecByQuat<float>(quat, rBF.col(i)) - rIF.col(i);
         f+= pow(r1.norm(),2);
     }
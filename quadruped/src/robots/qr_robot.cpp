@@ -27,7 +27,14 @@
 
 namespace Quadruped {
 
-qrRobot::qrRobot(): timer(useRosTime)
+qrRobot::qrRobot(): qrRobot(qrTimeSource::ROS_TIME)
+{
+}
+
+
+qrRobot::qrRobot(qrTimeSource timeSource):
+    useRosTime(timeSource == qrTimeSource::ROS_TIME),
+    timer(timeSource)
 {
     accFilter = qrMovingWindowFilter<float, 3>(5);
     gyroFilter = qrMovingWindowFilter<float, 3>(5);
@@ -59,6 +66,16 @@ void qrRobot::Reset()
 }
 
 
+void qrRobot::AdvanceTime(float dt)
+{
+    if (!timer.IsManualTime()) {
+        return;
+    }
+    double now = timer.AdvanceTime(dt);
+    tick = static_cast<uint32_t>(std::llround(now * 1000.0));
+}
+
+
 void qrRobot::UpdateDataFlow()
 {
     for (int legId=0; legId<NumLeg; ++legId) {
@@ -86,6 +103,45 @@ void qrRobot::ComputeMoment()
 }
 
 
+bool qrRobot::UpdateDynamicsModel()
+{
+    if (model._nDof == 0) {
+        return false;
+    }
+    if (modelState.q.size() != NumMotor) {
+        modelState.q = DVec<float>::Zero(NumMotor);
+        modelState.qd = DVec<float>::Zero(NumMotor);
+        modelEvaluated = false;
+    }
+
+    /* The velocity of the floating base is [angular; linear] in base frame. */
+    SVec<float> bodyVelocity;
+    bodyVelocity << baseRollPitchYawRate, baseVelocityInBaseFrame;
+    if (modelEvaluated
+        && modelState.bodyOrientation == baseOrientation
+        && modelState.bodyPosition == basePosition
+        && modelState.bodyVelocity == bodyVelocity
+        && modelState.q == motorAngles
+        && modelState.qd == motorVelocities) {
+        return false;
+    }
+
+    modelState.bodyOrientation = baseOrientation;
+    modelState.bodyPosition = basePosition;
+    modelState.bodyVelocity = bodyVelocity;
+    modelState.q = motorAngles;
+    modelState.qd = motorVelocities;
+
+    model.setState(modelState);
+    model.contactJacobians();
+    model.massMatrix();
+    model.generalizedGravityForce();
+    model.generalizedCoriolisForce();
+    modelEvaluated = true;
+    return true;
+}
+
+
 Vec3<float> qrRobot::WithLegSigns(const Vec3<float>& v, int leg_id)
 {
     switch (leg_id) {
@@ -238,16 +294,10 @@ Eigen::Matrix<float, 3, 3> qrRobot::ComputeJacobian(int leg_id)
 }
 
 
-std::map<int, float> qrRobot::MapContactForceToJointTorques(int leg_id, Vec3<float> contact_force)
+Vec3<float> qrRobot::MapContactForceToJointTorques(int leg_id, Vec3<float> contact_force)
 {
     const Eigen::Matrix<float, 3, 3>& jv = stateDataFlow.footJvs[leg_id];
-    Vec3<float> motorTorquesPerLeg = jv.transpose() * contact_force;
-    std::map<int, float> motorTorquesDict;
-    for (int torqueIndex = 0; torqueIndex < motorTorquesPerLeg.size(); torqueIndex++) {
-        int jointIndex = torqueIndex + leg_id * NumMotorOfOneLeg;
-        motorTorquesDict[jointIndex] = motorTorquesPerLeg[torqueIndex];
-    }
-    return motorTorquesDict;
+    return jv.transpose() * contact_force;
 }
 
 } // namespace Quadruped
@@ -0,0 +1,407 @@
+// The MIT License
+
+// Copyright (c) 2022
+// Robot Motion and Vision Laboratory at East China Normal University
+// Contact: tophill.robotics@gmail.com
+
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include "robots/qr_robot_headless_sim.h"
+
+
+namespace Quadruped {
+
+qrRobotHeadlessSim::qrRobotHeadlessSim(std::string configFilePath):
+    qrRobot(qrTimeSource::MANUAL_TIME)
+{
+    baseOrientation << 1.f, 0.f, 0.f, 0.f;
+    baseRollPitchYaw << 0.f, 0.f, 0.f;
+    baseRollPitchYawRate << 0.f, 0.f, 0.f;
+    motorVelocities = Eigen::Matrix<float, 12, 1>::Zero();
+    footForce << 0.f, 0.f, 0.f, 0.f;
+    footContact << 1, 1, 1, 1;
+
+    this->configFilePath = configFilePath;
+    robotConfig = YAML::LoadFile(configFilePath);
+
+    robotName = robotConfig["name"].as<std::string>();
+    isSim = true;
+    totalMass = robotConfig["robot_params"]["total_mass"].as<float>();
+    bodyMass = robotConfig["robot_params"]["body_mass"].as<float>();
+
+    std::vector<float> totalInertiaVec = robotConfig["robot_params"]["total_inertia"].as<std::vector<float >>();
+    totalInertia = Eigen::MatrixXf::Map(&totalInertiaVec[0], 3, 3);
+    std::vector<float> bodyInertiaVec = robotConfig["robot_params"]["body_inertia"].as<std::vector<float >>();
+    bodyInertia = Eigen::MatrixXf::Map(&bodyInertiaVec[0], 3, 3);
+
+    std::vector<std::vector<float>> inertias = robotConfig["robot_params"]["links_inertia"].as<std::vector<std::vector<float>>>();
+    std::vector<float> masses = robotConfig["robot_params"]["links_mass"].as<std::vector<float>>();
+    std::vector<std::vector<float>> linksComPos_ = robotConfig["robot_params"]["links_com_pos"].as<std::vector<std::vector<float>>>();
+
+    for (int legId = 0; legId < NumLeg; ++legId) {
+        for (int linkId = 0; linkId < 3; ++linkId) {
+            Mat3<float> inertia = Eigen::MatrixXf::Map(&inertias[linkId][0], 3, 3);
+            linkInertias.push_back(inertia);
+            linkMasses.push_back(masses[linkId]);
+            linksComPos.push_back(linksComPos_[linkId]);
+        }
+    }
+
+    bodyHeight = robotConfig["robot_params"]["body_height"].as<float>();
+    std::vector<float> abadLocation_ = robotConfig["robot_params"]["abad_location"].as<std::vector<float>>();
+    abadLocation = Eigen::MatrixXf::Map(&abadLocation_[0], 3, 1);
+    hipLength = robotConfig["robot_params"]["hip_l"].as<float>();
+    upperLegLength = robotConfig["robot_params"]["upper_l"].as<float>();
+    lowerLegLength = robotConfig["robot_params"]["lower_l"].as<float>();
+
+    std::vector<std::vector<float>> defaultHipPositionList =
+        robotConfig["robot_params"]["default_hip_positions"].as<std::vector<std::vector<float>>>();
+    Eigen::Matrix<float, 3, 1> defaultHipPositionFR = Eigen::MatrixXf::Map(&defaultHipPositionList[0][0], 3, 1);
+    Eigen::Matrix<float, 3, 1> defaultHipPositionFL = Eigen::MatrixXf::Map(&defaultHipPositionList[1][0], 3, 1);
+    Eigen::Matrix<float, 3, 1> defaultHipPositionRL = Eigen::MatrixXf::Map(&defaultHipPositionList[2][0], 3, 1);
+    Eigen::Matrix<float, 3, 1> defaultHipPositionRR = Eigen::MatrixXf::Map(&defaultHipPositionList[3][0], 3, 1);
+    defaultHipPosition << defaultHipPositionFR, defaultHipPositionFL, defaultHipPositionRL, defaultHipPositionRR;
+
+    float abadKp, abadKd, hipKp, hipKd, kneeKp, kneeKd;
+    abadKp = robotConfig["motor_params"]["abad_p"].as<float>();
+    abadKd = robotConfig["motor_params"]["abad_d"].as<float>();
+    hipKp = robotConfig["motor_params"]["hip_p"].as<float>();
+    hipKd = robotConfig["motor_params"]["hip_d"].as<float>();
+    kneeKp = robotConfig["motor_params"]["knee_p"].as<float>();
+    kneeKd = robotConfig["motor_params"]["knee_d"].as<float>();
+    Eigen::Matrix<float, 3, 1> kps(abadKp, hipKp, kneeKp);
+    Eigen::Matrix<float, 3, 1> kds(abadKd, hipKd, kneeKd);
+    motorKps << kps, kps, kps, kps;
+    motorKds << kds, kds, kds, kds;
+
+    std::vector<float>
+        jointDirectionList = robotConfig["motor_params"]["joint_directions"].as<std::vector<float >>();
+    std::vector<float>
+        jointOffsetList = robotConfig["motor_params"]["joint_offsets"].as<std::vector<float >>();
+    jointDirection = Eigen::MatrixXf::Map(&jointDirectionList[0], 12, 1);
+    jointOffset = Eigen::MatrixXf::Map(&jointOffsetList[0], 12, 1);
+
+    float standUpAbAngle, standUpHipAngle, standUpKneeAngle;
+    standUpAbAngle = 0.f;
+    standUpHipAngle = std::acos(bodyHeight / 2.f / upperLegLength);
+    standUpKneeAngle = -2.f * standUpHipAngle;
+    Eigen::Matrix<float, 3, 1> defaultStandUpAngle(standUpAbAngle, standUpHipAngle, standUpKneeAngle);
+    standUpMotorAngles << defaultStandUpAngle, defaultStandUpAngle, defaultStandUpAngle, defaultStandUpAngle;
+
+    float sitDownAbAngle, sitDownHipAngle, sitDownKneeAngle;
+    sitDownAbAngle = robotConfig["robot_params"]["default_sitdown_angle"]["ab"].as<float>();
+    sitDownHipAngle = robotConfig["robot_params"]["default_sitdown_angle"]["hip"].as<float>();
+    sitDownKneeAngle = robotConfig["robot_params"]["default_sitdown_angle"]["knee"].as<float>();
+    Eigen::Matrix<float, 3, 1> defaultSitDownAngle(sitDownAbAngle, sitDownHipAngle, sitDownKneeAngle);
+    sitDownMotorAngles << defaultSitDownAngle, defaultSitDownAngle, defaultSitDownAngle, defaultSitDownAngle;
+
+    /* The parameters of the simulation are optional, the gazebo config files work as they are. */
+    if (robotConfig["sim_params"]) {
+        YAML::Node simParams = robotConfig["sim_params"];
+        simTimeStep = simParams["time_step"].as<float>(simTimeStep);
+        groundK = simParams["ground_k"].as<float>(groundK);
+        groundD = simParams["ground_d"].as<float>(groundD);
+        groundKt = simParams["ground_kt"].as<float>(groundKt);
+        groundDt = simParams["ground_dt"].as<float>(groundDt);
+        groundMu = simParams["ground_mu"].as<float>(groundMu);
+        maxTorque = simParams["max_torque"].as<float>(maxTorque);
+    }
+
+    controlParams["mode"] = robotConfig["controller_params"]["mode"].as<int>();
+    Reset(); // reset com_offset
+
+    timeStep = 0.001f;
+    BuildFloatingBaseModel(simModel);
+    ResetSimulation();
+
+    this->ResetTimer();
+    lastResetTime = GetTimeSinceReset();
+    initComplete = true;
+    std::cout << "-------HeadlessSim init Complete-------" << std::endl;
+}
+
+
+void qrRobotHeadlessSim::BuildFloatingBaseModel(FloatingBaseModel<float> &fbModel)
+{
+    std::vector<float> bodySize = robotConfig["robot_params"]["body_size"].as<std::vector<float>>(); // Length, Width, Height
+    Vec3<float> bodyDims(bodySize[0], bodySize[1], bodySize[2]);
+
+    Mat3<float> I3 = Mat3<float>::Identity();
+    Vec3<float> zero3 = Vec3<float>::Zero();
+
+    /* The rotors are not simulated, they are given a negligible inertia as in qrRobotA1Sim. */
+    SpatialInertia<float> rotorInertia(1e-8f, zero3, 1e-8f * I3);
+
+    SpatialInertia<float> baseInertia(bodyMass, zero3, bodyInertia);
+    fbModel.addBase(baseInertia);
+    // add contact for the robot's body
+    fbModel.addGroundContactBoxPoints(5, bodyDims);
+
+    const int baseID = 5;
+    int bodyID = baseID;
+    Vec3<float> hipLocation(0.f, hipLength, 0.f);
+    Vec3<float> kneeLocation(0.f, 0.f, -upperLegLength);
+
+    for (int legId = 0; legId < NumLeg; ++legId) {
+        /* The inertias in the config file are the ones of the left legs. */
+        bool isRightLeg = (legId == 0 || legId == 2);
+        SpatialInertia<float> linkInertia[3];
+        for (int linkId = 0; linkId < 3; ++linkId) {
+            int k = 3 * legId + linkId;
+            Vec3<float> com(linksComPos[k][0], linksComPos[k][1], linksComPos[k][2]);
+            linkInertia[linkId] = SpatialInertia<float>(linkMasses[k], com, linkInertias[k]);
+            if (isRightLeg) {
+                linkInertia[linkId] = linkInertia[linkId].flipAlongAxis(CoordinateAxis::Y);
+            }
+        }
+
+        // Ab/Ad joint
+        bodyID++;
+        Mat6<float> xtreeAbad = createSXform(I3, WithLegSigns(abadLocation, legId));
+        fbModel.addBody(linkInertia[0], rotorInertia, 1.f, baseID, JointType::Revolute,
+                        CoordinateAxis::X, xtreeAbad, xtreeAbad);
+
+        // Hip joint
+        bodyID++;
+        Mat6<float> xtreeHip = createSXform(I3, WithLegSigns(hipLocation, legId));
+        fbModel.addBody(linkInertia[1], rotorInertia, 1.f, bodyID - 1, JointType::Revolute,
+                        CoordinateAxis::Y, xtreeHip, xtreeHip);
+
+        // add knee ground contact point
+        fbModel.addGroundContactPoint(bodyID, kneeLocation);
+
+        // Knee joint
+        bodyID++;
+        Mat6<float> xtreeKnee = createSXform(I3, kneeLocation);
+        fbModel.addBody(linkInertia[2], rotorInertia, 1.f, bodyID - 1, JointType::Revolute,
+                        CoordinateAxis::Y, xtreeKnee, xtreeKnee);
+
+        // add foot
+        fbModel.addGroundContactPoint(bodyID, Vec3<float>(0.f, 0.f, -lowerLegLength), true);
+    }
+
+    Vec3<float> g(0.f, 0.f, -9.81f);
+    fbModel.setGravity(g);
+}
+
+
+bool qrRobotHeadlessSim::BuildDynamicModel()
+{
+    BuildFloatingBaseModel(model);
+    return true;
+}
+
+
+void qrRobotHeadlessSim::ResetSimulation()
+{
+    /* Lie on the ground with the legs folded, as the robots do before standing up. */
+    Mat34<float> footPositions = FootPositionsInBaseFrame(sitDownMotorAngles);
+    float baseHeight = -footPositions.row(2).minCoeff() + 0.01f;
+
+    simState.bodyOrientation << 1.f, 0.f, 0.f, 0.f;
+    simState.bodyPosition << 0.f, 0.f, baseHeight;
+    simState.bodyVelocity.setZero();
+    simState.q = sitDownMotorAngles;
+    simState.qd = DVec<float>::Zero(NumMotor);
+
+    simStateDerivative.dBodyPosition.setZero();
+    simStateDerivative.dBodyVelocity.setZero();
+    simStateDerivative.qdd = DVec<float>::Zero(NumMotor);
+
+    motorCommand.setZero();
+    jointTorques = DVec<float>::Zero(NumMotor);
+
+    contactForces.assign(simModel._nGroundContact, Vec3<float>::Zero());
+    contactAnchors.assign(simModel._nGroundContact, Vec3<float>::Zero());
+    contactActive.assign(simModel._nGroundContact, false);
+
+    simTime = 0.0;
+}
+
+
+void qrRobotHeadlessSim::ComputeGroundForces()
+{
+    for (size_t i = 0; i < simModel._nGroundContact; ++i) {
+        const Vec3<float> &p = simModel._pGC[i];
+        const Vec3<float> &v = simModel._vGC[i];
+        Vec3<float> &f = contactForces[i];
+        if (p[2] >= 0.f) {
+            contactActive[i] = false;
+            f.setZero();
+            continue;
+        }
+        if (!contactActive[i]) {
+            /* Touchdown, the tangential spring is anchored where the point enters the ground. */
+            contactAnchors[i] << p[0], p[1], 0.f;
+            contactActive[i] = true;
+        }
+
+        f[2] = std::max(0.f, -groundK * p[2] - groundD * v[2]);
+        Vec2<float> ft = -groundKt * (p.head<2>() - contactAnchors[i].head<2>()) - groundDt * v.head<2>();
+        float ftMax = groundMu * f[2];
+        float ftNorm = ft.norm();
+        if (ftNorm > ftMax) {
+            /* Slipping, the force is on the friction cone and the anchor follows the point. */
+            ft *= ftMax / ftNorm;
+            contactAnchors[i].head<2>() = p.head<2>() + ft / groundKt;
+        }
+        f.head<2>() = ft;
+
+        simModel._externalForces[simModel._gcParent[i]] += forceToSpatialForce(f, p);
+    }
+}
+
+
+void qrRobotHeadlessSim::ComputeMotorTorques()
+{
+    for (int motorId = 0; motorId < NumMotor; ++motorId) {
+        float tau = motorCommand(KP, motorId) * (motorCommand(POSITION, motorId) - simState.q[motorId])
+                    + motorCommand(KD, motorId) * (motorCommand(VELOCITY, motorId) - simState.qd[motorId])
+                    + motorCommand(TORQUE, motorId);
+        jointTorques[motorId] = std::min(std::max(tau, -maxTorque), maxTorque);
+    }
+}
+
+
+void qrRobotHeadlessSim::Integrate(float dt)
+{
+    simModel.setState(simState);
+    simModel.resetExternalForces();
+    simModel.forwardKinematics();
+    ComputeGroundForces();
+    ComputeMotorTorques();
+    simModel.runABA(jointTorques, simStateDerivative);
+
+    /* Semi-implicit Euler, the positions are integrated with the updated velocities. */
+    simState.qd += simStateDerivative.qdd * dt;
+    simState.bodyVelocity += simStateDerivative.dBodyVelocity * dt;
+    simState.q += simState.qd * dt;
+
+    Mat3<float> R = robotics::math::quaternionToRotationMatrix(simState.bodyOrientation);
+    simState.bodyPosition += R.transpose() * simState.bodyVelocity.tail<3>() * dt;
+    Vec3<float> omegaWorld = R.transpose() * simState.bodyVelocity.head<3>();
+    simState.bodyOrientation = robotics::math::integrateQuat(simState.bodyOrientation, omegaWorld, dt);
+
+    simTime += dt;
+}
+
+
+void qrRobotHeadlessSim::Simulate(float duration)
+{
+    int steps = std::max(1, int(std::round(duration / simTimeStep)));
+    float dt = duration / steps;
+    for (int i = 0; i < steps; ++i) {
+        Integrate(dt);
+    }
+    /* The robot clock is the simulated time, the controllers never wait for the wall clock. */
+    AdvanceTime(duration);
+}
+
+
+void qrRobotHeadlessSim::ReceiveObservation()
+{
+    simModel.setState(simState);
+    simModel.forwardKinematics();
+
+    Mat3<float> R = robotics::math::quaternionToRotationMatrix(simState.bodyOrientation);
+    Vec3<float> omegaBody = simState.bodyVelocity.head<3>();
+    Vec3<float> vBody = simState.bodyVelocity.tail<3>();
+
+    /* The accelerometer measures the classical acceleration minus the gravity, in base frame. */
+    Vec3<float> g(0.f, 0.f, -9.81f);
+    baseAccInBaseFrame = simStateDerivative.dBodyVelocity.tail<3>() + omegaBody.cross(vBody) - R * g;
+    stateDataFlow.baseLinearAcceleration = accFilter.CalculateAverage(baseAccInBaseFrame);
+
+    baseOrientation = simState.bodyOrientation;
+    baseRollPitchYaw = robotics::math::quatToRPY(baseOrientation);
+    baseRollPitchYawRate = omegaBody;
+
+    for (int motorId = 0; motorId < NumMotor; ++motorId) {
+        motorAngles[motorId] = simState.q[motorId];
+        motorVelocities[motorId] = simState.qd[motorId];
+        motorddq[motorId] = simStateDerivative.qdd[motorId];
+        motortorque[motorId] = jointTorques[motorId];
+    }
+
+    for (int footId = 0; footId < NumLeg; footId++) {
+        size_t gcId = simModel._footIndicesGC[footId];
+        footForce[footId] = contactForces[gcId][2];
+        footContact[footId] = footForce[footId] >= 5;
+        gazeboFootPositionInWorldFrame.col(footId) = simModel._pGC[gcId];
+    }
+
+    gazeboBasePosition = simState.bodyPosition;
+    gazeboBaseOrientation = simState.bodyOrientation;
+    gazeboBaseVInBaseFrame = vBody;
+
+    UpdateDataFlow();
+}
+
+
+void qrRobotHeadlessSim::ApplyAction(const Eigen::MatrixXf &motorCommands, MotorMode motorControlMode)
+{
+    if (motorControlMode == POSITION_MODE) {
+        Eigen::Matrix<float, 1, 12> motorCommandsShaped = motorCommands.transpose();
+        motorCommand.row(POSITION) = motorCommandsShaped;
+        motorCommand.row(KP) = motorKps.transpose();
+        motorCommand.row(VELOCITY).setZero();
+        motorCommand.row(KD) = motorKds.transpose();
+        motorCommand.row(TORQUE).setZero();
+    } else if (motorControlMode == TORQUE_MODE) {
+        Eigen::Matrix<float, 1, 12> motorCommandsShaped = motorCommands.transpose();
+        motorCommand.setZero();
+        motorCommand.row(TORQUE) = motorCommandsShaped;
+    } else if (motorControlMode == HYBRID_MODE) {
+        motorCommand = motorCommands;
+    }
+
+    motorCommand = motorCommand.unaryExpr([](float x) { return std::isnan(x) ? 0.f : x; });
+    Simulate(timeStep);
+}
+
+
+void qrRobotHeadlessSim::ApplyAction(const std::vector<qrMotorCommand> &motorCommands, MotorMode motorControlMode)
+{
+    for (int motorId = 0; motorId < NumMotor; motorId++) {
+        motorCommand(POSITION, motorId) = motorCommands[motorId].p;
+        motorCommand(KP, motorId) = motorCommands[motorId].Kp;
+        motorCommand(VELOCITY, motorId) = motorCommands[motorId].d;
+        motorCommand(KD, motorId) = motorCommands[motorId].Kd;
+        motorCommand(TORQUE, motorId) = motorCommands[motorId].tua;
+    }
+
+    motorCommand = motorCommand.unaryExpr([](float x) { return std::isnan(x) ? 0.f : x; });
+    Simulate(timeStep);
+}
+
+
+void qrRobotHeadlessSim::Step(const Eigen::MatrixXf &action, MotorMode motorControlMode)
+{
+    ReceiveObservation();
+    ApplyAction(action, motorControlMode);
+}
+
+
+void qrRobotHeadlessSim::Step(const std::vector<qrMotorCommand> &motorCommands, MotorMode motorControlMode)
+{
+    ReceiveObservation();
+    ApplyAction(motorCommands, motorControlMode);
+}
+
+} // namespace Quadruped
@@ -167,8 +167,12 @@ qrRobotLite2::qrRobotLite2(std::string configFilePath)
 
 void qrRobotLite2::ReceiveObservation()
 {
-    RobotState& state = lite2Receiver.get_recv();
-    // lowState_lite2 = state;
+    uint64_t seq = lite2Receiver.get_recv(lowState_lite2);
+    if (seq == stateSeq) {
+        ++staleStateCount;
+    }
+    stateSeq = seq;
+    const RobotState& state = lowState_lite2;
 
     tick = state.tick;
     std::array<float, 3> rpy;
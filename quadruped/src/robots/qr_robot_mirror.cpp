@@ -0,0 +1,201 @@
+// The MIT License
+
+// Copyright (c) 2022
+// Robot Motion and Vision Laboratory at East China Normal University
+// Contact: tophill.robotics@gmail.com
+
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include "robots/qr_robot_mirror.h"
+
+
+namespace Quadruped {
+
+qrRobotMirror::qrRobotMirror(qrRobot *sourceIn):
+    qrRobot(sourceIn->robotName, sourceIn->configFilePath),
+    source(sourceIn)
+{
+    CopyParameters();
+    Pull();
+    std::cout << "[Robot Mirror] mirror of " << robotName << std::endl;
+}
+
+
+void qrRobotMirror::CopyParameters()
+{
+    robotConfig = source->robotConfig;
+    totalMass = source->totalMass;
+    bodyMass = source->bodyMass;
+    totalInertia = source->totalInertia;
+    bodyInertia = source->bodyInertia;
+    linkInertias = source->linkInertias;
+    linkMasses = source->linkMasses;
+    linkLength = source->linkLength;
+    linksComPos = source->linksComPos;
+    bodyHeight = source->bodyHeight;
+    abadLocation = source->abadLocation;
+    hipLength = source->hipLength;
+    upperLegLength = source->upperLegLength;
+    lowerLegLength = source->lowerLegLength;
+    footHoldOffset = source->footHoldOffset;
+    comOffset = source->comOffset;
+    hipOffset = source->hipOffset;
+    defaultHipPosition = source->defaultHipPosition;
+    motorKps = source->motorKps;
+    motorKds = source->motorKds;
+    jointDirection = source->jointDirection;
+    jointOffset = source->jointOffset;
+    standUpMotorAngles = source->standUpMotorAngles;
+    sitDownMotorAngles = source->sitDownMotorAngles;
+    controlParams = source->controlParams;
+    useRosTime = source->useRosTime;
+    timeStep = source->timeStep;
+    isSim = source->isSim;
+    model = source->model;
+}
+
+
+void qrRobotMirror::Pull()
+{
+    /* Observation. */
+    tick = source->tick;
+    timer.FollowTime(source->timer);
+    lowState = source->lowState;
+    motorAngles = source->motorAngles;
+    motorVelocities = source->motorVelocities;
+    motorddq = source->motorddq;
+    motortorque = source->motortorque;
+    baseOrientation = source->baseOrientation;
+    baseRollPitchYaw = source->baseRollPitchYaw;
+    baseRollPitchYawRate = source->baseRollPitchYawRate;
+    baseAccInBaseFrame = source->baseAccInBaseFrame;
+    footForce = source->footForce;
+    gazeboBasePosition = source->gazeboBasePosition;
+    gazeboBaseOrientation = source->gazeboBaseOrientation;
+    gazeboBaseVInBaseFrame = source->gazeboBaseVInBaseFrame;
+    gazeboFootPositionInWorldFrame = source->gazeboFootPositionInWorldFrame;
+    yawOffset = source->yawOffset;
+    lastResetTime = source->lastResetTime;
+    initComplete = source->initComplete;
+
+    /* Estimation. */
+    footContact = source->footContact;
+    basePosition = source->basePosition;
+    absoluteHight = source->absoluteHight;
+    baseVelocityInBaseFrame = source->baseVelocityInBaseFrame;
+    footHoldOffset = source->footHoldOffset;
+
+    /* The visualizer and the WBC data belong to the control stage, so they are not copied. */
+    const qrStateDataFlow &flow = source->stateDataFlow;
+    stateDataFlow.footPositionsInBaseFrame = flow.footPositionsInBaseFrame;
+    stateDataFlow.footVelocitiesInBaseFrame = flow.footVelocitiesInBaseFrame;
+    stateDataFlow.baseVInWorldFrame = flow.baseVInWorldFrame;
+    stateDataFlow.baseWInWorldFrame = flow.baseWInWorldFrame;
+    stateDataFlow.baseLinearAcceleration = flow.baseLinearAcceleration;
+    for (int legId = 0; legId < NumLeg; ++legId) {
+        stateDataFlow.footJvs[legId] = flow.footJvs[legId];
+    }
+    stateDataFlow.estimatedFootForce = flow.estimatedFootForce;
+    stateDataFlow.estimatedMoment = flow.estimatedMoment;
+    stateDataFlow.heightInControlFrame = flow.heightInControlFrame;
+    stateDataFlow.zmp = flow.zmp;
+    stateDataFlow.baseRMat = flow.baseRMat;
+    stateDataFlow.groundRMat = flow.groundRMat;
+    stateDataFlow.baseRInControlFrame = flow.baseRInControlFrame;
+    stateDataFlow.groundOrientation = flow.groundOrientation;
+}
+
+
+void qrRobotMirror::Push()
+{
+    source->controlParams = controlParams;
+    source->timeStep = timeStep;
+    source->fsmMode = fsmMode;
+    source->stop = stop;
+}
+
+
+void qrRobotMirror::Sync()
+{
+    if (syncHook) {
+        syncHook();
+    }
+    Push();
+}
+
+
+void qrRobotMirror::Reset()
+{
+    Sync();
+    source->Reset();
+    comOffset = source->comOffset;
+    hipOffset = source->hipOffset;
+    Pull();
+}
+
+
+bool qrRobotMirror::BuildDynamicModel()
+{
+    Sync();
+    if (source->model._nDof == 0 && !source->BuildDynamicModel()) {
+        return false;
+    }
+    model = source->model;
+    return true;
+}
+
+
+void qrRobotMirror::ReceiveObservation()
+{
+    Sync();
+    source->ReceiveObservation();
+    Pull();
+}
+
+
+void qrRobotMirror::ApplyAction(const Eigen::MatrixXf &motorCommands, MotorMode motorControlMode)
+{
+    Sync();
+    source->ApplyAction(motorCommands, motorControlMode);
+}
+
+
+void qrRobotMirror::ApplyAction(const std::vector<qrMotorCommand> &motorCommands, MotorMode motorControlMode)
+{
+    Sync();
+    source->ApplyAction(motorCommands, motorControlMode);
+}
+
+
+void qrRobotMirror::Step(const Eigen::MatrixXf &action, MotorMode motorControlMode)
+{
+    Sync();
+    source->Step(action, motorControlMode);
+    Pull();
+}
+
+
+void qrRobotMirror::Step(const std::vector<qrMotorCommand> &motorCommands, MotorMode motorControlMode)
+{
+    Sync();
+    source->Step(motorCommands, motorControlMode);
+    Pull();
+}
+
+} // Namespace Quadruped
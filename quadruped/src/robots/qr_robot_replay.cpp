@@ -0,0 +1,90 @@
+// The MIT License
+
+// Copyright (c) 2022
+// Robot Motion and Vision Laboratory at East China Normal University
+// Contact: tophill.robotics@gmail.com
+
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include "robots/qr_robot_replay.h"
+
+
+namespace Quadruped {
+
+qrRobotReplay::qrRobotReplay(std::string configFilePath):
+    qrRobotHeadlessSim(configFilePath)
+{
+    /* The controllers take other branches on a real robot, so follow the robot that recorded the log. */
+    isSim = robotConfig["is_sim"].as<bool>(isSim);
+    lastCommand.setZero();
+}
+
+
+void qrRobotReplay::LoadRecord(const qrFlightRecord &record)
+{
+    baseAccInBaseFrame = Eigen::Map<const Vec3<float>>(record.accelerometer);
+    stateDataFlow.baseLinearAcceleration = accFilter.CalculateAverage(baseAccInBaseFrame);
+
+    baseRollPitchYaw = Eigen::Map<const Vec3<float>>(record.rpy);
+    baseOrientation = robotics::math::rpyToQuat(baseRollPitchYaw);
+    baseRollPitchYawRate = Eigen::Map<const Vec3<float>>(record.gyro);
+
+    motorAngles = Eigen::Map<const Vec12<float>>(record.motorAngles);
+    motorVelocities = Eigen::Map<const Vec12<float>>(record.motorVelocities);
+    motorddq = Eigen::Map<const Vec12<float>>(record.motorAccelerations);
+    motortorque = Eigen::Map<const Vec12<float>>(record.motorTorques);
+
+    footForce = Eigen::Map<const Vec4<float>>(record.footForces);
+    footContact = Eigen::Map<const Vec4<float>>(record.footContacts).array() > 0.5f;
+
+    /* In simulation the pose estimator reads the true horizontal position, which it has recorded as is. */
+    gazeboBasePosition = Eigen::Map<const Vec3<float>>(record.basePosition);
+
+    UpdateDataFlow();
+}
+
+
+void qrRobotReplay::ReceiveObservation()
+{
+}
+
+
+void qrRobotReplay::ApplyAction(const Eigen::MatrixXf &motorCommands, MotorMode motorControlMode)
+{
+    if (motorControlMode == POSITION_MODE) {
+        lastCommand.setZero();
+        lastCommand.row(POSITION) = motorCommands.transpose();
+        lastCommand.row(KP) = motorKps.transpose();
+        lastCommand.row(KD) = motorKds.transpose();
+    } else if (motorControlMode == TORQUE_MODE) {
+        lastCommand.setZero();
+        lastCommand.row(TORQUE) = motorCommands.transpose();
+    } else if (motorControlMode == HYBRID_MODE) {
+        lastCommand = motorCommands;
+    }
+    AdvanceTime(timeStep);
+}
+
+
+void qrRobotReplay::ApplyAction(const std::vector<qrMotorCommand> &motorCommands, MotorMode motorControlMode)
+{
+    ApplyAction(qrMotorCommand::convertToMatix(motorCommands), HYBRID_MODE);
+}
+
+} // namespace Quadruped
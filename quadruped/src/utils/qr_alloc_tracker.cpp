@@ -0,0 +1,206 @@
+// The MIT License
+
+// Copyright (c) 2022
+// Robot Motion and Vision Laboratory at East China Normal University
+// Contact: tophill.robotics@gmail.com
+
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include "utils/qr_alloc_tracker.h"
+#include "utils/qr_solver_arena.h"
+
+#ifdef QR_TRACK_ALLOCATION
+
+#include <atomic>
+#include <errno.h>
+#include <execinfo.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <unistd.h>
+
+/* glibc entry points of the real allocator. */
+extern "C" {
+void *__libc_malloc(size_t size);
+void *__libc_calloc(size_t num, size_t size);
+void *__libc_realloc(void *ptr, size_t size);
+void *__libc_memalign(size_t alignment, size_t size);
+void __libc_free(void *ptr);
+}
+
+namespace {
+
+/* initial-exec TLS never allocates on access, which would recurse into malloc. */
+#define QR_TLS static __thread __attribute__((tls_model("initial-exec")))
+
+QR_TLS bool armed = false;
+QR_TLS bool inHook = false;
+QR_TLS size_t allocations = 0;
+QR_TLS size_t bytes = 0;
+QR_TLS size_t arenaAllocations = 0;
+
+std::atomic<int> allocPolicy(Quadruped::ALLOC_COUNT);
+
+void OnAllocate(size_t size)
+{
+    if (!armed || inHook) {
+        return;
+    }
+    inHook = true;
+    ++allocations;
+    bytes += size;
+    int policy = allocPolicy.load(std::memory_order_relaxed);
+    if (allocations == 1 && policy != Quadruped::ALLOC_COUNT) {
+        /* backtrace_symbols_fd writes straight to the fd without allocating. */
+        void *frames[32];
+        int depth = backtrace(frames, 32);
+        dprintf(STDERR_FILENO, "[AllocTracker] allocation of %zu bytes in control tick:\n", size);
+        backtrace_symbols_fd(frames, depth, STDERR_FILENO);
+        if (policy == Quadruped::ALLOC_ABORT) {
+            abort();
+        }
+    }
+    inHook = false;
+}
+
+} // namespace
+
+
+extern "C" {
+
+void *malloc(size_t size)
+{
+    OnAllocate(size);
+    return __libc_malloc(size);
+}
+
+
+void *calloc(size_t num, size_t size)
+{
+    OnAllocate(num * size);
+    return __libc_calloc(num, size);
+}
+
+
+void *realloc(void *ptr, size_t size)
+{
+    OnAllocate(size);
+    return __libc_realloc(ptr, size);
+}
+
+
+void *memalign(size_t alignment, size_t size)
+{
+    OnAllocate(size);
+    return __libc_memalign(alignment, size);
+}
+
+
+void *aligned_alloc(size_t alignment, size_t size)
+{
+    OnAllocate(size);
+    return __libc_memalign(alignment, size);
+}
+
+
+int posix_memalign(void **ptr, size_t alignment, size_t size)
+{
+    OnAllocate(size);
+    void *p = __libc_memalign(alignment, size);
+    if (p == nullptr) {
+        return ENOMEM;
+    }
+    *ptr = p;
+    return 0;
+}
+
+
+void free(void *ptr)
+{
+    __libc_free(ptr);
+}
+
+} // extern "C"
+
+
+namespace Quadruped {
+
+bool qrAllocTracker::Enabled()
+{
+    return true;
+}
+
+
+void qrAllocTracker::SetPolicy(AllocPolicy policy)
+{
+    /* The first backtrace() call loads libgcc and allocates, do it outside of any tick. */
+    void *frame;
+    backtrace(&frame, 1);
+    allocPolicy.store(policy);
+}
+
+
+void qrAllocTracker::BeginTick()
+{
+    allocations = 0;
+    bytes = 0;
+    arenaAllocations = qrSolverArena::Allocations();
+    armed = true;
+}
+
+
+qrAllocStats qrAllocTracker::EndTick()
+{
+    armed = false;
+    qrAllocStats stats;
+    stats.allocations = allocations;
+    stats.bytes = bytes;
+    stats.solverAllocations = qrSolverArena::Allocations() - arenaAllocations;
+    return stats;
+}
+
+} // Namespace Quadruped
+
+#else
+
+namespace Quadruped {
+
+bool qrAllocTracker::Enabled()
+{
+    return false;
+}
+
+
+void qrAllocTracker::SetPolicy(AllocPolicy)
+{
+}
+
+
+void qrAllocTracker::BeginTick()
+{
+}
+
+
+qrAllocStats qrAllocTracker::EndTick()
+{
+    return qrAllocStats();
+}
+
+} // Namespace Quadruped
+
+#endif // QR_TRACK_ALLOCATION
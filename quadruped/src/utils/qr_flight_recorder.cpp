@@ -0,0 +1,357 @@
+// The MIT License
+
+// Copyright (c) 2022
+// Robot Motion and Vision Laboratory at East China Normal University
+// Contact: tophill.robotics@gmail.com
+
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include "utils/qr_flight_recorder.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <cstring>
+#include <fcntl.h>
+#include <stdexcept>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <type_traits>
+#include <unistd.h>
+
+
+namespace {
+
+/**
+ * @brief Identifies a flight recorder file.
+ */
+const char FILE_MAGIC[8] = {'Q', 'R', 'F', 'L', 'I', 'G', 'H', 'T'};
+
+/**
+ * @brief Identifies the start of a chunk.
+ */
+const uint32_t CHUNK_MAGIC = 0x4b4e4843;
+
+/**
+ * @brief Version of the file layout, not of the record schema, which is stored in the file.
+ */
+const uint32_t FILE_VERSION = 1;
+
+/**
+ * @brief Bytes reserved for the chunk header, keeps the records cache line aligned.
+ */
+const size_t CHUNK_HEADER_SIZE = 64;
+
+/**
+ * @brief Start of the file, followed by %fieldCount qrFlightField.
+ */
+struct qrFlightFileHeader {
+    char magic[8];
+    uint32_t version;
+    uint32_t recordSize;
+    uint32_t recordsPerChunk;
+    uint32_t fieldCount;
+    uint64_t dataOffset;
+    uint64_t chunkSize;
+};
+
+/**
+ * @brief Start of each chunk.
+ */
+struct qrFlightChunkHeader {
+    uint32_t magic;
+    uint32_t records;
+};
+
+} // Anonymous namespace
+
+
+namespace Quadruped {
+
+const std::vector<qrFlightField> &qrFlightRecorder::GetFields()
+{
+    static const std::vector<qrFlightField> fields = []() {
+        std::vector<qrFlightField> list;
+#define QR_FLIGHT_RECORD_DESCRIPTOR(valueType, member, valueCount)                      \
+        {                                                                              \
+            qrFlightField field = {};                                                  \
+            strncpy(field.name, #member, sizeof(field.name) - 1);                      \
+            field.offset = offsetof(qrFlightRecord, member);                           \
+            field.count = valueCount;                                                  \
+            field.type = std::is_same<valueType, uint32_t>::value ? 1 : 0;             \
+            list.push_back(field);                                                     \
+        }
+        QR_FLIGHT_RECORD_FIELDS(QR_FLIGHT_RECORD_DESCRIPTOR)
+#undef QR_FLIGHT_RECORD_DESCRIPTOR
+        return list;
+    }();
+    return fields;
+}
+
+
+qrFlightRecorder::qrFlightRecorder(const std::string &path, unsigned int capacity, unsigned int recordsPerChunkIn):
+    ring(std::max(1u, capacity)),
+    head(0),
+    tail(0),
+    dropped(0),
+    fd(-1),
+    recordsPerChunk(std::max(1u, recordsPerChunkIn)),
+    dataOffset(0),
+    chunkSize(0),
+    chunkCount(0),
+    chunk(nullptr),
+    chunkRecords(0),
+    running(true)
+{
+    fd = open(path.c_str(), O_RDWR | O_CREAT | O_TRUNC, 0644);
+    if (fd < 0) {
+        throw std::runtime_error("cannot open flight recorder file " + path);
+    }
+
+    /* The chunks are mapped one by one, so they start at multiples of the page size. */
+    const size_t page = sysconf(_SC_PAGESIZE);
+    const std::vector<qrFlightField> &fields = GetFields();
+    size_t headerSize = sizeof(qrFlightFileHeader) + fields.size() * sizeof(qrFlightField);
+    dataOffset = (headerSize + page - 1) / page * page;
+    chunkSize = (CHUNK_HEADER_SIZE + recordsPerChunk * sizeof(qrFlightRecord) + page - 1) / page * page;
+
+    std::vector<char> buffer(dataOffset, 0);
+    qrFlightFileHeader header;
+    memcpy(header.magic, FILE_MAGIC, sizeof(header.magic));
+    header.version = FILE_VERSION;
+    header.recordSize = sizeof(qrFlightRecord);
+    header.recordsPerChunk = recordsPerChunk;
+    header.fieldCount = fields.size();
+    header.dataOffset = dataOffset;
+    header.chunkSize = chunkSize;
+    memcpy(buffer.data(), &header, sizeof(header));
+    memcpy(buffer.data() + sizeof(header), fields.data(), fields.size() * sizeof(qrFlightField));
+    if (pwrite(fd, buffer.data(), buffer.size(), 0) != static_cast<ssize_t>(buffer.size())) {
+        close(fd);
+        throw std::runtime_error("cannot write flight recorder file " + path);
+    }
+
+    thread = std::thread(&qrFlightRecorder::Run, this);
+}
+
+
+qrFlightRecorder::~qrFlightRecorder()
+{
+    running.store(false, std::memory_order_release);
+    thread.join();
+    if (chunk) {
+        munmap(chunk, chunkSize);
+    }
+    close(fd);
+    if (dropped > 0) {
+        printf("[FlightRecorder] %lu records dropped, consider a larger flightRecorderCapacity\n", dropped);
+    }
+}
+
+
+void qrFlightRecorder::Run()
+{
+    while (running.load(std::memory_order_acquire)) {
+        if (!Flush()) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        }
+    }
+    while (Flush()) {}
+}
+
+
+bool qrFlightRecorder::Flush()
+{
+    unsigned long t = tail.load(std::memory_order_relaxed);
+    const unsigned long h = head.load(std::memory_order_acquire);
+    if (t == h) {
+        return false;
+    }
+
+    while (t < h) {
+        if (!chunk || chunkRecords == recordsPerChunk) {
+            NextChunk();
+            if (!chunk) {
+                /* The file cannot grow, discard the records so the control thread is not blocked. */
+                tail.store(h, std::memory_order_release);
+                return true;
+            }
+        }
+        /* Copy the longest run that is contiguous in both the ring and the chunk. */
+        size_t slot = t % ring.size();
+        size_t n = std::min<size_t>({h - t, recordsPerChunk - chunkRecords, ring.size() - slot});
+        memcpy(chunk + CHUNK_HEADER_SIZE + chunkRecords * sizeof(qrFlightRecord), &ring[slot],
+               n * sizeof(qrFlightRecord));
+        chunkRecords += n;
+        t += n;
+        reinterpret_cast<qrFlightChunkHeader *>(chunk)->records = chunkRecords;
+        tail.store(t, std::memory_order_release);
+    }
+    return true;
+}
+
+
+void qrFlightRecorder::NextChunk()
+{
+    if (chunk) {
+        munmap(chunk, chunkSize);
+        chunk = nullptr;
+    }
+
+    off_t offset = dataOffset + chunkCount * chunkSize;
+    if (ftruncate(fd, offset + chunkSize) != 0) {
+        fprintf(stderr, "[FlightRecorder] cannot grow the file, records are discarded\n");
+        return;
+    }
+    void *mapped = mmap(nullptr, chunkSize, PROT_READ | PROT_WRITE, MAP_SHARED, fd, offset);
+    if (mapped == MAP_FAILED) {
+        fprintf(stderr, "[FlightRecorder] cannot map the file, records are discarded\n");
+        return;
+    }
+    chunk = static_cast<char *>(mapped);
+    ++chunkCount;
+    chunkRecords = 0;
+
+    qrFlightChunkHeader chunkHeader = {CHUNK_MAGIC, 0};
+    memcpy(chunk, &chunkHeader, sizeof(chunkHeader));
+}
+
+
+qrFlightLog::qrFlightLog(const std::string &path):
+    data(nullptr),
+    size(0)
+{
+    int fd = open(path.c_str(), O_RDONLY);
+    if (fd < 0) {
+        throw std::runtime_error("cannot open flight log " + path);
+    }
+    struct stat info;
+    if (fstat(fd, &info) != 0 || info.st_size < static_cast<off_t>(sizeof(qrFlightFileHeader))) {
+        close(fd);
+        throw std::runtime_error("flight log " + path + " is too short");
+    }
+    size = info.st_size;
+    void *mapped = mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd);
+    if (mapped == MAP_FAILED) {
+        throw std::runtime_error("cannot map flight log " + path);
+    }
+    data = static_cast<const char *>(mapped);
+
+    qrFlightFileHeader header;
+    memcpy(&header, data, sizeof(header));
+    if (memcmp(header.magic, FILE_MAGIC, sizeof(FILE_MAGIC)) != 0 || header.version != FILE_VERSION
+        || sizeof(header) + header.fieldCount * sizeof(qrFlightField) > size) {
+        munmap(const_cast<char *>(data), size);
+        throw std::runtime_error(path + " is not a flight log");
+    }
+    fields.resize(header.fieldCount);
+    memcpy(fields.data(), data + sizeof(header), header.fieldCount * sizeof(qrFlightField));
+
+    /* Walk the chunks, the last one may be partly filled or cut short. */
+    for (size_t offset = header.dataOffset; offset + CHUNK_HEADER_SIZE <= size; offset += header.chunkSize) {
+        qrFlightChunkHeader chunkHeader;
+        memcpy(&chunkHeader, data + offset, sizeof(chunkHeader));
+        if (chunkHeader.magic != CHUNK_MAGIC) {
+            break;
+        }
+        uint32_t count = std::min(chunkHeader.records, header.recordsPerChunk);
+        for (uint32_t i = 0; i < count; ++i) {
+            size_t recordOffset = offset + CHUNK_HEADER_SIZE + i * header.recordSize;
+            if (recordOffset + header.recordSize > size) {
+                break;
+            }
+            records.push_back(data + recordOffset);
+        }
+    }
+}
+
+
+qrFlightLog::~qrFlightLog()
+{
+    munmap(const_cast<char *>(data), size);
+}
+
+
+const qrFlightField *qrFlightLog::FindField(const std::string &name) const
+{
+    for (const auto &field : fields) {
+        if (name == field.name) {
+            return &field;
+        }
+    }
+    return nullptr;
+}
+
+
+double qrFlightLog::Value(size_t record, const qrFlightField &field, unsigned int index) const
+{
+    const char *p = records[record] + field.offset + index * 4;
+    if (field.type == 1) {
+        uint32_t value;
+        memcpy(&value, p, sizeof(value));
+        return value;
+    }
+    float value;
+    memcpy(&value, p, sizeof(value));
+    return value;
+}
+
+
+void qrFlightLog::Read(size_t record, qrFlightRecord &out) const
+{
+    memset(&out, 0, sizeof(out));
+    for (const auto &field : qrFlightRecorder::GetFields()) {
+        const qrFlightField *stored = FindField(field.name);
+        if (!stored || stored->type != field.type) {
+            continue;
+        }
+        memcpy(reinterpret_cast<char *>(&out) + field.offset, records[record] + stored->offset,
+               std::min(field.count, stored->count) * 4);
+    }
+}
+
+
+void qrFlightLog::ExportCsv(std::ostream &os) const
+{
+    const char *separator = "";
+    for (const auto &field : fields) {
+        for (uint32_t i = 0; i < field.count; ++i) {
+            os << separator << field.name;
+            if (field.count > 1) {
+                os << "_" << i;
+            }
+            separator = ",";
+        }
+    }
+    os << "\n";
+
+    for (size_t r = 0; r < records.size(); ++r) {
+        separator = "";
+        for (const auto &field : fields) {
+            for (uint32_t i = 0; i < field.count; ++i) {
+                os << separator << Value(r, field, i);
+                separator = ",";
+            }
+        }
+        os << "\n";
+    }
+}
+
+} // namespace Quadruped
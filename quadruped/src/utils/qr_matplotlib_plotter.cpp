@@ -0,0 +1,78 @@
+// The MIT License
+
+// Copyright (c) 2022
+// Robot Motion and Vision Laboratory at East China Normal University
+// Contact: tophill.robotics@gmail.com
+
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include <map>
+#include <string>
+
+#include "matplotlibcpp.h"
+
+#include "utils/qr_visualization.h"
+
+
+namespace plt = matplotlibcpp;
+
+namespace {
+
+/**
+ * @brief Plot the curves of the same size as datax against it, in one figure.
+ */
+void PlotWithMatplotlib(const Visualization2D &vis)
+{
+    const std::vector<float> &datax = vis.datax;
+    const std::vector<std::string> &labelNames = vis.labelNames;
+    size_t n = datax.size();
+
+    plt::figure();
+
+    std::map<std::string, std::string> map_;
+    map_["cmap"] = "viridis";
+    map_["alpha"] = "0.5";
+
+    if (vis.datay1.size() == n)
+        plt::plot(datax, vis.datay1, {{"label", labelNames[0]},{"linestyle", "-."}});
+        // plt::scatter(datax,datay5, 1.0, map_);
+    if (vis.datay2.size() == n)
+        plt::plot(datax, vis.datay2, {{"label", labelNames[1]},{"linestyle", "-."}});
+    if (vis.datay3.size() == n)
+        plt::plot(datax, vis.datay3, {{"label", labelNames[2]},{"linestyle", "--"}});
+    if (vis.datay4.size() == n)
+        plt::plot(datax, vis.datay4, {{"label", labelNames[3]},{"linestyle", "--"}});
+    if (vis.datay5.size() == n)
+        plt::plot(datax, vis.datay5, {{"label", labelNames[4]}, {"linestyle", "--"}});
+        // plt::scatter(datay4,datay5, 1.0, map_);
+    if (vis.datay6.size() == n)
+        plt::plot(datax, vis.datay6, {{"label", labelNames[5]}, {"linestyle", "--"}});
+
+    // std::vector<float> xticks = {2.5f, 5.0f, 7.5f, 10.f};
+    // plt::xticks(xticks);
+
+    plt::grid(true);
+    plt::legend();
+    plt::show();
+}
+
+/* Visualization2D::Show plots with matplotlib once the adapter is loaded. */
+const bool matplotlibPlotterRegistered = (Visualization2D::SetPlotter(PlotWithMatplotlib), true);
+
+} // namespace
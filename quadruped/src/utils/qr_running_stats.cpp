@@ -0,0 +1,116 @@
+// The MIT License
+
+// Copyright (c) 2022
+// Robot Motion and Vision Laboratory at East China Normal University
+// Contact: tophill.robotics@gmail.com
+
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include "utils/qr_running_stats.h"
+
+
+namespace Quadruped {
+
+void qrRunningStats::Merge(const qrRunningStats &other)
+{
+    if (other.count == 0) {
+        return;
+    }
+    unsigned long total = count + other.count;
+    double delta = other.mean - mean;
+    /* Chan et al., the combined sum of squares of two partitions. */
+    m2 += other.m2 + delta * delta * count * other.count / total;
+    mean += delta * other.count / total;
+    count = total;
+    min = std::min(min, other.min);
+    max = std::max(max, other.max);
+}
+
+
+void qrRunningStats::Reset()
+{
+    *this = qrRunningStats();
+}
+
+
+qrQuantileSketch::qrQuantileSketch(double relativeAccuracy, double minValueIn):
+    gamma((1. + relativeAccuracy) / (1. - relativeAccuracy)),
+    logGamma(std::log(gamma)),
+    minValue(minValueIn)
+{
+    Reset();
+}
+
+
+void qrQuantileSketch::Merge(const qrQuantileSketch &other)
+{
+    count += other.count;
+    zeroCount += other.zeroCount;
+    for (int i = 0; i < NumBuckets; ++i) {
+        positive[i] += other.positive[i];
+        negative[i] += other.negative[i];
+    }
+}
+
+
+void qrQuantileSketch::Reset()
+{
+    count = 0;
+    zeroCount = 0;
+    positive.fill(0);
+    negative.fill(0);
+}
+
+
+double qrQuantileSketch::Value(int index) const
+{
+    return minValue * std::pow(gamma, index) * 2. / (gamma + 1.);
+}
+
+
+double qrQuantileSketch::GetQuantile(double q) const
+{
+    if (count == 0) {
+        return 0.;
+    }
+    q = std::min(std::max(q, 0.), 1.);
+    double rank = q * (count - 1);
+
+    /* From the most negative sample up to the most positive one. */
+    unsigned long seen = 0;
+    for (int i = NumBuckets - 1; i >= 0; --i) {
+        seen += negative[i];
+        if (seen > rank) {
+            return -Value(i);
+        }
+    }
+    seen += zeroCount;
+    if (seen > rank) {
+        return 0.;
+    }
+    for (int i = 0; i < NumBuckets; ++i) {
+        seen += positive[i];
+        if (seen > rank) {
+            return Value(i);
+        }
+    }
+    return Value(NumBuckets - 1);
+}
+
+} // namespace Quadruped
@@ -0,0 +1,339 @@
+// The MIT License
+
+// Copyright (c) 2022
+// Robot Motion and Vision Laboratory at East China Normal University
+// Contact: tophill.robotics@gmail.com
+
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+
+#include "utils/qr_solver_arena.h"
+
+#include <atomic>
+#include <new>
+#include <pthread.h>
+#include <stdint.h>
+#include <sys/mman.h>
+
+
+namespace {
+
+/* initial-exec TLS never allocates on access, which would recurse into operator new. */
+#define QR_TLS static __thread __attribute__((tls_model("initial-exec")))
+
+using Quadruped::qrSolverArena;
+
+/**
+ * @brief Header in front of every block. A block is freed by marking it,
+ * so any thread may free it, and only the owner of the slab moves the top.
+ */
+struct BlockHeader {
+    uint32_t size;                  // bytes of the block, header included
+    uint32_t previous;              // offset of the block below, or NO_BLOCK
+    std::atomic<uint32_t> released;
+    uint32_t padding;
+};
+
+static_assert(sizeof(BlockHeader) == 16, "blocks must keep the alignment of operator new");
+static_assert(qrSolverArena::SLAB_COUNT <= 32, "the slabs in use are a 32 bit mask");
+
+constexpr uint32_t NO_BLOCK = 0xffffffffu;
+constexpr size_t ALIGNMENT = sizeof(BlockHeader);
+constexpr uint32_t ALL_SLABS = qrSolverArena::SLAB_COUNT == 32 ?
+                               0xffffffffu : (1u << qrSolverArena::SLAB_COUNT) - 1;
+
+QR_TLS int depth = 0;
+QR_TLS char *slab = nullptr;
+QR_TLS size_t top = 0;
+QR_TLS uint32_t last = NO_BLOCK;
+QR_TLS size_t allocations = 0;
+QR_TLS size_t peakBytes = 0;
+QR_TLS bool exhausted = false;
+
+std::atomic<uint32_t> usedSlabs(0);
+pthread_key_t exitKey;
+
+
+void OnThreadExit(void *base);
+
+
+/**
+ * @brief Reserve the address space of all slabs without backing it.
+ * The pages become accessible when a thread takes its slab, and locked by then if mlockall(MCL_FUTURE) is on.
+ */
+char *ReserveRegion()
+{
+#ifdef QR_SOLVER_ARENA
+    void *region = mmap(nullptr, qrSolverArena::SLAB_COUNT * qrSolverArena::SLAB_SIZE, PROT_NONE,
+                        MAP_PRIVATE | MAP_ANONYMOUS | MAP_NORESERVE, -1, 0);
+    if (region == MAP_FAILED || pthread_key_create(&exitKey, OnThreadExit) != 0) {
+        return nullptr;
+    }
+    return static_cast<char *>(region);
+#else
+    return nullptr;
+#endif
+}
+
+
+char *const region = ReserveRegion();
+
+
+bool InRegion(const void *ptr)
+{
+    uintptr_t address = reinterpret_cast<uintptr_t>(ptr);
+    uintptr_t begin = reinterpret_cast<uintptr_t>(region);
+    return region != nullptr && address >= begin
+           && address < begin + qrSolverArena::SLAB_COUNT * qrSolverArena::SLAB_SIZE;
+}
+
+
+bool AcquireSlab()
+{
+    if (region == nullptr || exhausted) {
+        return false;
+    }
+    uint32_t used = usedSlabs.load();
+    int index;
+    do {
+        if ((used & ALL_SLABS) == ALL_SLABS) {
+            exhausted = true;
+            return false;
+        }
+        index = __builtin_ctz(~used);
+    } while (!usedSlabs.compare_exchange_weak(used, used | (1u << index)));
+
+    char *base = region + index * qrSolverArena::SLAB_SIZE;
+    if (mprotect(base, qrSolverArena::SLAB_SIZE, PROT_READ | PROT_WRITE) != 0) {
+        usedSlabs.fetch_and(~(1u << index));
+        exhausted = true;
+        return false;
+    }
+    slab = base;
+    top = 0;
+    last = NO_BLOCK;
+    pthread_setspecific(exitKey, base);
+    return true;
+}
+
+
+/**
+ * @brief Move the top of the slab of the calling thread below all the released blocks on it.
+ */
+void PopReleased()
+{
+    while (last != NO_BLOCK) {
+        BlockHeader *header = reinterpret_cast<BlockHeader *>(slab + last);
+        if (header->released.load(std::memory_order_acquire) == 0) {
+            break;
+        }
+        top = last;
+        last = header->previous;
+    }
+}
+
+
+void OnThreadExit(void *base)
+{
+    PopReleased();
+    /* A slab that still holds blocks is left to them. */
+    if (top == 0) {
+        int index = static_cast<int>((static_cast<char *>(base) - region) / qrSolverArena::SLAB_SIZE);
+        usedSlabs.fetch_and(~(1u << index));
+    }
+    slab = nullptr;
+}
+
+} // namespace
+
+
+namespace Quadruped {
+
+bool qrSolverArena::Enabled()
+{
+    return region != nullptr;
+}
+
+
+void *qrSolverArena::Allocate(size_t size)
+{
+    if (depth == 0 || (slab == nullptr && !AcquireSlab())) {
+        return nullptr;
+    }
+    if (size > SLAB_SIZE) {
+        return nullptr;
+    }
+    /* Blocks on top may have been released by other threads. */
+    PopReleased();
+    size_t blockSize = sizeof(BlockHeader) + (size + ALIGNMENT - 1) / ALIGNMENT * ALIGNMENT;
+    if (top + blockSize > SLAB_SIZE) {
+        return nullptr;
+    }
+
+    BlockHeader *header = new (slab + top) BlockHeader;
+    header->size = static_cast<uint32_t>(blockSize);
+    header->previous = last;
+    header->released.store(0, std::memory_order_relaxed);
+    last = static_cast<uint32_t>(top);
+    top += blockSize;
+
+    ++allocations;
+    if (top > peakBytes) {
+        peakBytes = top;
+    }
+    return header + 1;
+}
+
+
+bool qrSolverArena::Release(void *ptr)
+{
+    if (!InRegion(ptr)) {
+        return false;
+    }
+    BlockHeader *header = static_cast<BlockHeader *>(ptr) - 1;
+    header->released.store(1, std::memory_order_release);
+    if (slab != nullptr && static_cast<char *>(ptr) >= slab && static_cast<char *>(ptr) < slab + SLAB_SIZE) {
+        PopReleased();
+    }
+    return true;
+}
+
+
+size_t qrSolverArena::Allocations()
+{
+    return allocations;
+}
+
+
+size_t qrSolverArena::PeakBytes()
+{
+    return peakBytes;
+}
+
+
+qrSolverAllocScope::qrSolverAllocScope()
+{
+    ++depth;
+}
+
+
+qrSolverAllocScope::~qrSolverAllocScope()
+{
+    --depth;
+}
+
+} // Namespace Quadruped
+
+
+#ifdef QR_SOLVER_ARENA
+
+/* quadruped_core is linked with -Wl,--wrap for these symbols, see CMakeLists.txt,
+ * so its calls of operator new/delete land here and __real_ names the ones of libstdc++. */
+extern "C" {
+
+void *__real__Znwm(size_t size);
+void *__real__Znam(size_t size);
+void *__real__ZnwmRKSt9nothrow_t(size_t size, const std::nothrow_t &tag);
+void *__real__ZnamRKSt9nothrow_t(size_t size, const std::nothrow_t &tag);
+void __real__ZdlPv(void *ptr);
+void __real__ZdaPv(void *ptr);
+void __real__ZdlPvm(void *ptr, size_t size);
+void __real__ZdaPvm(void *ptr, size_t size);
+void __real__ZdlPvRKSt9nothrow_t(void *ptr, const std::nothrow_t &tag);
+void __real__ZdaPvRKSt9nothrow_t(void *ptr, const std::nothrow_t &tag);
+
+
+void *__wrap__Znwm(size_t size)
+{
+    void *ptr = Quadruped::qrSolverArena::Allocate(size);
+    return ptr != nullptr ? ptr : __real__Znwm(size);
+}
+
+
+void *__wrap__Znam(size_t size)
+{
+    void *ptr = Quadruped::qrSolverArena::Allocate(size);
+    return ptr != nullptr ? ptr : __real__Znam(size);
+}
+
+
+void *__wrap__ZnwmRKSt9nothrow_t(size_t size, const std::nothrow_t &tag)
+{
+    void *ptr = Quadruped::qrSolverArena::Allocate(size);
+    return ptr != nullptr ? ptr : __real__ZnwmRKSt9nothrow_t(size, tag);
+}
+
+
+void *__wrap__ZnamRKSt9nothrow_t(size_t size, const std::nothrow_t &tag)
+{
+    void *ptr = Quadruped::qrSolverArena::Allocate(size);
+    return ptr != nullptr ? ptr : __real__ZnamRKSt9nothrow_t(size, tag);
+}
+
+
+void __wrap__ZdlPv(void *ptr)
+{
+    if (!Quadruped::qrSolverArena::Release(ptr)) {
+        __real__ZdlPv(ptr);
+    }
+}
+
+
+void __wrap__ZdaPv(void *ptr)
+{
+    if (!Quadruped::qrSolverArena::Release(ptr)) {
+        __real__ZdaPv(ptr);
+    }
+}
+
+
+void __wrap__ZdlPvm(void *ptr, size_t size)
+{
+    if (!Quadruped::qrSolverArena::Release(ptr)) {
+        __real__ZdlPvm(ptr, size);
+    }
+}
+
+
+void __wrap__ZdaPvm(void *ptr, size_t size)
+{
+    if (!Quadruped::qrSolverArena::Release(ptr)) {
+        __real__ZdaPvm(ptr, size);
+    }
+}
+
+
+void __wrap__ZdlPvRKSt9nothrow_t(void *ptr, const std::nothrow_t &tag)
+{
+    if (!Quadruped::qrSolverArena::Release(ptr)) {
+        __real__ZdlPvRKSt9nothrow_t(ptr, tag);
+    }
+}
+
+
+void __wrap__ZdaPvRKSt9nothrow_t(void *ptr, const std::nothrow_t &tag)
+{
+    if (!Quadruped::qrSolverArena::Release(ptr)) {
+        __real__ZdaPvRKSt9nothrow_t(ptr, tag);
+    }
+}
+
+} // extern "C"
+
+#endif // QR_SOLVER_ARENA
@@ -0,0 +1,117 @@
+// The MIT License
+
+// Copyright (c) 2022
+// Robot Motion and Vision Laboratory at East China Normal University
+// Contact: tophill.robotics@gmail.com
+
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include "utils/qr_telemetry_publisher.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <stdexcept>
+
+
+namespace Quadruped {
+
+qrTelemetryPublisher::qrTelemetryPublisher(const std::string &url,
+                                           const std::map<std::string, float> &channelRates,
+                                           float controlFrequency,
+                                           unsigned int capacity):
+    lcm(url),
+    ring(std::max(1u, capacity)),
+    head(0),
+    tail(0),
+    ticks(0),
+    dropped(0),
+    published(0),
+    running(true)
+{
+    if (!lcm.good()) {
+        throw std::runtime_error("cannot connect the telemetry to LCM at " + url);
+    }
+
+    for (const auto &channel : channelRates) {
+        if (channel.second <= 0.f) {
+            continue;
+        }
+        if (channels.size() == 32) {
+            throw std::runtime_error("the telemetry publishes on 32 channels at most");
+        }
+        channels.push_back(channel.first);
+        periods.push_back(std::max(1u, static_cast<unsigned int>(std::lround(controlFrequency / channel.second))));
+    }
+
+    qr_telemetry_lcmt message;
+    buffer.resize(message.getEncodedSize());
+
+    thread = std::thread(&qrTelemetryPublisher::Run, this);
+}
+
+
+qrTelemetryPublisher::~qrTelemetryPublisher()
+{
+    running.store(false, std::memory_order_release);
+    thread.join();
+    if (dropped > 0) {
+        printf("[Telemetry] %lu samples dropped, consider a larger telemetryCapacity\n", dropped);
+    }
+}
+
+
+void qrTelemetryPublisher::Run()
+{
+    while (running.load(std::memory_order_acquire)) {
+        if (!Flush()) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        }
+    }
+    while (Flush()) {}
+}
+
+
+bool qrTelemetryPublisher::Flush()
+{
+    unsigned long t = tail.load(std::memory_order_relaxed);
+    const unsigned long h = head.load(std::memory_order_acquire);
+    if (t == h) {
+        return false;
+    }
+
+    for (; t < h; ++t) {
+        const qrTelemetrySample &sample = ring[t % ring.size()];
+        int size = sample.message.encode(buffer.data(), 0, buffer.size());
+        if (size > 0) {
+            /* Encoded once, then sent on each channel the sample is due on. */
+            for (size_t i = 0; i < channels.size(); ++i) {
+                if (sample.channels & (1u << i)) {
+                    if (lcm.publish(channels[i], buffer.data(), size) == 0) {
+                        published.fetch_add(1, std::memory_order_release);
+                    }
+                }
+            }
+        }
+        tail.store(t + 1, std::memory_order_release);
+    }
+    return true;
+}
+
+} // namespace Quadruped
@@ -63,19 +63,6 @@ int getch1()
 } // Namespace robotics
 
 
-#ifdef _useros
-/**
- * @brief A toolkit for loading yaml config file correctly.
- */
-std::string GetHomeDir(std::string homeName)
-{
-    std::string exepath = robotics::utils::GetExePath();
-    std::size_t found = exepath.find(homeName);
-    std::string homeDir = exepath.substr(0, found) + homeName + "src/quadruped/";
-    std::cout << "[USE ROS]: " << homeDir << std::endl;
-    return homeDir;
-}
-#else
 /**
  * @brief A toolkit for loading yaml config file correctly.
  */
@@ -84,7 +71,11 @@ std::string GetHomeDir(std::string homeName)
     std::string exepath = robotics::utils::GetExePath();
     std::size_t found = exepath.find(homeName);
     std::string homeDir = exepath.substr(0, found) + homeName;
+    std::string catkinHomeDir = homeDir + "src/quadruped/";
+    if (access(catkinHomeDir.c_str(), F_OK) == 0) {
+        std::cout << "[USE ROS]: " << catkinHomeDir << std::endl;
+        return catkinHomeDir;
+    }
     std::cout << "[NO ROS]: " << homeDir << std::endl;
     return homeDir;
 }
-#endif
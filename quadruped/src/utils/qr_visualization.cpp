@@ -22,28 +22,26 @@
 // OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
 // SOFTWARE.
 
-#include "matplotlibcpp.h"
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <iostream>
+#include <stdexcept>
 
 #include "utils/qr_visualization.h"
 
 
-namespace plt = matplotlibcpp;
+Visualization2D::Plotter Visualization2D::plotter = nullptr;
 
-StatisticAnalysis::StatisticAnalysis(float meanIn):
-    defaultMean(meanIn),
-    var_(0.f),
-    sigma_(0.f),
-    num(0)
+StatisticAnalysis::StatisticAnalysis(float meanIn)
 {
-    mean_ = defaultMean;
-    sum_ = defaultMean;
-    data.clear();
+    Reset(meanIn);
 }
 
 
 void StatisticAnalysis::Update(float in)
 {
-    data.push_back(in);
+    stats.Update(in);
     sum_ += in;
     num++;
 }
@@ -51,18 +49,15 @@ void StatisticAnalysis::Update(float in)
 
 float StatisticAnalysis::GetMean()
 {
-    mean_ = sum_ / num;
+    mean_ = num > 0 ? stats.GetMean() : defaultMean;
     return mean_;
 }
 
 
 float StatisticAnalysis::GetStandradVar()
 {
-    mean_ = sum_ / num;
-    for (const float& item : data) {
-        var_ += std::pow(item-mean_, 2);
-    }
-    var_ /= num;
+    GetMean();
+    var_ = stats.GetVariance();
     sigma_ = std::sqrt(var_);
     return sigma_;
 }
@@ -71,11 +66,11 @@ float StatisticAnalysis::GetStandradVar()
 void StatisticAnalysis::Reset(float meanIn) {
     defaultMean = meanIn;
     mean_ = defaultMean;
-    sum_ = defaultMean;
+    sum_ = 0;
     num = 0;
     var_ = 0;
     sigma_ = 0;
-    data.clear();
+    stats.Reset();
 }
 
 
@@ -109,40 +104,23 @@ void Visualization2D::SetLabelNames(std::vector<std::string> labelNamesIn)
 }
 
 
+void Visualization2D::SetPlotter(Plotter plotterIn)
+{
+    plotter = plotterIn;
+}
+
+
 void Visualization2D::Show()
 {
     int n = datax.size();
     std::cout << n << ", " << datay1.size() << ", " << datay2.size() << ", " << datay3.size()
                    << ", " << datay4.size() << ", " << datay5.size() << ", " << datay6.size() <<std::endl;
     if (n>0) {
-        plt::figure();
-        
-        std::map<std::string, std::string> map_;
-        map_["cmap"] = "viridis";
-        map_["alpha"] = "0.5";
-
-        if (datay1.size() == n)
-            plt::plot(datax,datay1, {{"label", labelNames[0]},{"linestyle", "-."}});
-            // plt::scatter(datax,datay5, 1.0, map_);
-        if (datay2.size() == n)
-            plt::plot(datax,datay2, {{"label", labelNames[1]},{"linestyle", "-."}});
-        if (datay3.size() == n)
-            plt::plot(datax,datay3, {{"label", labelNames[2]},{"linestyle", "--"}});
-        if (datay4.size() == n)
-            plt::plot(datax,datay4, {{"label", labelNames[3]},{"linestyle", "--"}});
-        if (datay5.size() == n)
-            plt::plot(datax,datay5, {{"label", labelNames[4]}, {"linestyle", "--"}});
-            // plt::scatter(datay4,datay5, 1.0, map_);
-        if (datay6.size() == n)
-            plt::plot(datax,datay6, {{"label", labelNames[5]}, {"linestyle", "--"}});
-        
-        // std::vector<float> xticks = {2.5f, 5.0f, 7.5f, 10.f};
-        // plt::xticks(xticks);
-
-        plt::grid(true);
-        plt::legend();
-        plt::show();
-        
+        if (plotter) {
+            plotter(*this);
+        } else {
+            std::cout << "[Visualization2D] no plotter is set, nothing is shown." << std::endl;
+        }
     } else {
         throw std::domain_error("datax no data");
     }
@@ -0,0 +1,113 @@
+// The MIT License
+
+// Copyright (c) 2022
+// Robot Motion and Vision Laboratory at East China Normal University
+// Contact: tophill.robotics@gmail.com
+
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include <gtest/gtest.h>
+
+#include "exec/qr_batch_rollout.h"
+#include "exec/qr_robot_runner.h"
+#include "robots/qr_robot_headless_sim.h"
+#include "utils/qr_alloc_tracker.h"
+#include "utils/qr_solver_arena.h"
+
+using namespace Quadruped;
+
+namespace {
+
+/**
+ * @brief Ticks run before the check, for the robot to stand up and settle into the trot.
+ */
+constexpr int WARMUP_TICKS = 1000;
+
+/**
+ * @brief Ticks whose allocations are counted.
+ */
+constexpr int CHECKED_TICKS = 2000;
+
+/**
+ * @brief Steps the runner of a1_sim on the headless simulation, sequential or pipelined, with or without the WBC.
+ */
+class qrAllocFreeTickTest : public ::testing::TestWithParam<std::tuple<bool, bool>> {};
+
+} // Anonymous namespace
+
+
+TEST_P(qrAllocFreeTickTest, SteadyTrotDoesNotAllocate)
+{
+    /* The test is only registered with -DTRACK_ALLOCATION=ON and -DSOLVER_ARENA=ON. */
+    ASSERT_TRUE(qrAllocTracker::Enabled());
+    ASSERT_TRUE(qrSolverArena::Enabled());
+
+    const bool pipelined = std::get<0>(GetParam());
+    const bool useWBC = std::get<1>(GetParam());
+    std::string workDir = std::string(QR_TEST_WORK_DIR) + (pipelined ? "pipelined" : "sequential")
+                          + (useWBC ? "_wbc/" : "/");
+    qrBatchRollout::PrepareConfig(QR_TEST_HOME, {
+        {"a1_sim/main.yaml", "const_twist/linear", YAML::Load("[0.2, 0, 0]")},
+        {"user_parameters.yaml", "usePipeline", YAML::Node(pipelined)},
+        {"user_parameters.yaml", "useWBC", YAML::Node(useWBC)}}, workDir);
+
+    /* The runner owns the robot. */
+    qrRobotHeadlessSim *robot = new qrRobotHeadlessSim(workDir + "config/a1_sim/a1_sim.yaml");
+    qrRobotRunner runner(robot, workDir);
+    runner.Update();
+    runner.Step();
+    runner.GetDesiredStateCommand()->setJoyCtrlState(RC_MODE::HARD_CODE);
+    runner.GetControlRobot()->fsmMode = K_LOCOMOTION;
+    for (int i = 0; i < WARMUP_TICKS; ++i) {
+        runner.Update();
+        runner.Step();
+    }
+
+    /* Print where the first allocation of a checked tick comes from. */
+    qrAllocTracker::SetPolicy(ALLOC_BACKTRACE);
+    size_t allocations = 0;
+    size_t bytes = 0;
+    size_t solverAllocations = 0;
+    int firstTick = -1;
+    float startX = robot->GetSimulationState().bodyPosition[0];
+    for (int i = 0; i < CHECKED_TICKS; ++i) {
+        runner.Update();
+        runner.Step();
+        const qrAllocStats &stats = runner.GetAllocStats();
+        if (stats.allocations > 0 && firstTick < 0) {
+            firstTick = i;
+        }
+        allocations += stats.allocations;
+        bytes += stats.bytes;
+        solverAllocations += stats.solverAllocations;
+    }
+
+    /* The solvers included, as their allocations are served by the solver arena. */
+    EXPECT_EQ(allocations, 0u) << bytes << " bytes allocated, the first in tick " << firstTick;
+    EXPECT_GT(solverAllocations, 0u) << "the MPC is not solved";
+    EXPECT_GT(robot->GetSimulationState().bodyPosition[2], 0.15f) << "the robot is not trotting";
+    EXPECT_GT(robot->GetSimulationState().bodyPosition[0] - startX, 0.1f) << "the robot does not walk forward";
+}
+
+
+INSTANTIATE_TEST_SUITE_P(Runner, qrAllocFreeTickTest, ::testing::Combine(::testing::Bool(), ::testing::Bool()),
+                         [](const ::testing::TestParamInfo<std::tuple<bool, bool>> &info) {
+                             return std::string(std::get<0>(info.param) ? "Pipelined" : "Sequential")
+                                    + (std::get<1>(info.param) ? "Wbc" : "");
+                         });
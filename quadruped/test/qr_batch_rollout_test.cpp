@@ -0,0 +1,113 @@
+// The MIT License
+
+// Copyright (c) 2022
+// Robot Motion and Vision Laboratory at East China Normal University
+// Contact: tophill.robotics@gmail.com
+
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include <gtest/gtest.h>
+
+#include <string>
+#include <vector>
+
+#include "exec/qr_batch_rollout.h"
+
+using namespace Quadruped;
+
+namespace {
+
+/**
+ * @brief Rollouts of a1_sim at different forward velocities.
+ */
+std::vector<qrRolloutSpec> MakeSpecs()
+{
+    std::vector<qrRolloutSpec> specs;
+    const float velocities[] = {0.f, 0.1f, 0.2f, 0.3f};
+    for (float vx : velocities) {
+        qrRolloutSpec spec;
+        spec.name = "vx" + std::to_string(int(vx * 10));
+        spec.duration = 1.f;
+        spec.parameters.push_back({"a1_sim/main.yaml", "const_twist/linear",
+                                   YAML::Load("[" + std::to_string(vx) + ", 0, 0]")});
+        specs.push_back(spec);
+    }
+    return specs;
+}
+
+} // Anonymous namespace
+
+
+TEST(qrBatchRolloutTest, ResultsDoNotDependOnThreadCount)
+{
+    const std::vector<qrRolloutSpec> specs = MakeSpecs();
+    std::vector<std::vector<qrRolloutMetrics>> results;
+    for (unsigned int numWorkers : {1u, 2u, 4u}) {
+        qrBatchRollout batch(QR_TEST_HOME, "a1_sim", std::string(QR_TEST_WORK_DIR) + std::to_string(numWorkers), numWorkers);
+        results.push_back(batch.Run(specs));
+    }
+
+    for (size_t i = 0; i < specs.size(); ++i) {
+        const qrRolloutMetrics &serial = results[0][i];
+        EXPECT_EQ(serial.name, specs[i].name);
+        EXPECT_TRUE(serial.error.empty()) << serial.error;
+        EXPECT_FALSE(serial.fell) << serial.name << " fell at " << serial.fallTime << " s";
+        EXPECT_GT(serial.ticks, 0u) << serial.name;
+
+        /* The rollouts run in simulated time, so the metrics are equal to the bit, except the wall time. */
+        for (size_t k = 1; k < results.size(); ++k) {
+            const qrRolloutMetrics &parallel = results[k][i];
+            EXPECT_EQ(parallel.error, serial.error) << serial.name;
+            EXPECT_EQ(parallel.fell, serial.fell) << serial.name;
+            EXPECT_EQ(parallel.ticks, serial.ticks) << serial.name;
+            EXPECT_EQ(parallel.duration, serial.duration) << serial.name;
+            EXPECT_EQ(parallel.linearVelocityRmse, serial.linearVelocityRmse) << serial.name;
+            EXPECT_EQ(parallel.yawRateRmse, serial.yawRateRmse) << serial.name;
+            EXPECT_EQ(parallel.energy, serial.energy) << serial.name;
+        }
+    }
+}
+
+
+TEST(qrBatchRolloutTest, OverridesChangeTheScores)
+{
+    /* The same forward command, once trotting and once with the stand gait, in which no leg swings. */
+    std::vector<qrRolloutSpec> specs(2);
+    specs[0].name = "trot";
+    specs[1].name = "stand";
+    for (qrRolloutSpec &spec : specs) {
+        spec.duration = 2.f;
+        spec.parameters.push_back({"a1_sim/main.yaml", "const_twist/linear", YAML::Load("[0.2, 0, 0]")});
+    }
+    specs[1].parameters.push_back({"a1_sim/openloop_gait_generator.yaml", "gait_params/gait", YAML::Node("stand")});
+
+    qrBatchRollout batch(QR_TEST_HOME, "a1_sim", std::string(QR_TEST_WORK_DIR) + "overrides", 2);
+    const std::vector<qrRolloutMetrics> results = batch.Run(specs);
+    for (const qrRolloutMetrics &metrics : results) {
+        ASSERT_TRUE(metrics.error.empty()) << metrics.error;
+        EXPECT_FALSE(metrics.fell) << metrics.name << " fell at " << metrics.fallTime << " s";
+        EXPECT_EQ(metrics.ticks, results[0].ticks) << metrics.name;
+    }
+
+    /* Swinging the legs costs most of the energy of the trot. */
+    const qrRolloutMetrics &trot = results[0];
+    const qrRolloutMetrics &stand = results[1];
+    EXPECT_GT(stand.energy, 0.f);
+    EXPECT_LT(stand.energy, 0.5f * trot.energy) << "stand " << stand.energy << " J, trot " << trot.energy << " J";
+}
@@ -0,0 +1,164 @@
+// The MIT License
+
+// Copyright (c) 2022
+// Robot Motion and Vision Laboratory at East China Normal University
+// Contact: tophill.robotics@gmail.com
+
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+
+#include <gtest/gtest.h>
+
+#include "estimators/qr_elevation_map.h"
+
+using namespace Quadruped;
+
+namespace {
+
+constexpr int SIZE = qrElevationMap::SIZE;
+
+/**
+ * @brief A height that identifies the world cell.
+ */
+float CellHeight(int ix, int iy)
+{
+    return 0.01f * ix + 0.0001f * iy;
+}
+
+/**
+ * @brief Fuse the identifying height into every cell of the window [x0, x0 + SIZE) x [y0, y0 + SIZE).
+ * The map has a resolution of 1 m, so that the world cell (ix, iy) is centered at (ix + 0.5, iy + 0.5).
+ */
+void FillWindow(qrElevationMap &map, int x0, int y0)
+{
+    for (int iy = y0; iy < y0 + SIZE; ++iy) {
+        for (int ix = x0; ix < x0 + SIZE; ++ix) {
+            map.Fuse(Vec3<float>(ix + 0.5f, iy + 0.5f, CellHeight(ix, iy)));
+        }
+    }
+}
+
+/**
+ * @brief Whether the cell is known and holds its identifying height.
+ */
+bool HoldsCell(const qrElevationMap &map, int ix, int iy)
+{
+    float z;
+    return map.GetHeight(ix + 0.5f, iy + 0.5f, z) && z == CellHeight(ix, iy);
+}
+
+bool IsKnown(const qrElevationMap &map, int ix, int iy)
+{
+    float z;
+    return map.GetHeight(ix + 0.5f, iy + 0.5f, z);
+}
+
+} // namespace
+
+
+TEST(qrElevationMapTest, EveryCellOfAWrappedWindowHasItsOwnStorage)
+{
+    /* Centered at 40, the window [8, 72) wraps around the storage and crosses tiles on both axes. */
+    qrElevationMap map(1.f);
+    map.Recenter(40.5f, -21.5f);
+    FillWindow(map, 8, -54);
+    for (int iy = -54; iy < -54 + SIZE; ++iy) {
+        for (int ix = 8; ix < 8 + SIZE; ++ix) {
+            ASSERT_TRUE(HoldsCell(map, ix, iy)) << "cell " << ix << ", " << iy;
+        }
+    }
+    EXPECT_FALSE(IsKnown(map, 7, -54));
+    EXPECT_FALSE(IsKnown(map, 72, -54));
+    EXPECT_FALSE(IsKnown(map, 8, -55));
+    EXPECT_FALSE(IsKnown(map, 8, 10));
+}
+
+
+TEST(qrElevationMapTest, RecenterKeepsTheOverlapAndClearsTheCellsScrollingIn)
+{
+    qrElevationMap map(1.f);
+    map.Recenter(0.5f, 0.5f);
+    FillWindow(map, -SIZE / 2, -SIZE / 2);
+
+    /* The new window is [-27, 37) x [-35, 29). Its cells x >= 32 and y < -32 reuse the storage
+     * of the cells x < -27 and y >= 29, which scroll out. */
+    map.Recenter(5.5f, -2.5f);
+    for (int iy = -35; iy < 29; ++iy) {
+        for (int ix = -27; ix < 37; ++ix) {
+            bool overlap = ix < SIZE / 2 && iy >= -SIZE / 2;
+            if (overlap) {
+                ASSERT_TRUE(HoldsCell(map, ix, iy)) << "kept cell " << ix << ", " << iy;
+            } else {
+                ASSERT_FALSE(IsKnown(map, ix, iy)) << "scrolled in cell " << ix << ", " << iy;
+            }
+        }
+    }
+    EXPECT_FALSE(IsKnown(map, -28, 0));
+    EXPECT_FALSE(IsKnown(map, 0, 29));
+
+    /* Back to the first window, the cells that scrolled out are gone, the others are kept. */
+    map.Recenter(0.5f, 0.5f);
+    for (int iy = -SIZE / 2; iy < SIZE / 2; ++iy) {
+        for (int ix = -SIZE / 2; ix < SIZE / 2; ++ix) {
+            bool kept = ix >= -27 && iy < 29;
+            ASSERT_EQ(HoldsCell(map, ix, iy), kept) << "cell " << ix << ", " << iy;
+            ASSERT_EQ(IsKnown(map, ix, iy), kept) << "cell " << ix << ", " << iy;
+        }
+    }
+}
+
+
+TEST(qrElevationMapTest, RecenterFartherThanTheMapClearsEveryCell)
+{
+    qrElevationMap map(1.f);
+    FillWindow(map, -SIZE / 2, -SIZE / 2);
+    map.Recenter(SIZE + 0.5f, 0.5f);
+    map.Recenter(0.5f, 0.5f);
+    for (int iy = -SIZE / 2; iy < SIZE / 2; ++iy) {
+        for (int ix = -SIZE / 2; ix < SIZE / 2; ++ix) {
+            ASSERT_FALSE(IsKnown(map, ix, iy)) << "cell " << ix << ", " << iy;
+        }
+    }
+}
+
+
+TEST(qrElevationMapTest, CopyFromComparesTheRevisionsOfTheSameMapOnly)
+{
+    qrElevationMap a(1.f);
+    qrElevationMap b(1.f);
+    a.Fuse(Vec3<float>(1.5f, 1.5f, 0.3f));
+    b.Fuse(Vec3<float>(2.5f, 2.5f, 0.7f));
+    ASSERT_EQ(a.GetRevision(), b.GetRevision());
+
+    /* Equal revisions of different maps. */
+    qrElevationMap copy(1.f);
+    copy.CopyFrom(a);
+    EXPECT_TRUE(IsKnown(copy, 1, 1));
+    copy.CopyFrom(b);
+    EXPECT_FALSE(IsKnown(copy, 1, 1));
+    EXPECT_TRUE(IsKnown(copy, 2, 2));
+
+    /* The copy and its source changed by as many revisions. */
+    copy.Fuse(Vec3<float>(3.5f, 3.5f, 0.1f));
+    b.Fuse(Vec3<float>(4.5f, 4.5f, 0.1f));
+    ASSERT_EQ(copy.GetRevision(), b.GetRevision());
+    copy.CopyFrom(b);
+    EXPECT_FALSE(IsKnown(copy, 3, 3));
+    EXPECT_TRUE(IsKnown(copy, 4, 4));
+}
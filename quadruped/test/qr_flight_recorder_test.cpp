@@ -0,0 +1,114 @@
+// The MIT License
+
+// Copyright (c) 2022
+// Robot Motion and Vision Laboratory at East China Normal University
+// Contact: tophill.robotics@gmail.com
+
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+
+#include <gtest/gtest.h>
+
+#include <sys/stat.h>
+
+#include <cstring>
+#include <random>
+#include <thread>
+#include <vector>
+
+#include "utils/qr_flight_recorder.h"
+
+using namespace Quadruped;
+
+namespace {
+
+/**
+ * @brief Fill a record with random values, drawn from a generator seeded with the tick.
+ */
+void FillRecord(uint32_t tick, qrFlightRecord &record)
+{
+    std::mt19937 generator(tick);
+    std::uniform_real_distribution<float> value(-100.f, 100.f);
+    std::vector<float> values(sizeof(qrFlightRecord) / sizeof(float));
+    for (float &v : values) {
+        v = value(generator);
+    }
+    memcpy(&record, values.data(), sizeof(qrFlightRecord));
+    record.tick[0] = tick;
+}
+
+/**
+ * @brief Path of a log in the work directory of the test.
+ */
+std::string LogPath(const std::string &name)
+{
+    mkdir(QR_TEST_WORK_DIR, 0755);
+    return std::string(QR_TEST_WORK_DIR) + name;
+}
+
+} // Anonymous namespace
+
+
+TEST(qrFlightRecorderTest, RecordsCrossChunksUnchanged)
+{
+    /* A small ring and small chunks, so that the ticks wrap the ring and fill ten chunks and a half. */
+    const uint32_t numRecords = 1050;
+    const unsigned int recordsPerChunk = 100;
+    const std::string path = LogPath("chunks.qrf");
+    {
+        qrFlightRecorder recorder(path, 64, recordsPerChunk);
+        for (uint32_t tick = 0; tick < numRecords; ++tick) {
+            qrFlightRecord *record = recorder.BeginRecord();
+            while (!record) {
+                /* The ring is full, wait for the flush thread rather than drop the tick. */
+                std::this_thread::yield();
+                record = recorder.BeginRecord();
+            }
+            FillRecord(tick, *record);
+            recorder.CommitRecord();
+        }
+    }
+
+    qrFlightLog log(path);
+    ASSERT_EQ(log.Size(), numRecords);
+    const qrFlightField *tickField = log.FindField("tick");
+    ASSERT_NE(tickField, nullptr);
+
+    qrFlightRecord expected;
+    qrFlightRecord read;
+    for (uint32_t tick = 0; tick < numRecords; ++tick) {
+        FillRecord(tick, expected);
+        log.Read(tick, read);
+        EXPECT_EQ(memcmp(&read, &expected, sizeof(qrFlightRecord)), 0) << "record " << tick;
+        EXPECT_EQ(log.Value(tick, *tickField), tick);
+    }
+}
+
+
+TEST(qrFlightRecorderTest, EmptyLogHasNoRecords)
+{
+    const std::string path = LogPath("empty.qrf");
+    {
+        qrFlightRecorder recorder(path);
+        EXPECT_EQ(recorder.GetWritten(), 0u);
+    }
+    qrFlightLog log(path);
+    EXPECT_EQ(log.Size(), 0u);
+    EXPECT_EQ(log.GetFields().size(), qrFlightRecorder::GetFields().size());
+}
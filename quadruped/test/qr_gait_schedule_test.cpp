@@ -0,0 +1,164 @@
+// The MIT License
+
+// Copyright (c) 2022
+// Robot Motion and Vision Laboratory at East China Normal University
+// Contact: tophill.robotics@gmail.com
+
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+
+#include <gtest/gtest.h>
+
+#include <cmath>
+#include <memory>
+
+#include "gait/qr_openloop_gait_generator.h"
+#include "robots/qr_robot_headless_sim.h"
+
+using namespace Quadruped;
+
+namespace {
+
+/**
+ * @brief Time step of the gait updates.
+ */
+constexpr float DT = 0.001f;
+
+/**
+ * @brief Whether the contact schedule plans a leg in stance, i slots after the current one.
+ */
+bool PlannedStance(const qrGaitGenerator &gait, int i, int legId)
+{
+    return (gait.GetContactSchedule()[i] >> legId) & 1;
+}
+
+/**
+ * @brief Whether a gait phase is in stance, or -1 if it is too close to a touch down or a lift off to tell it from its slot.
+ */
+int PhaseInStance(float phase, float dutyFactor)
+{
+    phase -= std::floor(phase);
+    const float margin = 2.f / qrGaitGenerator::CONTACT_SCHEDULE_SLOTS;
+    if (phase < margin || phase > 1.f - margin || std::abs(phase - dutyFactor) < margin) {
+        return -1;
+    }
+    return phase < dutyFactor;
+}
+
+/**
+ * @brief Gait whose periods are set by hand, and whose update only locates the contact schedule.
+ */
+class qrFixedPeriodGait : public qrGaitGenerator {
+
+public:
+
+    qrFixedPeriodGait(const Vec4<float> &period)
+    {
+        fullCyclePeriod = period;
+        dutyFactor << 0.6f, 0.6f, 0.6f, 0.6f;
+        initialLegPhase << 0.f, 0.5f, 0.5f, 0.f;
+        initialLegState << LegState::STANCE, LegState::STANCE, LegState::STANCE, LegState::STANCE;
+        BuildContactSchedule();
+    }
+
+    virtual void Update(float currentTime)
+    {
+        UpdateContactScheduleSlot(currentTime);
+    }
+};
+
+class qrGaitScheduleTest : public ::testing::Test {
+
+protected:
+
+    void SetUp() override
+    {
+        robot.reset(new qrRobotHeadlessSim(std::string(QR_TEST_HOME) + "config/a1_sim/a1_sim.yaml"));
+        robot->ReceiveObservation();
+        gait.reset(new qrOpenLoopGaitGenerator(robot.get(),
+                                               std::string(QR_TEST_HOME) + "config/a1_sim/openloop_gait_generator.yaml"));
+    }
+
+    std::unique_ptr<qrRobotHeadlessSim> robot;
+
+    std::unique_ptr<qrOpenLoopGaitGenerator> gait;
+};
+
+} // Anonymous namespace
+
+
+TEST_F(qrGaitScheduleTest, ScheduleFollowsTheLegPhases)
+{
+    const int lookahead[] = {0, qrGaitGenerator::ContactScheduleSlots(0.25f), qrGaitGenerator::ContactScheduleSlots(0.7f)};
+    for (int tick = 1; tick < 2000; ++tick) {
+        robot->footContact << true, true, true, true;
+        gait->Update(tick * DT);
+        ASSERT_EQ(gait->allowSwitchLegState.cast<int>().sum(), 4);
+
+        for (int i : lookahead) {
+            for (int legId = 0; legId < NumLeg; ++legId) {
+                float phase = gait->phaseInFullCycle[legId] + float(i) / qrGaitGenerator::CONTACT_SCHEDULE_SLOTS;
+                int inStance = PhaseInStance(phase, gait->dutyFactor[legId]);
+                if (inStance >= 0) {
+                    EXPECT_EQ(PlannedStance(*gait, i, legId), bool(inStance))
+                        << "tick " << tick << ", " << i << " slots later, leg " << legId;
+                }
+            }
+        }
+    }
+}
+
+
+TEST_F(qrGaitScheduleTest, LegWaitingForTouchDownHoldsTheSchedule)
+{
+    /* Without contacts, the leg touching down first holds the gait until the wait time of the yaml. */
+    int heldTicks = 0;
+    const u8 *schedule = gait->GetContactSchedule();
+    for (int tick = 1; tick < 2000; ++tick) {
+        robot->footContact << false, false, false, false;
+        gait->Update(tick * DT);
+        if (gait->allowSwitchLegState.cast<int>().sum() < 4) {
+            EXPECT_EQ(gait->GetContactSchedule(), schedule) << "tick " << tick;
+            ++heldTicks;
+        }
+        schedule = gait->GetContactSchedule();
+    }
+    EXPECT_GT(heldTicks, 0);
+}
+
+
+TEST(qrGaitScheduleFixedPeriodTest, LegsWithDifferentPeriods)
+{
+    qrFixedPeriodGait gait(Vec4<float>(0.5f, 0.5f, 0.5f, 0.6f));
+    const float slotDuration = gait.fullCyclePeriod[0] / qrGaitGenerator::CONTACT_SCHEDULE_SLOTS;
+    for (int tick = 0; tick < 5000; tick += 7) {
+        const float time = tick * DT;
+        gait.Update(time);
+        for (int i : {0, 100, 500, qrGaitGenerator::CONTACT_SCHEDULE_SLOTS - 1}) {
+            for (int legId = 0; legId < NumLeg; ++legId) {
+                float phase = gait.initialLegPhase[legId] + (time + i * slotDuration) / gait.fullCyclePeriod[legId];
+                int inStance = PhaseInStance(phase, gait.dutyFactor[legId]);
+                if (inStance >= 0) {
+                    EXPECT_EQ(PlannedStance(gait, i, legId), bool(inStance))
+                        << "time " << time << ", " << i << " slots later, leg " << legId;
+                }
+            }
+        }
+    }
+}
@@ -0,0 +1,104 @@
+// The MIT License
+
+// Copyright (c) 2022
+// Robot Motion and Vision Laboratory at East China Normal University
+// Contact: tophill.robotics@gmail.com
+
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+
+#include <gtest/gtest.h>
+
+#include <cmath>
+
+#include "estimators/qr_moving_window_filter.hpp"
+#include "exec/qr_batch_rollout.h"
+#include "exec/qr_robot_runner.h"
+#include "robots/qr_robot_headless_sim.h"
+
+using namespace Quadruped;
+
+namespace {
+
+/**
+ * @brief Simulated time for the robot to stand up and settle into the trot, in seconds.
+ */
+constexpr float WARMUP_TIME = 2.f;
+
+/**
+ * @brief Simulated time over which the tracking is scored, in seconds.
+ */
+constexpr float SCORED_TIME = 4.f;
+
+/**
+ * @brief Forward velocity commanded in main.yaml, the largest the desired state command lets through, in m/s.
+ */
+constexpr float FORWARD_VELOCITY = 0.2f;
+
+} // Anonymous namespace
+
+
+TEST(qrHeadlessSimTest, ClosedLoopTrotTracksTheVelocity)
+{
+    std::string workDir = QR_TEST_WORK_DIR;
+    qrBatchRollout::PrepareConfig(QR_TEST_HOME, {
+        {"a1_sim/main.yaml", "const_twist/linear", YAML::Load("[" + std::to_string(FORWARD_VELOCITY) + ", 0, 0]")}},
+        workDir);
+
+    /* The runner owns the robot. */
+    qrRobotHeadlessSim *robot = new qrRobotHeadlessSim(workDir + "config/a1_sim/a1_sim.yaml");
+    qrRobotRunner runner(robot, workDir);
+    runner.Update();
+    runner.Step();
+    qrDesiredStateCommand *desiredStateCommand = runner.GetDesiredStateCommand();
+    desiredStateCommand->setJoyCtrlState(RC_MODE::HARD_CODE);
+    robot->fsmMode = K_LOCOMOTION;
+
+    /* The base sways within a stride, so the velocity is averaged over a gait cycle before it is compared. */
+    const float gaitCycle = runner.GetGaitGenerator()->fullCyclePeriod[0];
+    qrMovingWindowFilter<float, 3> strideVelocity(static_cast<unsigned int>(gaitCycle / robot->timeStep + 0.5f));
+
+    const float startTime = robot->GetTimeSinceReset();
+    double squaredError = 0.;
+    int ticks = 0;
+    float startX = 0.f;
+    while (robot->GetTimeSinceReset() - startTime < WARMUP_TIME + SCORED_TIME) {
+        runner.Update();
+        runner.Step();
+
+        /* The velocity is scored on the true state of the simulation, in base frame. */
+        const FBModelState<float> &state = robot->GetSimulationState();
+        ASSERT_GT(state.bodyPosition[2], 0.15f) << "the robot fell at " << robot->GetTimeSinceReset() - startTime << " s";
+        const Vec3<float> velocity = strideVelocity.CalculateAverage(state.bodyVelocity.tail<3>());
+        if (robot->GetTimeSinceReset() - startTime < WARMUP_TIME) {
+            startX = state.bodyPosition[0];
+            continue;
+        }
+        const Vec3<float> desiredVelocity(desiredStateCommand->stateDes(6), desiredStateCommand->stateDes(7), 0.f);
+        squaredError += (velocity - desiredVelocity).squaredNorm();
+        ++ticks;
+    }
+    const float rmse = std::sqrt(squaredError / ticks);
+    const float speed = (robot->GetSimulationState().bodyPosition[0] - startX) / SCORED_TIME;
+    std::cout << "[Headless Sim] velocity RMSE over a stride " << rmse << " m/s, mean forward speed " << speed
+              << " m/s" << std::endl;
+
+    EXPECT_LT(rmse, 0.1f);
+    EXPECT_GT(speed, 0.5f * FORWARD_VELOCITY);
+}
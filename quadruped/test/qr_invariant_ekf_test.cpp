@@ -0,0 +1,159 @@
+// The MIT License
+
+// Copyright (c) 2022
+// Robot Motion and Vision Laboratory at East China Normal University
+// Contact: tophill.robotics@gmail.com
+
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include <gtest/gtest.h>
+
+#include <memory>
+#include <random>
+
+#include "estimators/qr_invariant_ekf.h"
+#include "robots/qr_robot_headless_sim.h"
+
+using namespace Quadruped;
+
+namespace {
+
+/**
+ * @brief Time step of the IMU and the kinematics.
+ */
+constexpr double DT = 0.001;
+
+/**
+ * @brief Number of steps, 5 s.
+ */
+constexpr int NUM_STEPS = 5000;
+
+/**
+ * @brief Runs a qrInvariantEKF on synthetic IMU and kinematics of a known base trajectory.
+ * The robot only gives the initial orientation and foot positions, with which Reset() initializes the filter.
+ * All four feet stay in contact at fixed points of the world.
+ */
+class qrInvariantEKFTest : public ::testing::Test {
+
+protected:
+
+    void SetUp() override
+    {
+        robot.reset(new qrRobotHeadlessSim(std::string(QR_TEST_HOME) + "config/a1_sim/a1_sim.yaml"));
+        robot->ReceiveObservation();
+        filter.reset(new qrInvariantEKF(robot.get()));
+        filter->Reset(0);
+
+        R0 = filter->GetRotation();
+        p0 = filter->GetPosition();
+        footPositionsInWorldFrame = R0 * robot->GetFootPositionsInBaseFrame().cast<double>();
+        footPositionsInWorldFrame.colwise() += p0;
+    }
+
+    /**
+     * @brief Feed the filter with one step of the trajectory, given by the state at the start of the step.
+     * @param R: rotation of the base.
+     * @param p: position of the base in world frame.
+     * @param w: angular velocity in base frame.
+     * @param accInWorldFrame: acceleration of the base in world frame, without gravity.
+     */
+    void Step(const Mat3<double> &R, const Vec3<double> &p, const Vec3<double> &w, const Vec3<double> &accInWorldFrame,
+              const Vec3<double> &gyroscopeError = Vec3<double>::Zero(),
+              const Vec3<double> &accelerometerError = Vec3<double>::Zero(),
+              const Eigen::Matrix<double, 3, NumLeg> &kinematicsError = Eigen::Matrix<double, 3, NumLeg>::Zero())
+    {
+        const Vec3<double> gravity(0, 0, -9.81);
+        Eigen::Matrix<double, 3, NumLeg> footPositions = footPositionsInWorldFrame;
+        footPositions.colwise() -= p;
+        footPositions = R.transpose() * footPositions + kinematicsError;
+        filter->Propagate(w + gyroscopeError, R.transpose() * (accInWorldFrame - gravity) + accelerometerError, DT);
+        filter->CorrectKinematics(footPositions, Vec4<bool>(true, true, true, true));
+    }
+
+    std::unique_ptr<qrRobotHeadlessSim> robot;
+
+    std::unique_ptr<qrInvariantEKF> filter;
+
+    /**
+     * @brief Initial rotation and position of the base.
+     */
+    Mat3<double> R0;
+
+    Vec3<double> p0;
+
+    Eigen::Matrix<double, 3, NumLeg> footPositionsInWorldFrame;
+
+};
+
+} // Anonymous namespace
+
+
+TEST_F(qrInvariantEKFTest, StationaryRobotDoesNotDrift)
+{
+    for (int i = 0; i < NUM_STEPS; ++i) {
+        Step(R0, p0, Vec3<double>::Zero(), Vec3<double>::Zero());
+    }
+    EXPECT_LT((filter->GetPosition() - p0).norm(), 1e-6);
+    EXPECT_LT(filter->GetVelocity().norm(), 1e-6);
+    EXPECT_LT((filter->GetRotation() - R0).norm(), 1e-6);
+}
+
+
+TEST_F(qrInvariantEKFTest, StationaryRobotWithNoisySensorsStaysInPlace)
+{
+    /* Without the kinematics, the accelerometer bias alone would move the base by 0.5 * 0.05 * 5^2 = 0.6 m. */
+    std::mt19937 generator(42);
+    std::normal_distribution<double> noise(0., 1.);
+    const Vec3<double> accelerometerBias(0.05, -0.03, 0.02);
+    for (int i = 0; i < NUM_STEPS; ++i) {
+        Vec3<double> gyroscopeError, accelerometerError;
+        Eigen::Matrix<double, 3, NumLeg> kinematicsError;
+        for (int j = 0; j < 3; ++j) {
+            gyroscopeError[j] = 0.005 * noise(generator);
+            accelerometerError[j] = accelerometerBias[j] + 0.05 * noise(generator);
+            for (int leg = 0; leg < NumLeg; ++leg) {
+                kinematicsError(j, leg) = 0.001 * noise(generator);
+            }
+        }
+        Step(R0, p0, Vec3<double>::Zero(), Vec3<double>::Zero(), gyroscopeError, accelerometerError, kinematicsError);
+    }
+    EXPECT_LT((filter->GetPosition() - p0).norm(), 0.01);
+    EXPECT_LT(filter->GetVelocity().norm(), 0.01);
+}
+
+
+TEST_F(qrInvariantEKFTest, FollowsAccelerationAndYaw)
+{
+    /* The base accelerates forward from rest while turning at a constant yaw rate, under the fixed feet. */
+    const Vec3<double> acc(0.3, 0.1, 0.);
+    const Vec3<double> w(0., 0., 0.2);
+    Mat3<double> R = R0;
+    Vec3<double> p = p0;
+    Vec3<double> v = Vec3<double>::Zero();
+    for (int i = 0; i < NUM_STEPS / 5; ++i) {
+        Step(R, p, w, acc);
+        p += v * DT + 0.5 * acc * DT * DT;
+        v += acc * DT;
+        R = R * Eigen::AngleAxisd(w.norm() * DT, w.normalized()).toRotationMatrix();
+    }
+    /* The IMU is held over a step while the base turns, which leaves a discretization error of the order of DT. */
+    EXPECT_LT((filter->GetPosition() - p).norm(), 1e-3);
+    EXPECT_LT((filter->GetVelocity() - v).norm(), 1e-3);
+    EXPECT_LT((filter->GetRotation() - R).norm(), 1e-4);
+}
@@ -0,0 +1,183 @@
+// The MIT License
+
+// Copyright (c) 2022
+// Robot Motion and Vision Laboratory at East China Normal University
+// Contact: tophill.robotics@gmail.com
+
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include <gtest/gtest.h>
+
+#include <random>
+
+#include "controllers/qr_state_dataflow.h"
+#include "estimators/qr_kalman_filter.hpp"
+#include "estimators/qr_robot_estimator.h"
+
+using namespace Quadruped;
+
+namespace {
+
+/**
+ * @brief Random symmetric positive definite matrix, whose eigenvalues are at least minEigenvalue.
+ */
+template<int N>
+Eigen::Matrix<double, N, N> RandomSPD(std::mt19937 &generator, double minEigenvalue)
+{
+    std::normal_distribution<double> noise(0., 1.);
+    Eigen::Matrix<double, N, N> L;
+    for (int i = 0; i < N; ++i) {
+        for (int j = 0; j < N; ++j) {
+            L(i, j) = noise(generator);
+        }
+    }
+    return L * L.transpose() / N + minEigenvalue * Eigen::Matrix<double, N, N>::Identity();
+}
+
+/**
+ * @brief Checks qrKalmanFilter::Update against the update that CMUUpdate used to do,
+ * with two full pivoting QR solves and the dense covariance product, on random problems.
+ */
+template<int NX, int NZ>
+void CheckUpdate(const Eigen::Matrix<double, NZ, NX> &H, unsigned int seed)
+{
+    std::mt19937 generator(seed);
+    std::normal_distribution<double> noise(0., 1.);
+    const Eigen::Matrix<double, NX, NX> P = RandomSPD<NX>(generator, 1e-3);
+    const Eigen::Matrix<double, NZ, NZ> R = RandomSPD<NZ>(generator, 1e-3);
+    Eigen::Matrix<double, NX, 1> x;
+    Eigen::Matrix<double, NZ, 1> z;
+    for (int i = 0; i < NX; ++i) {
+        x[i] = noise(generator);
+    }
+    for (int i = 0; i < NZ; ++i) {
+        z[i] = noise(generator);
+    }
+
+    Eigen::Matrix<double, NZ, NZ> S = H * P * H.transpose() + R;
+    S = 0.5 * (S + S.transpose());
+    Eigen::Matrix<double, NX, 1> xExpected = x + P * H.transpose() * S.fullPivHouseholderQr().solve(z - H * x);
+    Eigen::Matrix<double, NX, NX> PExpected = P - P * H.transpose() * S.fullPivHouseholderQr().solve(H) * P;
+
+    qrKalmanFilter<double, NX, NZ> filter;
+    filter.H = H;
+    filter.Reset(x, P);
+    ASSERT_TRUE(filter.Update(z, R));
+
+    const double scale = 1. + PExpected.cwiseAbs().maxCoeff();
+    EXPECT_LT((filter.x - xExpected).cwiseAbs().maxCoeff(), 1e-9 * scale) << "seed " << seed;
+    EXPECT_LT((filter.P - PExpected).cwiseAbs().maxCoeff(), 1e-9 * scale) << "seed " << seed;
+    EXPECT_EQ(filter.P, filter.P.transpose()) << "seed " << seed;
+}
+
+} // Anonymous namespace
+
+
+TEST(qrKalmanFilterTest, UpdateMatchesQRUpdateOnCMUObservation)
+{
+    /* The observation matrix of the CMU filter in qrRobotEstimator::CMUInitState(). */
+    Eigen::Matrix<double, MEAS_SIZE, STATE_SIZE> C = Eigen::Matrix<double, MEAS_SIZE, STATE_SIZE>::Zero();
+    for (int i = 0; i < NumLeg; ++i) {
+        C.block<3, 3>(i * 3, 0) = -Mat3<double>::Identity();
+        C.block<3, 3>(i * 3, 6 + i * 3) = Mat3<double>::Identity();
+        C.block<3, 3>(NumLeg * 3 + i * 3, 3) = Mat3<double>::Identity();
+        C(NumLeg * 6 + i, 6 + i * 3 + 2) = 1;
+    }
+    for (unsigned int seed = 0; seed < 20; ++seed) {
+        CheckUpdate<STATE_SIZE, MEAS_SIZE>(C, seed);
+    }
+}
+
+
+TEST(qrKalmanFilterTest, UpdateMatchesQRUpdateOnRandomObservation)
+{
+    std::mt19937 generator(7);
+    std::normal_distribution<double> noise(0., 1.);
+    for (unsigned int seed = 0; seed < 20; ++seed) {
+        Eigen::Matrix<double, 6, 9> H;
+        for (int i = 0; i < H.rows(); ++i) {
+            for (int j = 0; j < H.cols(); ++j) {
+                H(i, j) = noise(generator);
+            }
+        }
+        CheckUpdate<9, 6>(H, seed);
+    }
+}
+
+
+TEST(qrKalmanFilterTest, VelocityFilterMatchesQRUpdate)
+{
+    /* The shape of the filter of qrRobotVelocityEstimator, whose H is identity. */
+    for (unsigned int seed = 0; seed < 20; ++seed) {
+        CheckUpdate<3, 3>(Mat3<double>::Identity(), seed);
+    }
+}
+
+
+TEST(qrKalmanFilterTest, GateMatchesMahalanobisDistance)
+{
+    std::mt19937 generator(7);
+    std::normal_distribution<double> noise(0., 1.);
+    qrKalmanFilter<double, 3, 3> filter;
+    filter.Reset(Vec3<double>(0.3, -0.1, 0.05), RandomSPD<3>(generator, 1e-3));
+    filter.Q = RandomSPD<3>(generator, 1e-3);
+    filter.R = RandomSPD<3>(generator, 1e-3);
+
+    /* The factor of the gate is reused between the measurements and refreshed after Predict() and Update(). */
+    const double threshold = 11.34;
+    for (int step = 0; step < 10; ++step) {
+        for (int i = 0; i < 20; ++i) {
+            Vec3<double> z = filter.x + 2. * Vec3<double>(noise(generator), noise(generator), noise(generator));
+            EXPECT_EQ(filter.IsInlier(z, threshold), filter.MahalanobisDistance(z, filter.R) <= threshold)
+                << "step " << step << ", measurement " << i;
+            EXPECT_TRUE(filter.IsInlier(z, 0.));
+        }
+        filter.Predict(Vec3<double>(0.01, 0., 0.));
+        filter.Update(filter.x + 0.1 * Vec3<double>(noise(generator), noise(generator), noise(generator)));
+    }
+}
+
+
+TEST(qrKalmanFilterTest, VelocityGateRejectsASlippingLeg)
+{
+    /* The filter of qrRobotVelocityEstimator with the variances of user_parameters.yaml,
+     * converged on a robot trotting at 0.3 m/s. */
+    std::mt19937 generator(11);
+    std::normal_distribution<float> noise(0.f, std::sqrt(0.1f));
+    const Vec3<float> velocity(0.3f, 0.f, 0.f);
+    qrKalmanFilter<float, 3, 3> filter(0.1f, 0.1f, 0.1f);
+    for (int tick = 0; tick < 1000; ++tick) {
+        filter.Predict(Vec3<float>::Zero());
+        filter.Update(velocity + Vec3<float>(noise(generator), noise(generator), noise(generator)));
+    }
+
+    qrUserParameters userParameters(std::string(QR_TEST_HOME) + "config/user_parameters.yaml");
+    const float threshold = userParameters.velocityGateThreshold;
+    ASSERT_GT(threshold, 0.f);
+
+    /* The legs in stance observe the velocity within their noise, the slipping foot drags the base along. */
+    int accepted = 0;
+    for (int leg = 0; leg < 3; ++leg) {
+        accepted += filter.IsInlier(velocity + Vec3<float>(noise(generator), noise(generator), 0.f), threshold);
+    }
+    EXPECT_EQ(accepted, 3);
+    const Vec3<float> slipping = velocity + Vec3<float>(2.f, 0.5f, 0.f);
+    EXPECT_FALSE(filter.IsInlier(slipping, threshold));
+    EXPECT_TRUE(filter.IsInlier(slipping, 0.f));
+}
@@ -0,0 +1,114 @@
+// The MIT License
+
+// Copyright (c) 2022
+// Robot Motion and Vision Laboratory at East China Normal University
+// Contact: tophill.robotics@gmail.com
+
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+
+#include <gtest/gtest.h>
+
+#include <memory>
+
+#include "exec/qr_batch_rollout.h"
+#include "exec/qr_log_replay.h"
+#include "exec/qr_robot_runner.h"
+#include "robots/qr_robot_headless_sim.h"
+#include "utils/qr_flight_recorder.h"
+
+using namespace Quadruped;
+
+namespace {
+
+/**
+ * @brief Simulated time of the recorded trot, in seconds.
+ */
+constexpr float RECORD_TIME = 2.f;
+
+/**
+ * @brief Records a1_sim trotting on the headless simulation once, for all the tests.
+ */
+class qrLogReplayTest : public ::testing::Test {
+
+protected:
+
+    static void SetUpTestSuite()
+    {
+        recordDir = std::string(QR_TEST_WORK_DIR) + "record/";
+        logPath = recordDir + "trot.qrf";
+        qrBatchRollout::PrepareConfig(QR_TEST_HOME, {
+            {"a1_sim/main.yaml", "const_twist/linear", YAML::Load("[0.2, 0, 0]")},
+            {"user_parameters.yaml", "flightRecorderPath", YAML::Node(logPath)}}, recordDir);
+
+        /* The runner owns the robot, and flushes the log when it is destroyed. */
+        qrRobotHeadlessSim *robot = new qrRobotHeadlessSim(recordDir + "config/a1_sim/a1_sim.yaml");
+        std::unique_ptr<qrRobotRunner> runner(new qrRobotRunner(robot, recordDir));
+        runner->Update();
+        runner->Step();
+        runner->GetDesiredStateCommand()->setJoyCtrlState(RC_MODE::HARD_CODE);
+        robot->fsmMode = K_LOCOMOTION;
+        const float startTime = robot->GetTimeSinceReset();
+        while (robot->GetTimeSinceReset() - startTime < RECORD_TIME) {
+            runner->Update();
+            runner->Step();
+        }
+    }
+
+    static std::string recordDir;
+
+    static std::string logPath;
+};
+
+std::string qrLogReplayTest::recordDir;
+
+std::string qrLogReplayTest::logPath;
+
+} // Anonymous namespace
+
+
+TEST_F(qrLogReplayTest, ReplayDoesNotDiverge)
+{
+    const size_t numRecords = qrFlightLog(logPath).Size();
+    ASSERT_GT(numRecords, 1000u);
+
+    /* The replay reads the configuration the log was recorded with. */
+    qrLogReplay replay(recordDir, "a1_sim", std::string(QR_TEST_WORK_DIR) + "replay/");
+    const qrReplayReport report = replay.Run(logPath);
+    report.Print();
+    ASSERT_TRUE(report.error.empty()) << report.error;
+    EXPECT_EQ(report.ticks, numRecords);
+    EXPECT_EQ(report.divergentTicks, 0u) << "first at tick " << report.firstDivergentTick;
+
+    /* The filters of the replay start on the first record rather than before the log, hence not to the bit. */
+    EXPECT_LT(report.maxEstimateError[0], 1e-2f);
+    EXPECT_LT(report.maxEstimateError[1], 1e-2f);
+}
+
+
+TEST_F(qrLogReplayTest, ControllerChangeDiverges)
+{
+    /* Other MPC weights than in the recording give other forces, so other torques. */
+    qrLogReplay replay(recordDir, "a1_sim", std::string(QR_TEST_WORK_DIR) + "replay_q/");
+    const qrReplayReport report = replay.Run(logPath, {
+        {"a1_sim/stance_leg_controller.yaml", "stance_leg_params/advanced_trot/Q",
+         YAML::Load("[50, 50, 5, 40, 60, 100, 0., 0, 0.5, 5, 5, 1]")}});
+    ASSERT_TRUE(report.error.empty()) << report.error;
+    EXPECT_GT(report.divergentTicks, report.ticks / 2);
+}
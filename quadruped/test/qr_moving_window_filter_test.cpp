@@ -0,0 +1,183 @@
+// The MIT License
+
+// Copyright (c) 2022
+// Robot Motion and Vision Laboratory at East China Normal University
+// Contact: tophill.robotics@gmail.com
+
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include <gtest/gtest.h>
+
+#include <deque>
+#include <random>
+#include <vector>
+
+#include "estimators/qr_moving_window_filter.hpp"
+#include "utils/qr_alloc_tracker.h"
+
+using namespace Quadruped;
+
+namespace {
+
+/**
+ * @brief Number of values pushed, several times the windows below, so that the ring buffer wraps around.
+ */
+constexpr int NUM_VALUES = 500;
+
+/**
+ * @brief The value at which the window is reset, to check that the ring buffer starts over.
+ */
+constexpr int RESET_AT = 211;
+
+/**
+ * @brief Random values around an offset, which makes the running sum lose low-order digits without compensation.
+ */
+template<class T, int N>
+std::vector<Eigen::Matrix<T, N, 1>> RandomValues(unsigned int seed)
+{
+    std::mt19937 generator(seed);
+    std::normal_distribution<double> noise(0., 1.);
+    std::vector<Eigen::Matrix<T, N, 1>> values(NUM_VALUES);
+    for (auto &value : values) {
+        for (int j = 0; j < N; ++j) {
+            value[j] = T(100. + noise(generator));
+        }
+    }
+    return values;
+}
+
+/**
+ * @brief Push the values into a filter and check the average and the variance of every window
+ * against the ones computed from a plain copy of the window, and that no push allocates.
+ */
+template<class T, int N>
+void CheckFilter(unsigned int windowSize, double tolerance)
+{
+    SCOPED_TRACE("window " + std::to_string(windowSize));
+    const auto values = RandomValues<T, N>(windowSize);
+    std::vector<Eigen::Matrix<T, N, 1>> averages(NUM_VALUES), variances(NUM_VALUES);
+    qrMovingWindowFilter<T, N> filter(windowSize);
+
+    qrAllocTracker::BeginTick();
+    for (int i = 0; i < NUM_VALUES; ++i) {
+        if (i == RESET_AT) {
+            filter.Reset();
+        }
+        averages[i] = filter.CalculateAverage(values[i]);
+        variances[i] = filter.GetVariance();
+    }
+    qrAllocStats stats = qrAllocTracker::EndTick();
+    EXPECT_EQ(stats.allocations, 0u) << stats.bytes << " bytes allocated";
+
+    std::deque<Eigen::Matrix<double, N, 1>> window;
+    for (int i = 0; i < NUM_VALUES; ++i) {
+        if (i == RESET_AT) {
+            window.clear();
+        }
+        window.push_back(values[i].template cast<double>());
+        if (window.size() > windowSize) {
+            window.pop_front();
+        }
+        Eigen::Matrix<double, N, 1> average = Eigen::Matrix<double, N, 1>::Zero();
+        for (const auto &value : window) {
+            average += value;
+        }
+        average /= window.size();
+        Eigen::Matrix<double, N, 1> variance = Eigen::Matrix<double, N, 1>::Zero();
+        for (const auto &value : window) {
+            variance += (value - average).array().square().matrix();
+        }
+        variance /= window.size();
+
+        ASSERT_LE((averages[i].template cast<double>() - average).cwiseAbs().maxCoeff(), tolerance) << "value " << i;
+        ASSERT_LE((variances[i].template cast<double>() - variance).cwiseAbs().maxCoeff(), tolerance) << "value " << i;
+    }
+}
+
+/**
+ * @brief The same for the specialization of scalar doubles.
+ */
+void CheckScalarFilter(unsigned int windowSize, double tolerance)
+{
+    SCOPED_TRACE("window " + std::to_string(windowSize));
+    const auto values = RandomValues<double, 1>(windowSize);
+    std::vector<double> averages(NUM_VALUES), variances(NUM_VALUES);
+    qrMovingWindowFilter<double, 1> filter(windowSize);
+
+    qrAllocTracker::BeginTick();
+    for (int i = 0; i < NUM_VALUES; ++i) {
+        if (i == RESET_AT) {
+            filter.Reset();
+        }
+        averages[i] = filter.CalculateAverage(values[i][0]);
+        variances[i] = filter.GetVariance();
+    }
+    qrAllocStats stats = qrAllocTracker::EndTick();
+    EXPECT_EQ(stats.allocations, 0u) << stats.bytes << " bytes allocated";
+
+    std::deque<double> window;
+    for (int i = 0; i < NUM_VALUES; ++i) {
+        if (i == RESET_AT) {
+            window.clear();
+        }
+        window.push_back(values[i][0]);
+        if (window.size() > windowSize) {
+            window.pop_front();
+        }
+        double average = 0.;
+        for (double value : window) {
+            average += value;
+        }
+        average /= window.size();
+        double variance = 0.;
+        for (double value : window) {
+            variance += (value - average) * (value - average);
+        }
+        variance /= window.size();
+
+        ASSERT_NEAR(averages[i], average, tolerance) << "value " << i;
+        ASSERT_NEAR(variances[i], variance, tolerance) << "value " << i;
+    }
+}
+
+} // Anonymous namespace
+
+
+TEST(qrMovingWindowFilterTest, VectorFloatMatchesRecomputation)
+{
+    for (unsigned int windowSize : {1u, 7u, 20u, 64u}) {
+        CheckFilter<float, 12>(windowSize, 1e-3);
+    }
+}
+
+
+TEST(qrMovingWindowFilterTest, VectorDoubleMatchesRecomputation)
+{
+    for (unsigned int windowSize : {1u, 7u, 20u, 64u}) {
+        CheckFilter<double, 3>(windowSize, 1e-9);
+    }
+}
+
+
+TEST(qrMovingWindowFilterTest, ScalarDoubleMatchesRecomputation)
+{
+    for (unsigned int windowSize : {1u, 7u, 50u, 64u}) {
+        CheckScalarFilter(windowSize, 1e-9);
+    }
+}
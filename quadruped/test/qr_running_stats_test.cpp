@@ -0,0 +1,178 @@
+// The MIT License
+
+// Copyright (c) 2022
+// Robot Motion and Vision Laboratory at East China Normal University
+// Contact: tophill.robotics@gmail.com
+
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <cmath>
+#include <random>
+#include <vector>
+
+#include "utils/qr_running_stats.h"
+
+using namespace Quadruped;
+
+namespace {
+
+/**
+ * @brief Number of samples, enough for the tails of the sketch to hold many samples.
+ */
+constexpr int NUM_SAMPLES = 20000;
+
+/**
+ * @brief Relative error of the sketch with the default constructor, as stated in its header.
+ */
+constexpr double RELATIVE_ACCURACY = 0.01;
+
+/**
+ * @brief Samples around a large offset with a small spread, for which the naive
+ * sum of squares loses most of its digits.
+ */
+std::vector<double> OffsetSamples(unsigned int seed)
+{
+    std::mt19937 generator(seed);
+    std::normal_distribution<double> noise(1e6, 0.1);
+    std::vector<double> samples(NUM_SAMPLES);
+    for (double &sample : samples) {
+        sample = noise(generator);
+    }
+    return samples;
+}
+
+/**
+ * @brief Samples of both signs spread over many orders of magnitude, with a few exact zeros.
+ */
+std::vector<double> WideSamples(unsigned int seed)
+{
+    std::mt19937 generator(seed);
+    std::lognormal_distribution<double> magnitude(0., 3.);
+    std::bernoulli_distribution negative(0.3);
+    std::bernoulli_distribution zero(0.01);
+    std::vector<double> samples(NUM_SAMPLES);
+    for (double &sample : samples) {
+        if (zero(generator)) {
+            sample = 0.;
+        } else {
+            sample = negative(generator) ? -magnitude(generator) : magnitude(generator);
+        }
+    }
+    return samples;
+}
+
+/**
+ * @brief Check the statistics against the mean and the population variance
+ * computed in two passes over the samples.
+ */
+void CheckTwoPass(const qrRunningStats &stats, const std::vector<double> &samples)
+{
+    double mean = 0.;
+    for (double sample : samples) {
+        mean += sample;
+    }
+    mean /= samples.size();
+    double variance = 0.;
+    for (double sample : samples) {
+        variance += (sample - mean) * (sample - mean);
+    }
+    variance /= samples.size();
+
+    EXPECT_EQ(stats.GetCount(), samples.size());
+    EXPECT_NEAR(stats.GetMean(), mean, 1e-9 * std::max(1., std::abs(mean)));
+    EXPECT_NEAR(stats.GetVariance(), variance, 1e-6 * variance);
+    EXPECT_NEAR(stats.GetSum(), mean * samples.size(), 1e-9 * std::abs(mean) * samples.size());
+    EXPECT_EQ(stats.GetMin(), *std::min_element(samples.begin(), samples.end()));
+    EXPECT_EQ(stats.GetMax(), *std::max_element(samples.begin(), samples.end()));
+}
+
+/**
+ * @brief Check the quantiles of the sketch against the sample at the same rank of the sorted samples.
+ */
+void CheckQuantiles(const qrQuantileSketch &sketch, std::vector<double> samples)
+{
+    std::sort(samples.begin(), samples.end());
+    ASSERT_EQ(sketch.GetCount(), samples.size());
+    for (double q : {0., 0.001, 0.01, 0.1, 0.25, 0.5, 0.75, 0.9, 0.99, 0.999, 1.}) {
+        double exact = samples[static_cast<size_t>(q * (samples.size() - 1))];
+        EXPECT_LE(std::abs(sketch.GetQuantile(q) - exact), RELATIVE_ACCURACY * std::abs(exact) + 1e-12)
+            << "quantile " << q << " exact " << exact;
+    }
+}
+
+} // Anonymous namespace
+
+
+TEST(qrRunningStatsTest, MatchesTwoPassComputation)
+{
+    for (const auto &samples : {OffsetSamples(1), WideSamples(2)}) {
+        qrRunningStats stats;
+        for (double sample : samples) {
+            stats.Update(sample);
+        }
+        CheckTwoPass(stats, samples);
+    }
+}
+
+
+TEST(qrRunningStatsTest, MergeMatchesOneStream)
+{
+    const auto samples = OffsetSamples(3);
+    qrRunningStats first, second;
+    for (int i = 0; i < NUM_SAMPLES; ++i) {
+        (i < NUM_SAMPLES / 3 ? first : second).Update(samples[i]);
+    }
+    first.Merge(second);
+    CheckTwoPass(first, samples);
+
+    first.Reset();
+    EXPECT_EQ(first.GetCount(), 0u);
+    EXPECT_EQ(first.GetVariance(), 0.);
+}
+
+
+TEST(qrQuantileSketchTest, QuantilesWithinRelativeAccuracy)
+{
+    for (const auto &samples : {OffsetSamples(4), WideSamples(5)}) {
+        qrQuantileSketch sketch;
+        for (double sample : samples) {
+            sketch.Update(sample);
+        }
+        CheckQuantiles(sketch, samples);
+    }
+}
+
+
+TEST(qrQuantileSketchTest, MergeMatchesOneStream)
+{
+    const auto samples = WideSamples(6);
+    qrQuantileSketch first, second;
+    for (int i = 0; i < NUM_SAMPLES; ++i) {
+        (i % 2 ? first : second).Update(samples[i]);
+    }
+    first.Merge(second);
+    CheckQuantiles(first, samples);
+
+    first.Reset();
+    EXPECT_EQ(first.GetCount(), 0u);
+    EXPECT_EQ(first.GetQuantile(0.5), 0.);
+}
@@ -0,0 +1,110 @@
+// The MIT License
+
+// Copyright (c) 2022
+// Robot Motion and Vision Laboratory at East China Normal University
+// Contact: tophill.robotics@gmail.com
+
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include <gtest/gtest.h>
+
+#include <stdint.h>
+#include <thread>
+
+#include "utils/qr_solver_arena.h"
+
+using namespace Quadruped;
+
+
+TEST(qrSolverArenaTest, ServesOnlyInsideScope)
+{
+    EXPECT_EQ(qrSolverArena::Allocate(64), nullptr);
+    {
+        qrSolverAllocScope scope;
+        {
+            qrSolverAllocScope nested;
+        }
+        size_t allocations = qrSolverArena::Allocations();
+        void *ptr = qrSolverArena::Allocate(64);
+        ASSERT_NE(ptr, nullptr);
+        EXPECT_EQ(reinterpret_cast<uintptr_t>(ptr) % 16, 0u);
+        EXPECT_EQ(qrSolverArena::Allocations(), allocations + 1);
+        EXPECT_TRUE(qrSolverArena::Release(ptr));
+    }
+    EXPECT_EQ(qrSolverArena::Allocate(64), nullptr);
+
+    int onHeap = 0;
+    EXPECT_FALSE(qrSolverArena::Release(&onHeap));
+    EXPECT_FALSE(qrSolverArena::Release(nullptr));
+}
+
+
+TEST(qrSolverArenaTest, ReusesReleasedBlocks)
+{
+    qrSolverAllocScope scope;
+    char *a = static_cast<char *>(qrSolverArena::Allocate(100));
+    char *b = static_cast<char *>(qrSolverArena::Allocate(1));
+    ASSERT_NE(a, nullptr);
+    ASSERT_NE(b, nullptr);
+    EXPECT_GE(b, a + 100);
+
+    /* In LIFO order the top goes back at once. */
+    EXPECT_TRUE(qrSolverArena::Release(b));
+    EXPECT_EQ(qrSolverArena::Allocate(1), b);
+
+    /* Out of order, a is reclaimed with the last block above it. */
+    EXPECT_TRUE(qrSolverArena::Release(a));
+    char *c = static_cast<char *>(qrSolverArena::Allocate(1));
+    EXPECT_GT(c, b);
+    EXPECT_TRUE(qrSolverArena::Release(c));
+    EXPECT_TRUE(qrSolverArena::Release(b));
+    EXPECT_EQ(qrSolverArena::Allocate(100), a);
+    EXPECT_TRUE(qrSolverArena::Release(a));
+}
+
+
+TEST(qrSolverArenaTest, ReclaimsBlocksReleasedByAnotherThread)
+{
+    qrSolverAllocScope scope;
+    void *a = qrSolverArena::Allocate(256);
+    ASSERT_NE(a, nullptr);
+
+    bool released = false;
+    std::thread other([&]() {
+        released = qrSolverArena::Release(a);
+    });
+    other.join();
+    EXPECT_TRUE(released);
+
+    EXPECT_EQ(qrSolverArena::Allocate(256), a);
+    EXPECT_TRUE(qrSolverArena::Release(a));
+}
+
+
+TEST(qrSolverArenaTest, FallsBackWhenTheSlabIsFull)
+{
+    qrSolverAllocScope scope;
+    EXPECT_EQ(qrSolverArena::Allocate(qrSolverArena::SLAB_SIZE), nullptr);
+
+    void *half = qrSolverArena::Allocate(qrSolverArena::SLAB_SIZE / 2);
+    ASSERT_NE(half, nullptr);
+    EXPECT_EQ(qrSolverArena::Allocate(qrSolverArena::SLAB_SIZE / 2), nullptr);
+    EXPECT_TRUE(qrSolverArena::Release(half));
+    EXPECT_GE(qrSolverArena::PeakBytes(), qrSolverArena::SLAB_SIZE / 2);
+}
@@ -0,0 +1,185 @@
+// The MIT License
+
+// Copyright (c) 2022
+// Robot Motion and Vision Laboratory at East China Normal University
+// Contact: tophill.robotics@gmail.com
+
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <chrono>
+#include <map>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "exec/qr_task_scheduler.h"
+
+using namespace Quadruped;
+
+namespace {
+
+/**
+ * @brief Number of ticks run, a multiple of all the periods below.
+ */
+constexpr unsigned long NUM_TICKS = 48;
+
+/**
+ * @brief One run of a task.
+ */
+struct qrTaskRun {
+
+    std::string name;
+
+    unsigned long tick;
+
+    /**
+     * @brief Position of the start and of the end of the run among all the events.
+     */
+    size_t start;
+
+    size_t end;
+};
+
+/**
+ * @brief The user parameters with the given number of workers and without real-time setup.
+ * The rates are left to the defaults given to AddTask.
+ */
+qrUserParameters LoadParameters(unsigned int threads)
+{
+    qrUserParameters userParameters(std::string(QR_TEST_HOME) + "config/user_parameters.yaml");
+    userParameters.useRealtime = false;
+    userParameters.schedulerThreads = threads;
+    userParameters.taskRates.clear();
+    return userParameters;
+}
+
+/**
+ * @brief A scheduler with a diamond of tasks at different rates, and an independent task:
+ *
+ *   imu (1) --> estimator (2, 0) --> controller (1) --> actuation (1)
+ *          \--> contacts  (3, 1) -/
+ *   logger (4, 2)
+ *
+ * Each task records its runs, so the test can check the order and the ticks of the releases.
+ * The number of worker threads is the parameter.
+ */
+class qrTaskSchedulerTest : public ::testing::TestWithParam<unsigned int> {
+
+protected:
+
+    qrTaskSchedulerTest():
+        userParameters(LoadParameters(GetParam())),
+        realtimeSetup(userParameters),
+        events(0)
+    {
+    }
+
+    /**
+     * @brief A task that records when it starts and ends. It lasts long enough
+     * for a task that starts too early to be seen overlapping.
+     */
+    std::function<void()> Recorder(const std::string &name, qrTaskScheduler &scheduler)
+    {
+        return [this, name, &scheduler]() {
+            qrTaskRun run = {name, scheduler.GetTick(), events++, 0};
+            std::this_thread::sleep_for(std::chrono::microseconds(100));
+            run.end = events++;
+            std::lock_guard<std::mutex> lock(mutex);
+            runs.push_back(run);
+        };
+    }
+
+    qrUserParameters userParameters;
+
+    qrRealtimeSetup realtimeSetup;
+
+    std::atomic<size_t> events;
+
+    std::mutex mutex;
+
+    std::vector<qrTaskRun> runs;
+
+};
+
+} // Anonymous namespace
+
+
+TEST_P(qrTaskSchedulerTest, RunsTheDueTasksInDependencyOrder)
+{
+    const std::map<std::string, qrTaskRate> rates = {
+        {"imu", {1, 0}}, {"estimator", {2, 0}}, {"contacts", {3, 1}},
+        {"controller", {1, 0}}, {"actuation", {1, 0}}, {"logger", {4, 2}}};
+    const std::map<std::string, std::vector<std::string>> dependencies = {
+        {"imu", {}}, {"estimator", {"imu"}}, {"contacts", {"imu"}},
+        {"controller", {"estimator", "contacts"}}, {"actuation", {"controller"}}, {"logger", {}}};
+
+    qrTaskScheduler scheduler(userParameters, realtimeSetup);
+    for (const auto &task : dependencies) {
+        scheduler.AddTask(task.first, Recorder(task.first, scheduler), task.second, rates.at(task.first));
+    }
+    scheduler.Build();
+    for (unsigned long tick = 0; tick < NUM_TICKS; ++tick) {
+        ASSERT_EQ(scheduler.GetTick(), tick);
+        scheduler.Run();
+    }
+
+    /* Each task is released exactly at the ticks of its period and offset. */
+    for (const auto &rate : rates) {
+        std::vector<unsigned long> ticks, expected;
+        for (const auto &run : runs) {
+            if (run.name == rate.first) {
+                ticks.push_back(run.tick);
+            }
+        }
+        for (unsigned long tick = rate.second.offset; tick < NUM_TICKS; tick += rate.second.period) {
+            expected.push_back(tick);
+        }
+        EXPECT_EQ(ticks, expected) << rate.first;
+    }
+
+    /* Within a tick, a task starts after all its dependencies that ran in the tick have ended. */
+    for (const auto &run : runs) {
+        for (const auto &dependency : dependencies.at(run.name)) {
+            for (const auto &other : runs) {
+                if (other.name == dependency && other.tick == run.tick) {
+                    EXPECT_LT(other.end, run.start) << run.name << " before " << dependency << " in tick " << run.tick;
+                }
+            }
+        }
+    }
+}
+
+
+TEST_P(qrTaskSchedulerTest, RejectsCycles)
+{
+    qrTaskScheduler scheduler(userParameters, realtimeSetup);
+    scheduler.AddTask("a", Recorder("a", scheduler), {"b"});
+    scheduler.AddTask("b", Recorder("b", scheduler), {"a"});
+    EXPECT_THROW(scheduler.Build(), std::runtime_error);
+}
+
+
+INSTANTIATE_TEST_SUITE_P(Threads, qrTaskSchedulerTest, ::testing::Values(0u, 1u, 3u),
+                         [](const ::testing::TestParamInfo<unsigned int> &info) {
+                             return std::to_string(info.param) + "Workers";
+                         });
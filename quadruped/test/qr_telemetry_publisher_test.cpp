@@ -0,0 +1,160 @@
+// The MIT License
+
+// Copyright (c) 2022
+// Robot Motion and Vision Laboratory at East China Normal University
+// Contact: tophill.robotics@gmail.com
+
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <map>
+#include <string>
+#include <vector>
+
+#include "utils/qr_telemetry_publisher.h"
+
+using namespace Quadruped;
+
+namespace {
+
+/**
+ * @brief Frequency of the simulated control loop (unit: Hz).
+ */
+constexpr float CONTROL_FREQUENCY = 500.f;
+
+/**
+ * @brief Number of control ticks. The ring holds all of them, so that no sample is dropped
+ * even if the publisher thread is not scheduled before the end of the loop.
+ */
+constexpr unsigned int NUM_TICKS = 1000;
+
+/**
+ * @brief Fill a message with values that identify the tick they come from.
+ */
+void FillSample(qr_telemetry_lcmt &message, int tick)
+{
+    message.utime = 2000 * static_cast<int64_t>(tick);
+    message.tick = tick;
+    message.fsm_mode = static_cast<int8_t>(tick % 3);
+    message.latency = 1e-4f * tick;
+    for (int i = 0; i < 3; ++i) {
+        message.rpy[i] = 0.01f * tick + i;
+        message.velocity[i] = -0.5f * tick + i;
+        message.velocity_command[i] = 0.25f * i;
+    }
+    for (int i = 0; i < 12; ++i) {
+        message.q[i] = 0.1f * i + tick;
+        message.tau_des[i] = -0.2f * i - tick;
+    }
+    for (int i = 0; i < 4; ++i) {
+        message.foot_force[i] = 10.f * i + tick;
+        message.contact[i] = (tick + i) % 2 == 0;
+    }
+}
+
+/**
+ * @brief Check that a received message holds the values of its tick.
+ */
+void CheckSample(const qr_telemetry_lcmt &message)
+{
+    qr_telemetry_lcmt expected;
+    FillSample(expected, message.tick);
+    EXPECT_EQ(message.utime, expected.utime);
+    EXPECT_EQ(message.fsm_mode, expected.fsm_mode);
+    EXPECT_EQ(message.latency, expected.latency);
+    for (int i = 0; i < 3; ++i) {
+        EXPECT_EQ(message.rpy[i], expected.rpy[i]);
+        EXPECT_EQ(message.velocity[i], expected.velocity[i]);
+        EXPECT_EQ(message.velocity_command[i], expected.velocity_command[i]);
+    }
+    for (int i = 0; i < 12; ++i) {
+        EXPECT_EQ(message.q[i], expected.q[i]);
+        EXPECT_EQ(message.tau_des[i], expected.tau_des[i]);
+    }
+    for (int i = 0; i < 4; ++i) {
+        EXPECT_EQ(message.foot_force[i], expected.foot_force[i]);
+        EXPECT_EQ(message.contact[i], expected.contact[i]);
+    }
+}
+
+} // Anonymous namespace
+
+
+TEST(qrTelemetryPublisherTest, PublishesDecimatedChannelsOverMemq)
+{
+    /* 30 Hz does not divide the control frequency, its decimation is rounded to 17 ticks. */
+    const std::map<std::string, float> rates = {
+        {"TELEMETRY_FAST", 100.f}, {"TELEMETRY_ODD", 30.f}, {"TELEMETRY_SLOW", 10.f}, {"TELEMETRY_OFF", 0.f}};
+    const std::map<std::string, int> periods = {{"TELEMETRY_FAST", 5}, {"TELEMETRY_ODD", 17}, {"TELEMETRY_SLOW", 50}};
+    qrTelemetryPublisher publisher("memq://", rates, CONTROL_FREQUENCY, NUM_TICKS);
+
+    std::map<std::string, std::vector<int>> received;
+    for (const auto &rate : rates) {
+        lcm::Subscription *subscription = publisher.GetLcm().subscribe<qr_telemetry_lcmt>(rate.first,
+            [&received](const lcm::ReceiveBuffer *, const std::string &channel, const qr_telemetry_lcmt *message) {
+                received[channel].push_back(message->tick);
+                CheckSample(*message);
+            });
+        /* Handled only after the loop, so the subscriber keeps every message. */
+        subscription->setQueueCapacity(0);
+    }
+
+    unsigned long expectedMessages = 0;
+    for (const auto &period : periods) {
+        expectedMessages += (NUM_TICKS - 1) / period.second + 1;
+    }
+
+    for (unsigned int tick = 0; tick < NUM_TICKS; ++tick) {
+        qr_telemetry_lcmt *message = publisher.BeginSample();
+        bool due = false;
+        for (const auto &period : periods) {
+            due = due || tick % period.second == 0;
+        }
+        ASSERT_EQ(message != nullptr, due) << "tick " << tick;
+        if (message) {
+            FillSample(*message, tick);
+            publisher.CommitSample();
+        }
+    }
+    EXPECT_EQ(publisher.GetDropped(), 0u);
+
+    unsigned long handled = 0;
+    const auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(10);
+    while (std::chrono::steady_clock::now() < deadline) {
+        if (handled < expectedMessages && publisher.GetLcm().handleTimeout(100) > 0) {
+            ++handled;
+        } else if (handled == expectedMessages && publisher.GetPublished() == expectedMessages) {
+            break;
+        }
+    }
+    EXPECT_EQ(handled, expectedMessages);
+    EXPECT_EQ(publisher.GetPublished(), expectedMessages);
+
+    EXPECT_EQ(received.count("TELEMETRY_OFF"), 0u);
+    for (const auto &period : periods) {
+        SCOPED_TRACE(period.first);
+        const std::vector<int> &ticks = received[period.first];
+        ASSERT_EQ(ticks.size(), (NUM_TICKS - 1) / period.second + 1);
+        for (size_t i = 0; i < ticks.size(); ++i) {
+            EXPECT_EQ(ticks[i], static_cast<int>(i) * period.second);
+        }
+    }
+}